@@ -154,6 +154,7 @@
 #include "gl_text.h"
 #include "gl_shapes.h"
 #include "gl_image.h"
+#include "gl_stats.h"
 
 /** \addtogroup apigroup API
  *  \brief API
@@ -221,6 +222,36 @@ void gl_set_driver(gl_driver_t *driver);
  */
 void gl_clear(gl_color_t color);
 
+/**
+ * @brief Move already drawn area of the display to new position.
+ * If driver is not set or it does not support copying then function do nothing.
+ *
+ * @details Borders set by user using @ref gl_set_crop_borders will be ignored.
+ * Source and destination areas may overlap. Area left uncovered by the copy
+ * keeps its previous content and should be redrawn by the caller.
+ *
+ * @param[in] src Area that is copied. Must be inside of the display.
+ * @param[in] x X coordinate of the top left corner of the destination area.
+ * @param[in] y Y coordinate of the top left corner of the destination area.
+ * @return true if area is copied, false if driver does not support copying or
+ * any of the areas is outside of the display, in which case caller should redraw
+ * destination area.
+ *
+ * Example :
+ * @code
+    gl_rectangle_t list_rect = {{0, 20}, 100, 200};
+
+    // Scroll area up for 10 pixels and redraw exposed strip at the bottom.
+    list_rect.top_left.y += 10;
+    list_rect.height -= 10;
+    if (!gl_copy_rect(&list_rect, 0, 20))
+    {
+        // redraw whole area
+    }
+ * @endcode
+ */
+bool gl_copy_rect(gl_rectangle_t *src, gl_coord_t x, gl_coord_t y);
+
 /**
  * @brief Initialize borders for drawing on display.
  *
@@ -51,14 +51,88 @@ extern "C"{
 #endif
 
 /**
- *  This type is used for color representation.
+ *  Native pixel format selectors for @ref GL_COLOR_DEPTH.
  */
-typedef uint16_t gl_color_t;
+#define GL_COLOR_DEPTH_1BPP   1   /**< Monochrome, one bit per pixel. */
+#define GL_COLOR_DEPTH_8BPP   8   /**< RGB332, one byte per pixel. */
+#define GL_COLOR_DEPTH_16BPP 16   /**< RGB565, two bytes per pixel. */
+#define GL_COLOR_DEPTH_24BPP 24   /**< RGB888, three bytes per pixel. */
 
 /**
- *  Macro used for making specific color out of hex.
+ *  Native pixel format the Graphic Library is built for.
+ *  Can be set with MSDK_GL_COLOR_DEPTH CMake option, or defined before including
+ *  this header. Every module that shares @ref gl_color_t with the library
+ *  (display drivers, VTFT, application) must be built with the same value.
+ *  Defaults to RGB565.
  */
-#define GL_HEX2COLOR( hex ) ((gl_color_t)((((hex) & 0xF80000)>>8) | (((hex) & 0x00FC00)>>5) | (((hex) & 0x0000F8)>>3)))
+#ifndef GL_COLOR_DEPTH
+#define GL_COLOR_DEPTH GL_COLOR_DEPTH_16BPP
+#endif
+
+#if (GL_COLOR_DEPTH == GL_COLOR_DEPTH_1BPP)
+
+/**
+ *  This type is used for color representation. Holds 0 (pixel off) or 1 (pixel on).
+ */
+typedef uint8_t gl_color_t;
+
+/**
+ *  Macro used for making color out of RGB values.
+ *  Pixel is on if brightness of the color is at least half of the maximum.
+ */
+#define GL_RGB2COLOR( r, g, b ) ((gl_color_t)(((((uint16_t)(r) & 0xFF) + (((uint16_t)(g) & 0xFF) << 1) + ((uint16_t)(b) & 0xFF)) >> 2) >= 0x80))
+
+/**
+ *  Macros for getting values for red, green and blue color from RGB out of given @ref gl_color_t.
+ */
+#define GL_RED_OF( c ) ((c) ? 0xFF : 0x00)
+#define GL_GREEN_OF( c ) ((c) ? 0xFF : 0x00)
+#define GL_BLUE_OF( c ) ((c) ? 0xFF : 0x00)
+
+#elif (GL_COLOR_DEPTH == GL_COLOR_DEPTH_8BPP)
+
+/**
+ *  This type is used for color representation. Bits are laid out as RRRGGGBB.
+ */
+typedef uint8_t gl_color_t;
+
+/**
+ *  Macro used for making color out of RGB values.
+ */
+#define GL_RGB2COLOR( r, g, b ) ((gl_color_t)((((uint8_t)(r) >> 5) << 5) | (((uint8_t)(g) >> 5) << 2) | ((uint8_t)(b) >> 6)))
+
+/**
+ *  Macros for getting values for red, green and blue color from RGB out of given @ref gl_color_t.
+ */
+#define GL_RED_OF( c ) ((uint8_t)((gl_color_t)(c) & 0xE0))
+#define GL_GREEN_OF( c ) ((uint8_t)(((gl_color_t)(c) & 0x1C) << 3))
+#define GL_BLUE_OF( c ) ((uint8_t)(((gl_color_t)(c) & 0x03) << 6))
+
+#elif (GL_COLOR_DEPTH == GL_COLOR_DEPTH_24BPP)
+
+/**
+ *  This type is used for color representation. Bits are laid out as 0x00RRGGBB.
+ */
+typedef uint32_t gl_color_t;
+
+/**
+ *  Macro used for making color out of RGB values.
+ */
+#define GL_RGB2COLOR( r, g, b ) ((gl_color_t)((((gl_color_t)(r) & 0xFF) << 16) | (((gl_color_t)(g) & 0xFF) << 8) | ((gl_color_t)(b) & 0xFF)))
+
+/**
+ *  Macros for getting values for red, green and blue color from RGB out of given @ref gl_color_t.
+ */
+#define GL_RED_OF( c ) ((uint8_t)((gl_color_t)(c) >> 16))
+#define GL_GREEN_OF( c ) ((uint8_t)((gl_color_t)(c) >> 8))
+#define GL_BLUE_OF( c ) ((uint8_t)(c))
+
+#elif (GL_COLOR_DEPTH == GL_COLOR_DEPTH_16BPP)
+
+/**
+ *  This type is used for color representation.
+ */
+typedef uint16_t gl_color_t;
 
 /**
  *  Macro used for making color out of RGB values.
@@ -80,6 +154,39 @@ typedef uint16_t gl_color_t;
  */
 #define GL_BLUE_OF( c ) ((gl_color_t)c << 3)
 
+#else
+#error "Unsupported GL_COLOR_DEPTH value."
+#endif
+
+#if (GL_COLOR_DEPTH == GL_COLOR_DEPTH_16BPP)
+
+/**
+ *  Macro used for making specific color out of hex.
+ */
+#define GL_HEX2COLOR( hex ) ((gl_color_t)((((hex) & 0xF80000)>>8) | (((hex) & 0x00FC00)>>5) | (((hex) & 0x0000F8)>>3)))
+
+/**
+ *  Macro for converting RGB565 value (the format of images and palettes
+ *  generated by NECTO Studio) to @ref gl_color_t. No-op in RGB565 build.
+ */
+#define GL_RGB565_TO_COLOR( c ) ((gl_color_t)(c))
+
+/**
+ *  Macro for converting @ref gl_color_t to RGB565 value, for display
+ *  controllers that only accept 16-bit pixels. No-op in RGB565 build.
+ */
+#define GL_COLOR_TO_RGB565( c ) ((uint16_t)(c))
+
+#else
+
+#define GL_HEX2COLOR( hex ) GL_RGB2COLOR(((hex) >> 16) & 0xFF, ((hex) >> 8) & 0xFF, (hex) & 0xFF)
+
+#define GL_RGB565_TO_COLOR( c ) GL_RGB2COLOR(((uint16_t)(c) >> 11) << 3, (((uint16_t)(c) >> 5) & 0x3F) << 2, ((uint16_t)(c) & 0x1F) << 3)
+
+#define GL_COLOR_TO_RGB565( c ) ((uint16_t)((((uint16_t)GL_RED_OF(c) >> 3) << 11) | (((uint16_t)GL_GREEN_OF(c) >> 2) << 5) | ((uint16_t)GL_BLUE_OF(c) >> 3)))
+
+#endif
+
 /**
  *  Macro for getting brightness of the given color.
  */
@@ -87,6 +194,8 @@ typedef uint16_t gl_color_t;
 
 /**
  * \details Graphic Library color palette. Name of color corespond to the standard name which can be found at <a href="https://www.w3schools.com/colors/colors_hex.asp">lw3school</a>.
+ * Values are given in the native format selected by @ref GL_COLOR_DEPTH. RGB888 build
+ * requires a compiler whose enumeration constants are at least 32 bits wide.
  */
 enum gl_palette
 {
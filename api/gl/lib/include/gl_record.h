@@ -0,0 +1,175 @@
+/****************************************************************************
+**
+** Copyright (C) 2023 MikroElektronika d.o.o.
+** Contact: https://www.mikroe.com/contact
+**
+** This file is part of the mikroSDK package
+**
+** Commercial License Usage
+**
+** Licensees holding valid commercial NECTO compilers AI licenses may use this
+** file in accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The MikroElektronika Company.
+** For licensing terms and conditions see
+** https://www.mikroe.com/legal/software-license-agreement.
+** For further information use the contact form at
+** https://www.mikroe.com/contact.
+**
+**
+** GNU Lesser General Public License Usage
+**
+** Alternatively, this file may be used for
+** non-commercial projects under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** The above copyright notice and this permission notice shall be
+** included in all copies or substantial portions of the Software.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+** OF MERCHANTABILITY, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED
+** TO THE WARRANTIES FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+** IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+** DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT
+** OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+** OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+**
+****************************************************************************/
+
+/**
+ * @file gl_record.h
+ * @brief Recording of the pixels sent to display driver, so they can be sent again without drawing.
+ *
+ * @details While recording, everything drawn is sent to the driver as usual and also stored as a
+ * stream of driver calls: filled rectangles and frames of pixel data, with runs of equal pixels stored
+ * once. Playing the record repeats the same calls, which is much faster than drawing shapes, text and
+ * images again. Record is kept in RAM or, through read and write functions, in any other storage
+ * such as external flash or a file.
+ */
+#ifndef _GL_RECORD_H_
+#define _GL_RECORD_H_
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+#include "gl_types.h"
+
+/** @addtogroup apigroup API
+ *  @brief API
+ *  @{
+ */
+
+/**
+ * @addtogroup glgroup Graphic Library
+ * @brief Graphic Library
+ *  @{
+ */
+
+/**
+ * @brief Size of the buffer used for reading and writing records kept outside of RAM.
+ */
+#ifndef GL_RECORD_BUFFER_SIZE
+#define GL_RECORD_BUFFER_SIZE 32
+#endif
+
+/**
+ * @brief Function writing a part of the record to storage.
+ * @details Record is written in order, starting from offset 0, so storage which has to be erased
+ * before writing can be erased when offset 0 is written.
+ *
+ * @param[in] context Context given to @ref gl_record_init_storage.
+ * @param[in] offset Offset of the data in the record.
+ * @param[in] data Data to be written.
+ * @param[in] size Number of bytes to be written.
+ * @return true if data is written.
+ */
+typedef bool (*gl_record_write_t)(void *context, uint32_t offset, const uint8_t *data, uint16_t size);
+
+/**
+ * @brief Function reading a part of the record from storage.
+ *
+ * @param[in] context Context given to @ref gl_record_init_storage.
+ * @param[in] offset Offset of the data in the record.
+ * @param[out] data Buffer for the data.
+ * @param[in] size Number of bytes to be read.
+ * @return true if data is read.
+ */
+typedef bool (*gl_record_read_t)(void *context, uint32_t offset, uint8_t *data, uint16_t size);
+
+/**
+ * @brief Recorded driver calls and the storage they are kept in.
+ */
+typedef struct
+{
+    uint8_t *memory;            /**< Record kept in RAM, NULL if kept in storage. */
+    gl_record_write_t write_f;  /**< Writes record to storage. */
+    gl_record_read_t read_f;    /**< Reads record from storage. */
+    void *context;              /**< Context of storage functions. */
+    uint32_t capacity;          /**< Maximal size of the record in bytes. */
+
+    uint32_t size;              /**< Size of the recorded data in bytes. */
+    bool complete;              /**< Indicates that the record holds everything drawn while recording. */
+
+    uint8_t buffer[GL_RECORD_BUFFER_SIZE]; /**< Data waiting to be written to, or read from, storage. */
+    uint16_t buffered;                     /**< Number of bytes in buffer. */
+    gl_color_t run_color;                  /**< Color of the pixel run being recorded. */
+    uint16_t run_length;                   /**< Number of pixels in the run being recorded. */
+} gl_record_t;
+
+/**
+ * @brief Initializes record kept in RAM.
+ *
+ * @param[out] record Record to be initialized.
+ * @param[in] memory Memory the record is kept in.
+ * @param[in] capacity Size of the memory in bytes.
+ */
+void gl_record_init_memory(gl_record_t *record, uint8_t *memory, uint32_t capacity);
+
+/**
+ * @brief Initializes record kept in storage accessed by the given functions.
+ *
+ * @param[out] record Record to be initialized.
+ * @param[in] write_f Function writing the record to storage.
+ * @param[in] read_f Function reading the record from storage.
+ * @param[in] context Context passed to storage functions.
+ * @param[in] capacity Maximal size of the record in bytes.
+ */
+void gl_record_init_storage(gl_record_t *record, gl_record_write_t write_f, gl_record_read_t read_f,
+                            void *context, uint32_t capacity);
+
+/**
+ * @brief Starts recording everything drawn, replacing the previous content of the record.
+ * @details Only one record can be recorded at a time. Driver must not be changed while recording.
+ *
+ * @param[in,out] record Initialized record.
+ * @return false if driver is not set or other record is being recorded.
+ */
+bool gl_record_start(gl_record_t *record);
+
+/**
+ * @brief Stops recording.
+ *
+ * @return true if the record holds everything drawn while recording. It doesn't if the record ran out of
+ * capacity, storage couldn't be written or display area was copied.
+ */
+bool gl_record_stop();
+
+/**
+ * @brief Sends recorded driver calls to the driver.
+ *
+ * @param[in,out] record Completely recorded record.
+ * @return false if the record is not complete or couldn't be read, in which case part of it may be drawn.
+ */
+bool gl_record_play(gl_record_t *record);
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+/** @} */ // glgroup
+/** @} */ // apigroup
+
+#endif // _GL_RECORD_H_
+// ------------------------------------------------------------------------- END
@@ -46,6 +46,25 @@
 
 #include "gl_types.h"
 
+/**
+ * @brief Number of rounded rectangle corner tables kept between calls.
+ * @details Corner is described by spans of brush and pen for every row of the
+ * quarter circle and depends only on radius and pen width. Tables are looked up
+ * by these two values and least recently used one is replaced on miss.
+ * Set to 0 to compute corners on every call.
+ */
+#ifndef GL_CORNER_CACHE_SIZE
+#define GL_CORNER_CACHE_SIZE 4
+#endif
+
+/**
+ * @brief Largest corner (radius plus pen width) which is stored in cache.
+ * @details Bigger corners are computed on every call. Must not exceed 255.
+ */
+#ifndef GL_CORNER_CACHE_MAX_ROWS
+#define GL_CORNER_CACHE_MAX_ROWS 32
+#endif
+
 /** @addtogroup apigroup API
  *  @brief API
  *  @{
@@ -0,0 +1,159 @@
+/****************************************************************************
+**
+** Copyright (C) 2023 MikroElektronika d.o.o.
+** Contact: https://www.mikroe.com/contact
+**
+** This file is part of the mikroSDK package
+**
+** Commercial License Usage
+**
+** Licensees holding valid commercial NECTO compilers AI licenses may use this
+** file in accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The MikroElektronika Company.
+** For licensing terms and conditions see
+** https://www.mikroe.com/legal/software-license-agreement.
+** For further information use the contact form at
+** https://www.mikroe.com/contact.
+**
+**
+** GNU Lesser General Public License Usage
+**
+** Alternatively, this file may be used for
+** non-commercial projects under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** The above copyright notice and this permission notice shall be
+** included in all copies or substantial portions of the Software.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+** OF MERCHANTABILITY, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED
+** TO THE WARRANTIES FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+** IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+** DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT
+** OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+** OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+**
+****************************************************************************/
+
+/**
+ * @file gl_stats.h
+ * @brief Optional rendering statistics of Graphic Library. Enabled by defining GL_STATS_ENABLED when building library.
+ */
+#ifndef _GL_STATS_H_
+#define _GL_STATS_H_
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+#include "gl_types.h"
+
+/** @addtogroup apigroup API
+ *  @brief API
+ *  @{
+ */
+
+/**
+ * @addtogroup glgroup Graphic Library
+ * @brief Graphic Library
+ *  @{
+ */
+
+/**
+ * @brief Drawing functions which are profiled.
+ * @details Only outermost call is counted, e.g. points plotted by JPEG decoder
+ * are accounted to @ref GL_STATS_PRIMITIVE_JPEG.
+ */
+typedef enum
+{
+    GL_STATS_PRIMITIVE_CLEAR = 0,        /**< @ref gl_clear */
+    GL_STATS_PRIMITIVE_POINT,            /**< @ref gl_draw_point */
+    GL_STATS_PRIMITIVE_LINE,             /**< @ref gl_draw_line */
+    GL_STATS_PRIMITIVE_RECT,             /**< @ref gl_draw_rect */
+    GL_STATS_PRIMITIVE_RECT_ROUNDED,     /**< @ref gl_draw_rect_rounded */
+    GL_STATS_PRIMITIVE_CIRCLE,           /**< @ref gl_draw_circle */
+    GL_STATS_PRIMITIVE_ELLIPSE,          /**< @ref gl_draw_ellipse */
+    GL_STATS_PRIMITIVE_ARC,              /**< @ref gl_draw_arc */
+    GL_STATS_PRIMITIVE_CHAR,             /**< @ref gl_draw_char */
+    GL_STATS_PRIMITIVE_TEXT,             /**< @ref gl_draw_text */
+    GL_STATS_PRIMITIVE_IMAGE,            /**< @ref gl_draw_image */
+    GL_STATS_PRIMITIVE_JPEG,             /**< @ref gl_draw_jpeg_image */
+
+    GL_STATS_PRIMITIVE_COUNT
+} gl_stats_primitive_t;
+
+/**
+ * @brief Function returning free running counter, e.g. core cycle counter or system tick.
+ * @details Differences of two readings are accumulated, so counter may wrap around.
+ */
+typedef uint32_t (*gl_stats_timestamp_t)(void);
+
+/**
+ * @brief Counters of one drawing function.
+ */
+typedef struct
+{
+    uint32_t calls;     /**< Number of calls. */
+    uint32_t pixels;    /**< Number of pixels sent to driver. */
+    uint32_t time;      /**< Time spent, in units of timestamp function. */
+} gl_stats_counter_t;
+
+/**
+ * @brief Rendering statistics gathered since last @ref gl_stats_reset.
+ */
+typedef struct
+{
+    gl_stats_counter_t primitive[GL_STATS_PRIMITIVE_COUNT]; /**< Per drawing function counters. */
+
+    uint32_t fill_calls;            /**< Calls of driver's fill function. */
+    uint32_t fill_pixels;           /**< Pixels filled by driver's fill function. */
+    uint32_t begin_frame_calls;     /**< Calls of driver's begin frame function. */
+    uint32_t frame_data_calls;      /**< Calls of driver's frame data function, one per pixel. */
+    uint32_t frame_data_buffer_calls;   /**< Calls of driver's frame data buffer function. */
+    uint32_t frame_data_buffer_pixels;  /**< Pixels sent by driver's frame data buffer function. */
+    uint32_t end_frame_calls;       /**< Calls of driver's end frame function. */
+} gl_stats_t;
+
+#ifdef GL_STATS_ENABLED
+
+#include "log.h"
+
+/**
+ * @brief Sets function used for measuring time spent in drawing functions.
+ *
+ * @param[in] timestamp Timestamp function, NULL disables time measurement.
+ */
+void gl_stats_set_timestamp(gl_stats_timestamp_t timestamp);
+
+/**
+ * @brief Clears all counters.
+ */
+void gl_stats_reset();
+
+/**
+ * @brief Returns counters gathered since last @ref gl_stats_reset.
+ *
+ * @return Pointer to statistics of Graphic Library instance.
+ */
+const gl_stats_t *gl_stats_get();
+
+/**
+ * @brief Prints all counters as a table through logger library.
+ *
+ * @param[in] log Initialized logger.
+ */
+void gl_stats_dump(log_t *log);
+
+#endif // GL_STATS_ENABLED
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+/** @} */ // glgroup
+/** @} */ // apigroup
+
+#endif // _GL_STATS_H_
+// ------------------------------------------------------------------------- END
@@ -47,7 +47,9 @@
 #define _GL_TYPES_H_
 
 #include "gl_colors.h"
+#include "generic_pointer.h"
 #include <stdbool.h>
+#include <stddef.h>
 
 #ifdef __cplusplus
 extern "C"{
@@ -135,10 +137,20 @@ typedef struct
 } gl_rectangle_t;
 
 
+/**
+ * @brief Number of pixels the library collects, when drawing images, before
+ * sending them with driver's frame data buffer function.
+ */
+#ifndef GL_FRAME_DATA_BUFFER_SIZE
+#define GL_FRAME_DATA_BUFFER_SIZE 32
+#endif
+
 typedef void (*gl_fill_t)(gl_rectangle_t *rect, gl_color_t color);  /**< Function used for drawing on display. Should be defined in driver. */
 typedef void (*gl_begin_frame_t)(gl_rectangle_t *rect); /**< Function used for drawing on display. Should be defined in driver. */
 typedef void (*gl_frame_data_t)(gl_color_t color); /**< Function used for drawing on display. Should be defined in driver. */
+typedef void (*gl_frame_data_buffer_t)(const gl_color_t * __generic_ptr pixels, size_t count); /**< Function used for sending consecutive pixels of the frame at once. Optional, can be defined in driver. */
 typedef void (*gl_end_frame_t)(); /**< Function used for drawing on display. Should be defined in driver. */
+typedef void (*gl_copy_rect_t)(gl_rectangle_t *src, gl_coord_t x, gl_coord_t y); /**< Function used for moving already drawn area on display. Optional, can be defined in driver. */
 
 /**
  * @brief The context structure for storing driver configuration.
@@ -152,7 +164,9 @@ typedef struct
     gl_fill_t         fill_f;                       /**< Send color data to frame transfer and do the drawing. */
     gl_begin_frame_t  begin_frame_f;  /**< Begin frame transfer. */
     gl_frame_data_t   frame_data_f;   /**< Send color data to frame transfer. */
+    gl_frame_data_buffer_t frame_data_buffer_f; /**< Send buffer of color data to frame transfer, NULL if not supported. */
     gl_end_frame_t    end_frame_f;    /**< Finish frame transfer. */
+    gl_copy_rect_t    copy_rect_f;    /**< Copy area already on display to new position, NULL if not supported. */
 } gl_driver_t;
 
 #ifdef __cplusplus
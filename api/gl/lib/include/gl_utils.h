@@ -43,6 +43,7 @@
 #define _GL_UTILS_H
 
 #include "gl_types.h"
+#include "gl_stats.h"
 
 
 typedef struct
@@ -96,6 +97,37 @@ typedef struct
     gl_color_t to;      /**> Color used in ending point of the gradientally pinted area. */
 } gl_gradient_color;
 
+#ifdef GL_STATS_ENABLED
+typedef struct
+{
+    gl_stats_t counters;
+
+    gl_driver_t driver;                 //!<-- display driver, gl_t driver holds counting wrappers around it
+
+    gl_stats_timestamp_t timestamp_f;
+
+    gl_stats_primitive_t current;       //!<-- outermost drawing function in progress
+    uint8_t depth;                      //!<-- nesting of drawing functions, 0 when idle
+    uint32_t start;                     //!<-- timestamp of outermost drawing function start
+} gl_stats_context_t;
+
+void _gl_stats_hook_driver();
+void _gl_stats_begin(gl_stats_primitive_t primitive);
+void _gl_stats_end();
+
+#define GL_STATS_BEGIN(primitive) _gl_stats_begin(primitive)
+#define GL_STATS_END() _gl_stats_end()
+
+// Primitives are drawn by static functions, wrapped by public ones which count them.
+#define GL_STATS_PRIMITIVE static
+#else
+#define GL_STATS_BEGIN(primitive)
+#define GL_STATS_END()
+
+// Without statistics, functions drawing primitives are defined under their public names.
+#define GL_STATS_PRIMITIVE
+#endif
+
 typedef struct
 {
     gl_driver_t driver;
@@ -109,8 +141,19 @@ typedef struct
     gl_gradient_color gradient_color;
 
     gl_font_t font;
+
+#ifdef GL_STATS_ENABLED
+    gl_stats_context_t stats;
+#endif
 } gl_t;
 
+/**
+ * @brief Sends @p count consecutive pixels of the frame started with driver's
+ * begin frame function. Driver's frame data buffer function is used if it has
+ * one, otherwise pixels are sent one by one.
+ */
+void _gl_frame_data_buffer(const gl_color_t * __generic_ptr pixels, size_t count);
+
 
 typedef struct
 {
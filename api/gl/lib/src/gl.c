@@ -44,7 +44,7 @@
 gl_t instance =
 {
     // driver
-    {0, 0, 0, 0, 0, 0},
+    {0, 0, 0, 0, 0, 0, 0, 0},
 
     // crop_border
     0, 0, 0, 0,
@@ -66,12 +66,28 @@ void gl_set_driver(gl_driver_t *driver)
 {
     memcpy(&instance.driver, driver, sizeof(gl_driver_t));
 
+#ifdef GL_STATS_ENABLED
+    _gl_stats_hook_driver();
+#endif
+
     instance.crop_rect.top = 0;
     instance.crop_rect.left = 0;
     instance.crop_rect.right  = instance.driver.display_width;
     instance.crop_rect.bottom = instance.driver.display_height;
 }
 
+void _gl_frame_data_buffer(const gl_color_t * __generic_ptr pixels, size_t count)
+{
+    if (instance.driver.frame_data_buffer_f)
+    {
+        instance.driver.frame_data_buffer_f(pixels, count);
+        return;
+    }
+
+    while (count--)
+        instance.driver.frame_data_f(*pixels++);
+}
+
 void gl_clear(gl_color_t color)
 {
     gl_rectangle_t _rect;
@@ -84,7 +100,33 @@ void gl_clear(gl_color_t color)
     _rect.width  = instance.driver.display_width;
     _rect.height = instance.driver.display_height;
 
+    GL_STATS_BEGIN(GL_STATS_PRIMITIVE_CLEAR);
     instance.driver.fill_f(&_rect, color);
+    GL_STATS_END();
+}
+
+bool gl_copy_rect(gl_rectangle_t *src, gl_coord_t x, gl_coord_t y)
+{
+    if (!instance.driver.copy_rect_f)
+        return false;
+
+    if (src->top_left.x < 0 || src->top_left.y < 0 || x < 0 || y < 0)
+        return false;
+
+    if (src->top_left.x + src->width > instance.driver.display_width ||
+        x + src->width > instance.driver.display_width)
+        return false;
+
+    if (src->top_left.y + src->height > instance.driver.display_height ||
+        y + src->height > instance.driver.display_height)
+        return false;
+
+    if (!src->width || !src->height)
+        return true;
+
+    instance.driver.copy_rect_f(src, x, y);
+
+    return true;
 }
 
 bool gl_set_crop_borders(gl_coord_t left, gl_coord_t top, gl_coord_t bottom, gl_coord_t right)
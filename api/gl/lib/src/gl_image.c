@@ -51,11 +51,45 @@
 
 extern gl_t instance;
 
+#ifndef GL_STATS_ENABLED
+// Nothing is counted, so primitives are drawn by their public functions without wrappers.
+#define _draw_image      gl_draw_image
+#define _draw_jpeg_image gl_draw_jpeg_image
+#endif
+
+/**
+ * @brief Palettes and 16bpp pixel data of images generated by NECTO Studio
+ * are always stored as RGB565, regardless of @ref GL_COLOR_DEPTH.
+ */
+typedef uint16_t gl_image_color_t;
+
 typedef struct
 {
-    gl_color_t color[2];
+    gl_image_color_t color[2];
 } gl_1bpp_pallete_t;
 
+/**
+ * @brief Pixels of the frame collected to be sent to driver at once.
+ */
+static gl_color_t _line_buffer[GL_FRAME_DATA_BUFFER_SIZE];
+static size_t _line_length = 0;
+
+static void _line_flush()
+{
+    if (_line_length)
+        _gl_frame_data_buffer(_line_buffer, _line_length);
+
+    _line_length = 0;
+}
+
+static void _line_put(gl_color_t color)
+{
+    _line_buffer[_line_length++] = color;
+
+    if (_line_length == GL_FRAME_DATA_BUFFER_SIZE)
+        _line_flush();
+}
+
 uint16_t gl_image_width(const uint8_t * image)
 {
     const gl_image_header_t * header = (const gl_image_header_t *)image;
@@ -119,15 +153,43 @@ void gl_draw_bitmap_16bpp(gl_rectangle_t *dest, gl_rectangle_t *src, const uint8
     gl_int_t x_cnt;
     gl_int_t y_cnt;
 
+    uint32_t x_index;
+    uint32_t y_index;
+
     const uint16_t * pixel_data = (const uint16_t *)(image + sizeof(gl_image_header_t));
 
-    // Nearest-neighbor interpolation.
     instance.driver.begin_frame_f(dest);
+
+#if (GL_COLOR_DEPTH == GL_COLOR_DEPTH_16BPP)
+    // Without scaling, pixels are sent to driver straight from the image.
+    if (src->width == dest->width && src->height == dest->height)
+    {
+        if (src->top_left.x == 0 && dest->width == w)
+        {
+            _gl_frame_data_buffer(pixel_data + (uint32_t)src->top_left.y * w, (size_t)dest->width * dest->height);
+        }
+        else
+        {
+            for (y_cnt = 0; y_cnt < dest->height; y_cnt++)
+                _gl_frame_data_buffer(pixel_data + (uint32_t)(src->top_left.y + y_cnt) * w + src->top_left.x, dest->width);
+        }
+
+        instance.driver.end_frame_f();
+        return;
+    }
+#endif
+
+    // Nearest-neighbor interpolation.
     for (y_cnt = 0; y_cnt < dest->height; y_cnt++)
     {
+        y_index = (((y_cnt * src->height) / dest->height) + src->top_left.y);
         for (x_cnt = 0; x_cnt < dest->width; x_cnt++)
-            instance.driver.frame_data_f(pixel_data[((((y_cnt * src->height) / dest->height) + src->top_left.y) * w) + (((x_cnt * src->width) / dest->width) + src->top_left.x)]);
+        {
+            x_index = (((x_cnt * src->width) / dest->width) + src->top_left.x);
+            _line_put(GL_RGB565_TO_COLOR(pixel_data[(y_index * w) + x_index]));
+        }
     }
+    _line_flush();
     instance.driver.end_frame_f();
 }
 
@@ -150,8 +212,8 @@ void gl_draw_bitmap_4bpp(gl_rectangle_t *dest, gl_rectangle_t *src, const uint8_
     size_t pallete_index;
     size_t data_index;
 
-    const gl_color_t * pallete = (const uint8_t *)(image + sizeof(gl_image_header_t));
-    const uint8_t * pixel_data = (const uint8_t *)(image + sizeof(gl_image_header_t) + sizeof(gl_color_t) * 16);
+    const gl_image_color_t * pallete = (const gl_image_color_t *)(image + sizeof(gl_image_header_t));
+    const uint8_t * pixel_data = (const uint8_t *)(image + sizeof(gl_image_header_t) + sizeof(gl_image_color_t) * 16);
     // Nearest-neighbor interpolation.
     instance.driver.begin_frame_f(dest);
     for (y_cnt = 0; y_cnt < dest->height; y_cnt++)
@@ -173,10 +235,11 @@ void gl_draw_bitmap_4bpp(gl_rectangle_t *dest, gl_rectangle_t *src, const uint8_
             }
             pallete_index &= (size_t)0x0F;
 
-            color = pallete[pallete_index];
-            instance.driver.frame_data_f(color);
+            color = GL_RGB565_TO_COLOR(pallete[pallete_index]);
+            _line_put(color);
         }
     }
+    _line_flush();
     instance.driver.end_frame_f();
 }
 /**
@@ -194,8 +257,8 @@ void gl_draw_bitmap_8bpp(gl_rectangle_t *dest, gl_rectangle_t *src, const uint8_
     uint32_t x_index;
     uint32_t y_index;
 
-    const gl_color_t * pallete = (const uint8_t *)(image + sizeof(gl_image_header_t));
-    const uint8_t * pixel_data = (const uint8_t *)(image + sizeof(gl_image_header_t) + sizeof(gl_color_t) * 256);
+    const gl_image_color_t * pallete = (const gl_image_color_t *)(image + sizeof(gl_image_header_t));
+    const uint8_t * pixel_data = (const uint8_t *)(image + sizeof(gl_image_header_t) + sizeof(gl_image_color_t) * 256);
 
     // Nearest-neighbor interpolation.
     instance.driver.begin_frame_f(dest);
@@ -206,9 +269,10 @@ void gl_draw_bitmap_8bpp(gl_rectangle_t *dest, gl_rectangle_t *src, const uint8_
         {
             x_index = (((x_cnt * src->width) / dest->width) + src->top_left.x);
             pixel_index = (y_index * w) + x_index;
-            instance.driver.frame_data_f(pallete[pixel_data[pixel_index]]);
+            _line_put(GL_RGB565_TO_COLOR(pallete[pixel_data[pixel_index]]));
         }
     }
+    _line_flush();
     instance.driver.end_frame_f();
 }
 
@@ -229,6 +293,8 @@ void gl_draw_bitmap_1bpp(gl_rectangle_t *dest, gl_rectangle_t *src, const uint8_
 
     const gl_1bpp_pallete_t * pallete = (const gl_1bpp_pallete_t *)(image + sizeof(gl_image_header_t));
     const uint8_t * pixel_data = (const uint8_t *)(image + sizeof(gl_image_header_t) + sizeof(gl_1bpp_pallete_t));
+    const gl_color_t color_on = GL_RGB565_TO_COLOR(pallete->color[1]);
+    const gl_color_t color_off = GL_RGB565_TO_COLOR(pallete->color[0]);
 
     // Nearest-neighbor interpolation.
     instance.driver.begin_frame_f(dest);
@@ -240,16 +306,17 @@ void gl_draw_bitmap_1bpp(gl_rectangle_t *dest, gl_rectangle_t *src, const uint8_
             x_index = (((x_cnt * src->width) / dest->width) + src->top_left.x);
             pixel_index = (y_index * w) + x_index / 8;
             if (pixel_data[pixel_index] & (0x80 >> (x_index % 8)))
-               instance.driver.frame_data_f(pallete->color[1]);
+               _line_put(color_on);
             else
-               instance.driver.frame_data_f(pallete->color[0]);
+               _line_put(color_off);
         }
     }
+    _line_flush();
     instance.driver.end_frame_f();
 }
 
 // TODO: Change return value to enum which contains error message.
-int gl_draw_image(gl_rectangle_t *dest, gl_rectangle_t *src1, const uint8_t * image)
+GL_STATS_PRIMITIVE int _draw_image(gl_rectangle_t *dest, gl_rectangle_t *src1, const uint8_t * image)
 {
     gl_int_t cut_len_dest;
     gl_int_t cut_len_src;
@@ -330,6 +397,19 @@ int gl_draw_image(gl_rectangle_t *dest, gl_rectangle_t *src1, const uint8_t * im
     return GL_DRAW_IMAGE_SUCCESS;
 }
 
+#ifdef GL_STATS_ENABLED
+int gl_draw_image(gl_rectangle_t *dest, gl_rectangle_t *src1, const uint8_t * image)
+{
+    int result;
+
+    GL_STATS_BEGIN(GL_STATS_PRIMITIVE_IMAGE);
+    result = _draw_image(dest, src1, image);
+    GL_STATS_END();
+
+    return result;
+}
+#endif
+
 static const uint8_t * _jpeg_image_read_ptr;
 static jpeg_decoder_t _jpeg_decoder;
 static jpeg_color_space_pointers_t _jpeg_color_space_ptr;
@@ -1201,9 +1281,9 @@ static void _jpeg_sample_draw_point(uint16_t _x, uint16_t _y, uint16_t cb_cr_ind
     s3 = _jpeg_color_space_ptr.cr_ptr[cb_cr_index];
 
     temp = instance.pen.color;
-    instance.pen.color = ((_jpeg_to_char_range((s1 + (128 * s3 + 64 * s3 - 8 * s3 - 4 * s3)) >> 7) >> 3) << 11) |
-                          ((_jpeg_to_char_range((s1 - (32 * s2 + 8 * s2 + 4 * s2) - (64 * s3 + 32 * s3 - 4 * s3 - s3)) >> 7) >> 2) << 5) |
-                          ((_jpeg_to_char_range((s1 + (256 * s2 - 32 * s2 + 2 * s2 + s2)) >> 7) >> 3));
+    instance.pen.color = GL_RGB2COLOR(_jpeg_to_char_range((s1 + (128 * s3 + 64 * s3 - 8 * s3 - 4 * s3)) >> 7),
+                                      _jpeg_to_char_range((s1 - (32 * s2 + 8 * s2 + 4 * s2) - (64 * s3 + 32 * s3 - 4 * s3 - s3)) >> 7),
+                                      _jpeg_to_char_range((s1 + (256 * s2 - 32 * s2 + 2 * s2 + s2)) >> 7));
 
     gl_draw_point(_x, _y);
     instance.pen.color = temp;
@@ -1219,12 +1299,12 @@ static void _jpeg_set_color(uint16_t width, int32_t s1, int32_t s2, int32_t s3,
     color.g = _jpeg_to_char_range((s1 - 44 * s2 - 91 * s3) >> 7);
     color.b = _jpeg_to_char_range((s1 + 227 * s2) >> 7);
 
-    gl_color = ((color.r >> 3) << 11) | ((color.g >> 2) << 5) | (color.b >> 3);
+    gl_color = GL_RGB2COLOR(color.r, color.g, color.b);
 
     for (i = 0; i < drawing_count; i++)
     {
         if (width < instance.driver.display_width)
-            instance.driver.frame_data_f(gl_color);
+            _line_put(gl_color);
         else
             return;
     }
@@ -1359,6 +1439,7 @@ static void _jpeg_sample_1x1()
                             {
                                 rect.top_left.x = _jpeg_decoder.drawing.dest->top_left.x + _jpeg_calculate_dest_x_offset(src_offset_x + _x);
                                 rect.top_left.y = display_offset_y;
+                                _line_flush();
                                 instance.driver.begin_frame_f(&rect);
                                 first_x_drawing = false;
                             }
@@ -1513,6 +1594,7 @@ static void _jpeg_sample_2x2()
                                 {
                                     rect.top_left.x = _jpeg_decoder.drawing.dest->top_left.x + _jpeg_calculate_dest_x_offset(src_offset_x + _x);
                                     rect.top_left.y = display_offset_y;
+                                    _line_flush();
                                     instance.driver.begin_frame_f(&rect);
                                     first_x_drawing = true;
                                 }
@@ -1675,11 +1757,12 @@ static void _jpeg_draw_blocks()
             break;
     }
 
+    _line_flush();
     instance.driver.end_frame_f();
 }
 
 
-int gl_draw_jpeg_image(gl_rectangle_t *dest, gl_rectangle_t *src, const uint8_t * image)
+GL_STATS_PRIMITIVE int _draw_jpeg_image(gl_rectangle_t *dest, gl_rectangle_t *src, const uint8_t * image)
 {
     _jpeg_decoder.error = GL_DRAW_IMAGE_SUCCESS;
 
@@ -1701,3 +1784,16 @@ int gl_draw_jpeg_image(gl_rectangle_t *dest, gl_rectangle_t *src, const uint8_t
 
     return _jpeg_decoder.error;
 }
+
+#ifdef GL_STATS_ENABLED
+int gl_draw_jpeg_image(gl_rectangle_t *dest, gl_rectangle_t *src, const uint8_t * image)
+{
+    int result;
+
+    GL_STATS_BEGIN(GL_STATS_PRIMITIVE_JPEG);
+    result = _draw_jpeg_image(dest, src, image);
+    GL_STATS_END();
+
+    return result;
+}
+#endif
@@ -0,0 +1,375 @@
+/****************************************************************************
+**
+** Copyright (C) 2023 MikroElektronika d.o.o.
+** Contact: https://www.mikroe.com/contact
+**
+** This file is part of the mikroSDK package
+**
+** Commercial License Usage
+**
+** Licensees holding valid commercial NECTO compilers AI licenses may use this
+** file in accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The MikroElektronika Company.
+** For licensing terms and conditions see
+** https://www.mikroe.com/legal/software-license-agreement.
+** For further information use the contact form at
+** https://www.mikroe.com/contact.
+**
+**
+** GNU Lesser General Public License Usage
+**
+** Alternatively, this file may be used for
+** non-commercial projects under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** The above copyright notice and this permission notice shall be
+** included in all copies or substantial portions of the Software.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+** OF MERCHANTABILITY, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED
+** TO THE WARRANTIES FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+** IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+** DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT
+** OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+** OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+**
+****************************************************************************/
+
+#include "gl_record.h"
+#include "gl_utils.h"
+#include <string.h>
+
+#define GL_RECORD_FILL        1
+#define GL_RECORD_BEGIN_FRAME 2
+#define GL_RECORD_PIXELS      3
+#define GL_RECORD_END_FRAME   4
+
+extern gl_t instance;
+
+static gl_record_t *recording = NULL;
+static gl_driver_t recorded_driver;
+
+/**
+ * @brief Pixels of equal color sent to driver at once, when playing a record.
+ */
+static gl_color_t play_pixels[GL_FRAME_DATA_BUFFER_SIZE];
+
+static void _record_flush(gl_record_t *record)
+{
+    if (record->buffered && record->complete)
+        if (!record->write_f(record->context, record->size - record->buffered, record->buffer, record->buffered))
+            record->complete = false;
+
+    record->buffered = 0;
+}
+
+static void _record_write(gl_record_t *record, const void *data, uint16_t size)
+{
+    const uint8_t *bytes = (const uint8_t *)data;
+    uint16_t part;
+
+    if (!record->complete)
+        return;
+
+    if (record->size + size > record->capacity)
+    {
+        record->complete = false;
+        return;
+    }
+
+    if (record->memory)
+    {
+        memcpy(record->memory + record->size, bytes, size);
+        record->size += size;
+        return;
+    }
+
+    while (size)
+    {
+        part = GL_RECORD_BUFFER_SIZE - record->buffered;
+        if (part > size)
+            part = size;
+
+        memcpy(record->buffer + record->buffered, bytes, part);
+        record->buffered += part;
+        record->size += part;
+        bytes += part;
+        size -= part;
+
+        if (record->buffered == GL_RECORD_BUFFER_SIZE)
+            _record_flush(record);
+    }
+}
+
+static void _record_rect(gl_record_t *record, uint8_t command, gl_rectangle_t *rect)
+{
+    _record_write(record, &command, 1);
+    _record_write(record, &rect->top_left.x, sizeof(gl_int_t));
+    _record_write(record, &rect->top_left.y, sizeof(gl_int_t));
+    _record_write(record, &rect->width, sizeof(uint16_t));
+    _record_write(record, &rect->height, sizeof(uint16_t));
+}
+
+static void _record_pixels(gl_record_t *record)
+{
+    uint8_t command = GL_RECORD_PIXELS;
+
+    if (!record->run_length)
+        return;
+
+    _record_write(record, &command, 1);
+    _record_write(record, &record->run_length, sizeof(uint16_t));
+    _record_write(record, &record->run_color, sizeof(gl_color_t));
+    record->run_length = 0;
+}
+
+static void _record_fill(gl_rectangle_t *rect, gl_color_t color)
+{
+    _record_rect(recording, GL_RECORD_FILL, rect);
+    _record_write(recording, &color, sizeof(gl_color_t));
+
+    recorded_driver.fill_f(rect, color);
+}
+
+static void _record_begin_frame(gl_rectangle_t *rect)
+{
+    recording->run_length = 0;
+    _record_rect(recording, GL_RECORD_BEGIN_FRAME, rect);
+
+    recorded_driver.begin_frame_f(rect);
+}
+
+static void _record_color(gl_record_t *record, gl_color_t color)
+{
+    // equal neighbouring pixels are stored once, with their count
+    if (record->run_length && (record->run_color != color || record->run_length == 0xFFFF))
+        _record_pixels(record);
+
+    record->run_color = color;
+    record->run_length++;
+}
+
+static void _record_frame_data(gl_color_t color)
+{
+    _record_color(recording, color);
+
+    recorded_driver.frame_data_f(color);
+}
+
+static void _record_frame_data_buffer(const gl_color_t * __generic_ptr pixels, size_t count)
+{
+    size_t i;
+
+    for (i = 0; i < count; i++)
+        _record_color(recording, pixels[i]);
+
+    recorded_driver.frame_data_buffer_f(pixels, count);
+}
+
+static void _record_end_frame()
+{
+    uint8_t command = GL_RECORD_END_FRAME;
+
+    _record_pixels(recording);
+    _record_write(recording, &command, 1);
+
+    recorded_driver.end_frame_f();
+}
+
+static void _record_copy_rect(gl_rectangle_t *src, gl_coord_t x, gl_coord_t y)
+{
+    // result depends on what was on display before recording, so it can't be played
+    recording->complete = false;
+
+    recorded_driver.copy_rect_f(src, x, y);
+}
+
+static bool _play_read(gl_record_t *record, uint32_t *offset, void *data, uint16_t size)
+{
+    uint8_t *bytes = (uint8_t *)data;
+    uint16_t part;
+
+    if (*offset + size > record->size)
+        return false;
+
+    if (record->memory)
+    {
+        memcpy(bytes, record->memory + *offset, size);
+        *offset += size;
+        return true;
+    }
+
+    // the last buffered bytes of buffer are the data at offset
+    while (size)
+    {
+        if (!record->buffered)
+        {
+            part = GL_RECORD_BUFFER_SIZE;
+            if (part > record->size - *offset)
+                part = record->size - *offset;
+
+            if (!record->read_f(record->context, *offset, record->buffer + GL_RECORD_BUFFER_SIZE - part, part))
+                return false;
+
+            record->buffered = part;
+        }
+
+        part = record->buffered;
+        if (part > size)
+            part = size;
+
+        memcpy(bytes, record->buffer + GL_RECORD_BUFFER_SIZE - record->buffered, part);
+        record->buffered -= part;
+        *offset += part;
+        bytes += part;
+        size -= part;
+    }
+
+    return true;
+}
+
+static void _play_pixels(gl_color_t color, uint16_t count)
+{
+    uint16_t part;
+
+    if (!instance.driver.frame_data_buffer_f)
+    {
+        while (count--)
+            instance.driver.frame_data_f(color);
+        return;
+    }
+
+    part = count < GL_FRAME_DATA_BUFFER_SIZE ? count : GL_FRAME_DATA_BUFFER_SIZE;
+    while (part)
+        play_pixels[--part] = color;
+
+    while (count)
+    {
+        part = count < GL_FRAME_DATA_BUFFER_SIZE ? count : GL_FRAME_DATA_BUFFER_SIZE;
+        instance.driver.frame_data_buffer_f(play_pixels, part);
+        count -= part;
+    }
+}
+
+static bool _play_rect(gl_record_t *record, uint32_t *offset, gl_rectangle_t *rect)
+{
+    return _play_read(record, offset, &rect->top_left.x, sizeof(gl_int_t)) &&
+           _play_read(record, offset, &rect->top_left.y, sizeof(gl_int_t)) &&
+           _play_read(record, offset, &rect->width, sizeof(uint16_t)) &&
+           _play_read(record, offset, &rect->height, sizeof(uint16_t));
+}
+
+void gl_record_init_memory(gl_record_t *record, uint8_t *memory, uint32_t capacity)
+{
+    memset(record, 0, sizeof(gl_record_t));
+    record->memory = memory;
+    record->capacity = capacity;
+}
+
+void gl_record_init_storage(gl_record_t *record, gl_record_write_t write_f, gl_record_read_t read_f,
+                            void *context, uint32_t capacity)
+{
+    memset(record, 0, sizeof(gl_record_t));
+    record->write_f = write_f;
+    record->read_f = read_f;
+    record->context = context;
+    record->capacity = capacity;
+}
+
+bool gl_record_start(gl_record_t *record)
+{
+    if (recording || !instance.driver.fill_f || !instance.driver.begin_frame_f ||
+        !instance.driver.frame_data_f || !instance.driver.end_frame_f)
+        return false;
+
+    record->size = 0;
+    record->buffered = 0;
+    record->run_length = 0;
+    record->complete = true;
+    recording = record;
+
+    memcpy(&recorded_driver, &instance.driver, sizeof(gl_driver_t));
+    instance.driver.fill_f = _record_fill;
+    instance.driver.begin_frame_f = _record_begin_frame;
+    instance.driver.frame_data_f = _record_frame_data;
+    if (instance.driver.frame_data_buffer_f)
+        instance.driver.frame_data_buffer_f = _record_frame_data_buffer;
+    instance.driver.end_frame_f = _record_end_frame;
+    if (instance.driver.copy_rect_f)
+        instance.driver.copy_rect_f = _record_copy_rect;
+
+    return true;
+}
+
+bool gl_record_stop()
+{
+    gl_record_t *record = recording;
+
+    if (!record)
+        return false;
+
+    memcpy(&instance.driver, &recorded_driver, sizeof(gl_driver_t));
+    recording = NULL;
+
+    // frame left open is not complete
+    if (record->run_length)
+        record->complete = false;
+
+    if (!record->memory)
+        _record_flush(record);
+
+    return record->complete;
+}
+
+bool gl_record_play(gl_record_t *record)
+{
+    gl_rectangle_t rect;
+    gl_color_t color;
+    uint32_t offset = 0;
+    uint16_t count;
+    uint8_t command;
+
+    if (!record->complete || record == recording || !instance.driver.fill_f)
+        return false;
+
+    record->buffered = 0;
+
+    while (offset < record->size)
+    {
+        if (!_play_read(record, &offset, &command, 1))
+            return false;
+
+        switch (command)
+        {
+            case GL_RECORD_FILL:
+                if (!_play_rect(record, &offset, &rect) || !_play_read(record, &offset, &color, sizeof(gl_color_t)))
+                    return false;
+                instance.driver.fill_f(&rect, color);
+                break;
+
+            case GL_RECORD_BEGIN_FRAME:
+                if (!_play_rect(record, &offset, &rect))
+                    return false;
+                instance.driver.begin_frame_f(&rect);
+                break;
+
+            case GL_RECORD_PIXELS:
+                if (!_play_read(record, &offset, &count, sizeof(uint16_t)) ||
+                    !_play_read(record, &offset, &color, sizeof(gl_color_t)))
+                    return false;
+                _play_pixels(color, count);
+                break;
+
+            case GL_RECORD_END_FRAME:
+                instance.driver.end_frame_f();
+                break;
+
+            default:
+                return false;
+        }
+    }
+
+    return true;
+}
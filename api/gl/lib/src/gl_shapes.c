@@ -47,6 +47,17 @@
 
 extern gl_t instance;
 
+#ifndef GL_STATS_ENABLED
+// Nothing is counted, so primitives are drawn by their public functions without wrappers.
+#define _draw_rect         gl_draw_rect
+#define _draw_point        gl_draw_point
+#define _draw_line         gl_draw_line
+#define _draw_circle       gl_draw_circle
+#define _draw_ellipse      gl_draw_ellipse
+#define _draw_arc          gl_draw_arc
+#define _draw_rect_rounded gl_draw_rect_rounded
+#endif
+
 #ifdef __GNUC__
 static inline int32_t max(int32_t a, int32_t b) { return((a) > (b) ? a : b); }
 static inline int32_t min(int32_t a, int32_t b) { return((a) < (b) ? a : b); }
@@ -1684,7 +1695,7 @@ static void _draw_slice(gl_arc_t* arc, gl_rectangle_t* border_rect)
 
 }
 
-void gl_draw_rect(gl_coord_t top_left_x, gl_coord_t top_left_y, gl_uint_t width, gl_uint_t height)
+GL_STATS_PRIMITIVE void _draw_rect(gl_coord_t top_left_x, gl_coord_t top_left_y, gl_uint_t width, gl_uint_t height)
 {
     gl_rectangle_t tmp_rect;
     bool no_crop;
@@ -1792,7 +1803,16 @@ void gl_draw_rect(gl_coord_t top_left_x, gl_coord_t top_left_y, gl_uint_t width,
     }
 }
 
-void gl_draw_point(gl_coord_t x, gl_coord_t y)
+#ifdef GL_STATS_ENABLED
+void gl_draw_rect(gl_coord_t top_left_x, gl_coord_t top_left_y, gl_uint_t width, gl_uint_t height)
+{
+    GL_STATS_BEGIN(GL_STATS_PRIMITIVE_RECT);
+    _draw_rect(top_left_x, top_left_y, width, height);
+    GL_STATS_END();
+}
+#endif
+
+GL_STATS_PRIMITIVE void _draw_point(gl_coord_t x, gl_coord_t y)
 {
     gl_rectangle_t _rect;
     gl_uint_t pen = instance.pen.inner_width + instance.pen.outer_width;
@@ -1809,6 +1829,15 @@ void gl_draw_point(gl_coord_t x, gl_coord_t y)
     _rect_fill_crop(&_rect, instance.pen.color);
 }
 
+#ifdef GL_STATS_ENABLED
+void gl_draw_point(gl_coord_t x, gl_coord_t y)
+{
+    GL_STATS_BEGIN(GL_STATS_PRIMITIVE_POINT);
+    _draw_point(x, y);
+    GL_STATS_END();
+}
+#endif
+
 /*************************************************************************
  * Draw a line between T1(x0,y0) and T2(x1, y1) with outer frame width
  * outter_offset based on pen_width.
@@ -1844,7 +1873,7 @@ void gl_draw_point(gl_coord_t x, gl_coord_t y)
  * 8.) If pen width is lower then 3 then draw only line
  * 9.) Otherwise draw line using two triangle ABC and ADC!
  *************************************************************************/
-void gl_draw_line(gl_coord_t x1, gl_coord_t y1, gl_coord_t x2, gl_coord_t y2)
+GL_STATS_PRIMITIVE void _draw_line(gl_coord_t x1, gl_coord_t y1, gl_coord_t x2, gl_coord_t y2)
 {
     gl_rectangle_t rect;
     gl_int_t outter_offset = instance.pen.outer_width;
@@ -1987,6 +2016,15 @@ void gl_draw_line(gl_coord_t x1, gl_coord_t y1, gl_coord_t x2, gl_coord_t y2)
     }
 }
 
+#ifdef GL_STATS_ENABLED
+void gl_draw_line(gl_coord_t x1, gl_coord_t y1, gl_coord_t x2, gl_coord_t y2)
+{
+    GL_STATS_BEGIN(GL_STATS_PRIMITIVE_LINE);
+    _draw_line(x1, y1, x2, y2);
+    GL_STATS_END();
+}
+#endif
+
 gl_int_t _find_circle_line_width(gl_int_t x, gl_int_t y, gl_int_t r_in, gl_int_t r_out)
 {
     gl_int_t w = 0;
@@ -2006,7 +2044,7 @@ gl_int_t _find_circle_line_width(gl_int_t x, gl_int_t y, gl_int_t r_in, gl_int_t
     return w;
 }
 
-void gl_draw_circle(gl_coord_t x0, gl_coord_t y0, gl_uint_t radius)
+GL_STATS_PRIMITIVE void _draw_circle(gl_coord_t x0, gl_coord_t y0, gl_uint_t radius)
 {
     gl_int_t inner_offset = instance.pen.inner_width;
     gl_int_t outer_offset = instance.pen.outer_width;
@@ -2122,9 +2160,17 @@ void gl_draw_circle(gl_coord_t x0, gl_coord_t y0, gl_uint_t radius)
 //     }
 }
 
-#pragma funcall gl_draw_ellipse
-void gl_draw_ellipse(gl_coord_t x0, gl_coord_t y0, gl_uint_t half_a,
-                     gl_uint_t half_b) {
+#ifdef GL_STATS_ENABLED
+void gl_draw_circle(gl_coord_t x0, gl_coord_t y0, gl_uint_t radius)
+{
+    GL_STATS_BEGIN(GL_STATS_PRIMITIVE_CIRCLE);
+    _draw_circle(x0, y0, radius);
+    GL_STATS_END();
+}
+#endif
+
+GL_STATS_PRIMITIVE void _draw_ellipse(gl_coord_t x0, gl_coord_t y0, gl_uint_t half_a,
+                          gl_uint_t half_b) {
     if (NULL == instance.driver.fill_f) {
         return;
     }
@@ -2450,7 +2496,18 @@ void gl_draw_ellipse(gl_coord_t x0, gl_coord_t y0, gl_uint_t half_a,
     }
 }
 
-void gl_draw_arc(gl_coord_t x, gl_coord_t y, gl_uint_t radius, gl_angle_t start_angle, gl_angle_t end_angle)
+#pragma funcall gl_draw_ellipse
+#ifdef GL_STATS_ENABLED
+void gl_draw_ellipse(gl_coord_t x0, gl_coord_t y0, gl_uint_t half_a,
+                     gl_uint_t half_b)
+{
+    GL_STATS_BEGIN(GL_STATS_PRIMITIVE_ELLIPSE);
+    _draw_ellipse(x0, y0, half_a, half_b);
+    GL_STATS_END();
+}
+#endif
+
+GL_STATS_PRIMITIVE void _draw_arc(gl_coord_t x, gl_coord_t y, gl_uint_t radius, gl_angle_t start_angle, gl_angle_t end_angle)
 {
     gl_arc_t arc_tmp;
     gl_rectangle_t border_rect;
@@ -2640,144 +2697,268 @@ void gl_draw_arc(gl_coord_t x, gl_coord_t y, gl_uint_t radius, gl_angle_t start_
         _draw_slice_crop(&arc_tmp, &border_rect);
 }
 
-#pragma funcall  _draw_rects_quarters _draw_one_color_line, _draw_horizontal_gradient_line, _draw_vertical_gradient_line
-static void _draw_rects_quarters(gl_point_t t1, gl_point_t t2, gl_int_t radius, gl_rectangle_t* gradient_border)
+#ifdef GL_STATS_ENABLED
+void gl_draw_arc(gl_coord_t x, gl_coord_t y, gl_uint_t radius, gl_angle_t start_angle, gl_angle_t end_angle)
 {
-    void (*fill_f_brush)(gl_rectangle_t*, gl_rectangle_t*);
-    gl_rectangle_t rect;
-    gl_rectangle_t rect_ring;
-
-    gl_int_t radius1;
-    gl_int_t radius2;
+    GL_STATS_BEGIN(GL_STATS_PRIMITIVE_ARC);
+    _draw_arc(x, y, radius, start_angle, end_angle);
+    GL_STATS_END();
+}
+#endif
 
+/**
+ * @brief State of row by row rounded corner computation.
+ * @details Widths are relative to corner center, so the same sequence of
+ * rows describes all four quarters of any rectangle with equal radius and pen.
+ */
+typedef struct
+{
+    gl_int_t radius_in;         //!<-- radius of brush part
+    gl_int_t radius_out;        //!<-- radius including pen
+    gl_int_t row;               //!<-- distance of current row from center
+    gl_int_t x_out;             //!<-- outer edge of current row
+    gl_int_t x_in;              //!<-- inner edge of pen on current row
+    gl_int_t brush_width;
+    gl_int_t ring_width;
     bool no_pen;
-    bool has_brush;
     bool no_more_brush;
+} gl_corner_iterator_t;
+
+/**
+ * @brief Spans of one corner row, pen is placed right after the brush.
+ */
+typedef struct
+{
+    uint8_t brush_width;
+    uint8_t pen_width;
+} gl_corner_span_t;
 
-    gl_int_t x_right_up;
-    gl_int_t x_ring;
+#if GL_CORNER_CACHE_SIZE > 0
+typedef struct
+{
+    gl_int_t radius;
+    gl_uint_t pen;
+    uint16_t last_use;          //!<-- 0 marks empty entry
+    gl_corner_span_t spans[GL_CORNER_CACHE_MAX_ROWS];
+} gl_corner_cache_entry_t;
+
+static gl_corner_cache_entry_t corner_cache[GL_CORNER_CACHE_SIZE];
+static uint16_t corner_cache_clock;
+#endif
 
-    gl_int_t y_temp = 0;
-    gl_int_t y_max;
-    gl_int_t y_inner_max;
+static void _corner_iterator_init(gl_corner_iterator_t* it, gl_int_t radius, gl_uint_t pen)
+{
+    it->radius_in = radius;
+    it->radius_out = radius + pen;
+    it->row = 0;
+    it->x_out = it->radius_out;
+    it->x_in = radius;
+    it->brush_width = radius;
+    it->ring_width = pen;
+    it->no_pen = it->radius_out == it->radius_in;
+    it->no_more_brush = radius <= 0;
+}
 
+/**
+ * @brief Outputs spans of current row and advances to the next one.
+ * @return False when whole corner is done.
+ */
+static bool _corner_iterator_next(gl_corner_iterator_t* it, gl_int_t* brush_width, gl_int_t* pen_width)
+{
     gl_int_t circle_equation_part; //<-- r^2-(y-y0)^2
-    gl_uint_t pen = instance.pen.inner_width + instance.pen.outer_width;
 
-    radius2 = radius;
-    radius1 = radius2 + pen;
+    if (it->row >= it->radius_out)
+        return false;
 
-    // set function for brush color style
-    if (instance.brush.style == GL_BRUSH_STYLE_FILL)
-        fill_f_brush = &_draw_one_color_line;
-    else if (instance.brush.style == GL_BRUSH_STYLE_GRADIENT_LEFT_RIGHT)
-        fill_f_brush = &_draw_horizontal_gradient_line;
-    else if (instance.brush.style == GL_BRUSH_STYLE_GRADIENT_TOP_DOWN)
-        fill_f_brush = &_draw_vertical_gradient_line;
+    if (it->no_pen)
+    {
+        *brush_width = it->brush_width;
+        *pen_width = 0;
+    }
+    else if (it->no_more_brush)
+    {
+        *brush_width = 0;
+        *pen_width = it->brush_width;
+    }
+    else
+    {
+        *brush_width = it->brush_width;
+        *pen_width = it->ring_width;
+    }
 
-    rect.height = 1;
-    rect.top_left.y = t2.y;
-    rect.top_left.x = t2.x;
-    rect.width = radius2;
-    x_right_up = t2.x + radius1;
+    ++it->row;
 
-    rect_ring.height = 1;
-    rect_ring.top_left.y = t2.y;
-    rect_ring.top_left.x = t2.x + radius2;
-    rect_ring.width = radius1 - radius2;
-    x_ring = t2.x + radius2;
-
-    y_max = t2.y + radius1;
-    y_inner_max = t2.y + radius2;
-    no_more_brush = radius2 <= 0;
-    no_pen = radius1 == radius2;
-    has_brush = instance.brush.style != GL_BRUSH_STYLE_NONE;
-    if (!has_brush && no_pen)
-        return;
+    // find new x
+    circle_equation_part = it->radius_out*it->radius_out - it->row*it->row;
+    while (it->x_out*it->x_out > circle_equation_part)
+        it->x_out -= 1;
 
-    while (rect.top_left.y < y_max)
+    // here check the ring values
+    if (!it->no_more_brush)
     {
-        if (no_pen)
-        {
-            rect.top_left.x = t2.x;
-            (*fill_f_brush)(&rect, gradient_border);
+        circle_equation_part = it->radius_in*it->radius_in - it->row*it->row;
+        while ((it->x_in*it->x_in > circle_equation_part) && (circle_equation_part >= 0))
+            it->x_in -= 1;
 
-            rect.top_left.y = t1.y - y_temp;
-            (*fill_f_brush)(&rect, gradient_border);
+        it->brush_width = it->x_in;
+        it->ring_width = it->x_out - it->x_in;
 
-            rect.top_left.x = t1.x - rect.width;
-            (*fill_f_brush)(&rect, gradient_border);
-
-            rect.top_left.y = t2.y + y_temp;
-            (*fill_f_brush)(&rect, gradient_border);
-        }
-        else if (no_more_brush)
+        if (it->radius_in < it->row)
         {
-            rect.top_left.x = t2.x;
-            instance.driver.fill_f(&rect, instance.pen.color);
+            it->no_more_brush = true;
+            it->brush_width = it->x_out;
+        }
+    }
+    else
+        it->brush_width = it->x_out;
 
-            rect.top_left.y = t1.y - y_temp;
-            instance.driver.fill_f(&rect, instance.pen.color);
+    return true;
+}
 
-            rect.top_left.x = t1.x - rect.width;
-            instance.driver.fill_f(&rect, instance.pen.color);
+#if GL_CORNER_CACHE_SIZE > 0
+/**
+ * @brief Returns span table for corner, computing it on cache miss.
+ * @return NULL if corner is too big to be cached.
+ */
+static const gl_corner_span_t* _corner_cache_get(gl_int_t radius, gl_uint_t pen)
+{
+    gl_corner_cache_entry_t* entry;
+    gl_corner_cache_entry_t* victim = &corner_cache[0];
+    gl_corner_iterator_t it;
+    gl_int_t brush_width;
+    gl_int_t pen_width;
+    uint8_t i;
 
-            rect.top_left.y = t2.y + y_temp;
-            instance.driver.fill_f(&rect, instance.pen.color);
-        }
-        else
+    if (radius < 0 || radius + pen > GL_CORNER_CACHE_MAX_ROWS)
+        return NULL;
+
+    if (!++corner_cache_clock)
+    {
+        // clock wrapped, start aging from scratch
+        for (i = 0; i < GL_CORNER_CACHE_SIZE; i++)
+            if (corner_cache[i].last_use)
+                corner_cache[i].last_use = 1;
+        corner_cache_clock = 2;
+    }
+
+    for (i = 0; i < GL_CORNER_CACHE_SIZE; i++)
+    {
+        entry = &corner_cache[i];
+        if (entry->last_use && entry->radius == radius && entry->pen == pen)
         {
-            rect.top_left.x = t2.x;
-            rect_ring.top_left.x = x_ring;
-            if (has_brush)
-                (*fill_f_brush)(&rect, gradient_border);
-            instance.driver.fill_f(&rect_ring, instance.pen.color);
-
-            rect_ring.top_left.y = rect.top_left.y = t1.y - y_temp;
-            if (has_brush)
-                (*fill_f_brush)(&rect, gradient_border);
-            instance.driver.fill_f(&rect_ring, instance.pen.color);
-
-            rect.top_left.x = t1.x - rect.width;
-            rect_ring.top_left.x = t1.x - rect_ring.width - rect.width;
-            if (has_brush)
-                (*fill_f_brush)(&rect, gradient_border);
-            instance.driver.fill_f(&rect_ring, instance.pen.color);
-
-            rect_ring.top_left.y = rect.top_left.y = t2.y + y_temp;
-            if (has_brush)
-                (*fill_f_brush)(&rect, gradient_border);
-            instance.driver.fill_f(&rect_ring, instance.pen.color);
+            entry->last_use = corner_cache_clock;
+            return entry->spans;
         }
 
-        ++y_temp;
-        ++rect.top_left.y;
+        if (entry->last_use < victim->last_use)
+            victim = entry;
+    }
+
+    _corner_iterator_init(&it, radius, pen);
+    i = 0;
+    while (_corner_iterator_next(&it, &brush_width, &pen_width))
+    {
+        victim->spans[i].brush_width = brush_width;
+        victim->spans[i].pen_width = pen_width;
+        i++;
+    }
 
-        // find new x
-        circle_equation_part = radius1*radius1 - (rect.top_left.y - t2.y)*(rect.top_left.y - t2.y);
-        while ((x_right_up - t2.x)*(x_right_up-t2.x) > circle_equation_part)
-            x_right_up -= 1;
+    victim->radius = radius;
+    victim->pen = pen;
+    victim->last_use = corner_cache_clock;
 
-        // here check the ring values
-        if (!no_more_brush)
-        {
-            rect_ring.top_left.y = rect.top_left.y;
-            circle_equation_part = radius2*radius2 - (rect_ring.top_left.y - t2.y)*(rect_ring.top_left.y - t2.y);
-            while (((x_ring - t2.x)*(x_ring - t2.x) > circle_equation_part) && (circle_equation_part >= 0))
-                x_ring -= 1;
+    return victim->spans;
+}
+#endif
 
-            rect.width = x_ring - t2.x;
-            rect_ring.width = x_right_up - x_ring;
+/**
+ * @brief Draws one row of all four quarters.
+ */
+#pragma funcall  _draw_corner_row _draw_one_color_line, _draw_horizontal_gradient_line, _draw_vertical_gradient_line
+static void _draw_corner_row(gl_point_t t1, gl_point_t t2, gl_int_t row,
+                             gl_int_t brush_width, gl_int_t pen_width,
+                             void (*fill_f_brush)(gl_rectangle_t*, gl_rectangle_t*),
+                             gl_rectangle_t* gradient_border)
+{
+    gl_rectangle_t rect;
+    gl_rectangle_t rect_ring;
 
-            if (y_inner_max < rect.top_left.y)
-            {
-                no_more_brush = true;
-                rect.width = x_right_up - t2.x;
-            }
-        }
-        else
-            rect.width = x_right_up - t2.x;
+    rect.height = 1;
+    rect.width = brush_width;
+    rect_ring.height = 1;
+    rect_ring.width = pen_width;
+
+    if (brush_width && fill_f_brush)
+    {
+        rect.top_left.x = t2.x;
+        rect.top_left.y = t2.y + row;
+        (*fill_f_brush)(&rect, gradient_border);
+
+        rect.top_left.y = t1.y - row;
+        (*fill_f_brush)(&rect, gradient_border);
+
+        rect.top_left.x = t1.x - brush_width;
+        (*fill_f_brush)(&rect, gradient_border);
+
+        rect.top_left.y = t2.y + row;
+        (*fill_f_brush)(&rect, gradient_border);
+    }
+
+    if (pen_width)
+    {
+        rect_ring.top_left.x = t2.x + brush_width;
+        rect_ring.top_left.y = t2.y + row;
+        instance.driver.fill_f(&rect_ring, instance.pen.color);
+
+        rect_ring.top_left.y = t1.y - row;
+        instance.driver.fill_f(&rect_ring, instance.pen.color);
+
+        rect_ring.top_left.x = t1.x - brush_width - pen_width;
+        instance.driver.fill_f(&rect_ring, instance.pen.color);
+
+        rect_ring.top_left.y = t2.y + row;
+        instance.driver.fill_f(&rect_ring, instance.pen.color);
+    }
+}
+
+#pragma funcall  _draw_rects_quarters _draw_one_color_line, _draw_horizontal_gradient_line, _draw_vertical_gradient_line
+static void _draw_rects_quarters(gl_point_t t1, gl_point_t t2, gl_int_t radius, gl_rectangle_t* gradient_border)
+{
+    void (*fill_f_brush)(gl_rectangle_t*, gl_rectangle_t*) = NULL;
+    gl_corner_iterator_t it;
+    gl_int_t brush_width;
+    gl_int_t pen_width;
+    gl_uint_t pen = instance.pen.inner_width + instance.pen.outer_width;
+#if GL_CORNER_CACHE_SIZE > 0
+    const gl_corner_span_t* spans;
+    gl_int_t row;
+#endif
+
+    // set function for brush color style
+    if (instance.brush.style == GL_BRUSH_STYLE_FILL)
+        fill_f_brush = &_draw_one_color_line;
+    else if (instance.brush.style == GL_BRUSH_STYLE_GRADIENT_LEFT_RIGHT)
+        fill_f_brush = &_draw_horizontal_gradient_line;
+    else if (instance.brush.style == GL_BRUSH_STYLE_GRADIENT_TOP_DOWN)
+        fill_f_brush = &_draw_vertical_gradient_line;
+
+    if (!fill_f_brush && !pen)
+        return;
+
+#if GL_CORNER_CACHE_SIZE > 0
+    // same corners repeat across buttons, so replay stored spans when possible
+    spans = _corner_cache_get(radius, pen);
+    if (spans)
+    {
+        for (row = 0; row < radius + (gl_int_t)pen; row++)
+            _draw_corner_row(t1, t2, row, spans[row].brush_width, spans[row].pen_width, fill_f_brush, gradient_border);
+        return;
     }
+#endif
+
+    _corner_iterator_init(&it, radius, pen);
+    while (_corner_iterator_next(&it, &brush_width, &pen_width))
+        _draw_corner_row(t1, t2, it.row - 1, brush_width, pen_width, fill_f_brush, gradient_border);
 }
 
 static void _draw_rect_rounded_non_standard( gl_rectangle_t *rect, gl_int_t radius)
@@ -2952,7 +3133,7 @@ static void _draw_rect_rounded_non_standard( gl_rectangle_t *rect, gl_int_t radi
     }
 }
 
-void gl_draw_rect_rounded(gl_coord_t x, gl_coord_t y, gl_uint_t width, gl_uint_t height, gl_uint_t radius)
+GL_STATS_PRIMITIVE void _draw_rect_rounded(gl_coord_t x, gl_coord_t y, gl_uint_t width, gl_uint_t height, gl_uint_t radius)
 {
     gl_int_t inner_offset = instance.pen.inner_width;
 
@@ -2995,3 +3176,12 @@ void gl_draw_rect_rounded(gl_coord_t x, gl_coord_t y, gl_uint_t width, gl_uint_t
         instance.pen.inner_width = inner_offset;
     }
 }
+
+#ifdef GL_STATS_ENABLED
+void gl_draw_rect_rounded(gl_coord_t x, gl_coord_t y, gl_uint_t width, gl_uint_t height, gl_uint_t radius)
+{
+    GL_STATS_BEGIN(GL_STATS_PRIMITIVE_RECT_ROUNDED);
+    _draw_rect_rounded(x, y, width, height, radius);
+    GL_STATS_END();
+}
+#endif
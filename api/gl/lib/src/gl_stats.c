@@ -0,0 +1,190 @@
+/****************************************************************************
+**
+** Copyright (C) 2023 MikroElektronika d.o.o.
+** Contact: https://www.mikroe.com/contact
+**
+** This file is part of the mikroSDK package
+**
+** Commercial License Usage
+**
+** Licensees holding valid commercial NECTO compilers AI licenses may use this
+** file in accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The MikroElektronika Company.
+** For licensing terms and conditions see
+** https://www.mikroe.com/legal/software-license-agreement.
+** For further information use the contact form at
+** https://www.mikroe.com/contact.
+**
+**
+** GNU Lesser General Public License Usage
+**
+** Alternatively, this file may be used for
+** non-commercial projects under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** The above copyright notice and this permission notice shall be
+** included in all copies or substantial portions of the Software.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+** OF MERCHANTABILITY, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED
+** TO THE WARRANTIES FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+** IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+** DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT
+** OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+** OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+**
+****************************************************************************/
+
+
+#ifdef GL_STATS_ENABLED
+
+#include "gl_stats.h"
+#include "gl_utils.h"
+#include <string.h>
+
+extern gl_t instance;
+
+static const char *primitive_names[GL_STATS_PRIMITIVE_COUNT] =
+{
+    "clear",
+    "point",
+    "line",
+    "rect",
+    "rect_rounded",
+    "circle",
+    "ellipse",
+    "arc",
+    "char",
+    "text",
+    "image",
+    "jpeg"
+};
+
+static void _stats_add_pixels(uint32_t pixels)
+{
+    if (instance.stats.depth)
+        instance.stats.counters.primitive[instance.stats.current].pixels += pixels;
+}
+
+static void _stats_fill(gl_rectangle_t *rect, gl_color_t color)
+{
+    uint32_t pixels = (uint32_t)rect->width * rect->height;
+
+    instance.stats.counters.fill_calls++;
+    instance.stats.counters.fill_pixels += pixels;
+    _stats_add_pixels(pixels);
+
+    instance.stats.driver.fill_f(rect, color);
+}
+
+static void _stats_begin_frame(gl_rectangle_t *rect)
+{
+    instance.stats.counters.begin_frame_calls++;
+
+    instance.stats.driver.begin_frame_f(rect);
+}
+
+static void _stats_frame_data(gl_color_t color)
+{
+    instance.stats.counters.frame_data_calls++;
+    _stats_add_pixels(1);
+
+    instance.stats.driver.frame_data_f(color);
+}
+
+static void _stats_frame_data_buffer(const gl_color_t * __generic_ptr pixels, size_t count)
+{
+    instance.stats.counters.frame_data_buffer_calls++;
+    instance.stats.counters.frame_data_buffer_pixels += count;
+    _stats_add_pixels(count);
+
+    instance.stats.driver.frame_data_buffer_f(pixels, count);
+}
+
+static void _stats_end_frame()
+{
+    instance.stats.counters.end_frame_calls++;
+
+    instance.stats.driver.end_frame_f();
+}
+
+void _gl_stats_hook_driver()
+{
+    memcpy(&instance.stats.driver, &instance.driver, sizeof(gl_driver_t));
+
+    // missing driver functions are left NULL, library checks them before drawing
+    if (instance.driver.fill_f)
+        instance.driver.fill_f = _stats_fill;
+    if (instance.driver.begin_frame_f)
+        instance.driver.begin_frame_f = _stats_begin_frame;
+    if (instance.driver.frame_data_f)
+        instance.driver.frame_data_f = _stats_frame_data;
+    if (instance.driver.frame_data_buffer_f)
+        instance.driver.frame_data_buffer_f = _stats_frame_data_buffer;
+    if (instance.driver.end_frame_f)
+        instance.driver.end_frame_f = _stats_end_frame;
+}
+
+void _gl_stats_begin(gl_stats_primitive_t primitive)
+{
+    if (instance.stats.depth++)
+        return;
+
+    instance.stats.current = primitive;
+    instance.stats.counters.primitive[primitive].calls++;
+
+    if (instance.stats.timestamp_f)
+        instance.stats.start = instance.stats.timestamp_f();
+}
+
+void _gl_stats_end()
+{
+    if (--instance.stats.depth)
+        return;
+
+    if (instance.stats.timestamp_f)
+        instance.stats.counters.primitive[instance.stats.current].time += instance.stats.timestamp_f() - instance.stats.start;
+}
+
+void gl_stats_set_timestamp(gl_stats_timestamp_t timestamp)
+{
+    instance.stats.timestamp_f = timestamp;
+}
+
+void gl_stats_reset()
+{
+    memset(&instance.stats.counters, 0, sizeof(gl_stats_t));
+}
+
+const gl_stats_t *gl_stats_get()
+{
+    return &instance.stats.counters;
+}
+
+void gl_stats_dump(log_t *log)
+{
+    gl_stats_t *counters = &instance.stats.counters;
+    uint8_t i;
+
+    log_printf(log, "GL stats: primitive calls pixels time\r\n");
+    for (i = 0; i < GL_STATS_PRIMITIVE_COUNT; i++)
+    {
+        if (!counters->primitive[i].calls)
+            continue;
+
+        log_printf(log, "  %s %lu %lu %lu\r\n", primitive_names[i],
+                   counters->primitive[i].calls,
+                   counters->primitive[i].pixels,
+                   counters->primitive[i].time);
+    }
+
+    log_printf(log, "GL stats: fill %lu (%lu px), begin_frame %lu, frame_data %lu, frame_data_buffer %lu (%lu px), end_frame %lu\r\n",
+               counters->fill_calls, counters->fill_pixels,
+               counters->begin_frame_calls, counters->frame_data_calls,
+               counters->frame_data_buffer_calls, counters->frame_data_buffer_pixels, counters->end_frame_calls);
+}
+
+#endif // GL_STATS_ENABLED
+// ------------------------------------------------------------------------- END
@@ -44,6 +44,12 @@
 
 extern gl_t instance;
 
+#ifndef GL_STATS_ENABLED
+// Nothing is counted, so primitives are drawn by their public functions without wrappers.
+#define _draw_char gl_draw_char
+#define _draw_text gl_draw_text
+#endif
+
 static gl_int_t _saturate(gl_int_t value, gl_int_t min, gl_int_t max)
 {
     if (value < min)
@@ -307,7 +313,7 @@ static void _draw_char_ver(char ch, gl_int_t x, gl_int_t y)
     }
 }
 
-void gl_draw_char(char ch, gl_coord_t x, gl_coord_t y)
+GL_STATS_PRIMITIVE void _draw_char(char ch, gl_coord_t x, gl_coord_t y)
 {
     if (!instance.driver.fill_f || !instance.font.data_array)
         return;
@@ -318,7 +324,16 @@ void gl_draw_char(char ch, gl_coord_t x, gl_coord_t y)
         _draw_char_ver_crop(ch, x, y);
 }
 
-void gl_draw_text(const char * __generic_ptr text, gl_coord_t x, gl_coord_t y)
+#ifdef GL_STATS_ENABLED
+void gl_draw_char(char ch, gl_coord_t x, gl_coord_t y)
+{
+    GL_STATS_BEGIN(GL_STATS_PRIMITIVE_CHAR);
+    _draw_char(ch, x, y);
+    GL_STATS_END();
+}
+#endif
+
+GL_STATS_PRIMITIVE void _draw_text(const char * __generic_ptr text, gl_coord_t x, gl_coord_t y)
 {
     gl_int_t x_pos = x;
     gl_int_t y_pos = y;
@@ -497,6 +512,15 @@ void gl_draw_text(const char * __generic_ptr text, gl_coord_t x, gl_coord_t y)
     }
 }
 
+#ifdef GL_STATS_ENABLED
+void gl_draw_text(const char * __generic_ptr text, gl_coord_t x, gl_coord_t y)
+{
+    GL_STATS_BEGIN(GL_STATS_PRIMITIVE_TEXT);
+    _draw_text(text, x, y);
+    GL_STATS_END();
+}
+#endif
+
 gl_size_t gl_get_text_dimensions(const char * __generic_ptr text)
 {
     gl_size_t result;
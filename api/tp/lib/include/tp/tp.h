@@ -50,6 +50,7 @@
 
 #include <stdint.h>
 #include <stddef.h>
+#include "tp_filter.h"
 
 /**
  * @brief Touch Panel Touch Limit.
@@ -191,6 +192,13 @@ typedef void ( * tp_press_callback_t )( tp_event_t, tp_coord_t, tp_coord_t,
  */
 typedef void ( * tp_gesture_callback_t )( tp_event_t );
 
+/**
+ * @brief Touch Panel Touch Item Callback Function.
+ * @details Callback function getting all touched points of each processed
+ * touch reading, defined for Touch Panel library.
+ */
+typedef void ( * tp_touch_callback_t )( tp_touch_item_t * );
+
 /**
  * @brief Touch Panel Driver Interface Items.
  * @details Driver interface items defined for Touch Panel library.
@@ -204,6 +212,37 @@ typedef struct
 
 } tp_drv_t;
 
+/**
+ * @brief Touch Panel Timestamp Function.
+ * @details Returns the current time, used to timestamp touch samples.
+ */
+typedef uint32_t ( * tp_timestamp_t )( void );
+
+/**
+ * @brief Touch Panel Interrupt Mode Definition.
+ * @details Ways of reading the touch controller after its interrupt.
+ */
+typedef enum
+{
+    TP_IRQ_MODE_DEFERRED,   /**< Interrupt only notifies, controller is read by #tp_process. */
+    TP_IRQ_MODE_ISR         /**< Controller is read in the interrupt, by #tp_irq_sample. */
+
+} tp_irq_mode_t;
+
+/**
+ * @brief Touch Panel Sample Definition.
+ * @details Touch controller data read after its interrupt, waiting to be
+ * processed by #tp_process.
+ */
+typedef struct
+{
+    uint32_t         timestamp;     /**< Time of reading. */
+    tp_event_t       press_det;     /**< Touch pressure event. */
+    tp_touch_item_t  touch;         /**< Touch points, as reported by the driver. */
+    tp_event_t       gesture;       /**< Gesture, as reported by the driver. */
+
+} tp_sample_t;
+
 /**
  * @brief Touch Panel Size And Placement Configuration Object.
  * @details Specified configuration defined for Touch Panel library.
@@ -229,6 +268,7 @@ typedef struct
 
     tp_press_callback_t   press_callback_f;     /**< Callback function handler. */
     tp_gesture_callback_t gesture_callback_f;   /**< Callback function handler. */
+    tp_touch_callback_t   touch_callback_f;     /**< Callback function handler. */
 
     // Touch panel size and orientation.
 
@@ -251,6 +291,25 @@ typedef struct
 
     uint8_t          release;                   /**< Touch release detector. */
 
+    // Touch panel interrupt driven reading.
+
+    tp_sample_t *    samples;                   /**< Sample ring, NULL if the controller is polled. */
+    uint8_t          n_samples;                 /**< Number of entries of the sample ring. */
+    volatile uint8_t sample_head;               /**< Entry of the next sample. */
+    volatile uint8_t sample_tail;               /**< Entry of the oldest unprocessed sample. */
+    volatile uint8_t irq_pending;               /**< Interrupt notified and not yet processed. */
+    tp_irq_mode_t    irq_mode;                  /**< Interrupt mode. */
+    uint8_t          touch_active;              /**< Last sample was touched. */
+    tp_timestamp_t   timestamp_f;               /**< Timestamp function handler. */
+    uint32_t         sample_timestamp;          /**< Timestamp of the processed sample. */
+    uint16_t         samples_dropped;           /**< Samples lost because the ring was full. */
+
+    // Touch panel coordinate filter.
+
+    const tp_filter_cfg_t * filter_cfg;         /**< Filter tunables, NULL if coordinates are not filtered. */
+    tp_filter_point_t filter[ TP_N_TOUCHES_MAX ];   /**< Filter state, per touch ID. */
+    uint8_t          filter_ids;                /**< Touch IDs being filtered. */
+
 } tp_t;
 
 /*!
@@ -395,6 +454,36 @@ tp_press_callback_setup( tp_t * ctx, tp_press_callback_t cb );
 void
 tp_gesture_callback_setup( tp_t * ctx, tp_gesture_callback_t cb );
 
+/**
+ * @brief Touch Panel Callback Setup Function.
+ * @details This function sets callback handler getting all touched points,
+ * rotated to the panel orientation, after each touch reading processed by
+ * #tp_process, and no points once the touch is released. Points are meant to
+ * be passed to #tp_tracker_update, to track them and recognize gestures for
+ * touch controllers without gesture support.
+ * @param[out] ctx : Touch Panel context object. See #tp_t structure definition
+ * for detailed explanation.
+ * @param[in] cb : Callback function (handler).
+ * See #tp_touch_callback_t structure definition for detailed explanation.
+ * @return Nothing.
+ * @note If callback handler is not set, it will be ignored in the code.
+ * Readings with touch coordinates out of range are not passed.
+ *
+ * @b Example
+ * @code
+ *    // TP API object.
+ *    tp_t tp;
+ *
+ *    // Callback handler function declaration.
+ *    void touch_item_callback( tp_touch_item_t * touch_item );
+ *
+ *    // Callback handler setting.
+ *    tp_touch_callback_setup( &tp, touch_item_callback );
+ * @endcode
+ */
+void
+tp_touch_callback_setup( tp_t * ctx, tp_touch_callback_t cb );
+
 /**
  * @brief Touch Panel Rotate Function.
  * @details This function sets the Touch Panel orientation.
@@ -570,6 +659,133 @@ tp_gesture( tp_t * ctx, tp_event_t * event );
 tp_err_t
 tp_process( tp_t * ctx );
 
+/**
+ * @brief Touch Panel Filter Setup Function.
+ * @details This function enables filtering of the touch coordinates read from
+ * the driver, before their events are found and callback handlers are called.
+ * Filter smooths jitter of a still touch and predicts a moving touch ahead, so
+ * drags are steady and follow the finger without extra lag.
+ * @param[out] ctx : Touch Panel context object. See #tp_t structure definition
+ * for detailed explanation.
+ * @param[in,out] cfg : Filter tunables, kept by reference, NULL disables filtering.
+ * See #tp_filter_cfg_t structure definition for detailed explanation.
+ * @return Nothing.
+ *
+ * @b Example
+ * @code
+ *    // TP API object.
+ *    tp_t tp;
+ *    // Filter tunables of the panel.
+ *    static tp_filter_cfg_t filter_cfg;
+ *
+ *    tp_filter_cfg_setup( &filter_cfg );
+ *    tp_filter_setup( &tp, &filter_cfg );
+ * @endcode
+ */
+void
+tp_filter_setup( tp_t * ctx, tp_filter_cfg_t * cfg );
+
+/**
+ * @brief Touch Panel Interrupt Setup Function.
+ * @details This function switches Touch Panel from polling the controller on
+ * every #tp_process call to reading it only after its interrupt line reports
+ * a touch. The application handles the interrupt of the controller's INT pin
+ * and calls #tp_irq_notify or #tp_irq_sample from it. Read samples wait in the
+ * given ring, with their timestamps, until #tp_process handles them.
+ * @param[out] ctx : Touch Panel context object. See #tp_t structure definition
+ * for detailed explanation.
+ * @param[in] samples : Sample ring, NULL switches back to polling.
+ * See #tp_sample_t structure definition for detailed explanation.
+ * @param[in] n_samples : Number of entries of the sample ring, at least 3.
+ * One entry is always left empty and one is kept for the release.
+ * @param[in] mode : Interrupt mode. See #tp_irq_mode_t for valid values.
+ * @param[in] timestamp : Timestamp function, can be NULL.
+ * @return @li @c 0 - OK,
+ *         @li @c 6 - Sample ring is too small.
+ * See #tp_err_t structure definition for detailed explanation.
+ * @note In #TP_IRQ_MODE_DEFERRED mode, #tp_process reads the controller after
+ * the interrupt and then on every call until the touch is released, so the
+ * controller may keep its INT pin low while touched. In #TP_IRQ_MODE_ISR mode
+ * only the interrupt reads the controller, so it has to pulse the INT pin on
+ * every report, including release.
+ * @b Example
+ * @code
+ *    // TP API object.
+ *    tp_t tp;
+ *    // TP sample ring.
+ *    tp_sample_t tp_samples[ 8 ];
+ *    // Read the controller only after it reports a touch.
+ *    tp_irq_setup( &tp, tp_samples, 8, TP_IRQ_MODE_DEFERRED, NULL );
+ *    // INT pin falling edge interrupt handler.
+ *    void tp_int_handler( void )
+ *    {
+ *        tp_irq_notify( &tp );
+ *    }
+ * @endcode
+ */
+tp_err_t
+tp_irq_setup( tp_t * ctx, tp_sample_t * samples, uint8_t n_samples,
+              tp_irq_mode_t mode, tp_timestamp_t timestamp );
+
+/**
+ * @brief Touch Panel Interrupt Notify Function.
+ * @details This function notifies that the controller reported a touch, so
+ * that the next #tp_process call reads it. It's safe to call from interrupt.
+ * @param[out] ctx : Touch Panel context object. See #tp_t structure definition
+ * for detailed explanation.
+ * @return Nothing.
+ * @b Example
+ * @code
+ *    // TP API object.
+ *    tp_t tp;
+ *    // Notify from the INT pin interrupt handler.
+ *    tp_irq_notify( &tp );
+ * @endcode
+ */
+void
+tp_irq_notify( tp_t * ctx );
+
+/**
+ * @brief Touch Panel Interrupt Sample Function.
+ * @details This function reads the controller and stores the read data in the
+ * sample ring, to be handled by #tp_process. It's meant to be called from the
+ * controller's interrupt in #TP_IRQ_MODE_ISR mode, if the controller's bus can
+ * be used from interrupt. If the ring is full, new samples are dropped, but
+ * the last entry is kept for a release, so a stored press is always released.
+ * @param[out] ctx : Touch Panel context object. See #tp_t structure definition
+ * for detailed explanation.
+ * @return @li @c 0 - OK,
+ *         @li @c 5 - Number of pressed touches is out of range.
+ * See #tp_err_t structure definition for detailed explanation.
+ * @b Example
+ * @code
+ *    // TP API object.
+ *    tp_t tp;
+ *    // Read the controller from the INT pin interrupt handler.
+ *    tp_irq_sample( &tp );
+ * @endcode
+ */
+tp_err_t
+tp_irq_sample( tp_t * ctx );
+
+/**
+ * @brief Touch Panel Sample Timestamp Function.
+ * @details This function returns the timestamp of the sample being handled,
+ * so that callback handlers can tell when the touch was read.
+ * @param[in] ctx : Touch Panel context object. See #tp_t structure definition
+ * for detailed explanation.
+ * @return Timestamp of the sample, 0 if the controller is polled.
+ * @b Example
+ * @code
+ *    // TP API object.
+ *    tp_t tp;
+ *    // Time the touch was read, in touch callback handler.
+ *    uint32_t read_time = tp_get_sample_timestamp( &tp );
+ * @endcode
+ */
+uint32_t
+tp_get_sample_timestamp( tp_t * ctx );
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,264 @@
+/****************************************************************************
+**
+** Copyright (C) 2023 MikroElektronika d.o.o.
+** Contact: https://www.mikroe.com/contact
+**
+** This file is part of the mikroSDK package
+**
+** Commercial License Usage
+**
+** Licensees holding valid commercial NECTO compilers AI licenses may use this
+** file in accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The MikroElektronika Company.
+** For licensing terms and conditions see
+** https://www.mikroe.com/legal/software-license-agreement.
+** For further information use the contact form at
+** https://www.mikroe.com/contact.
+**
+**
+** GNU Lesser General Public License Usage
+**
+** Alternatively, this file may be used for
+** non-commercial projects under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** The above copyright notice and this permission notice shall be
+** included in all copies or substantial portions of the Software.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+** OF MERCHANTABILITY, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED
+** TO THE WARRANTIES FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+** IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+** DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT
+** OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+** OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+**
+****************************************************************************/
+
+/*!
+ * @file tp_calibration.h
+ * @brief Touch Panel Calibration Library.
+ */
+
+#ifndef _TP_CALIBRATION_H_
+#define _TP_CALIBRATION_H_
+
+#include "tp.h"
+
+/**
+ * @brief Touch Panel Calibration Fixed Point Format.
+ * @details Number of fractional bits of the calibration coefficients (Q16).
+ */
+#define TP_CALIBRATION_FRACTION_BITS  16
+
+/**
+ * @brief Touch Panel Calibration Minimal Number Of Points.
+ * @details Number of touched points needed to compute calibration.
+ */
+#define TP_CALIBRATION_POINTS_MIN     3
+
+/**
+ * @brief Touch Panel Calibration Data Size.
+ * @details Number of bytes needed to save calibration coefficients.
+ */
+#define TP_CALIBRATION_DATA_SIZE      26
+
+/**
+ * @brief Touch Panel Calibration Object Definition.
+ * @details Affine transform converting raw touch controller values to display
+ * coordinates. Coefficients are in Q16 fixed point format:
+ * - x = ( a * raw_x + b * raw_y + c ) >> 16,
+ * - y = ( d * raw_x + e * raw_y + f ) >> 16.
+ * Besides scaling and offset, it compensates rotated and skewed panels, and
+ * each sample is converted with multiplications and additions only.
+ */
+typedef struct
+{
+    int32_t a; /**< Raw x coefficient of x coordinate. */
+    int32_t b; /**< Raw y coefficient of x coordinate. */
+    int32_t c; /**< Offset of x coordinate. */
+    int32_t d; /**< Raw x coefficient of y coordinate. */
+    int32_t e; /**< Raw y coefficient of y coordinate. */
+    int32_t f; /**< Offset of y coordinate. */
+
+} tp_calibration_t;
+
+/**
+ * @brief Touch Panel Calibration Point Definition.
+ * @details Raw values read from touch controller while touching the given
+ * display coordinates.
+ */
+typedef struct
+{
+    uint16_t   raw_x; /**< Raw x value read from touch controller. */
+    uint16_t   raw_y; /**< Raw y value read from touch controller. */
+    tp_coord_t x;     /**< Touched display coordinate x. */
+    tp_coord_t y;     /**< Touched display coordinate y. */
+
+} tp_calibration_point_t;
+
+/*!
+ * \addtogroup middlewaregroup
+ * @{
+ */
+
+/*!
+ * @addtogroup tpgroup Touch Panel Library
+ * @{
+ */
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * @brief Touch Panel Calibration Compute Function.
+ * @details Computes calibration from touched points. Three points give exact
+ * transform, more points are fitted with least squares to average out touch
+ * inaccuracy. Points shouldn't lie on a single line, the best results are got
+ * with points near three or four display corners.
+ * @param[out] cal : Calibration object. See #tp_calibration_t structure
+ * definition for detailed explanation.
+ * @param[in] points : Touched points. See #tp_calibration_point_t structure
+ * definition for detailed explanation.
+ * @param[in] n_points : Number of touched points, at least
+ * #TP_CALIBRATION_POINTS_MIN.
+ * @return @li @c 0 - OK,
+ *         @li @c 4 - Not enough points or points lie on a single line.
+ * See #tp_err_t structure definition for detailed explanation.
+ * @note Calibration is computed in floating point, but only once. Samples are
+ * converted in fixed point by #tp_calibration_apply.
+ *
+ * @b Example
+ * @code
+ *    // Calibration object.
+ *    tp_calibration_t cal;
+ *    // Raw values read while touching three display corners.
+ *    tp_calibration_point_t points[ 3 ] = {
+ *        { 3850,  240,   0,   0 },
+ *        {  230,  250, 319,   0 },
+ *        { 3870, 3790,   0, 239 } };
+ *
+ *    tp_calibration_compute( &cal, points, 3 );
+ * @endcode
+ */
+tp_err_t
+tp_calibration_compute( tp_calibration_t * cal, const tp_calibration_point_t * points,
+                        uint8_t n_points );
+
+/**
+ * @brief Touch Panel Calibration Range Function.
+ * @details Sets calibration mapping the given raw value ranges linearly to the
+ * display size, the same way min/max calibration data of resistive touch
+ * controller drivers is used.
+ * @param[out] cal : Calibration object. See #tp_calibration_t structure
+ * definition for detailed explanation.
+ * @param[in] min_x : Raw x value at display coordinate x 0.
+ * @param[in] max_x : Raw x value at display coordinate x @p width.
+ * @param[in] min_y : Raw y value at display coordinate y 0.
+ * @param[in] max_y : Raw y value at display coordinate y @p height.
+ * @param[in] width : Display width in pixels.
+ * @param[in] height : Display height in pixels.
+ * @return @li @c 0 - OK,
+ *         @li @c 4 - Empty raw value range.
+ * See #tp_err_t structure definition for detailed explanation.
+ */
+tp_err_t
+tp_calibration_from_range( tp_calibration_t * cal, uint16_t min_x, uint16_t max_x,
+                           uint16_t min_y, uint16_t max_y, uint16_t width, uint16_t height );
+
+/**
+ * @brief Touch Panel Calibration Swap Axes Function.
+ * @details Swaps raw x and raw y inputs of the calibration, for panels whose
+ * x plate runs along display y axis.
+ * @param[in,out] cal : Calibration object. See #tp_calibration_t structure
+ * definition for detailed explanation.
+ * @return Nothing.
+ */
+void
+tp_calibration_swap_axes( tp_calibration_t * cal );
+
+/**
+ * @brief Touch Panel Calibration Mirror Function.
+ * @details Mirrors calibration output, so x becomes @p width - x and/or
+ * y becomes @p height - y.
+ * @param[in,out] cal : Calibration object. See #tp_calibration_t structure
+ * definition for detailed explanation.
+ * @param[in] width : Display width in pixels, 0 keeps x as it is.
+ * @param[in] height : Display height in pixels, 0 keeps y as it is.
+ * @return Nothing.
+ */
+void
+tp_calibration_mirror( tp_calibration_t * cal, uint16_t width, uint16_t height );
+
+/**
+ * @brief Touch Panel Calibration Apply Function.
+ * @details Converts raw touch controller values to display coordinates.
+ * Negative coordinates are clamped to 0.
+ * @param[in] cal : Calibration object. See #tp_calibration_t structure
+ * definition for detailed explanation.
+ * @param[in] raw_x : Raw x value read from touch controller.
+ * @param[in] raw_y : Raw y value read from touch controller.
+ * @param[out] x : Display coordinate x.
+ * @param[out] y : Display coordinate y.
+ * @return Nothing.
+ */
+void
+tp_calibration_apply( const tp_calibration_t * cal, uint16_t raw_x, uint16_t raw_y,
+                      tp_coord_t * x, tp_coord_t * y );
+
+/**
+ * @brief Touch Panel Calibration Save Function.
+ * @details Stores calibration to the buffer, so it can be kept in non-volatile
+ * memory or written to a file and loaded on the next start-up instead of
+ * calibrating again. Stored data doesn't depend on MCU byte order.
+ * @param[in] cal : Calibration object. See #tp_calibration_t structure
+ * definition for detailed explanation.
+ * @param[out] buffer : Buffer of #TP_CALIBRATION_DATA_SIZE bytes.
+ * @return Nothing.
+ *
+ * @b Example
+ * @code
+ *    uint8_t data[ TP_CALIBRATION_DATA_SIZE ];
+ *
+ *    tp_calibration_save( &cal, data );
+ *    file_write( &file, data, TP_CALIBRATION_DATA_SIZE );
+ * @endcode
+ */
+void
+tp_calibration_save( const tp_calibration_t * cal, uint8_t * buffer );
+
+/**
+ * @brief Touch Panel Calibration Load Function.
+ * @details Restores calibration stored by #tp_calibration_save.
+ * @param[out] cal : Calibration object, left unchanged if data isn't valid.
+ * See #tp_calibration_t structure definition for detailed explanation.
+ * @param[in] buffer : Buffer of #TP_CALIBRATION_DATA_SIZE bytes.
+ * @return @li @c 0 - OK,
+ *         @li @c 3 - Buffer doesn't contain valid calibration.
+ * See #tp_err_t structure definition for detailed explanation.
+ *
+ * @b Example
+ * @code
+ *    uint8_t data[ TP_CALIBRATION_DATA_SIZE ];
+ *
+ *    if ( ( FSS_OK != file_read( &file, data, TP_CALIBRATION_DATA_SIZE ) ) ||
+ *         ( TP_OK != tp_calibration_load( &cal, data ) ) ) {
+ *        // Calibrate the panel.
+ *    }
+ * @endcode
+ */
+tp_err_t
+tp_calibration_load( tp_calibration_t * cal, const uint8_t * buffer );
+
+#ifdef __cplusplus
+}
+#endif
+#endif // _TP_CALIBRATION_H_
+
+/*! @} */ // tpgroup
+/*! @} */ // middlewaregroup
+
+// ------------------------------------------------------------------------ END
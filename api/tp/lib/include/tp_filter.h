@@ -0,0 +1,182 @@
+/****************************************************************************
+**
+** Copyright (C) 2023 MikroElektronika d.o.o.
+** Contact: https://www.mikroe.com/contact
+**
+** This file is part of the mikroSDK package
+**
+** Commercial License Usage
+**
+** Licensees holding valid commercial NECTO compilers AI licenses may use this
+** file in accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The MikroElektronika Company.
+** For licensing terms and conditions see
+** https://www.mikroe.com/legal/software-license-agreement.
+** For further information use the contact form at
+** https://www.mikroe.com/contact.
+**
+**
+** GNU Lesser General Public License Usage
+**
+** Alternatively, this file may be used for
+** non-commercial projects under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** The above copyright notice and this permission notice shall be
+** included in all copies or substantial portions of the Software.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+** OF MERCHANTABILITY, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED
+** TO THE WARRANTIES FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+** IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+** DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT
+** OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+** OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+**
+****************************************************************************/
+
+/*!
+ * @file tp_filter.h
+ * @brief Touch Panel Filter Library.
+ */
+
+#ifndef _TP_FILTER_H_
+#define _TP_FILTER_H_
+
+#include <stdint.h>
+
+/**
+ * @brief Touch Panel Filter Gain Format.
+ * @details Number of fractional bits of the filter gains (Q8), e.g. 256
+ * stands for 1.
+ */
+#define TP_FILTER_GAIN_BITS      8
+
+/**
+ * @brief Touch Panel Filter Position Format.
+ * @details Number of fractional bits of the filtered position and velocity.
+ */
+#define TP_FILTER_POSITION_BITS  4
+
+/**
+ * @brief Touch Panel Filter Configuration Object.
+ * @details Per panel tunables of the adaptive alpha-beta filter. Position gain
+ * grows from @b alpha_min at rest to @b alpha_max at @b speed_max, so a still
+ * touch is smoothed and a fast drag follows the finger. Velocity is used to
+ * predict the position @b prediction reports ahead, which compensates the lag
+ * of smoothing and of the touch controller itself. Gains are in Q8 format.
+ * After changing the tunables, #tp_filter_cfg_update derives @b alpha_slope.
+ */
+typedef struct
+{
+    uint16_t alpha_min;     /**< Position gain of a still touch, 1 to 256. */
+    uint16_t alpha_max;     /**< Position gain of a fast touch, @b alpha_min to 256. */
+    uint16_t speed_max;     /**< Movement per report in pixels where @b alpha_max is reached, at least 1. */
+    uint16_t beta;          /**< Velocity gain, 0 to 256. */
+    uint16_t prediction;    /**< Reports to predict ahead, 0 disables prediction, 256 predicts one report. */
+
+    uint32_t alpha_slope;   /**< Position gain added per pixel of movement, in Q8 format. Derived, not a tunable. */
+
+} tp_filter_cfg_t;
+
+/**
+ * @brief Touch Panel Filter Axis State.
+ * @details Filtered position and velocity along one axis, in fixed point
+ * format with #TP_FILTER_POSITION_BITS fractional bits.
+ */
+typedef struct
+{
+    int32_t position;   /**< Filtered position. */
+    int32_t velocity;   /**< Filtered velocity, per report. */
+
+} tp_filter_axis_t;
+
+/**
+ * @brief Touch Panel Filter Point State.
+ * @details Filter state of one touch point.
+ */
+typedef struct
+{
+    tp_filter_axis_t x;     /**< State along x axis. */
+    tp_filter_axis_t y;     /**< State along y axis. */
+
+} tp_filter_point_t;
+
+/*!
+ * \addtogroup middlewaregroup
+ * @{
+ */
+
+/*!
+ * @addtogroup tpgroup Touch Panel Library
+ * @{
+ */
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * @brief Touch Panel Filter Configuration Function.
+ * @details Configures filter configuration structure to default tunables,
+ * suitable for touch controllers reported 50 to 100 times per second.
+ * @param[out] cfg : Filter configuration object. See #tp_filter_cfg_t
+ * structure definition for detailed explanation.
+ * @return Nothing.
+ */
+void
+tp_filter_cfg_setup( tp_filter_cfg_t * cfg );
+
+/**
+ * @brief Touch Panel Filter Configuration Update Function.
+ * @details Derives the growth of position gain with movement from the
+ * tunables, so that filtering a report doesn't divide. Has to be called after
+ * the tunables are changed, #tp_filter_cfg_setup and #tp_filter_setup call it.
+ * @param[in,out] cfg : Filter configuration object. See #tp_filter_cfg_t
+ * structure definition for detailed explanation.
+ * @return Nothing.
+ */
+void
+tp_filter_cfg_update( tp_filter_cfg_t * cfg );
+
+/**
+ * @brief Touch Panel Filter Reset Function.
+ * @details Starts filtering a new touch at the given coordinates.
+ * @param[out] point : Filter point state. See #tp_filter_point_t structure
+ * definition for detailed explanation.
+ * @param[in] x : Touch coordinate x.
+ * @param[in] y : Touch coordinate y.
+ * @return Nothing.
+ */
+void
+tp_filter_reset( tp_filter_point_t * point, uint16_t x, uint16_t y );
+
+/**
+ * @brief Touch Panel Filter Update Function.
+ * @details Filters the reported coordinates of the touch, in place. Uses
+ * integer additions, shifts and multiplications only, it doesn't divide.
+ * @param[in] cfg : Filter configuration object. See #tp_filter_cfg_t
+ * structure definition for detailed explanation.
+ * @param[in,out] point : Filter point state. See #tp_filter_point_t
+ * structure definition for detailed explanation.
+ * @param[in,out] x : Touch coordinate x, replaced by the filtered one.
+ * @param[in,out] y : Touch coordinate y, replaced by the filtered one.
+ * @param[in] x_max : Maximal coordinate x, predicted coordinate is limited to it.
+ * @param[in] y_max : Maximal coordinate y, predicted coordinate is limited to it.
+ * @return Nothing.
+ */
+void
+tp_filter_update( const tp_filter_cfg_t * cfg, tp_filter_point_t * point,
+                  uint16_t * x, uint16_t * y, uint16_t x_max, uint16_t y_max );
+
+#ifdef __cplusplus
+}
+#endif
+#endif // _TP_FILTER_H_
+
+/*! @} */ // tpgroup
+/*! @} */ // middlewaregroup
+
+// ------------------------------------------------------------------------ END
@@ -49,6 +49,7 @@
 
 #include <stdint.h>
 #include <stddef.h>
+#include "tp_filter.h"
 
 /**
  * @brief Touch Panel Error Code Definition.
@@ -180,6 +181,10 @@ typedef struct {
     tp_touch_coord_t touch_prev;           /**< Touch point previous data. */
     tp_touch_coord_t touch_prev_mirr;      /**< Touch point mirrored data. */
     uint8_t release;                      /**< Touch release detector. */
+
+    // Touch panel coordinate filter.
+    const tp_filter_cfg_t *filter_cfg;    /**< Filter tunables, NULL if coordinates are not filtered. */
+    tp_filter_point_t filter;             /**< Filter state. */
 } tp_t;
 
 /*!
@@ -282,6 +287,31 @@ tp_err_t tp_init( tp_t *ctx, tp_cfg_t *cfg, tp_drv_t *drv, void *drv_ctx );
  */
 void tp_press_callback_setup( tp_t *ctx, tp_press_callback_t cb );
 
+/**
+ * @brief Touch Panel Filter Setup Function.
+ * @details This function enables filtering of the touch coordinates read from
+ * the driver, before their events are found and callback handler is called.
+ * Filter smooths jitter of a still touch and predicts a moving touch ahead, so
+ * drags are steady and follow the finger without extra lag.
+ * @param[out] ctx : Touch Panel context object. See #tp_t structure definition
+ * for detailed explanation.
+ * @param[in,out] cfg : Filter tunables, kept by reference, NULL disables filtering.
+ * See #tp_filter_cfg_t structure definition for detailed explanation.
+ * @return Nothing.
+ *
+ * @b Example
+ * @code
+ *    // TP API object.
+ *    tp_t tp;
+ *    // Filter tunables of the panel.
+ *    static tp_filter_cfg_t filter_cfg;
+ *
+ *    tp_filter_cfg_setup( &filter_cfg );
+ *    tp_filter_setup( &tp, &filter_cfg );
+ * @endcode
+ */
+void tp_filter_setup( tp_t *ctx, tp_filter_cfg_t *cfg );
+
 /**
  * @brief Touch Panel Rotate Function.
  * @details This function sets the Touch Panel orientation.
@@ -0,0 +1,238 @@
+/****************************************************************************
+**
+** Copyright (C) 2023 MikroElektronika d.o.o.
+** Contact: https://www.mikroe.com/contact
+**
+** This file is part of the mikroSDK package
+**
+** Commercial License Usage
+**
+** Licensees holding valid commercial NECTO compilers AI licenses may use this
+** file in accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The MikroElektronika Company.
+** For licensing terms and conditions see
+** https://www.mikroe.com/legal/software-license-agreement.
+** For further information use the contact form at
+** https://www.mikroe.com/contact.
+**
+**
+** GNU Lesser General Public License Usage
+**
+** Alternatively, this file may be used for
+** non-commercial projects under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** The above copyright notice and this permission notice shall be
+** included in all copies or substantial portions of the Software.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+** OF MERCHANTABILITY, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED
+** TO THE WARRANTIES FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+** IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+** DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT
+** OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+** OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+**
+****************************************************************************/
+
+/*!
+ * @file tp_tracker.h
+ * @brief Touch Panel Tracker Library.
+ */
+
+#ifndef _TP_TRACKER_H_
+#define _TP_TRACKER_H_
+
+#include "tp.h"
+
+/**
+ * @brief Touch Panel Tracker Point Limit.
+ * @details Maximal number of tracked touch points.
+ */
+#ifndef TP_TRACKER_POINTS_MAX
+#define TP_TRACKER_POINTS_MAX  5
+#endif
+
+/**
+ * @brief Touch Panel Tracker Gesture Definition.
+ * @details Gestures recognized from tracked touch points.
+ */
+typedef enum
+{
+    TP_TRACKER_GEST_NONE,       /**< No gesture. */
+    TP_TRACKER_GEST_LEFT,       /**< Single touch swiped left. */
+    TP_TRACKER_GEST_RIGHT,      /**< Single touch swiped right. */
+    TP_TRACKER_GEST_UP,         /**< Single touch swiped up. */
+    TP_TRACKER_GEST_DOWN,       /**< Single touch swiped down. */
+    TP_TRACKER_GEST_TAP,        /**< Single touch tapped. */
+    TP_TRACKER_GEST_DOUBLE_TAP, /**< Single touch tapped twice. */
+    TP_TRACKER_GEST_LONG_PRESS, /**< Single touch held still. */
+    TP_TRACKER_GEST_ZOOM_IN,    /**< Two touches spread apart. */
+    TP_TRACKER_GEST_ZOOM_OUT,   /**< Two touches pinched together. */
+    TP_TRACKER_GEST_ROTATE_CW,  /**< Two touches rotated clockwise. */
+    TP_TRACKER_GEST_ROTATE_CCW  /**< Two touches rotated counterclockwise. */
+
+} tp_tracker_gesture_t;
+
+/**
+ * @brief Touch Panel Tracker Configuration Object.
+ * @details Gesture recognition thresholds. Distances are in pixels and times
+ * in units of the timestamps given to #tp_tracker_update, usually
+ * milliseconds.
+ */
+typedef struct
+{
+    uint16_t match_distance;    /**< Maximal movement of a touch between two updates. */
+    uint16_t tap_distance;      /**< Maximal movement of a tap or long press. */
+    uint16_t tap_time;          /**< Maximal duration of a tap. */
+    uint16_t double_tap_time;   /**< Maximal time between two taps of a double tap. */
+    uint16_t long_press_time;   /**< Minimal duration of a long press. */
+    uint16_t swipe_distance;    /**< Minimal movement of a swipe. */
+    uint16_t swipe_time;        /**< Maximal duration of a swipe. */
+    uint16_t zoom_distance;     /**< Change of distance between two touches reported as zoom. */
+    uint8_t  rotate_angle;      /**< Rotation of two touches reported as rotate, in degrees, 1 to 89. */
+
+} tp_tracker_cfg_t;
+
+/**
+ * @brief Touch Panel Tracker Point Object.
+ * @details Tracked touch point. Index of the point in the tracker is its
+ * touch ID, kept while the point is touched. Event of the point is:
+ * - #TP_EVENT_PRESS_DOWN - pressed by the last update,
+ * - #TP_EVENT_PRESS_MOVE - moved by the last update,
+ * - #TP_EVENT_PRESS_DET - touched and not moved by the last update,
+ * - #TP_EVENT_PRESS_UP - released by the last update,
+ * - #TP_EVENT_PRESS_NOT_DET - not touched.
+ */
+typedef struct
+{
+    tp_coord_t  coord_x;        /**< Touch coordinate x. */
+    tp_coord_t  coord_y;        /**< Touch coordinate y. */
+    tp_coord_t  start_x;        /**< Touch coordinate x when pressed. */
+    tp_coord_t  start_y;        /**< Touch coordinate y when pressed. */
+    int32_t     velocity_x;     /**< Smoothed velocity along x, in pixels per 1000 time units. */
+    int32_t     velocity_y;     /**< Smoothed velocity along y, in pixels per 1000 time units. */
+    uint32_t    start_time;     /**< Timestamp when pressed. */
+    uint32_t    time;           /**< Timestamp of the last update. */
+    tp_event_t  event;          /**< Touch event of the last update. */
+
+} tp_tracker_point_t;
+
+/**
+ * @brief Touch Panel Tracker Context Object.
+ * @details Tracked touch points and gesture recognition state.
+ */
+typedef struct
+{
+    tp_tracker_cfg_t    cfg;                                /**< Gesture recognition thresholds. */
+    int16_t             rotate_sin;                         /**< Sine of rotate angle, Q8 format. */
+
+    tp_tracker_point_t  point[ TP_TRACKER_POINTS_MAX ];     /**< Tracked points, indexed by touch ID. */
+    uint8_t             n_points;                           /**< Number of touched points. */
+
+    uint8_t             multi_touch;                        /**< More than one point touched since all were released. */
+    uint8_t             long_press;                         /**< Long press reported for the current touch. */
+    uint8_t             tap_pending;                        /**< Tap reported and waiting for the second tap. */
+    uint32_t            tap_time;                           /**< Timestamp of the pending tap. */
+    tp_coord_t          tap_x;                              /**< Coordinate x of the pending tap. */
+    tp_coord_t          tap_y;                              /**< Coordinate y of the pending tap. */
+
+    uint8_t             pair_valid;                         /**< Reference of two touches is set. */
+    uint8_t             pair_id[ 2 ];                       /**< IDs of the two touches of the reference. */
+    int16_t             pair_dx;                            /**< Reference vector x, between two touches. */
+    int16_t             pair_dy;                            /**< Reference vector y, between two touches. */
+    uint16_t            pair_distance;                      /**< Reference distance between two touches. */
+
+} tp_tracker_t;
+
+/*!
+ * \addtogroup middlewaregroup
+ * @{
+ */
+
+/*!
+ * @addtogroup tpgroup Touch Panel Library
+ * @{
+ */
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * @brief Touch Panel Tracker Configuration Function.
+ * @details Configures tracker configuration structure to default thresholds,
+ * for timestamps in milliseconds.
+ * @param[out] cfg : Tracker configuration object. See #tp_tracker_cfg_t
+ * structure definition for detailed explanation.
+ * @return Nothing.
+ */
+void
+tp_tracker_cfg_setup( tp_tracker_cfg_t * cfg );
+
+/**
+ * @brief Touch Panel Tracker Initialization Function.
+ * @details Initializes tracker with no touched points.
+ * @param[out] tracker : Tracker context object. See #tp_tracker_t structure
+ * definition for detailed explanation.
+ * @param[in] cfg : Tracker configuration object. See #tp_tracker_cfg_t
+ * structure definition for detailed explanation.
+ * @return Nothing.
+ * @note Rotate angle is limited to 1 to 89 degrees.
+ */
+void
+tp_tracker_init( tp_tracker_t * tracker, tp_tracker_cfg_t * cfg );
+
+/**
+ * @brief Touch Panel Tracker Update Function.
+ * @details Associates the touched points with tracked points by the nearest
+ * distance, so each touch keeps its ID no matter the order the controller
+ * reports it, updates their velocities and recognizes gestures. Works with
+ * any touch controller, so controllers without gesture support get the same
+ * gestures. Cost of each update is bounded by #TP_TRACKER_POINTS_MAX.
+ * @param[in,out] tracker : Tracker context object. See #tp_tracker_t
+ * structure definition for detailed explanation.
+ * @param[in] points : Touched points in display coordinates, only
+ * coordinates are used. See #tp_touch_coord_t structure definition for
+ * detailed explanation.
+ * @param[in] n_points : Number of touched points, 0 if nothing is touched.
+ * @param[in] timestamp : Time of reading the points.
+ * @return Recognized gesture. See #tp_tracker_gesture_t definition for
+ * detailed explanation.
+ * @note Long press is reported by an update, so the touch controller has to
+ * be read while it's touched. Tracked points and their events are in
+ * @p tracker->point. A point released by this update keeps its last
+ * coordinates, unless its ID is taken by a new point.
+ *
+ * @b Example
+ * @code
+ *    // TP API object.
+ *    tp_t tp;
+ *    // Tracker object.
+ *    tp_tracker_t tracker;
+ *
+ *    // Touch handler, set by tp_touch_callback_setup.
+ *    void touch_handler( tp_touch_item_t * touch_item )
+ *    {
+ *        tp_tracker_gesture_t gesture;
+ *
+ *        gesture = tp_tracker_update( &tracker, touch_item->point,
+ *                                     touch_item->n_touches, get_time_ms( ) );
+ *    }
+ * @endcode
+ */
+tp_tracker_gesture_t
+tp_tracker_update( tp_tracker_t * tracker, const tp_touch_coord_t * points,
+                   uint8_t n_points, uint32_t timestamp );
+
+#ifdef __cplusplus
+}
+#endif
+#endif // _TP_TRACKER_H_
+
+/*! @} */ // tpgroup
+/*! @} */ // middlewaregroup
+
+// ------------------------------------------------------------------------ END
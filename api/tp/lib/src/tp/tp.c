@@ -113,6 +113,71 @@ static void
 tp_get_rotated_coord( tp_t * ctx, tp_touch_item_t * to, tp_touch_item_t * from,
                       uint8_t index );
 
+/**
+ * @brief TP Filter Coordinates Function.
+ * @details This function filters the touch points read from the driver, if
+ * filter is set. Filter of each touch ID starts at its first point.
+ * @param[in,out] ctx : TP context object, with touch points read from the
+ * driver. See #tp_t structure definition for detailed explanation.
+ * @return Nothing.
+ */
+static void
+tp_filter_coordinates( tp_t * ctx );
+
+/**
+ * @brief TP Update Coordinates Function.
+ * @details This function rotates the touch points read from the driver and
+ * finds their events by comparing them with the previous ones.
+ * @param[in] ctx : TP context object, with touch points read from the driver.
+ * See #tp_t structure definition for detailed explanation.
+ * @param[out] touch_item : Touch item data. See #tp_touch_item_t structure
+ * definition for detailed explanation.
+ * @return @li @c 0 - OK,
+ *         @li @c 4 - Touch coordinates are out of range.
+ * See #tp_err_t structure definition for detailed explanation.
+ */
+static tp_err_t
+tp_update_coordinates( tp_t * ctx, tp_touch_item_t * touch_item );
+
+/**
+ * @brief TP Update Gesture Function.
+ * @details This function rotates the gesture read from the driver.
+ * @param[in] ctx : TP context object, with gesture read from the driver.
+ * See #tp_t structure definition for detailed explanation.
+ * @param[out] event : Gesture event, #TP_EVENT_GEST_NONE if it's not new.
+ * @return Nothing.
+ */
+static void
+tp_update_gesture( tp_t * ctx, tp_event_t * event );
+
+/**
+ * @brief TP Handle Touch Function.
+ * @details This function finds the events of the touch read from the driver
+ * and calls the callback handlers.
+ * @param[in] ctx : TP context object, with touch points and gesture read from
+ * the driver. See #tp_t structure definition for detailed explanation.
+ * @param[in] press_det : Touch pressure event read from the driver.
+ * @return @li @c 0 - OK,
+ *         @li @c 4 - Touch coordinates are out of range.
+ * See #tp_err_t structure definition for detailed explanation.
+ */
+static tp_err_t
+tp_handle_touch( tp_t * ctx, tp_event_t press_det );
+
+/**
+ * @brief TP Process Samples Function.
+ * @details This function reads the controller if its interrupt was notified,
+ * and handles all samples in the ring, in order.
+ * @param[in] ctx : TP context object. See #tp_t structure definition for
+ * detailed explanation.
+ * @return @li @c 0 - OK,
+ *         @li @c 4 - Touch coordinates are out of range,
+ *         @li @c 5 - Number of pressed touches is out of range.
+ * See #tp_err_t structure definition for detailed explanation.
+ */
+static tp_err_t
+tp_process_samples( tp_t * ctx );
+
 void
 tp_cfg_setup( tp_cfg_t * cfg )
 {
@@ -131,11 +196,24 @@ tp_init( tp_t * ctx, tp_cfg_t * cfg, tp_drv_t * drv, void * drv_ctx )
 
     ctx->press_callback_f     = NULL;
     ctx->gesture_callback_f   = NULL;
+    ctx->touch_callback_f     = NULL;
     ctx->start_pos            = cfg->start_pos;
     ctx->curr_pos             = cfg->start_pos;
     ctx->rotate               = TP_ROTATE_0;
     ctx->release              = TP_RELEASE_DET;
     ctx->touch_prev.n_touches = 0;
+    ctx->samples              = NULL;
+    ctx->n_samples            = 0;
+    ctx->sample_head          = 0;
+    ctx->sample_tail          = 0;
+    ctx->irq_pending          = 0;
+    ctx->irq_mode             = TP_IRQ_MODE_DEFERRED;
+    ctx->touch_active         = 0;
+    ctx->timestamp_f          = NULL;
+    ctx->sample_timestamp     = 0;
+    ctx->samples_dropped      = 0;
+    ctx->filter_cfg           = NULL;
+    ctx->filter_ids           = 0;
 
     for ( idx = 0; idx < TP_N_TOUCHES_MAX; idx++ )
     {
@@ -176,6 +254,12 @@ tp_gesture_callback_setup( tp_t * ctx, tp_gesture_callback_t cb )
     ctx->gesture_callback_f = cb;
 }
 
+void
+tp_touch_callback_setup( tp_t * ctx, tp_touch_callback_t cb )
+{
+    ctx->touch_callback_f = cb;
+}
+
 void
 tp_rotate( tp_t * ctx, tp_rotate_t rotate )
 {
@@ -239,12 +323,216 @@ tp_press_detect( tp_t * ctx )
 
 tp_err_t
 tp_press_coordinates( tp_t * ctx, tp_touch_item_t * touch_item )
+{
+    ctx->tp_drv->tp_press_coordinates_f( ctx->tp_drv_ctx, &ctx->touch );
+
+    return tp_update_coordinates( ctx, touch_item );
+}
+
+void
+tp_gesture( tp_t * ctx, tp_event_t * event )
+{
+    ctx->tp_drv->tp_gesture_f( ctx->tp_drv_ctx, &ctx->gesture );
+
+    tp_update_gesture( ctx, event );
+}
+
+tp_err_t
+tp_process( tp_t * ctx )
+{
+    tp_err_t status;
+    tp_event_t press_det;
+
+    if ( ctx->samples != NULL )
+    {
+        return tp_process_samples( ctx );
+    }
+
+    status = ctx->tp_drv->tp_process_f( ctx->tp_drv_ctx );
+
+    if ( status != TP_OK )
+    {
+        return status;
+    }
+
+    press_det = tp_press_detect( ctx );
+
+    if ( TP_EVENT_PRESS_DET == press_det )
+    {
+        ctx->tp_drv->tp_press_coordinates_f( ctx->tp_drv_ctx, &ctx->touch );
+        ctx->tp_drv->tp_gesture_f( ctx->tp_drv_ctx, &ctx->gesture );
+    }
+
+    return tp_handle_touch( ctx, press_det );
+}
+
+void
+tp_filter_setup( tp_t * ctx, tp_filter_cfg_t * cfg )
+{
+    if ( cfg != NULL )
+    {
+        tp_filter_cfg_update( cfg );
+    }
+
+    ctx->filter_cfg = cfg;
+    ctx->filter_ids = 0;
+}
+
+tp_err_t
+tp_irq_setup( tp_t * ctx, tp_sample_t * samples, uint8_t n_samples,
+              tp_irq_mode_t mode, tp_timestamp_t timestamp )
+{
+    if ( ( samples != NULL ) && ( n_samples < 3 ) )
+    {
+        return TP_ERR_N_DATA;
+    }
+
+    ctx->samples          = samples;
+    ctx->n_samples        = n_samples;
+    ctx->sample_head      = 0;
+    ctx->sample_tail      = 0;
+    ctx->irq_mode         = mode;
+    ctx->timestamp_f      = timestamp;
+    ctx->sample_timestamp = 0;
+    ctx->samples_dropped  = 0;
+
+    // The first call of tp_process reads the controller, in case it is
+    // already touched.
+    ctx->irq_pending  = 1;
+    ctx->touch_active = 0;
+
+    return TP_OK;
+}
+
+void
+tp_irq_notify( tp_t * ctx )
+{
+    ctx->irq_pending = 1;
+}
+
+tp_err_t
+tp_irq_sample( tp_t * ctx )
+{
+    tp_err_t status;
+    tp_sample_t * sample;
+    uint8_t next;
+    uint8_t after;
+
+    next = ctx->sample_head + 1;
+
+    if ( next == ctx->n_samples )
+    {
+        next = 0;
+    }
+
+    after = next + 1;
+
+    if ( after == ctx->n_samples )
+    {
+        after = 0;
+    }
+
+    // Ring is full and its newest sample is a release, as only a release
+    // takes the last entry, so nothing newer is needed until it's handled.
+    if ( next == ctx->sample_tail )
+    {
+        ctx->samples_dropped++;
+
+        return TP_OK;
+    }
+
+    status = ctx->tp_drv->tp_process_f( ctx->tp_drv_ctx );
+
+    if ( status != TP_OK )
+    {
+        return status;
+    }
+
+    sample = &ctx->samples[ ctx->sample_head ];
+
+    sample->timestamp = ( ctx->timestamp_f != NULL ) ? ctx->timestamp_f( ) : 0;
+    sample->press_det = tp_press_detect( ctx );
+    sample->touch.n_touches = 0;
+    sample->gesture = TP_EVENT_GEST_NONE;
+
+    if ( TP_EVENT_PRESS_DET == sample->press_det )
+    {
+        ctx->tp_drv->tp_press_coordinates_f( ctx->tp_drv_ctx, &sample->touch );
+        ctx->tp_drv->tp_gesture_f( ctx->tp_drv_ctx, &sample->gesture );
+    }
+
+    ctx->touch_active = ( TP_EVENT_PRESS_DET == sample->press_det );
+
+    // Last entry is kept for the release, so that stored presses are always
+    // released; newer presses are dropped until tp_process catches up.
+    if ( ( after == ctx->sample_tail ) && ctx->touch_active )
+    {
+        ctx->samples_dropped++;
+
+        return TP_OK;
+    }
+
+    // Sample is complete before it's published to tp_process.
+    ctx->sample_head = next;
+
+    return TP_OK;
+}
+
+uint32_t
+tp_get_sample_timestamp( tp_t * ctx )
+{
+    return ctx->sample_timestamp;
+}
+
+static void
+tp_filter_coordinates( tp_t * ctx )
+{
+    tp_touch_coord_t * point;
+    uint8_t ids = 0;
+    uint8_t idx;
+
+    if ( ctx->filter_cfg == NULL )
+    {
+        return;
+    }
+
+    for ( idx = 0; idx < ctx->touch.n_touches; idx++ )
+    {
+        point = &ctx->touch.point[ idx ];
+
+        // Points out of range are left as they are, to be reported as error.
+        if ( ( point->id >= TP_N_TOUCHES_MAX ) ||
+             ( point->coord_x > ctx->coord_x_max ) ||
+             ( point->coord_y > ctx->coord_y_max ) )
+        {
+            continue;
+        }
+
+        if ( ctx->filter_ids & ( 1 << point->id ) )
+        {
+            tp_filter_update( ctx->filter_cfg, &ctx->filter[ point->id ],
+                              &point->coord_x, &point->coord_y,
+                              ctx->coord_x_max, ctx->coord_y_max );
+        }
+        else
+        {
+            tp_filter_reset( &ctx->filter[ point->id ], point->coord_x, point->coord_y );
+        }
+
+        ids |= 1 << point->id;
+    }
+
+    ctx->filter_ids = ids;
+}
+
+static tp_err_t
+tp_update_coordinates( tp_t * ctx, tp_touch_item_t * touch_item )
 {
     uint8_t idx;
     uint8_t state = 0;
     tp_err_t status = TP_OK;
 
-    ctx->tp_drv->tp_press_coordinates_f( ctx->tp_drv_ctx, &ctx->touch );
+    tp_filter_coordinates( ctx );
 
     for ( idx = 0; idx < ctx->touch.n_touches; idx++ )
     {
@@ -329,13 +617,11 @@ tp_press_coordinates( tp_t * ctx, tp_touch_item_t * touch_item )
     return status;
 }
 
-void
-tp_gesture( tp_t * ctx, tp_event_t * event )
+static void
+tp_update_gesture( tp_t * ctx, tp_event_t * event )
 {
     uint8_t idx;
 
-    ctx->tp_drv->tp_gesture_f( ctx->tp_drv_ctx, &ctx->gesture );
-
     if ( ( ctx->gesture == TP_EVENT_GEST_NONE ) ||
          ( ctx->gesture == TP_EVENT_GEST_ZOOM_IN ) ||
          ( ctx->gesture == TP_EVENT_GEST_ZOOM_OUT ) )
@@ -396,24 +682,17 @@ tp_gesture( tp_t * ctx, tp_event_t * event )
     }
 }
 
-tp_err_t
-tp_process( tp_t * ctx )
+static tp_err_t
+tp_handle_touch( tp_t * ctx, tp_event_t press_det )
 {
-    tp_err_t status;
+    tp_err_t status = TP_OK;
     tp_touch_item_t touch_item;
 
-    status = ctx->tp_drv->tp_process_f( ctx->tp_drv_ctx );
-
-    if ( status != TP_OK )
-    {
-        return status;
-    }
-
-    if ( TP_EVENT_PRESS_DET == tp_press_detect( ctx ) )
+    if ( TP_EVENT_PRESS_DET == press_det )
     {
         uint8_t idx;
 
-        status = tp_press_coordinates( ctx, &touch_item );
+        status = tp_update_coordinates( ctx, &touch_item );
 
         for ( idx = 0; idx < touch_item.n_touches; idx++ )
         {
@@ -432,22 +711,19 @@ tp_process( tp_t * ctx )
 
         if ( ctx->touch_prev.n_touches > touch_item.n_touches )
         {
-            uint8_t idx2;
-            uint8_t state;
+            uint8_t touched = 0;
 
-            for ( idx = 0; idx < ctx->touch_prev.n_touches; idx++ )
+            // IDs still touched are collected once, so each previous point is
+            // checked in a single step.
+            for ( idx = 0; idx < touch_item.n_touches; idx++ )
             {
-                state = 0;
-
-                for ( idx2 = 0; idx2 < touch_item.n_touches; idx2++ )
-                {
-                    if ( ctx->touch_prev_mirr.point[ idx ].id == ctx->touch_prev.point[ idx2 ].id )
-                    {
-                        state = 1;
-                    }
-                }
+                touched |= 1 << ctx->touch_prev.point[ idx ].id;
+            }
 
-                if ( ( ctx->press_callback_f != NULL ) && ( state == 0 ) )
+            for ( idx = 0; idx < ctx->touch_prev.n_touches; idx++ )
+            {
+                if ( ( ctx->press_callback_f != NULL ) &&
+                     !( touched & ( 1 << ctx->touch_prev_mirr.point[ idx ].id ) ) )
                 {
                     ctx->press_callback_f( TP_EVENT_PRESS_UP,
                                            ctx->touch_prev_mirr.point[ idx ].coord_x,
@@ -459,11 +735,16 @@ tp_process( tp_t * ctx )
 
         ctx->touch_prev.n_touches = touch_item.n_touches;
 
+        if ( ( status == TP_OK ) && ( ctx->touch_callback_f != NULL ) )
+        {
+            ctx->touch_callback_f( &touch_item );
+        }
+
         if ( status == TP_OK )
         {
             tp_event_t event;
 
-            tp_gesture( ctx, &event );
+            tp_update_gesture( ctx, &event );
 
             if ( event != TP_EVENT_GEST_NONE )
             {
@@ -482,6 +763,11 @@ tp_process( tp_t * ctx )
 
         for ( idx = 0; idx < ctx->touch_prev.n_touches; idx++ )
         {
+            // Released points are reported where they were last touched.
+            tp_get_rotated_coord( ctx, &touch_item, &ctx->touch_prev, idx );
+
+            touch_item.point[ idx ].id = ctx->touch_prev.point[ idx ].id;
+
             if ( ctx->press_callback_f != NULL )
             {
                 ctx->press_callback_f( TP_EVENT_PRESS_UP,
@@ -502,6 +788,60 @@ tp_process( tp_t * ctx )
         ctx->gesture_prev         = TP_EVENT_GEST_NONE;
         ctx->release              = TP_RELEASE_DET;
         ctx->touch_prev.n_touches = 0;
+        ctx->filter_ids           = 0;
+
+        if ( ctx->touch_callback_f != NULL )
+        {
+            touch_item.n_touches = 0;
+
+            ctx->touch_callback_f( &touch_item );
+        }
+    }
+
+    return status;
+}
+
+static tp_err_t
+tp_process_samples( tp_t * ctx )
+{
+    tp_err_t status = TP_OK;
+    tp_sample_t * sample;
+    uint8_t tail;
+
+    // Deferred interrupt: the controller is read after it reports a touch,
+    // and then every time until the touch is released.
+    if ( ( ctx->irq_mode == TP_IRQ_MODE_DEFERRED ) &&
+         ( ctx->irq_pending || ctx->touch_active ) )
+    {
+        ctx->irq_pending = 0;
+
+        status = tp_irq_sample( ctx );
+    }
+
+    tail = ctx->sample_tail;
+
+    while ( tail != ctx->sample_head )
+    {
+        sample = &ctx->samples[ tail ];
+
+        ctx->touch            = sample->touch;
+        ctx->gesture          = sample->gesture;
+        ctx->sample_timestamp = sample->timestamp;
+
+        if ( tp_handle_touch( ctx, sample->press_det ) != TP_OK )
+        {
+            status = TP_ERR_PRESS_COORD;
+        }
+
+        tail++;
+
+        if ( tail == ctx->n_samples )
+        {
+            tail = 0;
+        }
+
+        // Entry is released only after it's processed.
+        ctx->sample_tail = tail;
     }
 
     return status;
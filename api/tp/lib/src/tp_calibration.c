@@ -0,0 +1,317 @@
+/****************************************************************************
+**
+** Copyright (C) 2023 MikroElektronika d.o.o.
+** Contact: https://www.mikroe.com/contact
+**
+** This file is part of the mikroSDK package
+**
+** Commercial License Usage
+**
+** Licensees holding valid commercial NECTO compilers AI licenses may use this
+** file in accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The MikroElektronika Company.
+** For licensing terms and conditions see
+** https://www.mikroe.com/legal/software-license-agreement.
+** For further information use the contact form at
+** https://www.mikroe.com/contact.
+**
+**
+** GNU Lesser General Public License Usage
+**
+** Alternatively, this file may be used for
+** non-commercial projects under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** The above copyright notice and this permission notice shall be
+** included in all copies or substantial portions of the Software.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+** OF MERCHANTABILITY, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED
+** TO THE WARRANTIES FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+** IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+** DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT
+** OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+** OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+**
+****************************************************************************/
+
+/*!
+ * @file tp_calibration.c
+ * @brief Touch Panel Calibration Library.
+ */
+
+#include "tp_calibration.h"
+
+/**
+ * @brief Touch Panel Calibration Private Macros.
+ * @details Specified macros for internal usage.
+ */
+#define TP_CALIBRATION_ONE         ( ( int32_t )1 << TP_CALIBRATION_FRACTION_BITS )
+#define TP_CALIBRATION_HALF        ( TP_CALIBRATION_ONE >> 1 )
+#define TP_CALIBRATION_DATA_MAGIC  0xCA
+#define TP_CALIBRATION_COEFS       6
+#define TP_CALIBRATION_COLLINEAR   0.001f
+
+/**
+ * @brief Touch Panel Calibration Fixed Point Conversion Function.
+ * @details This function converts the coefficient to Q16 fixed point format,
+ * rounded to the nearest value.
+ * @param[in] value : Coefficient.
+ * @return Coefficient in fixed point format.
+ */
+static int32_t
+tp_calibration_to_fixed( float value );
+
+/**
+ * @brief Touch Panel Calibration Coordinate Function.
+ * @details This function converts the transform result to display coordinate,
+ * rounded to the nearest value and clamped to coordinate range.
+ * @param[in] value : Transform result in fixed point format.
+ * @return Display coordinate.
+ */
+static tp_coord_t
+tp_calibration_to_coord( int32_t value );
+
+/**
+ * @brief Touch Panel Calibration Checksum Function.
+ * @details This function computes checksum of the saved calibration data.
+ * @param[in] buffer : Saved calibration data.
+ * @return Checksum.
+ */
+static uint8_t
+tp_calibration_checksum( const uint8_t * buffer );
+
+tp_err_t
+tp_calibration_compute( tp_calibration_t * cal, const tp_calibration_point_t * points,
+                        uint8_t n_points )
+{
+    float mean_rx = 0, mean_ry = 0, mean_x = 0, mean_y = 0;
+    float sxx = 0, sxy = 0, syy = 0, sxu = 0, syu = 0, sxv = 0, syv = 0;
+    float dx, dy, du, dv, det;
+    float a, b, d, e;
+    uint8_t cnt;
+
+    if ( TP_CALIBRATION_POINTS_MIN > n_points )
+    {
+        return TP_ERR_PRESS_COORD;
+    }
+
+    for ( cnt = 0; cnt < n_points; cnt++ )
+    {
+        mean_rx += points[ cnt ].raw_x;
+        mean_ry += points[ cnt ].raw_y;
+        mean_x += points[ cnt ].x;
+        mean_y += points[ cnt ].y;
+    }
+
+    mean_rx /= n_points;
+    mean_ry /= n_points;
+    mean_x /= n_points;
+    mean_y /= n_points;
+
+    // Sums are taken around the means to keep float precision with 12-bit
+    // and wider raw values.
+    for ( cnt = 0; cnt < n_points; cnt++ )
+    {
+        dx = points[ cnt ].raw_x - mean_rx;
+        dy = points[ cnt ].raw_y - mean_ry;
+        du = points[ cnt ].x - mean_x;
+        dv = points[ cnt ].y - mean_y;
+
+        sxx += dx * dx;
+        sxy += dx * dy;
+        syy += dy * dy;
+        sxu += dx * du;
+        syu += dy * du;
+        sxv += dx * dv;
+        syv += dy * dv;
+    }
+
+    det = sxx * syy - sxy * sxy;
+
+    if ( det <= TP_CALIBRATION_COLLINEAR * sxx * syy )
+    {
+        return TP_ERR_PRESS_COORD;
+    }
+
+    a = ( sxu * syy - syu * sxy ) / det;
+    b = ( syu * sxx - sxu * sxy ) / det;
+    d = ( sxv * syy - syv * sxy ) / det;
+    e = ( syv * sxx - sxv * sxy ) / det;
+
+    cal->a = tp_calibration_to_fixed( a );
+    cal->b = tp_calibration_to_fixed( b );
+    cal->c = tp_calibration_to_fixed( mean_x - a * mean_rx - b * mean_ry );
+    cal->d = tp_calibration_to_fixed( d );
+    cal->e = tp_calibration_to_fixed( e );
+    cal->f = tp_calibration_to_fixed( mean_y - d * mean_rx - e * mean_ry );
+
+    return TP_OK;
+}
+
+tp_err_t
+tp_calibration_from_range( tp_calibration_t * cal, uint16_t min_x, uint16_t max_x,
+                           uint16_t min_y, uint16_t max_y, uint16_t width, uint16_t height )
+{
+    if ( ( max_x <= min_x ) || ( max_y <= min_y ) )
+    {
+        return TP_ERR_PRESS_COORD;
+    }
+
+    cal->a = ( ( int32_t )width << TP_CALIBRATION_FRACTION_BITS ) / ( max_x - min_x );
+    cal->b = 0;
+    cal->c = -cal->a * min_x;
+    cal->d = 0;
+    cal->e = ( ( int32_t )height << TP_CALIBRATION_FRACTION_BITS ) / ( max_y - min_y );
+    cal->f = -cal->e * min_y;
+
+    return TP_OK;
+}
+
+void
+tp_calibration_swap_axes( tp_calibration_t * cal )
+{
+    int32_t tmp;
+
+    tmp = cal->a;
+    cal->a = cal->b;
+    cal->b = tmp;
+
+    tmp = cal->d;
+    cal->d = cal->e;
+    cal->e = tmp;
+}
+
+void
+tp_calibration_mirror( tp_calibration_t * cal, uint16_t width, uint16_t height )
+{
+    if ( width )
+    {
+        cal->a = -cal->a;
+        cal->b = -cal->b;
+        cal->c = ( ( int32_t )width << TP_CALIBRATION_FRACTION_BITS ) - cal->c;
+    }
+
+    if ( height )
+    {
+        cal->d = -cal->d;
+        cal->e = -cal->e;
+        cal->f = ( ( int32_t )height << TP_CALIBRATION_FRACTION_BITS ) - cal->f;
+    }
+}
+
+void
+tp_calibration_apply( const tp_calibration_t * cal, uint16_t raw_x, uint16_t raw_y,
+                      tp_coord_t * x, tp_coord_t * y )
+{
+    *x = tp_calibration_to_coord( cal->a * ( int32_t )raw_x + cal->b * ( int32_t )raw_y + cal->c );
+    *y = tp_calibration_to_coord( cal->d * ( int32_t )raw_x + cal->e * ( int32_t )raw_y + cal->f );
+}
+
+void
+tp_calibration_save( const tp_calibration_t * cal, uint8_t * buffer )
+{
+    int32_t coefs[ TP_CALIBRATION_COEFS ];
+    uint32_t coef;
+    uint8_t cnt;
+    uint8_t * ptr = buffer;
+
+    coefs[ 0 ] = cal->a;
+    coefs[ 1 ] = cal->b;
+    coefs[ 2 ] = cal->c;
+    coefs[ 3 ] = cal->d;
+    coefs[ 4 ] = cal->e;
+    coefs[ 5 ] = cal->f;
+
+    *ptr++ = TP_CALIBRATION_DATA_MAGIC;
+
+    // Little endian, regardless of the MCU.
+    for ( cnt = 0; cnt < TP_CALIBRATION_COEFS; cnt++ )
+    {
+        coef = ( uint32_t )coefs[ cnt ];
+        *ptr++ = coef;
+        *ptr++ = coef >> 8;
+        *ptr++ = coef >> 16;
+        *ptr++ = coef >> 24;
+    }
+
+    *ptr = tp_calibration_checksum( buffer );
+}
+
+tp_err_t
+tp_calibration_load( tp_calibration_t * cal, const uint8_t * buffer )
+{
+    int32_t coefs[ TP_CALIBRATION_COEFS ];
+    uint8_t cnt;
+    const uint8_t * ptr = buffer + 1;
+
+    if ( ( TP_CALIBRATION_DATA_MAGIC != buffer[ 0 ] ) ||
+         ( tp_calibration_checksum( buffer ) != buffer[ TP_CALIBRATION_DATA_SIZE - 1 ] ) )
+    {
+        return TP_ERR_SIZE;
+    }
+
+    for ( cnt = 0; cnt < TP_CALIBRATION_COEFS; cnt++ )
+    {
+        coefs[ cnt ] = ( int32_t )( ( uint32_t )ptr[ 0 ] |
+                                    ( ( uint32_t )ptr[ 1 ] << 8 ) |
+                                    ( ( uint32_t )ptr[ 2 ] << 16 ) |
+                                    ( ( uint32_t )ptr[ 3 ] << 24 ) );
+        ptr += 4;
+    }
+
+    cal->a = coefs[ 0 ];
+    cal->b = coefs[ 1 ];
+    cal->c = coefs[ 2 ];
+    cal->d = coefs[ 3 ];
+    cal->e = coefs[ 4 ];
+    cal->f = coefs[ 5 ];
+
+    return TP_OK;
+}
+
+static int32_t
+tp_calibration_to_fixed( float value )
+{
+    value *= TP_CALIBRATION_ONE;
+
+    return ( int32_t )( ( value < 0 ) ? ( value - 0.5f ) : ( value + 0.5f ) );
+}
+
+static tp_coord_t
+tp_calibration_to_coord( int32_t value )
+{
+    value += TP_CALIBRATION_HALF;
+
+    if ( value < 0 )
+    {
+        return 0;
+    }
+
+    value >>= TP_CALIBRATION_FRACTION_BITS;
+
+    if ( value > 0xFFFF )
+    {
+        return 0xFFFF;
+    }
+
+    return value;
+}
+
+static uint8_t
+tp_calibration_checksum( const uint8_t * buffer )
+{
+    uint8_t sum = 0;
+    uint8_t cnt;
+
+    for ( cnt = 0; cnt < TP_CALIBRATION_DATA_SIZE - 1; cnt++ )
+    {
+        sum += buffer[ cnt ];
+    }
+
+    return ~sum;
+}
+
+// ------------------------------------------------------------------------ END
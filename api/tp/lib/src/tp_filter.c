@@ -0,0 +1,168 @@
+/****************************************************************************
+**
+** Copyright (C) 2023 MikroElektronika d.o.o.
+** Contact: https://www.mikroe.com/contact
+**
+** This file is part of the mikroSDK package
+**
+** Commercial License Usage
+**
+** Licensees holding valid commercial NECTO compilers AI licenses may use this
+** file in accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The MikroElektronika Company.
+** For licensing terms and conditions see
+** https://www.mikroe.com/legal/software-license-agreement.
+** For further information use the contact form at
+** https://www.mikroe.com/contact.
+**
+**
+** GNU Lesser General Public License Usage
+**
+** Alternatively, this file may be used for
+** non-commercial projects under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** The above copyright notice and this permission notice shall be
+** included in all copies or substantial portions of the Software.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+** OF MERCHANTABILITY, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED
+** TO THE WARRANTIES FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+** IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+** DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT
+** OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+** OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+**
+****************************************************************************/
+
+/*!
+ * @file tp_filter.c
+ * @brief Touch Panel Filter Library.
+ */
+
+#include "tp_filter.h"
+
+/**
+ * @brief Touch Panel Filter Private Macros.
+ * @details Specified macros for internal usage.
+ */
+#define TP_FILTER_GAIN_HALF      ( ( int32_t )1 << ( TP_FILTER_GAIN_BITS - 1 ) )
+#define TP_FILTER_POSITION_HALF  ( ( int32_t )1 << ( TP_FILTER_POSITION_BITS - 1 ) )
+
+/**
+ * @brief Touch Panel Filter Gain Function.
+ * @details This function multiplies the value by Q8 gain, rounded to the
+ * nearest value.
+ * @param[in] value : Value.
+ * @param[in] gain : Gain in Q8 format.
+ * @return Value multiplied by gain.
+ */
+static int32_t
+tp_filter_gain( int32_t value, uint16_t gain );
+
+/**
+ * @brief Touch Panel Filter Axis Function.
+ * @details This function updates the filter state along one axis with the
+ * reported coordinate and returns the predicted coordinate.
+ * @param[in] cfg : Filter configuration object. See #tp_filter_cfg_t
+ * structure definition for detailed explanation.
+ * @param[in,out] axis : Filter axis state. See #tp_filter_axis_t structure
+ * definition for detailed explanation.
+ * @param[in] coord : Reported coordinate.
+ * @param[in] coord_max : Maximal coordinate.
+ * @return Filtered and predicted coordinate.
+ */
+static uint16_t
+tp_filter_axis( const tp_filter_cfg_t * cfg, tp_filter_axis_t * axis,
+                uint16_t coord, uint16_t coord_max );
+
+void
+tp_filter_cfg_setup( tp_filter_cfg_t * cfg )
+{
+    cfg->alpha_min  = 32;
+    cfg->alpha_max  = 230;
+    cfg->speed_max  = 12;
+    cfg->beta       = 24;
+    cfg->prediction = 256;
+
+    tp_filter_cfg_update( cfg );
+}
+
+void
+tp_filter_cfg_update( tp_filter_cfg_t * cfg )
+{
+    cfg->alpha_slope = ( ( uint32_t )( cfg->alpha_max - cfg->alpha_min ) << TP_FILTER_GAIN_BITS ) /
+                       cfg->speed_max;
+}
+
+void
+tp_filter_reset( tp_filter_point_t * point, uint16_t x, uint16_t y )
+{
+    point->x.position = ( int32_t )x << TP_FILTER_POSITION_BITS;
+    point->x.velocity = 0;
+    point->y.position = ( int32_t )y << TP_FILTER_POSITION_BITS;
+    point->y.velocity = 0;
+}
+
+void
+tp_filter_update( const tp_filter_cfg_t * cfg, tp_filter_point_t * point,
+                  uint16_t * x, uint16_t * y, uint16_t x_max, uint16_t y_max )
+{
+    *x = tp_filter_axis( cfg, &point->x, *x, x_max );
+    *y = tp_filter_axis( cfg, &point->y, *y, y_max );
+}
+
+static int32_t
+tp_filter_gain( int32_t value, uint16_t gain )
+{
+    return ( value * gain + TP_FILTER_GAIN_HALF ) >> TP_FILTER_GAIN_BITS;
+}
+
+static uint16_t
+tp_filter_axis( const tp_filter_cfg_t * cfg, tp_filter_axis_t * axis,
+                uint16_t coord, uint16_t coord_max )
+{
+    int32_t predicted;
+    int32_t residual;
+    uint32_t speed;
+    uint16_t alpha;
+
+    // Residual is the difference between the report and the position
+    // expected from the previous velocity.
+    predicted = axis->position + axis->velocity;
+    residual  = ( ( int32_t )coord << TP_FILTER_POSITION_BITS ) - predicted;
+
+    speed = ( uint32_t )( ( residual < 0 ) ? -residual : residual ) >> TP_FILTER_POSITION_BITS;
+
+    if ( speed >= cfg->speed_max )
+    {
+        alpha = cfg->alpha_max;
+    }
+    else
+    {
+        alpha = cfg->alpha_min +
+                ( uint16_t )( ( cfg->alpha_slope * speed ) >> TP_FILTER_GAIN_BITS );
+    }
+
+    axis->position = predicted + tp_filter_gain( residual, alpha );
+    axis->velocity = axis->velocity + tp_filter_gain( residual, cfg->beta );
+
+    predicted = axis->position + tp_filter_gain( axis->velocity, cfg->prediction );
+    predicted = ( predicted + TP_FILTER_POSITION_HALF ) >> TP_FILTER_POSITION_BITS;
+
+    if ( predicted < 0 )
+    {
+        return 0;
+    }
+
+    if ( predicted > coord_max )
+    {
+        return coord_max;
+    }
+
+    return ( uint16_t )predicted;
+}
+
+// ------------------------------------------------------------------------ END
@@ -84,6 +84,7 @@ tp_err_t tp_init( tp_t *ctx, tp_cfg_t *cfg, tp_drv_t *drv, void *drv_ctx ) {
     ctx->curr_pos = cfg->start_pos;
     ctx->rotate = TP_ROTATE_0;
     ctx->release = TP_RELEASE_DET;
+    ctx->filter_cfg = NULL;
 
     ctx->touch_prev.coord_x = TP_PRESS_COORD_DEFAULT;
     ctx->touch_prev.coord_y = TP_PRESS_COORD_DEFAULT;
@@ -110,6 +111,14 @@ void tp_press_callback_setup( tp_t *ctx, tp_press_callback_t cb ) {
     ctx->press_callback_f = cb;
 }
 
+void tp_filter_setup( tp_t *ctx, tp_filter_cfg_t *cfg ) {
+    if ( cfg ) {
+        tp_filter_cfg_update( cfg );
+    }
+
+    ctx->filter_cfg = cfg;
+}
+
 void tp_rotate( tp_t *ctx, tp_rotate_t rotate ) {
     if ( rotate == ctx->rotate ) {
         return;
@@ -163,6 +172,19 @@ tp_err_t tp_press_coordinates( tp_t *ctx, tp_touch_coord_t *touch_item )
 
     ctx->tp_drv->tp_press_coordinates_f( ctx->tp_drv_ctx, &ctx->touch );
 
+    // Filter starts at the first point of the touch.
+    if ( ( NULL != ctx->filter_cfg ) &&
+         ( ctx->touch.coord_x <= ctx->coord_x_max ) &&
+         ( ctx->touch.coord_y <= ctx->coord_y_max ) ) {
+        if ( ctx->release ) {
+            tp_filter_reset( &ctx->filter, ctx->touch.coord_x, ctx->touch.coord_y );
+        } else {
+            tp_filter_update( ctx->filter_cfg, &ctx->filter,
+                              &ctx->touch.coord_x, &ctx->touch.coord_y,
+                              ctx->coord_x_max, ctx->coord_y_max );
+        }
+    }
+
     if ( TP_EVENT_PRESS_UP == ctx->touch.event ) {
         state = 1;
     }
@@ -0,0 +1,547 @@
+/****************************************************************************
+**
+** Copyright (C) 2023 MikroElektronika d.o.o.
+** Contact: https://www.mikroe.com/contact
+**
+** This file is part of the mikroSDK package
+**
+** Commercial License Usage
+**
+** Licensees holding valid commercial NECTO compilers AI licenses may use this
+** file in accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The MikroElektronika Company.
+** For licensing terms and conditions see
+** https://www.mikroe.com/legal/software-license-agreement.
+** For further information use the contact form at
+** https://www.mikroe.com/contact.
+**
+**
+** GNU Lesser General Public License Usage
+**
+** Alternatively, this file may be used for
+** non-commercial projects under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** The above copyright notice and this permission notice shall be
+** included in all copies or substantial portions of the Software.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+** OF MERCHANTABILITY, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED
+** TO THE WARRANTIES FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+** IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+** DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT
+** OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+** OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+**
+****************************************************************************/
+
+/*!
+ * @file tp_tracker.c
+ * @brief Touch Panel Tracker Library.
+ */
+
+#include "tp_tracker.h"
+
+/**
+ * @brief Touch Panel Tracker Private Macros.
+ * @details Specified macros for internal usage.
+ */
+#define TP_TRACKER_SIN_ONE          256
+#define TP_TRACKER_ANGLE_MIN        1
+#define TP_TRACKER_ANGLE_MAX        89
+#define TP_TRACKER_VELOCITY_TIME    1000
+
+/**
+ * @brief Touch Panel Tracker Absolute Value Function.
+ * @details This function returns absolute value of the difference.
+ * @param[in] value : Difference.
+ * @return Absolute value.
+ */
+static uint32_t
+tp_tracker_abs( int32_t value );
+
+/**
+ * @brief Touch Panel Tracker Square Root Function.
+ * @details This function computes integer square root, in a fixed number of
+ * steps.
+ * @param[in] value : Value.
+ * @return Square root, rounded down.
+ */
+static uint16_t
+tp_tracker_sqrt( uint32_t value );
+
+/**
+ * @brief Touch Panel Tracker Match Function.
+ * @details This function associates the touched points with the tracked
+ * points, nearest pairs first, and updates their coordinates, velocities and
+ * events. Points which are not associated are released or pressed.
+ * @param[in,out] tracker : Tracker context object. See #tp_tracker_t
+ * structure definition for detailed explanation.
+ * @param[in] points : Touched points.
+ * @param[in] n_points : Number of touched points.
+ * @param[in] timestamp : Time of reading the points.
+ * @return Nothing.
+ */
+static void
+tp_tracker_match( tp_tracker_t * tracker, const tp_touch_coord_t * points,
+                  uint8_t n_points, uint32_t timestamp );
+
+/**
+ * @brief Touch Panel Tracker Single Touch Gesture Function.
+ * @details This function recognizes long press of the touched point, or tap,
+ * double tap and swipe of the released point.
+ * @param[in,out] tracker : Tracker context object. See #tp_tracker_t
+ * structure definition for detailed explanation.
+ * @param[in] timestamp : Time of reading the points.
+ * @return Recognized gesture.
+ */
+static tp_tracker_gesture_t
+tp_tracker_single( tp_tracker_t * tracker, uint32_t timestamp );
+
+/**
+ * @brief Touch Panel Tracker Two Touches Gesture Function.
+ * @details This function recognizes zoom and rotation of the first two touched
+ * points, relative to their reference position. Reference is moved to the
+ * current position after each recognized gesture.
+ * @param[in,out] tracker : Tracker context object. See #tp_tracker_t
+ * structure definition for detailed explanation.
+ * @return Recognized gesture.
+ */
+static tp_tracker_gesture_t
+tp_tracker_pair( tp_tracker_t * tracker );
+
+void
+tp_tracker_cfg_setup( tp_tracker_cfg_t * cfg )
+{
+    cfg->match_distance  = 60;
+    cfg->tap_distance    = 10;
+    cfg->tap_time        = 250;
+    cfg->double_tap_time = 300;
+    cfg->long_press_time = 800;
+    cfg->swipe_distance  = 50;
+    cfg->swipe_time      = 400;
+    cfg->zoom_distance   = 20;
+    cfg->rotate_angle    = 15;
+}
+
+void
+tp_tracker_init( tp_tracker_t * tracker, tp_tracker_cfg_t * cfg )
+{
+    int32_t angle;
+    int32_t prod;
+    uint8_t idx;
+
+    tracker->cfg = *cfg;
+
+    angle = cfg->rotate_angle;
+
+    if ( TP_TRACKER_ANGLE_MIN > angle )
+    {
+        angle = TP_TRACKER_ANGLE_MIN;
+    }
+    else if ( TP_TRACKER_ANGLE_MAX < angle )
+    {
+        angle = TP_TRACKER_ANGLE_MAX;
+    }
+
+    // Bhaskara approximation of sine, within 0.002 of the exact value.
+    prod = angle * ( 180 - angle );
+    tracker->rotate_sin = ( int16_t )( ( 4 * TP_TRACKER_SIN_ONE * prod ) /
+                                       ( 40500 - prod ) );
+
+    for ( idx = 0; idx < TP_TRACKER_POINTS_MAX; idx++ )
+    {
+        tracker->point[ idx ].event      = TP_EVENT_PRESS_NOT_DET;
+        tracker->point[ idx ].velocity_x = 0;
+        tracker->point[ idx ].velocity_y = 0;
+    }
+
+    tracker->n_points    = 0;
+    tracker->multi_touch = 0;
+    tracker->long_press  = 0;
+    tracker->tap_pending = 0;
+    tracker->pair_valid  = 0;
+}
+
+tp_tracker_gesture_t
+tp_tracker_update( tp_tracker_t * tracker, const tp_touch_coord_t * points,
+                   uint8_t n_points, uint32_t timestamp )
+{
+    tp_tracker_gesture_t gesture;
+
+    if ( TP_TRACKER_POINTS_MAX < n_points )
+    {
+        n_points = TP_TRACKER_POINTS_MAX;
+    }
+
+    tp_tracker_match( tracker, points, n_points, timestamp );
+
+    if ( 1 < tracker->n_points )
+    {
+        tracker->multi_touch = 1;
+        tracker->tap_pending = 0;
+
+        return tp_tracker_pair( tracker );
+    }
+
+    tracker->pair_valid = 0;
+
+    gesture = TP_TRACKER_GEST_NONE;
+
+    if ( !tracker->multi_touch )
+    {
+        gesture = tp_tracker_single( tracker, timestamp );
+    }
+
+    if ( 0 == tracker->n_points )
+    {
+        tracker->multi_touch = 0;
+        tracker->long_press  = 0;
+    }
+
+    return gesture;
+}
+
+static uint32_t
+tp_tracker_abs( int32_t value )
+{
+    return ( value < 0 ) ? ( uint32_t )( -value ) : ( uint32_t )value;
+}
+
+static uint16_t
+tp_tracker_sqrt( uint32_t value )
+{
+    uint32_t root = 0;
+    uint32_t bit = ( uint32_t )1 << 30;
+
+    while ( bit != 0 )
+    {
+        if ( value >= root + bit )
+        {
+            value -= root + bit;
+            root = ( root >> 1 ) + bit;
+        }
+        else
+        {
+            root >>= 1;
+        }
+
+        bit >>= 2;
+    }
+
+    return ( uint16_t )root;
+}
+
+static void
+tp_tracker_match( tp_tracker_t * tracker, const tp_touch_coord_t * points,
+                  uint8_t n_points, uint32_t timestamp )
+{
+    tp_tracker_point_t * point;
+    uint32_t match = ( uint32_t )tracker->cfg.match_distance * tracker->cfg.match_distance;
+    uint32_t dist, best;
+    uint8_t matched = 0;
+    uint8_t touched = 0;
+    uint8_t best_in = 0, best_tr = 0;
+    uint8_t in, tr;
+    int32_t dx, dy;
+    uint32_t dt;
+
+    // Points released by the previous update are no longer tracked.
+    for ( tr = 0; tr < TP_TRACKER_POINTS_MAX; tr++ )
+    {
+        if ( tracker->point[ tr ].event == TP_EVENT_PRESS_UP )
+        {
+            tracker->point[ tr ].event = TP_EVENT_PRESS_NOT_DET;
+        }
+    }
+
+    // Nearest pair of touched and tracked points is associated first, until
+    // no pair is close enough.
+    for ( ; ; )
+    {
+        best = match + 1;
+
+        for ( in = 0; in < n_points; in++ )
+        {
+            if ( matched & ( 1 << in ) )
+            {
+                continue;
+            }
+
+            for ( tr = 0; tr < TP_TRACKER_POINTS_MAX; tr++ )
+            {
+                point = &tracker->point[ tr ];
+
+                if ( ( point->event == TP_EVENT_PRESS_NOT_DET ) || ( touched & ( 1 << tr ) ) )
+                {
+                    continue;
+                }
+
+                dx = ( int32_t )points[ in ].coord_x - point->coord_x;
+                dy = ( int32_t )points[ in ].coord_y - point->coord_y;
+                dist = ( uint32_t )( dx * dx + dy * dy );
+
+                if ( dist < best )
+                {
+                    best = dist;
+                    best_in = in;
+                    best_tr = tr;
+                }
+            }
+        }
+
+        if ( best > match )
+        {
+            break;
+        }
+
+        point = &tracker->point[ best_tr ];
+
+        dx = ( int32_t )points[ best_in ].coord_x - point->coord_x;
+        dy = ( int32_t )points[ best_in ].coord_y - point->coord_y;
+        dt = timestamp - point->time;
+
+        if ( dt != 0 )
+        {
+            point->velocity_x = ( point->velocity_x + dx * TP_TRACKER_VELOCITY_TIME / ( int32_t )dt ) / 2;
+            point->velocity_y = ( point->velocity_y + dy * TP_TRACKER_VELOCITY_TIME / ( int32_t )dt ) / 2;
+        }
+
+        point->coord_x = points[ best_in ].coord_x;
+        point->coord_y = points[ best_in ].coord_y;
+        point->time    = timestamp;
+        point->event   = ( ( dx != 0 ) || ( dy != 0 ) ) ? TP_EVENT_PRESS_MOVE : TP_EVENT_PRESS_DET;
+
+        matched |= 1 << best_in;
+        touched |= 1 << best_tr;
+    }
+
+    // Tracked points without a touched point are released, keeping their
+    // velocity, e.g. for fling.
+    for ( tr = 0; tr < TP_TRACKER_POINTS_MAX; tr++ )
+    {
+        if ( ( tracker->point[ tr ].event != TP_EVENT_PRESS_NOT_DET ) && !( touched & ( 1 << tr ) ) )
+        {
+            tracker->point[ tr ].event = TP_EVENT_PRESS_UP;
+        }
+    }
+
+    // Remaining touched points are pressed, with the lowest free ID, or the ID
+    // of a point just released if there is no free ID.
+    for ( in = 0; in < n_points; in++ )
+    {
+        if ( matched & ( 1 << in ) )
+        {
+            continue;
+        }
+
+        for ( tr = 0; tr < TP_TRACKER_POINTS_MAX; tr++ )
+        {
+            if ( tracker->point[ tr ].event == TP_EVENT_PRESS_NOT_DET )
+            {
+                break;
+            }
+        }
+
+        if ( TP_TRACKER_POINTS_MAX == tr )
+        {
+            for ( tr = 0; tr < TP_TRACKER_POINTS_MAX; tr++ )
+            {
+                if ( tracker->point[ tr ].event == TP_EVENT_PRESS_UP )
+                {
+                    break;
+                }
+            }
+        }
+
+        point = &tracker->point[ tr ];
+
+        point->coord_x    = points[ in ].coord_x;
+        point->coord_y    = points[ in ].coord_y;
+        point->start_x    = points[ in ].coord_x;
+        point->start_y    = points[ in ].coord_y;
+        point->velocity_x = 0;
+        point->velocity_y = 0;
+        point->start_time = timestamp;
+        point->time       = timestamp;
+        point->event      = TP_EVENT_PRESS_DOWN;
+
+        touched |= 1 << tr;
+    }
+
+    tracker->n_points = n_points;
+}
+
+static tp_tracker_gesture_t
+tp_tracker_single( tp_tracker_t * tracker, uint32_t timestamp )
+{
+    tp_tracker_point_t * point = NULL;
+    uint32_t move_x, move_y, duration;
+    int32_t dx, dy;
+    uint8_t idx;
+
+    // Single touched point, or the single point just released.
+    for ( idx = 0; idx < TP_TRACKER_POINTS_MAX; idx++ )
+    {
+        if ( tracker->point[ idx ].event != TP_EVENT_PRESS_NOT_DET )
+        {
+            point = &tracker->point[ idx ];
+
+            break;
+        }
+    }
+
+    if ( ( point == NULL ) || ( point->event == TP_EVENT_PRESS_DOWN ) )
+    {
+        return TP_TRACKER_GEST_NONE;
+    }
+
+    dx = ( int32_t )point->coord_x - point->start_x;
+    dy = ( int32_t )point->coord_y - point->start_y;
+    move_x = tp_tracker_abs( dx );
+    move_y = tp_tracker_abs( dy );
+    duration = timestamp - point->start_time;
+
+    if ( point->event != TP_EVENT_PRESS_UP )
+    {
+        if ( !tracker->long_press &&
+             ( move_x <= tracker->cfg.tap_distance ) &&
+             ( move_y <= tracker->cfg.tap_distance ) &&
+             ( duration >= tracker->cfg.long_press_time ) )
+        {
+            tracker->long_press  = 1;
+            tracker->tap_pending = 0;
+
+            return TP_TRACKER_GEST_LONG_PRESS;
+        }
+
+        return TP_TRACKER_GEST_NONE;
+    }
+
+    if ( tracker->long_press )
+    {
+        return TP_TRACKER_GEST_NONE;
+    }
+
+    if ( ( duration <= tracker->cfg.swipe_time ) &&
+         ( ( move_x >= tracker->cfg.swipe_distance ) ||
+           ( move_y >= tracker->cfg.swipe_distance ) ) )
+    {
+        tracker->tap_pending = 0;
+
+        if ( move_x >= move_y )
+        {
+            return ( dx < 0 ) ? TP_TRACKER_GEST_LEFT : TP_TRACKER_GEST_RIGHT;
+        }
+
+        return ( dy < 0 ) ? TP_TRACKER_GEST_UP : TP_TRACKER_GEST_DOWN;
+    }
+
+    if ( ( duration > tracker->cfg.tap_time ) ||
+         ( move_x > tracker->cfg.tap_distance ) ||
+         ( move_y > tracker->cfg.tap_distance ) )
+    {
+        return TP_TRACKER_GEST_NONE;
+    }
+
+    if ( tracker->tap_pending &&
+         ( ( timestamp - tracker->tap_time ) <= tracker->cfg.double_tap_time ) &&
+         ( tp_tracker_abs( ( int32_t )point->start_x - tracker->tap_x ) <= tracker->cfg.tap_distance ) &&
+         ( tp_tracker_abs( ( int32_t )point->start_y - tracker->tap_y ) <= tracker->cfg.tap_distance ) )
+    {
+        tracker->tap_pending = 0;
+
+        return TP_TRACKER_GEST_DOUBLE_TAP;
+    }
+
+    tracker->tap_pending = 1;
+    tracker->tap_time    = timestamp;
+    tracker->tap_x       = point->start_x;
+    tracker->tap_y       = point->start_y;
+
+    return TP_TRACKER_GEST_TAP;
+}
+
+static tp_tracker_gesture_t
+tp_tracker_pair( tp_tracker_t * tracker )
+{
+    tp_tracker_point_t * first = NULL;
+    tp_tracker_point_t * second = NULL;
+    uint8_t first_id = 0, second_id = 0;
+    int32_t dx, dy, cross;
+    uint16_t distance;
+    uint8_t idx;
+
+    for ( idx = 0; idx < TP_TRACKER_POINTS_MAX; idx++ )
+    {
+        if ( ( tracker->point[ idx ].event == TP_EVENT_PRESS_NOT_DET ) ||
+             ( tracker->point[ idx ].event == TP_EVENT_PRESS_UP ) )
+        {
+            continue;
+        }
+
+        if ( first == NULL )
+        {
+            first = &tracker->point[ idx ];
+            first_id = idx;
+        }
+        else
+        {
+            second = &tracker->point[ idx ];
+            second_id = idx;
+
+            break;
+        }
+    }
+
+    dx = ( int32_t )second->coord_x - first->coord_x;
+    dy = ( int32_t )second->coord_y - first->coord_y;
+    distance = tp_tracker_sqrt( ( uint32_t )( dx * dx + dy * dy ) );
+
+    if ( !tracker->pair_valid ||
+         ( tracker->pair_id[ 0 ] != first_id ) || ( tracker->pair_id[ 1 ] != second_id ) ||
+         ( first->event == TP_EVENT_PRESS_DOWN ) || ( second->event == TP_EVENT_PRESS_DOWN ) )
+    {
+        tracker->pair_valid = 1;
+        tracker->pair_id[ 0 ] = first_id;
+        tracker->pair_id[ 1 ] = second_id;
+        tracker->pair_dx = ( int16_t )dx;
+        tracker->pair_dy = ( int16_t )dy;
+        tracker->pair_distance = distance;
+
+        return TP_TRACKER_GEST_NONE;
+    }
+
+    // Sine of the rotation is cross product of the vectors divided by their
+    // lengths. Display y axis points down, so positive rotation is clockwise.
+    cross = ( int32_t )tracker->pair_dx * dy - ( int32_t )tracker->pair_dy * dx;
+
+    if ( tp_tracker_abs( ( int32_t )distance - tracker->pair_distance ) >= tracker->cfg.zoom_distance )
+    {
+        tp_tracker_gesture_t gesture = ( distance > tracker->pair_distance ) ?
+                                       TP_TRACKER_GEST_ZOOM_IN : TP_TRACKER_GEST_ZOOM_OUT;
+
+        tracker->pair_dx = ( int16_t )dx;
+        tracker->pair_dy = ( int16_t )dy;
+        tracker->pair_distance = distance;
+
+        return gesture;
+    }
+
+    if ( ( 0 != tracker->pair_distance ) &&
+         ( tp_tracker_abs( cross ) * TP_TRACKER_SIN_ONE >=
+           ( uint32_t )tracker->rotate_sin * tracker->pair_distance * distance ) )
+    {
+        tracker->pair_dx = ( int16_t )dx;
+        tracker->pair_dy = ( int16_t )dy;
+        tracker->pair_distance = distance;
+
+        return ( cross > 0 ) ? TP_TRACKER_GEST_ROTATE_CW : TP_TRACKER_GEST_ROTATE_CCW;
+    }
+
+    return TP_TRACKER_GEST_NONE;
+}
+
+// ------------------------------------------------------------------------ END
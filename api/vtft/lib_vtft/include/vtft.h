@@ -84,6 +84,134 @@ void vtft_set_progress_bar_position(
     vtft_progress_bar *progress_bar,
     vtft_ucoord_t position);
 
+/*!
+ * @brief Sets the caption of the given component.
+ * @details Sets the caption of a label, button, check box or radio button and marks the component for redrawing.
+ * Captions are measured once and the size is kept until the caption is set again, so a caption changed in place
+ * is set again with the same pointer. Size of a label follows its caption.
+ * @param[in] instance Initialized VTFT instance. See #vtft_t structure definition for detailed explanation.
+ *
+ * @param[in,out] component Component whose caption is going to be set. See #vtft_component structure definition for detailed explanation.
+ *
+ * @param[in] caption Caption, kept by the component.
+ *
+ * @return 0 if the component has no caption.
+ *
+ * @b Example
+ */
+vtft_bool_t vtft_set_caption(vtft_t *instance, vtft_component *component, vtft_byte_t * __generic_ptr caption);
+
+/*!
+ * @brief Sets the font of the given component.
+ * @details Sets the font of a label, button, check box, radio button or progress bar and marks the component
+ * for redrawing. Caption is measured again with the new font. Size of a label follows its caption.
+ * @param[in] instance Initialized VTFT instance. See #vtft_t structure definition for detailed explanation.
+ *
+ * @param[in,out] component Component whose font is going to be set. See #vtft_component structure definition for detailed explanation.
+ *
+ * @param[in] font_data Font data, kept by the component.
+ *
+ * @param[in] color Color of the text.
+ *
+ * @return 0 if the component has no caption.
+ *
+ * @b Example
+ */
+vtft_bool_t vtft_set_font(vtft_t *instance, vtft_component *component, const vtft_byte_t *font_data, gl_color_t color);
+
+/*!
+ * @brief Scrolls the given list view.
+ * @details Scrolls the given list view and stops its scrolling after release, if any. Rows which stay visible are moved
+ * by the display driver when it supports copying of the display area, so no other component should cover the list view.
+ * @param[in] instance Initialized VTFT instance. See #vtft_t structure definition for detailed explanation.
+ *
+ * @param[in] list_view List view which is going to be scrolled. See #vtft_list_view structure definition for detailed explanation.
+ *
+ * @param[in] scroll Distance in pixels from the top of the first row to the top of the list view, limited to the rows of the list view.
+ *
+ * @return Nothing.
+ *
+ * @b Example
+ */
+void vtft_set_list_view_scroll(vtft_t *instance, vtft_list_view *list_view, int32_t scroll);
+
+/*!
+ * @brief Sets the number of rows of the given list view.
+ * @details Sets the number of rows of the given list view and redraws it.
+ * @param[in] instance Initialized VTFT instance. See #vtft_t structure definition for detailed explanation.
+ *
+ * @param[in] list_view List view whose rows are going to be set. See #vtft_list_view structure definition for detailed explanation.
+ *
+ * @param[in] row_count Number of rows.
+ *
+ * @return Nothing.
+ *
+ * @b Example
+ */
+void vtft_set_list_view_row_count(vtft_t *instance, vtft_list_view *list_view, uint16_t row_count);
+
+/*!
+ * @brief Redraws a single row of the given list view.
+ * @details Redraws a single row of the given list view, if it is visible. Call it after the row's contents change.
+ * @param[in] instance Initialized VTFT instance. See #vtft_t structure definition for detailed explanation.
+ *
+ * @param[in] list_view List view whose row is going to be redrawn. See #vtft_list_view structure definition for detailed explanation.
+ *
+ * @param[in] row Index of the row.
+ *
+ * @return Nothing.
+ *
+ * @b Example
+ */
+void vtft_redraw_list_view_row(vtft_t *instance, vtft_list_view *list_view, uint16_t row);
+
+/*!
+ * @brief Adds a sample to the given chart.
+ * @details Adds a sample to the given chart. Once all samples of a column are added, only that column is drawn,
+ * replacing the oldest one or, for a scrolling chart, after the trace is moved to the left. Scrolling requires
+ * display driver which can copy the display area, otherwise the chart switches to sweeping.
+ * @param[in] instance Initialized VTFT instance. See #vtft_t structure definition for detailed explanation.
+ *
+ * @param[in] chart Chart which the sample is added to. See #vtft_chart structure definition for detailed explanation.
+ *
+ * @param[in] value Value of the sample.
+ *
+ * @return Nothing.
+ *
+ * @b Example
+ */
+void vtft_add_chart_sample(vtft_t *instance, vtft_chart *chart, int16_t value);
+
+/*!
+ * @brief Adds multiple samples to the given chart.
+ * @details Adds the given samples to the chart in order, same as calling #vtft_add_chart_sample for each of them.
+ * @param[in] instance Initialized VTFT instance. See #vtft_t structure definition for detailed explanation.
+ *
+ * @param[in] chart Chart which the samples are added to. See #vtft_chart structure definition for detailed explanation.
+ *
+ * @param[in] values Values of the samples.
+ *
+ * @param[in] count Number of the samples.
+ *
+ * @return Nothing.
+ *
+ * @b Example
+ */
+void vtft_add_chart_samples(vtft_t *instance, vtft_chart *chart, const int16_t *values, uint16_t count);
+
+/*!
+ * @brief Removes all samples from the given chart.
+ * @details Removes all samples from the given chart and redraws it empty.
+ * @param[in] instance Initialized VTFT instance. See #vtft_t structure definition for detailed explanation.
+ *
+ * @param[in] chart Chart to be cleared. See #vtft_chart structure definition for detailed explanation.
+ *
+ * @return Nothing.
+ *
+ * @b Example
+ */
+void vtft_clear_chart(vtft_t *instance, vtft_chart *chart);
+
 /*!
  * @brief Draws the given component, using the appropriate drawing function.
  * @details Draws the given component, using the appropriate drawing function.
@@ -123,7 +251,8 @@ void vtft_set_current_screen(vtft_t *instance, vtft_screen *screen);
 
 /*!
  * @brief Processes the periodic events.
- * @details Processes the periodic events.
+ * @details Reads the touch panel and processes the queued touch events, then moves released list views
+ * and runs the animations.
  * @param[in] instance Initialized VTFT instance. See #vtft_t structure definition for detailed explanation.
  *
  * @return Nothing.
@@ -132,6 +261,219 @@ void vtft_set_current_screen(vtft_t *instance, vtft_screen *screen);
  */
 void vtft_process(vtft_t *instance);
 
+/*!
+ * @brief Marks the given component of the current screen for redrawing.
+ * @details Marks the given component of the current screen for redrawing. Component is redrawn by the next
+ * call of #vtft_update, together with all components which overlap it. Call it after changing the
+ * component's appearance, state or visibility. Area is taken at the time of update, so after moving or
+ * resizing the component use #vtft_invalidate_screen instead.
+ * @param[in] instance Initialized VTFT instance. See #vtft_t structure definition for detailed explanation.
+ *
+ * @param[in] component Component to be redrawn. See #vtft_component structure definition for detailed explanation.
+ *
+ * @return Nothing.
+ *
+ * @b Example
+ */
+void vtft_invalidate_component(vtft_t *instance, const vtft_component * __generic_ptr component);
+
+/*!
+ * @brief Marks the whole current screen for redrawing.
+ * @details Marks the whole current screen for redrawing. Screen is redrawn by the next call of #vtft_update.
+ * @param[in] instance Initialized VTFT instance. See #vtft_t structure definition for detailed explanation.
+ *
+ * @return Nothing.
+ *
+ * @b Example
+ */
+void vtft_invalidate_screen(vtft_t *instance);
+
+/*!
+ * @brief Keeps the drawing of the given screen in the given record.
+ * @details Next time the screen is drawn, everything sent to the display is recorded, and from then on the
+ * screen is drawn by playing the record instead of drawing its components. Progress bars, list views and charts
+ * are left out of the record and drawn after it is played, so they should not be covered by other components.
+ * Record is made again after the screen or its other components are invalidated. Up to
+ * VTFT_SCREEN_CACHE_SIZE screens can be cached at a time.
+ * @param[in] instance Initialized VTFT instance. See #vtft_t structure definition for detailed explanation.
+ *
+ * @param[in] screen Screen to be cached. See #vtft_screen structure definition for detailed explanation.
+ *
+ * @param[in] record Initialized record, kept in RAM or external storage, 0 stops caching the screen.
+ * See #gl_record_t structure definition for detailed explanation.
+ *
+ * @return 0 if all cache entries are taken.
+ *
+ * @b Example
+ */
+vtft_bool_t vtft_cache_screen(vtft_t *instance, const vtft_screen * __generic_ptr screen, gl_record_t *record);
+
+/*!
+ * @brief Marks the record of the given screen as outdated.
+ * @details Screen is recorded again the next time it is drawn. Call it after changing components of a screen
+ * which is not the current one, components of the current screen do it when invalidated.
+ * @param[in] instance Initialized VTFT instance. See #vtft_t structure definition for detailed explanation.
+ *
+ * @param[in] screen Cached screen. See #vtft_screen structure definition for detailed explanation.
+ *
+ * @return Nothing.
+ *
+ * @b Example
+ */
+void vtft_invalidate_screen_cache(vtft_t *instance, const vtft_screen * __generic_ptr screen);
+
+/*!
+ * @brief Redraws the parts of the current screen marked for redrawing.
+ * @details Area of every dirty component is cleared with the screen color and all components overlapping it
+ * are redrawn in their order, cropped to that area. Images and progress bars can not be cropped, so the area
+ * grows to cover them whole. Nothing is drawn if no component is dirty.
+ * @param[in] instance Initialized VTFT instance. See #vtft_t structure definition for detailed explanation.
+ *
+ * @return Nothing.
+ *
+ * @b Example
+ */
+void vtft_update(vtft_t *instance);
+
+/*!
+ * @brief Marks the given area of the current screen for redrawing.
+ * @details Marks the given area of the current screen for redrawing. Area is redrawn by the next call of
+ * #vtft_update, together with all components which overlap it. Call it before moving or resizing a component,
+ * with the area the component covers. Multiple areas are merged into one which covers them all.
+ * @param[in] instance Initialized VTFT instance. See #vtft_t structure definition for detailed explanation.
+ *
+ * @param[in] left Left border of the area.
+ *
+ * @param[in] top Top border of the area.
+ *
+ * @param[in] width Width of the area.
+ *
+ * @param[in] height Height of the area.
+ *
+ * @return Nothing.
+ *
+ * @b Example
+ */
+void vtft_invalidate_area(vtft_t *instance, vtft_coord_t left, vtft_coord_t top, vtft_ucoord_t width, vtft_ucoord_t height);
+
+/*!
+ * @brief Sets the time source of the animations.
+ * @details Sets the function which returns the current time in milliseconds. Tweens run only while it is set.
+ * @param[in] instance Initialized VTFT instance. See #vtft_t structure definition for detailed explanation.
+ *
+ * @param[in] timestamp Time source, NULL stops all animations. See #vtft_timestamp_t definition for detailed explanation.
+ *
+ * @return Nothing.
+ *
+ * @b Example
+ */
+void vtft_set_timestamp(vtft_t *instance, vtft_timestamp_t timestamp);
+
+/*!
+ * @brief Starts the given tween.
+ * @details Starts the given tween, restarting it if it is already running. Its property is changed by
+ * #vtft_process in animation frames, and the changed components are redrawn within the frame budget.
+ * @param[in] instance Initialized VTFT instance. See #vtft_t structure definition for detailed explanation.
+ *
+ * @param[in] tween Tween to be started, kept by the library until it finishes. See #vtft_tween structure definition for detailed explanation.
+ *
+ * @return Nothing.
+ *
+ * @b Example
+ */
+void vtft_start_tween(vtft_t *instance, vtft_tween *tween);
+
+/*!
+ * @brief Starts the given tweens as a timeline.
+ * @details Starts all the given tweens at the same time, so their delays place them on a common timeline.
+ * @param[in] instance Initialized VTFT instance. See #vtft_t structure definition for detailed explanation.
+ *
+ * @param[in] tweens Array of tweens to be started. See #vtft_tween structure definition for detailed explanation.
+ *
+ * @param[in] count Number of tweens in the array.
+ *
+ * @return Nothing.
+ *
+ * @b Example
+ */
+void vtft_start_timeline(vtft_t *instance, vtft_tween *tweens, uint16_t count);
+
+/*!
+ * @brief Stops the given tween.
+ * @details Stops the given tween without calling its done event.
+ * @param[in] instance Initialized VTFT instance. See #vtft_t structure definition for detailed explanation.
+ *
+ * @param[in] tween Tween to be stopped. See #vtft_tween structure definition for detailed explanation.
+ *
+ * @param[in] finish If true, the final value is applied, otherwise the property keeps its current value.
+ *
+ * @return Nothing.
+ *
+ * @b Example
+ */
+void vtft_stop_tween(vtft_t *instance, vtft_tween *tween, vtft_bool_t finish);
+
+/*!
+ * @brief Gets the measured animation frames.
+ * @details Gets the number of animation frames and the time spent in them, including redrawing.
+ * @param[in] instance Initialized VTFT instance. See #vtft_t structure definition for detailed explanation.
+ *
+ * @param[out] stats Measured frames. See #vtft_animation_stats structure definition for detailed explanation.
+ *
+ * @return Nothing.
+ *
+ * @b Example
+ */
+void vtft_get_animation_stats(vtft_t *instance, vtft_animation_stats *stats);
+
+/*!
+ * @brief Clears the measured animation frames.
+ * @details Clears the measured animation frames.
+ * @param[in] instance Initialized VTFT instance. See #vtft_t structure definition for detailed explanation.
+ *
+ * @return Nothing.
+ *
+ * @b Example
+ */
+void vtft_reset_animation_stats(vtft_t *instance);
+
+/*!
+ * @brief Gets the touch event queue counters.
+ * @details Gets the number of queued and processed touch events, moves merged into a previous move and events
+ * lost because the queue was full.
+ * @param[in] instance Initialized VTFT instance. See #vtft_t structure definition for detailed explanation.
+ *
+ * @param[out] stats Queue counters. See #vtft_event_stats structure definition for detailed explanation.
+ *
+ * @return Nothing.
+ *
+ * @b Example
+ */
+void vtft_get_event_stats(vtft_t *instance, vtft_event_stats *stats);
+
+/*!
+ * @brief Clears the touch event queue counters.
+ * @details Clears the touch event queue counters.
+ * @param[in] instance Initialized VTFT instance. See #vtft_t structure definition for detailed explanation.
+ *
+ * @return Nothing.
+ *
+ * @b Example
+ */
+void vtft_reset_event_stats(vtft_t *instance);
+
+/*!
+ * @brief Gets the number of touch grid entries needed by the current screen.
+ * @details Gets the number of entries the touch hit-test grid needed when the current screen was last drawn.
+ * If it is larger than VTFT_TOUCH_GRID_ENTRIES, the screen doesn't fit the grid and touch scans all of its components.
+ * @param[in] instance Initialized VTFT instance. See #vtft_t structure definition for detailed explanation.
+ *
+ * @return Number of entries, 0 if the grid is left out.
+ *
+ * @b Example
+ */
+uint16_t vtft_get_touch_grid_entries(vtft_t *instance);
+
 /*! @} */ // vtftgroup
 /*! @} */ // apigroup
 
@@ -272,6 +272,145 @@ void _draw_progress_bar(vtft_t *instance, vtft_component * __generic_ptr compone
  */
 void _update_progress_bar(vtft_t *instance, vtft_progress_bar * progressBar);
 
+/**
+ * @brief Draws the given list view component.
+ *
+ * @details Only the rows visible at the current scroll of the list view are drawn,
+ * each cropped to the list view. Scroll is first limited to the rows of the list view.
+ *
+ * @param[in] instance Initialized VTFT library instance. See #vtft_t structure definition for detailed explanation.
+ * @param[in] component The list view component that will be drawn. See #vtft_list_view structure definition for detailed explanation.
+ *
+ * @return Nothing.
+ *
+ * @b Example
+ */
+void _draw_list_view(vtft_t *instance, vtft_component *component);
+
+/**
+ * @brief Scrolls the given list view.
+ *
+ * @details Rows which stay visible are moved by the display driver using @ref gl_copy_rect,
+ * and only the uncovered strip is drawn. If the driver can not move them, the whole list view is drawn.
+ *
+ * @param[in] instance Initialized VTFT library instance. See #vtft_t structure definition for detailed explanation.
+ * @param[in,out] list_view The list view component that will be scrolled. See #vtft_list_view structure definition for detailed explanation.
+ * @param[in] scroll New distance from the top of the first row to the top of the list view.
+ *
+ * @return True if the scroll had to be limited to the rows of the list view.
+ *
+ * @b Example
+ */
+vtft_bool_t _scroll_list_view(vtft_t *instance, vtft_list_view *list_view, int32_t scroll);
+
+/**
+ * @brief Redraws a single row of the given list view.
+ *
+ * @details Nothing is drawn if the row is not visible at the current scroll.
+ *
+ * @param[in] instance Initialized VTFT library instance. See #vtft_t structure definition for detailed explanation.
+ * @param[in] list_view The list view component whose row will be drawn. See #vtft_list_view structure definition for detailed explanation.
+ * @param[in] row Index of the row.
+ *
+ * @return Nothing.
+ *
+ * @b Example
+ */
+void _update_list_view_row(vtft_t *instance, vtft_list_view *list_view, uint16_t row);
+
+/**
+ * @brief Draws the given chart component.
+ *
+ * @details Clears the chart and draws a column for every group of samples kept in its ring buffer,
+ * up to the width of the chart.
+ *
+ * @param[in] instance Initialized VTFT library instance. See #vtft_t structure definition for detailed explanation.
+ * @param[in] component The chart component that will be drawn. See #vtft_chart structure definition for detailed explanation.
+ *
+ * @return Nothing.
+ *
+ * @b Example
+ */
+void _draw_chart(vtft_t *instance, vtft_component *component);
+
+/**
+ * @brief Adds a sample to the given chart.
+ *
+ * @details Once the column of the sample is complete, only that column is drawn. Scrolling chart
+ * is moved by one column using @ref gl_copy_rect; if the display driver can't do it, the chart
+ * switches to sweeping and is drawn whole.
+ *
+ * @param[in] instance Initialized VTFT library instance. See #vtft_t structure definition for detailed explanation.
+ * @param[in,out] chart The chart component that the sample is added to. See #vtft_chart structure definition for detailed explanation.
+ * @param[in] value Value of the sample.
+ *
+ * @return Nothing.
+ *
+ * @b Example
+ */
+void _add_chart_sample(vtft_t *instance, vtft_chart *chart, int16_t value);
+
+/**
+ * @brief Gets the area covered by the given component.
+ *
+ * @details Area includes the part of the pen drawn outside of the component,
+ * so nothing drawn by the component's drawing handle lies outside of it.
+ *
+ * @param[in] component Component whose area is calculated. See #vtft_component structure definition for detailed explanation.
+ * @param[out] rect Area covered by the component, empty for components with an invalid type.
+ *
+ * @return Nothing.
+ */
+void _get_component_rect(const vtft_component * __generic_ptr component, gl_rectangle_t *rect);
+
+/**
+ * @brief Gets the text of the given component.
+ *
+ * @details Labels, buttons, check boxes and radio buttons have a text. Captions of progress bars
+ * are written by the library, so they are not given.
+ *
+ * @param[in] component Component whose text is given. See #vtft_component structure definition for detailed explanation.
+ *
+ * @return Text of the component, 0 for components without one.
+ */
+vtft_text *_get_component_text(vtft_component *component);
+
+/**
+ * @brief Drops the measured caption of the given component.
+ *
+ * @details Caption is measured again the next time the component is drawn.
+ * Called after the caption or the font of the component changes.
+ *
+ * @param[in] instance Initialized VTFT library instance. See #vtft_t structure definition for detailed explanation.
+ * @param[in] component Component whose caption changed. See #vtft_component structure definition for detailed explanation.
+ *
+ * @return Nothing.
+ */
+void _invalidate_text_metrics(vtft_t *instance, const vtft_component * __generic_ptr component);
+
+/**
+ * @brief Drops the measured captions of all components.
+ *
+ * @details Entries are given by component order, so they are dropped when another screen is shown.
+ *
+ * @param[in] instance Initialized VTFT library instance. See #vtft_t structure definition for detailed explanation.
+ *
+ * @return Nothing.
+ */
+void _clear_text_metrics(vtft_t *instance);
+
+/**
+ * @brief Sets the size of the given label to the size of its caption.
+ *
+ * @details Caption is measured with the font of the label, so the area of the label follows its caption.
+ *
+ * @param[in] instance Initialized VTFT library instance. See #vtft_t structure definition for detailed explanation.
+ * @param[in,out] label Label whose size is set. See #vtft_label structure definition for detailed explanation.
+ *
+ * @return Nothing.
+ */
+void _fit_label(vtft_t *instance, vtft_label *label);
+
 /*! @} */ // vtftgroup
 /*! @} */ // apigroup
 
@@ -0,0 +1,258 @@
+/****************************************************************************
+**
+** Copyright (C) 2023 MikroElektronika d.o.o.
+** Contact: https://www.mikroe.com/contact
+**
+** This file is part of the mikroSDK package
+**
+** Commercial License Usage
+**
+** Licensees holding valid commercial NECTO compilers AI licenses may use this
+** file in accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The MikroElektronika Company.
+** For licensing terms and conditions see
+** https://www.mikroe.com/legal/software-license-agreement.
+** For further information use the contact form at
+** https://www.mikroe.com/contact.
+**
+**
+** GNU Lesser General Public License Usage
+**
+** Alternatively, this file may be used for
+** non-commercial projects under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** The above copyright notice and this permission notice shall be
+** included in all copies or substantial portions of the Software.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+** OF MERCHANTABILITY, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED
+** TO THE WARRANTIES FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+** IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+** DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT
+** OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+** OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+**
+****************************************************************************/
+
+/*!
+ * \file
+ *
+ * Loader of screens described in the binary screen format, so that the user interface
+ * can be changed without rebuilding the firmware. Only the screen being shown is built
+ * in RAM, inside a memory area given to the loader.
+ *
+ * Format, all numbers are little endian and offsets are counted from the start of the data:
+ *
+ * Header, 16 bytes:
+ *   0  u8[4] magic "VTSC"
+ *   4  u16   version, VTFT_SCREEN_FORMAT_VERSION
+ *   6  u16   number of screens
+ *   8  u16   number of styles
+ *   10 u16   reserved
+ *   12 u32   offset of the style table
+ * Screen offsets, u32 per screen, follow the header.
+ *
+ * Style, 36 bytes; styles are shared by components, so equal ones are stored only once:
+ *   0  u32   pen color          4  u32 gradient start color  8  u32 gradient end color
+ *   12 u32   press start color  16 u32 press end color       20 u32 font color
+ *   24 u32   back color         28 u16 pen width             30 u8  gradient style
+ *   31 u8    transparent        32 u8  font index            33 u8[3] reserved
+ * Colors are given as 0xRRGGBB and converted to the color depth of the library.
+ *
+ * Screen, 16 bytes followed by its components:
+ *   0  u16   width              2  u16 height                4  u32 color
+ *   8  u8    press event        9  u8  down event            10 u8  up event
+ *   11 u8    reserved           12 u16 number of components  14 u16 reserved
+ *
+ * Component, 36 bytes followed by its caption, padded to 4 bytes:
+ *   0  u8    type, see #vtft_component_type
+ *   1  u8    flags, see VTFT_SCREEN_FLAG_*
+ *   2  u16   style index
+ *   4  s16   left               6  s16 top
+ *   8  u16   width, radius of circles, second left of lines
+ *   10 u16   height, second top of lines
+ *   12 u16   corner radius      14 u8  text alignment        15 u8 picture index
+ *   16 u8[4] press, down, up and click event
+ *   20 u32   image ratio, progress bar position
+ *   24 u32   progress bar minimum position
+ *   28 u32   progress bar maximum position
+ *   32 u16   caption length, including the terminating zero
+ *   34 u16   maximum caption length
+ *
+ * Fonts, pictures and events are given by their index in the tables passed to the loader,
+ * 0xFF stands for none. List views and charts can't be described, as they need the user's data.
+ */
+#ifndef _VTFT_LOADER_H_
+#define _VTFT_LOADER_H_
+
+#include "vtft_types.h"
+#ifdef VTFT_SCREEN_FILES_ENABLED
+#include "file.h"
+#endif
+
+/*! @addtogroup apigroup API
+ *  @{
+ */
+
+/*! @addtogroup vtftgroup VTFT Library
+ *  @{
+ */
+
+// Version of the binary screen format read by the loader.
+#define VTFT_SCREEN_FORMAT_VERSION 1
+
+// Component flags.
+#define VTFT_SCREEN_FLAG_VISIBLE       0x01
+#define VTFT_SCREEN_FLAG_ACTIVE        0x02
+#define VTFT_SCREEN_FLAG_VERTICAL_TEXT 0x04
+#define VTFT_SCREEN_FLAG_CHECKED       0x08
+#define VTFT_SCREEN_FLAG_SMOOTH        0x10
+#define VTFT_SCREEN_FLAG_SHOW_PERCENT  0x20
+#define VTFT_SCREEN_FLAG_SHOW_POSITION 0x40
+
+// Resource index standing for no resource.
+#define VTFT_SCREEN_NO_RESOURCE 0xFF
+
+// Loader errors.
+typedef enum
+{
+    VTFT_LOADER_OK,
+    // Data couldn't be read.
+    VTFT_LOADER_ERROR_READ,
+    // Data isn't in the binary screen format, or refers to a missing resource.
+    VTFT_LOADER_ERROR_FORMAT,
+    // Data is in a newer version of the format.
+    VTFT_LOADER_ERROR_VERSION,
+    // There is no screen with the given index.
+    VTFT_LOADER_ERROR_INDEX,
+    // Screen doesn't fit the memory given to the loader.
+    VTFT_LOADER_ERROR_MEMORY
+}
+vtft_loader_err_t;
+
+// Fonts, pictures and events which screens refer to by index.
+typedef struct
+{
+    const vtft_byte_t * const *fonts;
+    uint8_t font_count;
+    const vtft_byte_t * const *pictures;
+    uint8_t picture_count;
+    const vtft_event *events;
+    uint8_t event_count;
+}
+vtft_loader_resources_t;
+
+// Screen loader.
+typedef struct
+{
+    const vtft_loader_resources_t *resources;
+
+    // Memory the loaded screen is built in.
+    uint8_t *memory;
+    uint32_t memory_size;
+    uint32_t memory_used;
+
+    // Source of the data, memory mapped data or an open file.
+    const uint8_t * __generic_ptr data;
+#ifdef VTFT_SCREEN_FILES_ENABLED
+    file_t *file;
+#endif
+
+    uint16_t screen_count;
+    uint16_t style_count;
+    uint32_t style_offset;
+
+    // Currently loaded screen, 0 if none.
+    vtft_screen *screen;
+}
+vtft_loader_t;
+
+/*!
+ * @brief Initializes the screen loader.
+ * @details Initializes the screen loader with the resources screens refer to and the memory
+ * screens are built in. Only one screen is loaded at a time, so the memory has to fit the largest one.
+ * @param[out] loader Loader to be initialized. See #vtft_loader_t structure definition for detailed explanation.
+ *
+ * @param[in] resources Fonts, pictures and events, kept by the loader. See #vtft_loader_resources_t structure definition for detailed explanation.
+ *
+ * @param[in] memory Memory the loaded screen is built in, aligned to 4 bytes.
+ *
+ * @param[in] memory_size Size of the memory in bytes.
+ *
+ * @return Nothing.
+ *
+ * @b Example
+ */
+void vtft_loader_init(vtft_loader_t *loader, const vtft_loader_resources_t *resources, uint8_t *memory, uint32_t memory_size);
+
+/*!
+ * @brief Opens screens placed in memory.
+ * @details Opens screens placed in memory, e.g. flash. Captions which are not editable point directly into the data,
+ * so the data has to stay in place while screens are loaded.
+ * @param[in,out] loader Initialized loader. See #vtft_loader_t structure definition for detailed explanation.
+ *
+ * @param[in] data Screens in the binary screen format.
+ *
+ * @return See #vtft_loader_err_t definition for detailed explanation.
+ *
+ * @b Example
+ */
+vtft_loader_err_t vtft_loader_open_memory(vtft_loader_t *loader, const uint8_t * __generic_ptr data);
+
+#ifdef VTFT_SCREEN_FILES_ENABLED
+/*!
+ * @brief Opens screens stored in a file.
+ * @details Opens screens stored in a file, e.g. on an SD card. Screen is read from the file every time it is loaded,
+ * so the file has to stay open while screens are loaded.
+ * @param[in,out] loader Initialized loader. See #vtft_loader_t structure definition for detailed explanation.
+ *
+ * @param[in] file Open file with screens in the binary screen format. See #file_t structure definition for detailed explanation.
+ *
+ * @return See #vtft_loader_err_t definition for detailed explanation.
+ *
+ * @b Example
+ */
+vtft_loader_err_t vtft_loader_open_file(vtft_loader_t *loader, file_t *file);
+#endif
+
+/*!
+ * @brief Loads the given screen.
+ * @details Builds the given screen in the loader's memory, replacing the previously loaded one.
+ * Every screen is built at the same address, so the caller stops caching and animating the previous one.
+ * @param[in,out] loader Opened loader. See #vtft_loader_t structure definition for detailed explanation.
+ *
+ * @param[in] index Index of the screen.
+ *
+ * @param[out] screen Loaded screen. See #vtft_screen structure definition for detailed explanation.
+ *
+ * @return See #vtft_loader_err_t definition for detailed explanation.
+ *
+ * @b Example
+ */
+vtft_loader_err_t vtft_loader_load_screen(vtft_loader_t *loader, uint16_t index, vtft_screen **screen);
+
+/*!
+ * @brief Loads the given screen and shows it.
+ * @details Loads the given screen and sets it as the current screen of the VTFT instance.
+ * The previously loaded screen is released, so it must not be shown any more. Its tweens are stopped
+ * and it stops being cached, so a loaded screen is cached with #vtft_cache_screen after it is shown.
+ * @param[in] instance Initialized VTFT instance. See #vtft_t structure definition for detailed explanation.
+ *
+ * @param[in,out] loader Opened loader. See #vtft_loader_t structure definition for detailed explanation.
+ *
+ * @param[in] index Index of the screen.
+ *
+ * @return See #vtft_loader_err_t definition for detailed explanation.
+ *
+ * @b Example
+ */
+vtft_loader_err_t vtft_loader_show_screen(vtft_t *instance, vtft_loader_t *loader, uint16_t index);
+
+/*! @} */ // vtftgroup
+/*! @} */ // apigroup
+
+#endif // _VTFT_LOADER_H_
+// ------------------------------------------------------------------------- END
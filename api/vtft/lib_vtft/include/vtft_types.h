@@ -44,6 +44,7 @@
 #define _VTFT_TYPES_H_
 
 #include "gl_types.h"
+#include "gl_record.h"
 #include "generic_pointer.h"
 #include "tp.h"
 
@@ -57,6 +58,81 @@
  *  @{
  */
 
+// Number of components per screen whose dirty and occlusion state is tracked,
+// enough for screens of up to 256 components at 2 bits of RAM per component.
+// Invalidating a component beyond this limit marks the whole screen dirty,
+// and such components are always drawn.
+#ifndef VTFT_MAX_TRACKED_COMPONENTS
+#define VTFT_MAX_TRACKED_COMPONENTS 256
+#endif
+
+// Touch hit-test grid. Screen is split into VTFT_TOUCH_GRID_COLUMNS x VTFT_TOUCH_GRID_ROWS
+// cells, each listing the components which cover it. All lists share a pool of
+// VTFT_TOUCH_GRID_ENTRIES entries, enough for screens of about 150 components covering
+// a few cells each; if a screen needs more, touch falls back to scanning all components
+// and vtft_get_touch_grid_entries reports the number needed. Set VTFT_TOUCH_GRID_ENTRIES
+// to 0 to leave the grid out.
+#ifndef VTFT_TOUCH_GRID_COLUMNS
+#define VTFT_TOUCH_GRID_COLUMNS 8
+#endif
+#ifndef VTFT_TOUCH_GRID_ROWS
+#define VTFT_TOUCH_GRID_ROWS 6
+#endif
+#ifndef VTFT_TOUCH_GRID_ENTRIES
+#define VTFT_TOUCH_GRID_ENTRIES 512
+#endif
+
+// Measured captions, so that redrawing a component doesn't measure its caption again. Each component
+// keeps its caption size and position in the entry given by its order modulo VTFT_TEXT_METRICS_ENTRIES,
+// components sharing an entry measure their captions again when drawn in turn. A caption is measured
+// again after it is set with vtft_set_caption or its font with vtft_set_font. Set to 0 to always measure.
+#ifndef VTFT_TEXT_METRICS_ENTRIES
+#define VTFT_TEXT_METRICS_ENTRIES 32
+#endif
+
+// Number of screens whose drawing can be recorded with vtft_cache_screen, so that showing
+// them again only sends the recorded pixels to the display. Set to 0 to leave the cache out.
+#ifndef VTFT_SCREEN_CACHE_SIZE
+#define VTFT_SCREEN_CACHE_SIZE 4
+#endif
+
+// List view scrolling. Touch has to move this many pixels before the list view starts
+// following it; a shorter touch is a row click. After release, scrolling speed drops by
+// 1/2^VTFT_LIST_VIEW_FRICTION_SHIFT on every call of vtft_process, and the list view stops
+// once it moves less than VTFT_LIST_VIEW_MIN_SPEED/256 pixels per call.
+#ifndef VTFT_LIST_VIEW_DRAG_THRESHOLD
+#define VTFT_LIST_VIEW_DRAG_THRESHOLD 6
+#endif
+#ifndef VTFT_LIST_VIEW_FRICTION_SHIFT
+#define VTFT_LIST_VIEW_FRICTION_SHIFT 4
+#endif
+#ifndef VTFT_LIST_VIEW_MIN_SPEED
+#define VTFT_LIST_VIEW_MIN_SPEED 64
+#endif
+
+// Animation frames. While tweens are running, vtft_process steps them at most once every
+// VTFT_ANIMATION_FRAME_PERIOD milliseconds and then redraws the changed components until
+// VTFT_ANIMATION_FRAME_BUDGET milliseconds are spent; the rest are redrawn by the next frame.
+#ifndef VTFT_ANIMATION_FRAME_PERIOD
+#define VTFT_ANIMATION_FRAME_PERIOD 20
+#endif
+#ifndef VTFT_ANIMATION_FRAME_BUDGET
+#define VTFT_ANIMATION_FRAME_BUDGET 10
+#endif
+
+// Touch event queue. Touch events reported by tp_process wait in a queue of VTFT_EVENT_QUEUE_SIZE
+// entries and are processed afterwards by vtft_process, consecutive moves merged into one. The last
+// entry is kept for up events, so a full queue drops presses and moves but never releases of queued
+// presses; the queue needs at least 2 entries. If VTFT_EVENT_BUDGET is not 0 and the animation time
+// source is set, vtft_process leaves the rest of the events for its next call once that many
+// milliseconds are spent. Set VTFT_EVENT_QUEUE_SIZE to 0 to process events as soon as they are reported.
+#ifndef VTFT_EVENT_QUEUE_SIZE
+#define VTFT_EVENT_QUEUE_SIZE 8
+#endif
+#ifndef VTFT_EVENT_BUDGET
+#define VTFT_EVENT_BUDGET 0
+#endif
+
 // Scalar types.
 typedef uint8_t vtft_bool_t;
 typedef uint8_t vtft_byte_t;
@@ -81,6 +157,8 @@ typedef enum
     VTFT_COMPONENT_CHECK_BOX,
     VTFT_COMPONENT_RADIO_BUTTON,
     VTFT_COMPONENT_PROGRESS_BAR,
+    VTFT_COMPONENT_LIST_VIEW,
+    VTFT_COMPONENT_CHART,
     VTFT_COMPONENT_COUNT
 }
 vtft_component_type;
@@ -477,6 +555,188 @@ typedef struct
 }
 vtft_progress_bar;
 
+struct vtft_list_view_s;
+
+// Draws the given row of a list view. Area is the one of the whole row, drawing is cropped to the list view.
+typedef void (*vtft_list_view_draw_row)(struct vtft_list_view_s *list_view, uint16_t row, const gl_rectangle_t *area);
+// Called when the given row of a list view is clicked.
+typedef void (*vtft_list_view_row_event)(struct vtft_list_view_s *list_view, uint16_t row);
+
+// Scrollable list of rows of the same height. Rows are not stored in the component,
+// only the visible ones are drawn by calling draw_row. List view changes its state
+// while scrolling, so it must not be placed in the flash memory.
+typedef struct vtft_list_view_s
+{
+    vtft_comp_type_t type;
+    vtft_index_t order;
+    vtft_bool_t visible;
+    vtft_coord_t left;
+    vtft_coord_t top;
+    vtft_bool_t active;
+    vtft_event_set event_set;
+    vtft_ucoord_t width;
+    vtft_ucoord_t height;
+    gl_color_t back_color;
+    uint16_t row_count;
+    vtft_ucoord_t row_height;
+    vtft_list_view_draw_row draw_row;
+    vtft_list_view_row_event row_click;
+
+    // Scrolling state, initialize to 0.
+    // Distance from the top of the first row to the top of the list view.
+    int32_t scroll;
+    // Scroll of the rows currently on the display.
+    int32_t drawn_scroll;
+    // Scrolling speed in 1/256 pixels per call of vtft_process.
+    int32_t speed;
+    // Part of a pixel scrolled, in 1/256 pixels.
+    int32_t scroll_fraction;
+    // Touch coordinate where the press started and where it was last seen.
+    vtft_coord_t press_y;
+    vtft_coord_t drag_y;
+    // Indicates that the current touch scrolls the list view.
+    vtft_bool_t dragging;
+}
+vtft_list_view;
+
+// Live plot of the latest samples. Every column of pixels shows the range of
+// samples_per_column samples, joined with the previous column into a continuous trace.
+// Samples are kept in a ring buffer given by the user, which should hold at least
+// width * samples_per_column + 1 samples so the chart can be redrawn whole.
+// Chart changes its state with every sample, so it must not be placed in the flash memory.
+typedef struct
+{
+    vtft_comp_type_t type;
+    vtft_index_t order;
+    vtft_bool_t visible;
+    vtft_coord_t left;
+    vtft_coord_t top;
+    vtft_ucoord_t width;
+    vtft_ucoord_t height;
+    gl_color_t back_color;
+    gl_color_t trace_color;
+    // Values drawn at the bottom and at the top edge of the chart.
+    int16_t min_value;
+    int16_t max_value;
+    // Number of samples shown by a single column, 0 is the same as 1.
+    uint16_t samples_per_column;
+    // Indicates that the trace scrolls to the left, with the newest column at the right edge.
+    // Otherwise new columns sweep from left to right, replacing the oldest ones.
+    // Cleared by the library if the display driver can not move the display area.
+    vtft_bool_t scroll;
+    int16_t *samples;
+    uint16_t capacity;
+
+    // Sampling state, initialize to 0.
+    // Number of samples added since the chart was cleared.
+    uint32_t sample_count;
+    // Range of the samples of the column being collected.
+    int16_t column_min;
+    int16_t column_max;
+}
+vtft_chart;
+
+// Animation
+
+// Returns the current time in milliseconds.
+typedef uint32_t (*vtft_timestamp_t)(void);
+
+// Property changed by a tween.
+typedef enum
+{
+    // Left coordinate of the component.
+    VTFT_TWEEN_LEFT,
+    // Top coordinate of the component.
+    VTFT_TWEEN_TOP,
+    // One of the component's colors, given by the color field.
+    VTFT_TWEEN_COLOR,
+    // Position of the progress bar component.
+    VTFT_TWEEN_PROGRESS,
+    // Value passed to the step function, the component is redrawn if given.
+    VTFT_TWEEN_CUSTOM
+}
+vtft_tween_property;
+
+// Rate at which a tween changes its property over time.
+typedef enum
+{
+    VTFT_EASING_LINEAR,
+    VTFT_EASING_IN,
+    VTFT_EASING_OUT,
+    VTFT_EASING_IN_OUT
+}
+vtft_easing;
+
+struct vtft_tween_s;
+
+// Called when the given tween finishes.
+typedef void (*vtft_tween_event)(struct vtft_tween_s *tween);
+// Applies the given value of a custom tween.
+typedef void (*vtft_tween_step)(struct vtft_tween_s *tween, int32_t value);
+
+// Change of a single component property from one value to another over time.
+// Tween and the animated component must not be placed in the flash memory.
+typedef struct vtft_tween_s
+{
+    vtft_component *component;
+    vtft_tween_property property;
+    // Color changed by VTFT_TWEEN_COLOR.
+    gl_color_t *color;
+    // Values, colors for VTFT_TWEEN_COLOR.
+    int32_t from;
+    int32_t to;
+    // Time from the start to the first change, and the time of the change, in milliseconds.
+    uint32_t delay;
+    uint32_t duration;
+    vtft_easing easing;
+    vtft_tween_step step;
+    vtft_tween_event done;
+
+    // Running state, managed by the library.
+    uint32_t start;
+    // Last applied value.
+    int32_t value;
+    vtft_bool_t applied;
+    vtft_bool_t running;
+    struct vtft_tween_s *next;
+}
+vtft_tween;
+
+// Measured animation frames, times are in milliseconds.
+typedef struct
+{
+    uint32_t frames;
+    // Frames which ran out of budget and left components to the next frame.
+    uint32_t deferred_frames;
+    uint32_t last_frame_time;
+    uint32_t max_frame_time;
+    uint32_t total_frame_time;
+}
+vtft_animation_stats;
+
+// Touch event waiting in the queue.
+typedef struct
+{
+    tp_event_t event;
+    tp_coord_t x;
+    tp_coord_t y;
+}
+vtft_touch_event;
+
+// Counters of the touch event queue.
+typedef struct
+{
+    uint32_t queued;
+    uint32_t processed;
+    // Moves merged into the previous queued move.
+    uint32_t coalesced;
+    // Events lost because the queue was full.
+    uint32_t dropped;
+    // Largest number of events waiting at once.
+    uint16_t max_pending;
+}
+vtft_event_stats;
+
 // Screen
 
 typedef struct
@@ -494,6 +754,51 @@ typedef struct
 }
 vtft_screen;
 
+// Measured caption of a component.
+typedef struct
+{
+    // Component whose caption was measured, 0 for an empty entry.
+    const vtft_component * __generic_ptr component;
+    gl_size_t size;
+    // Position of the caption within the component.
+    vtft_coord_t offset_x;
+    vtft_coord_t offset_y;
+}
+vtft_text_metrics;
+
+// Touch hit-test grid of a screen.
+#if VTFT_TOUCH_GRID_ENTRIES > 0
+typedef struct
+{
+    // Indicates that the grid matches the current screen.
+    vtft_bool_t valid;
+    // Size of a single cell.
+    vtft_ucoord_t cell_width;
+    vtft_ucoord_t cell_height;
+    // Component list of cell i is entries[cell_start[i]] .. entries[cell_start[i + 1] - 1].
+    uint16_t cell_start[VTFT_TOUCH_GRID_COLUMNS * VTFT_TOUCH_GRID_ROWS + 1];
+    // Component indices, in drawing order within every cell.
+    vtft_index_t entries[VTFT_TOUCH_GRID_ENTRIES];
+    // Entries needed by the current screen, more than VTFT_TOUCH_GRID_ENTRIES if it doesn't fit.
+    uint16_t required_entries;
+}
+vtft_touch_grid;
+#endif
+
+// Recorded drawing of a screen.
+#if VTFT_SCREEN_CACHE_SIZE > 0
+typedef struct
+{
+    // Cached screen, 0 for an empty entry.
+    const vtft_screen * __generic_ptr screen;
+    // Record of the screen without its progress bars, list views and charts.
+    gl_record_t *record;
+    // Indicates that the record matches the screen.
+    vtft_bool_t valid;
+}
+vtft_screen_cache;
+#endif
+
 // Drawing Functions
 // The function signature for drawing a component.
 typedef void (*vtft_draw_handle)(struct vtft_s *instance, vtft_component * __generic_ptr component);
@@ -521,6 +826,60 @@ typedef struct vtft_s
 
     // The currently pressed component.
     vtft_active_component * __generic_ptr pressed_component;
+
+    // List view which keeps scrolling after being released.
+    vtft_list_view *scrolling_list_view;
+
+    // Time source of the animations.
+    vtft_timestamp_t timestamp;
+    // Running tweens.
+    vtft_tween *tweens;
+    // Start of the last animation frame.
+    uint32_t last_frame;
+    // Indicates that the last animation frame left components to be redrawn.
+    vtft_bool_t frame_pending;
+    vtft_animation_stats animation_stats;
+
+#if VTFT_EVENT_QUEUE_SIZE > 0
+    // Touch events waiting to be processed, the oldest one at events[event_head].
+    vtft_touch_event events[VTFT_EVENT_QUEUE_SIZE];
+    uint8_t event_head;
+    uint8_t event_count;
+#endif
+    vtft_event_stats event_stats;
+
+    // Components of the current screen waiting to be redrawn, one bit per component index.
+    uint8_t dirty_components[(VTFT_MAX_TRACKED_COMPONENTS + 7) / 8];
+    // Indicates that the whole current screen has to be redrawn.
+    vtft_bool_t screen_dirty;
+    // Area of the current screen waiting to be redrawn, e.g. left behind by a moved component.
+    vtft_bool_t area_dirty;
+    vtft_coord_t dirty_left;
+    vtft_coord_t dirty_top;
+    vtft_coord_t dirty_right;
+    vtft_coord_t dirty_bottom;
+
+    // Components of the current screen hidden behind a later opaque component, one bit per component index.
+    uint8_t occluded_components[(VTFT_MAX_TRACKED_COMPONENTS + 7) / 8];
+    // Indicates that the whole screen is covered by an opaque component.
+    vtft_bool_t background_covered;
+    // Indicates that the occlusion state matches the current screen.
+    vtft_bool_t occlusion_valid;
+
+#if VTFT_TEXT_METRICS_ENTRIES > 0
+    // Measured captions of the current screen, indexed by component order.
+    vtft_text_metrics text_metrics[VTFT_TEXT_METRICS_ENTRIES];
+#endif
+
+#if VTFT_TOUCH_GRID_ENTRIES > 0
+    // Touch hit-test grid of the current screen.
+    vtft_touch_grid touch_grid;
+#endif
+
+#if VTFT_SCREEN_CACHE_SIZE > 0
+    // Screens drawn from their records.
+    vtft_screen_cache screen_cache[VTFT_SCREEN_CACHE_SIZE];
+#endif
 }
 vtft_t;
 
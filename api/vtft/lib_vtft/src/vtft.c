@@ -41,22 +41,442 @@
 #include <string.h>
 #include "vtft_drawing.h"
 #include "vtft_touch.h"
+#include "vtft_animation.h"
 #include "gl.h"
 #include "tp.h"
 
 extern void _tp_event_handler( tp_event_t event, uint16_t x, uint16_t y, tp_touch_id_t i);
+// Local Type Definitions
+
+// Screen area given by its borders, right and bottom ones are exclusive.
+typedef struct
+{
+    vtft_coord_t left;
+    vtft_coord_t top;
+    vtft_coord_t right;
+    vtft_coord_t bottom;
+}
+vtft_area_t;
+
 // Local Variable Definitions
 
 
+// Clears all dirty indicators.
+static void _clear_dirty(vtft_t *instance)
+{
+    memset(instance->dirty_components, 0x00, sizeof(instance->dirty_components));
+    instance->screen_dirty = 0;
+    instance->area_dirty = 0;
+}
+
+// Returns true if two areas, given by their borders, overlap.
+static vtft_bool_t _borders_overlap(const vtft_area_t *a, const vtft_area_t *b)
+{
+    return (a->left < b->right) && (b->left < a->right) && (a->top < b->bottom) && (b->top < a->bottom);
+}
+
+// Gets the borders of the area covered by the given component.
+static void _get_component_borders(const vtft_component * __generic_ptr component, vtft_area_t *border)
+{
+    gl_rectangle_t rect;
+
+    _get_component_rect(component, &rect);
+    border->left = rect.top_left.x;
+    border->top = rect.top_left.y;
+    border->right = rect.top_left.x + rect.width;
+    border->bottom = rect.top_left.y + rect.height;
+}
+
+// Returns true if the first area lies completely inside the second one.
+static vtft_bool_t _area_inside(const vtft_area_t *inner, const vtft_area_t *outer)
+{
+    return (inner->left >= outer->left) && (inner->right <= outer->right) &&
+           (inner->top >= outer->top) && (inner->bottom <= outer->bottom);
+}
+
+// Gets the area which the given component paints completely, without any background showing through.
+// Returns false if there is no such area, e.g. the component is transparent, rounded or not rectangular.
+static vtft_bool_t _get_opaque_area(const vtft_component * __generic_ptr component, vtft_area_t *area)
+{
+    const vtft_box * __generic_ptr box;
+    const vtft_image * __generic_ptr image;
+    const vtft_list_view * __generic_ptr list_view;
+    const vtft_chart * __generic_ptr chart;
+    gl_image_format_t format;
+
+    if (component->visible == 0)
+        return 0;
+
+    switch (component->type)
+    {
+        case VTFT_COMPONENT_BOX:
+        case VTFT_COMPONENT_BUTTON:
+            box = (const vtft_box * __generic_ptr)component;
+            if (box->press_gradient.transparent)
+                return 0;
+
+            area->left = box->left;
+            area->top = box->top;
+            area->right = box->left + box->width;
+            area->bottom = box->top + box->height;
+            return 1;
+
+        case VTFT_COMPONENT_IMAGE:
+            // Bitmaps are scaled to the component, JPEG images are drawn in their own size.
+            image = (const vtft_image * __generic_ptr)component;
+            format = gl_image_format(image->picture_data);
+            if ((format != GL_IMAGE_FORMAT_BITMAP_1BPP) && (format != GL_IMAGE_FORMAT_BITMAP_4BPP) &&
+                (format != GL_IMAGE_FORMAT_BITMAP_8BPP) && (format != GL_IMAGE_FORMAT_BITMAP_16BPP))
+                return 0;
+
+            area->left = image->left;
+            area->top = image->top;
+            area->right = image->left + image->width;
+            area->bottom = image->top + image->height;
+            return 1;
+
+        case VTFT_COMPONENT_CHART:
+            chart = (const vtft_chart * __generic_ptr)component;
+            area->left = chart->left;
+            area->top = chart->top;
+            area->right = chart->left + chart->width;
+            area->bottom = chart->top + chart->height;
+            return 1;
+
+        case VTFT_COMPONENT_LIST_VIEW:
+            list_view = (const vtft_list_view * __generic_ptr)component;
+            area->left = list_view->left;
+            area->top = list_view->top;
+            area->right = list_view->left + list_view->width;
+            area->bottom = list_view->top + list_view->height;
+            return 1;
+
+        default:
+            return 0;
+    }
+}
+
+// Finds components of the given screen which are completely covered by a later opaque component.
+static void _update_occlusion(vtft_t *instance, const vtft_screen * __generic_ptr screen)
+{
+    vtft_component * __generic_ptr * __generic_ptr components = screen->components;
+    vtft_area_t screen_area;
+    vtft_area_t opaque;
+    vtft_area_t area;
+    vtft_index_t count;
+    vtft_index_t i;
+    vtft_index_t j;
+
+    memset(instance->occluded_components, 0x00, sizeof(instance->occluded_components));
+    instance->background_covered = 0;
+    instance->occlusion_valid = 1;
+
+    screen_area.left = 0;
+    screen_area.top = 0;
+    screen_area.right = gl_get_screen_width();
+    screen_area.bottom = gl_get_screen_height();
+
+    count = screen->component_count;
+    if (count > VTFT_MAX_TRACKED_COMPONENTS)
+        count = VTFT_MAX_TRACKED_COMPONENTS;
+
+    for (j = screen->component_count - 1; j >= 0; j--)
+    {
+        if (!_get_opaque_area(components[j], &opaque))
+            continue;
+
+        if (_area_inside(&screen_area, &opaque))
+            instance->background_covered = 1;
+
+        for (i = 0; (i < j) && (i < count); i++)
+        {
+            if (instance->occluded_components[i >> 3] & (1 << (i & 7)))
+                continue;
+
+            _get_component_borders(components[i], &area);
+            if (_area_inside(&area, &opaque))
+                instance->occluded_components[i >> 3] |= 1 << (i & 7);
+        }
+    }
+}
+
+// Returns true if the given component doesn't have to be drawn because it is hidden behind an opaque one.
+static vtft_bool_t _is_occluded(vtft_t *instance, vtft_index_t index)
+{
+    if (index >= VTFT_MAX_TRACKED_COMPONENTS)
+        return 0;
+
+    return (instance->occluded_components[index >> 3] & (1 << (index & 7))) != 0;
+}
+
+// Redraws the given area and everything overlapping it.
+static void _redraw_area(vtft_t *instance, const vtft_screen * __generic_ptr screen, vtft_area_t area)
+{
+    vtft_component * __generic_ptr * __generic_ptr components = screen->components;
+    vtft_component * __generic_ptr component;
+    vtft_area_t border;
+    vtft_bool_t grown;
+    vtft_index_t i;
+
+    // Images, progress bars and list views ignore crop borders, so they are drawn whole
+    // and the area has to cover them, including whatever overlaps them.
+    do
+    {
+        grown = 0;
+        for (i = 0; i < screen->component_count; i++)
+        {
+            component = components[i];
+            if (!component->visible)
+                continue;
+            if ((component->type != VTFT_COMPONENT_IMAGE) && (component->type != VTFT_COMPONENT_PROGRESS_BAR) &&
+                (component->type != VTFT_COMPONENT_LIST_VIEW))
+                continue;
+
+            _get_component_borders(component, &border);
+            if (!_borders_overlap(&area, &border))
+                continue;
+
+            if ((border.left < area.left) || (border.top < area.top) ||
+                (border.right > area.right) || (border.bottom > area.bottom))
+            {
+                if (border.left < area.left)
+                    area.left = border.left;
+                if (border.top < area.top)
+                    area.top = border.top;
+                if (border.right > area.right)
+                    area.right = border.right;
+                if (border.bottom > area.bottom)
+                    area.bottom = border.bottom;
+                grown = 1;
+            }
+        }
+    } while (grown);
+
+    if (!gl_set_crop_borders(area.left, area.top, area.bottom, area.right))
+        return;
+
+    // Clear the area with the screen color.
+    gl_set_pen(screen->color, 0);
+    gl_set_brush_style(GL_BRUSH_STYLE_FILL);
+    gl_set_brush_color(screen->color);
+    gl_draw_rect(area.left, area.top, area.right - area.left, area.bottom - area.top);
+
+    if (!instance->occlusion_valid)
+        _update_occlusion(instance, screen);
+
+    for (i = 0; i < screen->component_count; i++)
+    {
+        component = components[i];
+        if (!component->visible || _is_occluded(instance, i))
+            continue;
+
+        _get_component_borders(component, &border);
+        if (!_borders_overlap(&area, &border))
+            continue;
+
+        // Some drawing handles reset crop borders, so set them again for every component.
+        gl_set_crop_borders(area.left, area.top, area.bottom, area.right);
+        vtft_draw_component(instance, component);
+    }
+
+    gl_set_crop_borders(0, 0, gl_get_screen_height(), gl_get_screen_width());
+}
+
+#if VTFT_SCREEN_CACHE_SIZE > 0
+// Returns true for components which are redrawn without redrawing the screen, so they are left out of screen records.
+static vtft_bool_t _is_dynamic_component(const vtft_component * __generic_ptr component)
+{
+    return (component->type == VTFT_COMPONENT_PROGRESS_BAR) || (component->type == VTFT_COMPONENT_LIST_VIEW) ||
+           (component->type == VTFT_COMPONENT_CHART);
+}
+
+// Returns the cache entry of the given screen, or 0 if the screen isn't cached.
+static vtft_screen_cache *_get_screen_cache(vtft_t *instance, const vtft_screen * __generic_ptr screen)
+{
+    uint8_t i;
+
+    if (screen == 0)
+        return 0;
+
+    for (i = 0; i < VTFT_SCREEN_CACHE_SIZE; i++)
+    {
+        if (instance->screen_cache[i].screen == screen)
+            return &instance->screen_cache[i];
+    }
+
+    return 0;
+}
+
+// Draws the dynamic components of the given screen over its played record.
+static void _draw_dynamic_components(vtft_t *instance, const vtft_screen * __generic_ptr screen)
+{
+    vtft_index_t index;
+
+    for (index = 0; index < screen->component_count; index++)
+    {
+        if (!_is_occluded(instance, index) && _is_dynamic_component(screen->components[index]))
+            vtft_draw_component(instance, screen->components[index]);
+    }
+}
+#endif
+
 // Draws the given screen and all of its components.
 void _draw_screen(vtft_t *instance, const vtft_screen * __generic_ptr screen)
 {
-    uint32_t index = 0;
+    vtft_index_t index = 0;
+#if VTFT_SCREEN_CACHE_SIZE > 0
+    vtft_screen_cache *cache = _get_screen_cache(instance, screen);
+    vtft_bool_t recording = 0;
+#endif
+
+    _clear_dirty(instance);
+    instance->frame_pending = 0;
+
+    // Components may have been moved since the last full draw.
+    _build_touch_grid(instance);
+    _update_occlusion(instance, screen);
+
+#if VTFT_SCREEN_CACHE_SIZE > 0
+    // A cached screen is drawn by playing its record, if the record can't be played it is recorded again.
+    if ((cache != 0) && cache->valid)
+    {
+        if (gl_record_play(cache->record))
+        {
+            _draw_dynamic_components(instance, screen);
+            return;
+        }
+        cache->valid = 0;
+    }
+    if (cache != 0)
+        recording = gl_record_start(cache->record);
+#endif
+
+    if (!instance->background_covered)
+        gl_clear(screen->color);
+
+    for (index = 0; index < screen->component_count; index++)
+    {
+        if (_is_occluded(instance, index))
+            continue;
+#if VTFT_SCREEN_CACHE_SIZE > 0
+        // Dynamic components are drawn after the record is finished.
+        if (recording && _is_dynamic_component(screen->components[index]))
+            continue;
+#endif
+        vtft_draw_component(instance, screen->components[index]);
+    }
+
+#if VTFT_SCREEN_CACHE_SIZE > 0
+    if (recording)
+    {
+        cache->valid = gl_record_stop();
+        _draw_dynamic_components(instance, screen);
+    }
+#endif
+}
+
+// Redraws the parts of the current screen marked for redrawing.
+// With a non-zero budget, stops once that many milliseconds are spent, leaving the rest marked.
+// Returns true if everything was redrawn.
+static vtft_bool_t _update_dirty(vtft_t *instance, uint32_t budget)
+{
+    vtft_index_t index;
+    const vtft_screen * __generic_ptr screen = instance->current_screen;
+    vtft_area_t area;
+    uint32_t start = 0;
+
+    if (screen == 0)
+        return 1;
+
+    if (instance->screen_dirty)
+    {
+        _draw_screen(instance, screen);
+        return 1;
+    }
+
+    if (instance->timestamp == 0)
+        budget = 0;
+    if (budget != 0)
+        start = instance->timestamp();
+
+    if (instance->area_dirty)
+    {
+        instance->area_dirty = 0;
+        area.left = instance->dirty_left;
+        area.top = instance->dirty_top;
+        area.right = instance->dirty_right;
+        area.bottom = instance->dirty_bottom;
+        _redraw_area(instance, screen, area);
+    }
+
+    for (index = 0; (index < screen->component_count) && (index < VTFT_MAX_TRACKED_COMPONENTS); index++)
+    {
+        if ((instance->dirty_components[index >> 3] & (1 << (index & 7))) == 0)
+            continue;
+
+        if ((budget != 0) && (instance->timestamp() - start >= budget))
+            return 0;
+
+        instance->dirty_components[index >> 3] &= ~(1 << (index & 7));
+        _get_component_borders(screen->components[index], &area);
+        _redraw_area(instance, screen, area);
+    }
+
+    return 1;
+}
+
+// Prepares the given component for a change of its caption or font.
+static void _begin_text_change(vtft_t *instance, vtft_component *component)
+{
+    gl_rectangle_t rect;
+
+    // Label covers only its caption, so the area it leaves has to be redrawn.
+    if (component->type != VTFT_COMPONENT_LABEL)
+        return;
+
+    _get_component_rect(component, &rect);
+    vtft_invalidate_area(instance, rect.top_left.x, rect.top_left.y, rect.width, rect.height);
+}
+
+// Measures the changed caption of the given component and marks the component for redrawing.
+static void _end_text_change(vtft_t *instance, vtft_component *component)
+{
+    _invalidate_text_metrics(instance, component);
+    if (component->type == VTFT_COMPONENT_LABEL)
+    {
+        _fit_label(instance, (vtft_label *)component);
+        _invalidate_touch_grid(instance);
+    }
+
+    vtft_invalidate_component(instance, component);
+}
+
+// Steps the running tweens and redraws what they changed, at most once per frame period.
+static void _process_animations(vtft_t *instance)
+{
+    vtft_animation_stats *stats = &instance->animation_stats;
+    uint32_t now;
+    uint32_t frame_time;
 
-    gl_clear(screen->color);
+    if ((instance->timestamp == 0) || ((instance->tweens == 0) && !instance->frame_pending))
+        return;
+
+    now = instance->timestamp();
+    if (now - instance->last_frame < VTFT_ANIMATION_FRAME_PERIOD)
+        return;
+    instance->last_frame = now;
+
+    _step_tweens(instance, now);
+    instance->frame_pending = !_update_dirty(instance, VTFT_ANIMATION_FRAME_BUDGET);
 
-    while (index < screen->component_count)
-        vtft_draw_component(instance, screen->components[index++]);
+    frame_time = instance->timestamp() - now;
+    stats->frames++;
+    if (instance->frame_pending)
+        stats->deferred_frames++;
+    stats->last_frame_time = frame_time;
+    stats->total_frame_time += frame_time;
+    if (frame_time > stats->max_frame_time)
+        stats->max_frame_time = frame_time;
 }
 
 // Global Function Definitions
@@ -82,6 +502,8 @@ void vtft_init(vtft_t *vtft_instance, tp_t * tp_instance)
     vtft_instance->draw_handles[VTFT_COMPONENT_CHECK_BOX] = &_draw_check_box;
     vtft_instance->draw_handles[VTFT_COMPONENT_RADIO_BUTTON] = &_draw_radio_button;
     vtft_instance->draw_handles[VTFT_COMPONENT_PROGRESS_BAR] = &_draw_progress_bar;
+    vtft_instance->draw_handles[VTFT_COMPONENT_LIST_VIEW] = &_draw_list_view;
+    vtft_instance->draw_handles[VTFT_COMPONENT_CHART] = &_draw_chart;
 }
 
 // Sets the position of the given progress bar.
@@ -104,6 +526,86 @@ void vtft_set_progress_bar_position(
     _update_progress_bar(instance, progress_bar);
 }
 
+// Sets the caption of the given component and marks it for redrawing.
+vtft_bool_t vtft_set_caption(vtft_t *instance, vtft_component *component, vtft_byte_t * __generic_ptr caption)
+{
+    vtft_text *text = _get_component_text(component);
+
+    if (text == 0)
+        return 0;
+
+    _begin_text_change(instance, component);
+    text->caption = caption;
+    _end_text_change(instance, component);
+    return 1;
+}
+
+// Sets the font of the given component and marks it for redrawing.
+vtft_bool_t vtft_set_font(vtft_t *instance, vtft_component *component, const vtft_byte_t *font_data, gl_color_t color)
+{
+    vtft_text *text = _get_component_text(component);
+    vtft_font *font;
+
+    if (text != 0)
+        font = &text->font;
+    else if (component->type == VTFT_COMPONENT_PROGRESS_BAR)
+        font = &((vtft_progress_bar *)component)->font;
+    else
+        return 0;
+
+    _begin_text_change(instance, component);
+    font->font_data = font_data;
+    font->color = color;
+    _end_text_change(instance, component);
+    return 1;
+}
+
+// Scrolls the given list view to the given position.
+void vtft_set_list_view_scroll(vtft_t *instance, vtft_list_view *list_view, int32_t scroll)
+{
+    if (instance->scrolling_list_view == list_view)
+        instance->scrolling_list_view = 0;
+
+    list_view->speed = 0;
+    list_view->scroll_fraction = 0;
+    _scroll_list_view(instance, list_view, scroll);
+}
+
+// Sets the number of rows of the given list view and redraws it.
+void vtft_set_list_view_row_count(vtft_t *instance, vtft_list_view *list_view, uint16_t row_count)
+{
+    list_view->row_count = row_count;
+    vtft_draw_component(instance, (vtft_component *)list_view);
+}
+
+// Redraws the given row of the list view.
+void vtft_redraw_list_view_row(vtft_t *instance, vtft_list_view *list_view, uint16_t row)
+{
+    _update_list_view_row(instance, list_view, row);
+}
+
+// Adds a sample to the given chart.
+void vtft_add_chart_sample(vtft_t *instance, vtft_chart *chart, int16_t value)
+{
+    _add_chart_sample(instance, chart, value);
+}
+
+// Adds the given samples to the chart, in order.
+void vtft_add_chart_samples(vtft_t *instance, vtft_chart *chart, const int16_t *values, uint16_t count)
+{
+    uint16_t i;
+
+    for (i = 0; i < count; i++)
+        _add_chart_sample(instance, chart, values[i]);
+}
+
+// Removes all samples from the given chart and redraws it.
+void vtft_clear_chart(vtft_t *instance, vtft_chart *chart)
+{
+    chart->sample_count = 0;
+    vtft_draw_component(instance, (vtft_component *)chart);
+}
+
 // Draws the given component, using the appropriate drawing function.
 // void vtft_draw_component(vtft_t *instance, vtft_component *component)
 void vtft_draw_component(vtft_t *instance, const vtft_component * __generic_ptr component)
@@ -117,6 +619,7 @@ void vtft_draw_component(vtft_t *instance, const vtft_component * __generic_ptr
 // Redraws the current screen and all of its components.
 void vtft_refresh_current_screen(vtft_t *instance)
 {
+    vtft_invalidate_screen_cache(instance, instance->current_screen);
     _draw_screen(instance, instance->current_screen);
 }
 
@@ -127,14 +630,211 @@ void vtft_set_current_screen(vtft_t *instance, vtft_screen *screen)
        return;
 
     instance->current_screen = screen;
+    instance->scrolling_list_view = 0;
+    _clear_text_metrics(instance);
     _set_screen_changed(instance);
     _draw_screen(instance, screen);
 }
 
+// Marks the given component of the current screen for redrawing.
+void vtft_invalidate_component(vtft_t *instance, const vtft_component * __generic_ptr component)
+{
+    vtft_index_t index;
+    const vtft_screen * __generic_ptr screen = instance->current_screen;
+
+    if (screen == 0)
+        return;
+
+    for (index = 0; index < screen->component_count; index++)
+    {
+        if (screen->components[index] != component)
+            continue;
+
+        if (index < VTFT_MAX_TRACKED_COMPONENTS)
+            instance->dirty_components[index >> 3] |= 1 << (index & 7);
+        else
+            instance->screen_dirty = 1;
+
+        // Visibility or transparency may have changed.
+        instance->occlusion_valid = 0;
+#if VTFT_SCREEN_CACHE_SIZE > 0
+        if (!_is_dynamic_component(component))
+            vtft_invalidate_screen_cache(instance, screen);
+#endif
+        return;
+    }
+}
+
+// Marks the whole current screen for redrawing.
+void vtft_invalidate_screen(vtft_t *instance)
+{
+    instance->screen_dirty = 1;
+    vtft_invalidate_screen_cache(instance, instance->current_screen);
+}
+
+// Keeps the drawing of the given screen in the given record, or stops caching the screen if record is 0.
+vtft_bool_t vtft_cache_screen(vtft_t *instance, const vtft_screen * __generic_ptr screen, gl_record_t *record)
+{
+#if VTFT_SCREEN_CACHE_SIZE > 0
+    vtft_screen_cache *cache = _get_screen_cache(instance, screen);
+    uint8_t i;
+
+    if (screen == 0)
+        return 0;
+
+    if (cache == 0)
+    {
+        if (record == 0)
+            return 1;
+
+        for (i = 0; i < VTFT_SCREEN_CACHE_SIZE; i++)
+        {
+            if (instance->screen_cache[i].screen == 0)
+            {
+                cache = &instance->screen_cache[i];
+                break;
+            }
+        }
+
+        if (cache == 0)
+            return 0;
+    }
+
+    cache->screen = (record != 0) ? screen : 0;
+    cache->record = record;
+    cache->valid = 0;
+
+    return 1;
+#else
+    return 0;
+#endif
+}
+
+// Marks the record of the given screen as outdated, so that the screen is recorded again when drawn.
+void vtft_invalidate_screen_cache(vtft_t *instance, const vtft_screen * __generic_ptr screen)
+{
+#if VTFT_SCREEN_CACHE_SIZE > 0
+    vtft_screen_cache *cache = _get_screen_cache(instance, screen);
+
+    if (cache != 0)
+        cache->valid = 0;
+#endif
+}
+
+// Redraws the parts of the current screen marked for redrawing.
+void vtft_update(vtft_t *instance)
+{
+    _update_dirty(instance, 0);
+}
+
+// Marks the given area of the current screen for redrawing.
+void vtft_invalidate_area(vtft_t *instance, vtft_coord_t left, vtft_coord_t top, vtft_ucoord_t width, vtft_ucoord_t height)
+{
+    vtft_coord_t right = left + width;
+    vtft_coord_t bottom = top + height;
+
+    if ((width == 0) || (height == 0))
+        return;
+
+    // Components in the area may have been moved.
+    vtft_invalidate_screen_cache(instance, instance->current_screen);
+
+    // Areas are merged into one that covers them all.
+    if (instance->area_dirty)
+    {
+        if (left > instance->dirty_left)
+            left = instance->dirty_left;
+        if (top > instance->dirty_top)
+            top = instance->dirty_top;
+        if (right < instance->dirty_right)
+            right = instance->dirty_right;
+        if (bottom < instance->dirty_bottom)
+            bottom = instance->dirty_bottom;
+    }
+
+    instance->dirty_left = left;
+    instance->dirty_top = top;
+    instance->dirty_right = right;
+    instance->dirty_bottom = bottom;
+    instance->area_dirty = 1;
+}
+
+// Sets the time source of the animations.
+void vtft_set_timestamp(vtft_t *instance, vtft_timestamp_t timestamp)
+{
+    instance->timestamp = timestamp;
+    if (timestamp != 0)
+        instance->last_frame = timestamp() - VTFT_ANIMATION_FRAME_PERIOD;
+}
+
+// Starts the given tween.
+void vtft_start_tween(vtft_t *instance, vtft_tween *tween)
+{
+    _start_tween(instance, tween, (instance->timestamp != 0) ? instance->timestamp() : 0);
+}
+
+// Starts all the given tweens at the same time.
+void vtft_start_timeline(vtft_t *instance, vtft_tween *tweens, uint16_t count)
+{
+    uint32_t now = (instance->timestamp != 0) ? instance->timestamp() : 0;
+    uint16_t i;
+
+    for (i = 0; i < count; i++)
+        _start_tween(instance, &tweens[i], now);
+}
+
+// Stops the given tween.
+void vtft_stop_tween(vtft_t *instance, vtft_tween *tween, vtft_bool_t finish)
+{
+    _stop_tween(instance, tween, finish);
+}
+
+// Gets the measured animation frames.
+void vtft_get_animation_stats(vtft_t *instance, vtft_animation_stats *stats)
+{
+    memcpy(stats, &instance->animation_stats, sizeof(vtft_animation_stats));
+}
+
+// Clears the measured animation frames.
+void vtft_reset_animation_stats(vtft_t *instance)
+{
+    memset(&instance->animation_stats, 0x00, sizeof(vtft_animation_stats));
+}
+
+// Gets the touch event queue counters.
+void vtft_get_event_stats(vtft_t *instance, vtft_event_stats *stats)
+{
+    memcpy(stats, &instance->event_stats, sizeof(vtft_event_stats));
+}
+
+// Clears the touch event queue counters.
+void vtft_reset_event_stats(vtft_t *instance)
+{
+    memset(&instance->event_stats, 0x00, sizeof(vtft_event_stats));
+}
+
+// Gets the number of touch grid entries needed by the current screen.
+uint16_t vtft_get_touch_grid_entries(vtft_t *instance)
+{
+#if VTFT_TOUCH_GRID_ENTRIES > 0
+    return instance->touch_grid.required_entries;
+#else
+    (void *)instance;
+    return 0;
+#endif
+}
+
 // Processes the periodic events.
 void vtft_process(vtft_t *instance)
 {
+    // Nothing to process until a screen is shown, e.g. after a screen failed to load.
+    if (instance->current_screen == 0)
+        return;
+
     _set_current_instance(instance);
     _notify_press_events();
     tp_process(instance->tp_instance);
+    _process_touch_events(instance);
+    _process_list_view_scrolling(instance);
+    _process_animations(instance);
 }
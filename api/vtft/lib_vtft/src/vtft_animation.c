@@ -0,0 +1,276 @@
+/****************************************************************************
+**
+** Copyright (C) 2023 MikroElektronika d.o.o.
+** Contact: https://www.mikroe.com/contact
+**
+** This file is part of the mikroSDK package
+**
+** Commercial License Usage
+**
+** Licensees holding valid commercial NECTO compilers AI licenses may use this
+** file in accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The MikroElektronika Company.
+** For licensing terms and conditions see
+** https://www.mikroe.com/legal/software-license-agreement.
+** For further information use the contact form at
+** https://www.mikroe.com/contact.
+**
+**
+** GNU Lesser General Public License Usage
+**
+** Alternatively, this file may be used for
+** non-commercial projects under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** The above copyright notice and this permission notice shall be
+** included in all copies or substantial portions of the Software.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+** OF MERCHANTABILITY, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED
+** TO THE WARRANTIES FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+** IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+** DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT
+** OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+** OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+**
+****************************************************************************/
+
+#include "vtft_animation.h"
+#include "vtft.h"
+#include "vtft_drawing.h"
+#include "vtft_touch.h"
+
+// Local Variable Definitions
+
+// Cubic ease-in curve, sampled at 16 equal steps. Values are in 1/256 of the whole change.
+static const uint16_t _ease_in_table[17] =
+{
+    0, 0, 0, 2, 4, 8, 14, 21, 32, 46, 62, 83, 108, 137, 172, 211, 256
+};
+
+// Local Function Definitions
+
+// Gets the ease-in curve at the given progress, both in 1/256 of the whole.
+static int32_t _ease_in(int32_t progress)
+{
+    int32_t index = progress >> 4;
+    int32_t fraction = progress & 0x0F;
+
+    if (index >= 16)
+        return 256;
+
+    return _ease_in_table[index] + (((_ease_in_table[index + 1] - _ease_in_table[index]) * fraction) >> 4);
+}
+
+// Gets the part of the whole change done at the given progress, both in 1/256 of the whole.
+static int32_t _ease(vtft_easing easing, int32_t progress)
+{
+    switch (easing)
+    {
+        case VTFT_EASING_IN:
+            return _ease_in(progress);
+
+        case VTFT_EASING_OUT:
+            return 256 - _ease_in(256 - progress);
+
+        case VTFT_EASING_IN_OUT:
+            if (progress < 128)
+                return _ease_in(progress << 1) >> 1;
+            else
+                return 256 - (_ease_in((256 - progress) << 1) >> 1);
+
+        default:
+            return progress;
+    }
+}
+
+// Gets the color between the given two, mixing each channel separately.
+static gl_color_t _mix_colors(gl_color_t from, gl_color_t to, int32_t part)
+{
+    int32_t red = (uint8_t)GL_RED_OF(from);
+    int32_t green = (uint8_t)GL_GREEN_OF(from);
+    int32_t blue = (uint8_t)GL_BLUE_OF(from);
+
+    red += (((int32_t)(uint8_t)GL_RED_OF(to) - red) * part) >> 8;
+    green += (((int32_t)(uint8_t)GL_GREEN_OF(to) - green) * part) >> 8;
+    blue += (((int32_t)(uint8_t)GL_BLUE_OF(to) - blue) * part) >> 8;
+
+    return GL_RGB2COLOR(red, green, blue);
+}
+
+// Marks the area currently covered by the given component for redrawing, before it is moved.
+static void _invalidate_component_area(vtft_t *instance, const vtft_component *component)
+{
+    gl_rectangle_t rect;
+
+    _get_component_rect(component, &rect);
+    vtft_invalidate_area(instance, rect.top_left.x, rect.top_left.y, rect.width, rect.height);
+
+    // Touch areas change too.
+    _invalidate_touch_grid(instance);
+}
+
+// Applies the value of the given tween at the given part of its change.
+static void _apply_tween(vtft_t *instance, vtft_tween *tween, int32_t part)
+{
+    vtft_positioned_component *positioned = (vtft_positioned_component *)tween->component;
+    int32_t value;
+
+    if (tween->property == VTFT_TWEEN_COLOR)
+        value = _mix_colors((gl_color_t)tween->from, (gl_color_t)tween->to, part);
+    else
+        value = tween->from + (((tween->to - tween->from) * part) >> 8);
+
+    // Redraw only when the property really changes.
+    if (tween->applied && (value == tween->value))
+        return;
+    tween->applied = 1;
+    tween->value = value;
+
+    switch (tween->property)
+    {
+        case VTFT_TWEEN_LEFT:
+            _invalidate_component_area(instance, tween->component);
+            positioned->left = (vtft_coord_t)value;
+            vtft_invalidate_component(instance, tween->component);
+            break;
+
+        case VTFT_TWEEN_TOP:
+            _invalidate_component_area(instance, tween->component);
+            positioned->top = (vtft_coord_t)value;
+            vtft_invalidate_component(instance, tween->component);
+            break;
+
+        case VTFT_TWEEN_COLOR:
+            *tween->color = (gl_color_t)value;
+            vtft_invalidate_component(instance, tween->component);
+            break;
+
+        case VTFT_TWEEN_PROGRESS:
+            // Progress bars draw only the changed part themselves.
+            vtft_set_progress_bar_position(instance, (vtft_progress_bar *)tween->component, (vtft_ucoord_t)value);
+            break;
+
+        case VTFT_TWEEN_CUSTOM:
+            if (tween->step != 0)
+                tween->step(tween, value);
+            if (tween->component != 0)
+                vtft_invalidate_component(instance, tween->component);
+            break;
+    }
+}
+
+// Removes the given tween from the running ones.
+static void _unlink_tween(vtft_t *instance, vtft_tween *tween)
+{
+    vtft_tween **link = &instance->tweens;
+
+    while (*link != 0)
+    {
+        if (*link == tween)
+        {
+            *link = tween->next;
+            break;
+        }
+        link = &(*link)->next;
+    }
+
+    tween->next = 0;
+    tween->running = 0;
+}
+
+// Global Function Definitions
+
+// Starts the given tween at the given time, restarting it if it is already running.
+void _start_tween(vtft_t *instance, vtft_tween *tween, uint32_t now)
+{
+    if (tween->running)
+        _unlink_tween(instance, tween);
+
+    tween->start = now + tween->delay;
+    tween->applied = 0;
+    tween->running = 1;
+    tween->next = instance->tweens;
+    instance->tweens = tween;
+}
+
+// Stops the given tween, optionally applying its final value.
+void _stop_tween(vtft_t *instance, vtft_tween *tween, vtft_bool_t finish)
+{
+    if (!tween->running)
+        return;
+
+    _unlink_tween(instance, tween);
+    if (finish)
+        _apply_tween(instance, tween, 256);
+}
+
+// Stops the running tweens which change components of the given screen, without applying their final values.
+void _stop_screen_tweens(vtft_t *instance, const vtft_screen * __generic_ptr screen)
+{
+    vtft_tween **link = &instance->tweens;
+    vtft_tween *tween;
+    vtft_index_t index;
+
+    while ((tween = *link) != 0)
+    {
+        for (index = 0; index < screen->component_count; index++)
+        {
+            if (tween->component == screen->components[index])
+                break;
+        }
+
+        if (index == screen->component_count)
+        {
+            link = &tween->next;
+            continue;
+        }
+
+        *link = tween->next;
+        tween->next = 0;
+        tween->running = 0;
+    }
+}
+
+// Applies the values of all running tweens at the given time and removes the finished ones.
+void _step_tweens(vtft_t *instance, uint32_t now)
+{
+    vtft_tween **link = &instance->tweens;
+    vtft_tween *tween;
+    uint32_t elapsed;
+    int32_t progress;
+
+    while ((tween = *link) != 0)
+    {
+        // Waiting for its delay to pass.
+        elapsed = now - tween->start;
+        if ((int32_t)elapsed < 0)
+        {
+            link = &tween->next;
+            continue;
+        }
+
+        if (elapsed >= tween->duration)
+            progress = 256;
+        else if (tween->duration > 0x00FFFFFF)
+            progress = (int32_t)(elapsed / (tween->duration >> 8));
+        else
+            progress = (int32_t)((elapsed << 8) / tween->duration);
+
+        _apply_tween(instance, tween, _ease(tween->easing, progress));
+        if (progress < 256)
+        {
+            link = &tween->next;
+            continue;
+        }
+
+        // Finished, the done event may start it again.
+        *link = tween->next;
+        tween->next = 0;
+        tween->running = 0;
+        if (tween->done != 0)
+            tween->done(tween);
+    }
+}
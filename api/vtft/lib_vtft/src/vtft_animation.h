@@ -0,0 +1,56 @@
+/****************************************************************************
+**
+** Copyright (C) 2023 MikroElektronika d.o.o.
+** Contact: https://www.mikroe.com/contact
+**
+** This file is part of the mikroSDK package
+**
+** Commercial License Usage
+**
+** Licensees holding valid commercial NECTO compilers AI licenses may use this
+** file in accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The MikroElektronika Company.
+** For licensing terms and conditions see
+** https://www.mikroe.com/legal/software-license-agreement.
+** For further information use the contact form at
+** https://www.mikroe.com/contact.
+**
+**
+** GNU Lesser General Public License Usage
+**
+** Alternatively, this file may be used for
+** non-commercial projects under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** The above copyright notice and this permission notice shall be
+** included in all copies or substantial portions of the Software.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+** OF MERCHANTABILITY, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED
+** TO THE WARRANTIES FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+** IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+** DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT
+** OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+** OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+**
+****************************************************************************/
+
+#ifndef _VTFT_ANIMATION_H_
+#define _VTFT_ANIMATION_H_
+
+#include "vtft_types.h"
+
+// Global Function Declarations
+
+// Starts the given tween at the given time, restarting it if it is already running.
+void _start_tween(vtft_t *instance, vtft_tween *tween, uint32_t now);
+// Stops the given tween, optionally applying its final value.
+void _stop_tween(vtft_t *instance, vtft_tween *tween, vtft_bool_t finish);
+// Stops the running tweens which change components of the given screen, without applying their final values.
+void _stop_screen_tweens(vtft_t *instance, const vtft_screen * __generic_ptr screen);
+// Applies the values of all running tweens at the given time and removes the finished ones.
+void _step_tweens(vtft_t *instance, uint32_t now);
+
+#endif // _VTFT_ANIMATION_H_
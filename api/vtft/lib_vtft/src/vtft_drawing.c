@@ -156,59 +156,89 @@ static void _set_font(vtft_t *instance, const vtft_font * __generic_ptr font, vt
         gl_set_font_orientation(GL_FONT_HORIZONTAL);
 }
 
-// Draws text that is aligned to one of the given edges.
-static void _draw_aligned_text(vtft_t *instance,
-    const vtft_text * __generic_ptr text,
-    vtft_bool_t vertical_text,
+// Measures the caption of the given component, drawn with the font set by _set_font, and places it
+// in the area of the given size: aligned with the given margin to an edge, or centered.
+// Captions are measured once and kept in the entry of the component, until its caption or font is set.
+static const vtft_text_metrics *_get_text_metrics(vtft_t *instance,
+    const vtft_component * __generic_ptr component,
+    const vtft_byte_t * __generic_ptr caption,
     vtft_text_alignment text_align,
-    vtft_coord_t left,
-    vtft_coord_t top,
+    vtft_ucoord_t margin,
     vtft_ucoord_t width,
-    vtft_ucoord_t height)
+    vtft_ucoord_t height,
+    vtft_text_metrics *measured)
 {
-    gl_size_t text_size;
+    vtft_text_metrics *metrics = measured;
 
-    _set_font(instance, &(text->font), vertical_text);
+#if VTFT_TEXT_METRICS_ENTRIES > 0
+    metrics = &instance->text_metrics[component->order % VTFT_TEXT_METRICS_ENTRIES];
+    if (metrics->component == component)
+        return metrics;
+#endif
 
-    text_size = gl_get_text_dimensions(text->caption);
+    metrics->component = component;
+    metrics->size = gl_get_text_dimensions(caption);
 
     if (text_align == VTFT_TEXT_ALIGNMENT_LEFT)
-        left += 4;
+        metrics->offset_x = margin;
     else if (text_align == VTFT_TEXT_ALIGNMENT_RIGHT)
-        left += width - text_size.width - 4;
+        metrics->offset_x = width - metrics->size.width - margin;
     else
-        left += (vtft_coord_t)(width - text_size.width) / 2;
+        metrics->offset_x = (vtft_coord_t)(width - metrics->size.width) / 2;
 
     if (text_align == VTFT_TEXT_ALIGNMENT_TOP)
-        top += 4;
+        metrics->offset_y = margin;
     else if (text_align == VTFT_TEXT_ALIGNMENT_BOTTOM)
-        top += height - text_size.height - 4;
+        metrics->offset_y = height - metrics->size.height - margin;
     else
-        top += (vtft_coord_t)(height - text_size.height) / 2;
+        metrics->offset_y = (vtft_coord_t)(height - metrics->size.height) / 2;
+
+    return metrics;
+}
+
+// Draws text of the given component that is aligned to one of the given edges.
+static void _draw_aligned_text(vtft_t *instance,
+    const vtft_component * __generic_ptr component,
+    const vtft_text * __generic_ptr text,
+    vtft_bool_t vertical_text,
+    vtft_text_alignment text_align,
+    vtft_coord_t left,
+    vtft_coord_t top,
+    vtft_ucoord_t width,
+    vtft_ucoord_t height)
+{
+    const vtft_text_metrics *metrics;
+    vtft_text_metrics measured;
 
-    gl_draw_text(text->caption, left, top);
+    _set_font(instance, &(text->font), vertical_text);
+
+    metrics = _get_text_metrics(instance, component, text->caption, text_align, 4, width, height, &measured);
+    gl_draw_text(text->caption, left + metrics->offset_x, top + metrics->offset_y);
 }
 
 // Draws a text for a check box.
-static void _draw_check_box_text(vtft_t *instance,
+static void _draw_check_box_text(vtft_t *instance, const vtft_component * __generic_ptr component,
     const vtft_byte_t * __generic_ptr caption, vtft_coord_t left, vtft_coord_t top, vtft_ucoord_t height,  const vtft_font * __generic_ptr font)
 {
-    gl_size_t text_size;
+    const vtft_text_metrics *metrics;
+    vtft_text_metrics measured;
 
     // set gl state
     _set_font(instance, font, 0);
 
     // perform actions
-    text_size = gl_get_text_dimensions(caption);
-    gl_draw_text(caption, left, top + (height - text_size.height) / 2);
+    metrics = _get_text_metrics(instance, component, caption, VTFT_TEXT_ALIGNMENT_LEFT, 0, 0, height, &measured);
+    gl_draw_text(caption, left, top + metrics->offset_y);
 }
 
 // Updates the percentage text of the given progress bar.
 static void _update_percentage(vtft_t *instance, vtft_progress_bar *progress_bar)
 {
     vtft_ucoord_t local_position;
-    gl_size_t text_size;
-    char temp[10];
+    const vtft_text_metrics *metrics;
+    vtft_text_metrics measured;
+    // Ten digits and the terminating zero.
+    char temp[11];
 
     if (progress_bar->show_position == 0)
         return;
@@ -220,19 +250,124 @@ static void _update_percentage(vtft_t *instance, vtft_progress_bar *progress_bar
     strcpy(progress_bar->caption, temp);
     if (progress_bar->show_percent != 0)
         strcat(progress_bar->caption, "\%");
+    _invalidate_text_metrics(instance, (vtft_component *)progress_bar);
 
     // set gl state
     _set_font(instance, &(progress_bar->font), 0);
 
     // perform actions
-    text_size = gl_get_text_dimensions(progress_bar->caption);
+    metrics = _get_text_metrics(instance, (vtft_component *)progress_bar, progress_bar->caption,
+        VTFT_TEXT_ALIGNMENT_CENTER, 0, progress_bar->width, progress_bar->height, &measured);
     gl_draw_text(
         progress_bar->caption,
-        progress_bar->left + (progress_bar->width - text_size.width) / 2,
-        progress_bar->top + (progress_bar->height - text_size.height) / 2
+        progress_bar->left + metrics->offset_x,
+        progress_bar->top + metrics->offset_y
     );
 }
 
+// Gets the largest scroll of the given list view, at which its last row touches its bottom.
+static int32_t _get_list_view_max_scroll(const vtft_list_view *list_view)
+{
+    int32_t max_scroll = (int32_t)list_view->row_count * list_view->row_height - list_view->height;
+
+    return (max_scroll > 0) ? max_scroll : 0;
+}
+
+// Clears the given horizontal strip of the list view and draws the rows intersecting it.
+// Leaves the crop borders set to the strip.
+static void _draw_list_view_strip(vtft_list_view *list_view, vtft_coord_t top, vtft_coord_t bottom)
+{
+    vtft_coord_t right = list_view->left + list_view->width;
+    gl_rectangle_t area;
+    int32_t row;
+    int32_t last_row;
+
+    if (bottom <= top)
+        return;
+
+    gl_set_crop_borders(list_view->left, top, bottom, right);
+    gl_set_pen(list_view->back_color, 0);
+    gl_set_brush_style(GL_BRUSH_STYLE_FILL);
+    gl_set_brush_color(list_view->back_color);
+    gl_draw_rect(list_view->left, top, list_view->width, bottom - top);
+
+    if ((list_view->draw_row == 0) || (list_view->row_height == 0) || (list_view->row_count == 0))
+        return;
+
+    row = (top - list_view->top + list_view->scroll) / list_view->row_height;
+    last_row = (bottom - 1 - list_view->top + list_view->scroll) / list_view->row_height;
+    if (last_row >= list_view->row_count)
+        last_row = list_view->row_count - 1;
+
+    area.top_left.x = list_view->left;
+    area.width = list_view->width;
+    area.height = list_view->row_height;
+    for (; row <= last_row; row++)
+    {
+        area.top_left.y = list_view->top + row * list_view->row_height - list_view->scroll;
+
+        // Rows may draw text or images, which reset crop borders.
+        gl_set_crop_borders(list_view->left, top, bottom, right);
+        list_view->draw_row(list_view, row, &area);
+    }
+}
+
+// Gets the number of samples shown by a single column of the given chart.
+static uint16_t _get_chart_column_samples(const vtft_chart *chart)
+{
+    return (chart->samples_per_column != 0) ? chart->samples_per_column : 1;
+}
+
+// Gets the display row of the given chart value, limited to the chart.
+static vtft_coord_t _get_chart_y(const vtft_chart *chart, int32_t value)
+{
+    int32_t range = (int32_t)chart->max_value - chart->min_value;
+    vtft_coord_t bottom = chart->top + chart->height - 1;
+
+    if ((range <= 0) || (value <= chart->min_value))
+        return bottom;
+    if (value >= chart->max_value)
+        return chart->top;
+
+    return bottom - (vtft_coord_t)((value - chart->min_value) * (chart->height - 1) / range);
+}
+
+// Gets the display column of the given chart column, counted from the first sample.
+static vtft_coord_t _get_chart_x(const vtft_chart *chart, uint32_t column, uint32_t column_count)
+{
+    if (chart->scroll)
+        return chart->left + chart->width - (column_count - column);
+    else
+        return chart->left + column % chart->width;
+}
+
+// Draws the trace of the given chart column, from its lowest to its highest sample.
+// The range includes the last sample of the previous column, if it is still kept, so columns are joined.
+static void _draw_chart_trace(const vtft_chart *chart, vtft_coord_t x, uint32_t column, int16_t column_min, int16_t column_max)
+{
+    uint32_t previous = column * _get_chart_column_samples(chart);
+    vtft_coord_t y_top;
+    vtft_coord_t y_bottom;
+    int16_t value;
+
+    if ((chart->samples != 0) && (previous != 0) && (chart->sample_count - previous < chart->capacity))
+    {
+        value = chart->samples[(previous - 1) % chart->capacity];
+        if (value < column_min)
+            column_min = value;
+        if (value > column_max)
+            column_max = value;
+    }
+
+    y_top = _get_chart_y(chart, column_max);
+    y_bottom = _get_chart_y(chart, column_min);
+
+    gl_set_pen(chart->trace_color, 0);
+    gl_set_brush_style(GL_BRUSH_STYLE_FILL);
+    gl_set_brush_color(chart->trace_color);
+    gl_draw_rect(x, y_top, 1, y_bottom - y_top + 1);
+}
+
 // Global Function Definitions
 
 // An empty drawing handle for components with an invalid type.
@@ -323,6 +458,7 @@ void _draw_button(vtft_t *instance, const vtft_component *__generic_ptr componen
     _draw_box(instance, component);
     _draw_aligned_text(
         instance,
+        component,
         &(button->text),
         button->vertical_text,
         button->text_align,
@@ -341,6 +477,7 @@ void _draw_rounded_button(vtft_t *instance, const vtft_component * __generic_ptr
     _draw_rounded_box(instance, component);
     _draw_aligned_text(
         instance,
+        component,
         &(rounded_button->text),
         rounded_button->vertical_text,
         rounded_button->text_align,
@@ -359,6 +496,7 @@ void _draw_circle_button(vtft_t *instance, const vtft_component * __generic_ptr
     _draw_circle(instance, component);
     _draw_aligned_text(
         instance,
+        component,
         &(circle_button->text),
         circle_button->vertical_text,
         circle_button->text_align,
@@ -442,7 +580,7 @@ void _draw_check_box(vtft_t *instance, const vtft_component * __generic_ptr comp
     }
 
     // Draw the text.
-    _draw_check_box_text(instance, check_box->text.caption,
+    _draw_check_box_text(instance, component, check_box->text.caption,
         text_left, top, height, &(check_box->text.font));
 }
 
@@ -494,7 +632,7 @@ void _draw_radio_button(vtft_t *instance, vtft_component *component)
     }
 
     // Draw the text.
-    _draw_check_box_text(instance, radio_button->text.caption,
+    _draw_check_box_text(instance, component, radio_button->text.caption,
         text_left, top, height, &(radio_button->text.font));
 }
 
@@ -732,13 +870,15 @@ void _update_progress_bar(vtft_t *instance, vtft_progress_bar *progress_bar)
     // Delete old text
     gl_coord_t text_start = 0, text_end, text_top;
     gl_size_t text_size;
+    vtft_text_metrics measured;
     if (progress_bar->show_position)
     {
         // Set gl state
         _set_font(instance, &(progress_bar->font), 0);
 
         // perform action
-        text_size = gl_get_text_dimensions(progress_bar->caption);
+        text_size = _get_text_metrics(instance, (vtft_component *)progress_bar, progress_bar->caption,
+            VTFT_TEXT_ALIGNMENT_CENTER, 0, progress_bar->width, progress_bar->height, &measured)->size;
         if (text_size.width >  progress_bar->width)
             text_size.width =  progress_bar->width;
 
@@ -906,3 +1046,393 @@ void _update_progress_bar(vtft_t *instance, vtft_progress_bar *progress_bar)
     progress_bar->prev_pos = progress_bar->position;
     gl_set_crop_borders(0, 0, screen_height, screen_width);
 }
+
+// Draws the given list view, only the rows visible at its current scroll.
+void _draw_list_view(vtft_t *instance, vtft_component *component)
+{
+    vtft_list_view *list_view = (vtft_list_view *)component;
+    int32_t max_scroll = _get_list_view_max_scroll(list_view);
+
+    if (list_view->scroll > max_scroll)
+        list_view->scroll = max_scroll;
+    if (list_view->scroll < 0)
+        list_view->scroll = 0;
+
+    _draw_list_view_strip(list_view, list_view->top, list_view->top + list_view->height);
+    list_view->drawn_scroll = list_view->scroll;
+    gl_set_crop_borders(0, 0, gl_get_screen_height(), gl_get_screen_width());
+}
+
+// Scrolls the given list view to the given scroll, limited to its rows.
+// Rows still visible are moved on the display if the driver supports it, and only the uncovered ones are drawn.
+vtft_bool_t _scroll_list_view(vtft_t *instance, vtft_list_view *list_view, int32_t scroll)
+{
+    int32_t max_scroll = _get_list_view_max_scroll(list_view);
+    vtft_bool_t limited = 0;
+    int32_t delta;
+    gl_rectangle_t moved;
+    vtft_coord_t destination;
+
+    if (scroll > max_scroll)
+    {
+        scroll = max_scroll;
+        limited = 1;
+    }
+    if (scroll < 0)
+    {
+        scroll = 0;
+        limited = 1;
+    }
+
+    list_view->scroll = scroll;
+    delta = scroll - list_view->drawn_scroll;
+    if (delta == 0)
+        return limited;
+
+    if (list_view->visible == 0)
+    {
+        list_view->drawn_scroll = scroll;
+        return limited;
+    }
+
+    if ((delta < (int32_t)list_view->height) && (-delta < (int32_t)list_view->height))
+    {
+        moved.top_left.x = list_view->left;
+        moved.width = list_view->width;
+        if (delta > 0)
+        {
+            moved.top_left.y = list_view->top + delta;
+            moved.height = list_view->height - delta;
+            destination = list_view->top;
+        }
+        else
+        {
+            moved.top_left.y = list_view->top;
+            moved.height = list_view->height + delta;
+            destination = list_view->top - delta;
+        }
+
+        if (gl_copy_rect(&moved, list_view->left, destination))
+        {
+            list_view->drawn_scroll = scroll;
+            if (delta > 0)
+                _draw_list_view_strip(list_view, list_view->top + moved.height, list_view->top + list_view->height);
+            else
+                _draw_list_view_strip(list_view, list_view->top, destination);
+            gl_set_crop_borders(0, 0, gl_get_screen_height(), gl_get_screen_width());
+            return limited;
+        }
+    }
+
+    _draw_list_view(instance, (vtft_component *)list_view);
+    return limited;
+}
+
+// Redraws the given row of the list view, if it is visible.
+void _update_list_view_row(vtft_t *instance, vtft_list_view *list_view, uint16_t row)
+{
+    int32_t top;
+    int32_t bottom;
+
+    if ((list_view->visible == 0) || (row >= list_view->row_count))
+        return;
+
+    top = list_view->top + (int32_t)row * list_view->row_height - list_view->drawn_scroll;
+    bottom = top + list_view->row_height;
+    if (top < list_view->top)
+        top = list_view->top;
+    if (bottom > list_view->top + list_view->height)
+        bottom = list_view->top + list_view->height;
+    if (bottom <= top)
+        return;
+
+    _draw_list_view_strip(list_view, top, bottom);
+    gl_set_crop_borders(0, 0, gl_get_screen_height(), gl_get_screen_width());
+}
+
+// Draws the given chart with the latest samples it keeps.
+void _draw_chart(vtft_t *instance, vtft_component *component)
+{
+    vtft_chart *chart = (vtft_chart *)component;
+    uint16_t column_samples = _get_chart_column_samples(chart);
+    uint32_t column_count = chart->sample_count / column_samples;
+    uint32_t column = 0;
+    uint32_t sample;
+    uint32_t last_sample;
+    int16_t column_min;
+    int16_t column_max;
+    int16_t value;
+
+    gl_set_pen(chart->back_color, 0);
+    gl_set_brush_style(GL_BRUSH_STYLE_FILL);
+    gl_set_brush_color(chart->back_color);
+    gl_draw_rect(chart->left, chart->top, chart->width, chart->height);
+
+    if ((chart->samples == 0) || (chart->capacity == 0) || (chart->width == 0) || (chart->height == 0))
+        return;
+
+    // Only whole columns which are both kept and fit the chart are drawn.
+    if (column_count > chart->width)
+        column = column_count - chart->width;
+    if ((chart->sample_count > chart->capacity) &&
+        (column * column_samples < chart->sample_count - chart->capacity))
+        column = (chart->sample_count - chart->capacity + column_samples - 1) / column_samples;
+
+    for (; column < column_count; column++)
+    {
+        sample = column * column_samples;
+        last_sample = sample + column_samples;
+        column_min = column_max = chart->samples[sample % chart->capacity];
+        for (sample++; sample < last_sample; sample++)
+        {
+            value = chart->samples[sample % chart->capacity];
+            if (value < column_min)
+                column_min = value;
+            if (value > column_max)
+                column_max = value;
+        }
+
+        _draw_chart_trace(chart, _get_chart_x(chart, column, column_count), column, column_min, column_max);
+    }
+}
+
+// Adds the given sample to the chart, drawing the new column once all of its samples are collected.
+// Only that column is drawn; it replaces the oldest column, or the whole trace is moved to the left
+// by the display driver when the chart scrolls.
+void _add_chart_sample(vtft_t *instance, vtft_chart *chart, int16_t value)
+{
+    uint16_t column_samples = _get_chart_column_samples(chart);
+    uint32_t column;
+    vtft_coord_t x;
+    gl_rectangle_t moved;
+
+    if ((chart->sample_count % column_samples) == 0)
+    {
+        chart->column_min = value;
+        chart->column_max = value;
+    }
+    else
+    {
+        if (value < chart->column_min)
+            chart->column_min = value;
+        if (value > chart->column_max)
+            chart->column_max = value;
+    }
+
+    if ((chart->samples != 0) && (chart->capacity != 0))
+        chart->samples[chart->sample_count % chart->capacity] = value;
+    chart->sample_count++;
+
+    if (((chart->sample_count % column_samples) != 0) || (chart->visible == 0) ||
+        (chart->width == 0) || (chart->height == 0))
+        return;
+
+    column = chart->sample_count / column_samples - 1;
+    if (chart->scroll)
+    {
+        moved.top_left.x = chart->left + 1;
+        moved.top_left.y = chart->top;
+        moved.width = chart->width - 1;
+        moved.height = chart->height;
+        if (!gl_copy_rect(&moved, chart->left, chart->top))
+        {
+            chart->scroll = 0;
+            _draw_chart(instance, (vtft_component *)chart);
+            return;
+        }
+    }
+
+    x = _get_chart_x(chart, column, column + 1);
+    gl_set_pen(chart->back_color, 0);
+    gl_set_brush_style(GL_BRUSH_STYLE_FILL);
+    gl_set_brush_color(chart->back_color);
+    gl_draw_rect(x, chart->top, 1, chart->height);
+    _draw_chart_trace(chart, x, column, chart->column_min, chart->column_max);
+}
+
+// Gets the area covered by the given component, including the outer part of its pen.
+void _get_component_rect(const vtft_component * __generic_ptr component, gl_rectangle_t *rect)
+{
+    const vtft_positioned_component * __generic_ptr positioned = (const vtft_positioned_component * __generic_ptr)component;
+    vtft_ucoord_t pen_width = 0;
+
+    switch (component->type)
+    {
+        case VTFT_COMPONENT_LINE:
+        {
+            const vtft_line * __generic_ptr line = (const vtft_line * __generic_ptr)component;
+
+            pen_width = line->pen.width;
+            if (line->first_left < line->second_left)
+            {
+                rect->top_left.x = line->first_left;
+                rect->width = line->second_left - line->first_left + 1;
+            }
+            else
+            {
+                rect->top_left.x = line->second_left;
+                rect->width = line->first_left - line->second_left + 1;
+            }
+
+            if (line->first_top < line->second_top)
+            {
+                rect->top_left.y = line->first_top;
+                rect->height = line->second_top - line->first_top + 1;
+            }
+            else
+            {
+                rect->top_left.y = line->second_top;
+                rect->height = line->first_top - line->second_top + 1;
+            }
+            break;
+        }
+
+        case VTFT_COMPONENT_CIRCLE:
+        case VTFT_COMPONENT_CIRCLE_BUTTON:
+        {
+            const vtft_circle * __generic_ptr circle = (const vtft_circle * __generic_ptr)component;
+
+            pen_width = circle->pen.width;
+            rect->top_left.x = circle->left;
+            rect->top_left.y = circle->top;
+            rect->width = circle->radius << 1;
+            rect->height = circle->radius << 1;
+            break;
+        }
+
+        case VTFT_COMPONENT_LABEL:
+        {
+            const vtft_label * __generic_ptr label = (const vtft_label * __generic_ptr)component;
+
+            rect->width = label->width;
+            rect->height = label->height;
+            break;
+        }
+
+        case VTFT_COMPONENT_IMAGE:
+        {
+            const vtft_image * __generic_ptr image = (const vtft_image * __generic_ptr)component;
+
+            rect->width = image->width;
+            rect->height = image->height;
+            break;
+        }
+
+        case VTFT_COMPONENT_CHART:
+        {
+            const vtft_chart * __generic_ptr chart = (const vtft_chart * __generic_ptr)component;
+
+            rect->width = chart->width;
+            rect->height = chart->height;
+            break;
+        }
+
+        case VTFT_COMPONENT_LIST_VIEW:
+        {
+            const vtft_list_view * __generic_ptr list_view = (const vtft_list_view * __generic_ptr)component;
+
+            rect->width = list_view->width;
+            rect->height = list_view->height;
+            break;
+        }
+
+        case VTFT_COMPONENT_PROGRESS_BAR:
+        {
+            const vtft_progress_bar * __generic_ptr progress_bar = (const vtft_progress_bar * __generic_ptr)component;
+
+            pen_width = progress_bar->pen.width;
+            rect->width = progress_bar->width;
+            rect->height = progress_bar->height;
+            break;
+        }
+
+        case VTFT_COMPONENT_BOX:
+        case VTFT_COMPONENT_ROUNDED_BOX:
+        case VTFT_COMPONENT_ELLIPSE:
+        case VTFT_COMPONENT_BUTTON:
+        case VTFT_COMPONENT_ROUNDED_BUTTON:
+        case VTFT_COMPONENT_CHECK_BOX:
+        case VTFT_COMPONENT_RADIO_BUTTON:
+        {
+            const vtft_box * __generic_ptr box = (const vtft_box * __generic_ptr)component;
+
+            pen_width = box->pen.width;
+            rect->width = box->width;
+            rect->height = box->height;
+            break;
+        }
+
+        default:
+            rect->top_left.x = 0;
+            rect->top_left.y = 0;
+            rect->width = 0;
+            rect->height = 0;
+            return;
+    }
+
+    if (component->type != VTFT_COMPONENT_LINE)
+    {
+        rect->top_left.x = positioned->left;
+        rect->top_left.y = positioned->top;
+    }
+
+    // Pen is drawn centered on the outline, so it may stick out by its whole width.
+    rect->top_left.x -= pen_width;
+    rect->top_left.y -= pen_width;
+    rect->width += pen_width << 1;
+    rect->height += pen_width << 1;
+}
+
+// Gets the text of the given component, 0 for components without an editable one.
+vtft_text *_get_component_text(vtft_component *component)
+{
+    switch (component->type)
+    {
+        case VTFT_COMPONENT_LABEL:
+            return &((vtft_label *)component)->text;
+        case VTFT_COMPONENT_BUTTON:
+            return &((vtft_button *)component)->text;
+        case VTFT_COMPONENT_ROUNDED_BUTTON:
+            return &((vtft_rounded_button *)component)->text;
+        case VTFT_COMPONENT_CIRCLE_BUTTON:
+            return &((vtft_circle_button *)component)->text;
+        case VTFT_COMPONENT_CHECK_BOX:
+            return &((vtft_check_box *)component)->text;
+        case VTFT_COMPONENT_RADIO_BUTTON:
+            return &((vtft_radio_button *)component)->text;
+        default:
+            return 0;
+    }
+}
+
+// Drops the measured caption of the given component, so that it is measured when drawn next time.
+void _invalidate_text_metrics(vtft_t *instance, const vtft_component * __generic_ptr component)
+{
+#if VTFT_TEXT_METRICS_ENTRIES > 0
+    vtft_text_metrics *metrics = &instance->text_metrics[component->order % VTFT_TEXT_METRICS_ENTRIES];
+
+    if (metrics->component == component)
+        metrics->component = 0;
+#endif
+}
+
+// Drops the measured captions of all components.
+void _clear_text_metrics(vtft_t *instance)
+{
+#if VTFT_TEXT_METRICS_ENTRIES > 0
+    memset(instance->text_metrics, 0x00, sizeof(instance->text_metrics));
+#endif
+}
+
+// Sets the size of the given label to the size of its caption.
+void _fit_label(vtft_t *instance, vtft_label *label)
+{
+    const vtft_text_metrics *metrics;
+    vtft_text_metrics measured;
+
+    _set_font(instance, &(label->text.font), label->vertical_text);
+    metrics = _get_text_metrics(instance, (vtft_component *)label, label->text.caption,
+        VTFT_TEXT_ALIGNMENT_LEFT, 0, 0, 0, &measured);
+    label->width = metrics->size.width;
+    label->height = metrics->size.height;
+}
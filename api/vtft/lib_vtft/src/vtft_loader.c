@@ -0,0 +1,617 @@
+/****************************************************************************
+**
+** Copyright (C) 2023 MikroElektronika d.o.o.
+** Contact: https://www.mikroe.com/contact
+**
+** This file is part of the mikroSDK package
+**
+** Commercial License Usage
+**
+** Licensees holding valid commercial NECTO compilers AI licenses may use this
+** file in accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The MikroElektronika Company.
+** For licensing terms and conditions see
+** https://www.mikroe.com/legal/software-license-agreement.
+** For further information use the contact form at
+** https://www.mikroe.com/contact.
+**
+**
+** GNU Lesser General Public License Usage
+**
+** Alternatively, this file may be used for
+** non-commercial projects under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** The above copyright notice and this permission notice shall be
+** included in all copies or substantial portions of the Software.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+** OF MERCHANTABILITY, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED
+** TO THE WARRANTIES FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+** IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+** DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT
+** OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+** OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+**
+****************************************************************************/
+
+#include "vtft_loader.h"
+#include <string.h>
+#include "vtft.h"
+#include "gl_colors.h"
+#include "vtft_animation.h"
+
+// Sizes of the records of the binary screen format.
+#define _HEADER_SIZE    16
+#define _STYLE_SIZE     36
+#define _SCREEN_SIZE    16
+#define _COMPONENT_SIZE 36
+
+// Local Type Definitions
+
+// Style shared by components, converted to the types used by the components.
+typedef struct
+{
+    vtft_pen pen;
+    vtft_press_gradient gradient;
+    vtft_font font;
+    gl_color_t back_color;
+}
+vtft_loader_style_t;
+
+// Last style read, components next to each other mostly share their style.
+typedef struct
+{
+    uint16_t index;
+    vtft_loader_style_t style;
+}
+vtft_loader_style_cache_t;
+
+// Local Variable Definitions
+
+// Caption of components without one.
+static vtft_byte_t _empty_caption[1] = {0};
+
+// Local Function Definitions
+
+// Reads a little endian 16-bit number.
+static uint16_t _get_u16(const uint8_t *data)
+{
+    return (uint16_t)data[0] | ((uint16_t)data[1] << 8);
+}
+
+// Reads a little endian 32-bit number.
+static uint32_t _get_u32(const uint8_t *data)
+{
+    return (uint32_t)data[0] | ((uint32_t)data[1] << 8) | ((uint32_t)data[2] << 16) | ((uint32_t)data[3] << 24);
+}
+
+// Reads a 0xRRGGBB color, converted to the color depth of the library.
+static gl_color_t _get_color(const uint8_t *data)
+{
+    return GL_RGB2COLOR(data[2], data[1], data[0]);
+}
+
+// Reads the given part of the screen data.
+static vtft_bool_t _read(vtft_loader_t *loader, uint32_t offset, uint8_t *buffer, uint32_t size)
+{
+    const uint8_t * __generic_ptr data;
+
+    if (loader->data != 0)
+    {
+        for (data = loader->data + offset; size != 0; size--)
+            *buffer++ = *data++;
+        return 1;
+    }
+
+#ifdef VTFT_SCREEN_FILES_ENABLED
+    if (loader->file != 0)
+    {
+        if (file_seek(loader->file, offset, SEEK_START) != FSS_OK)
+            return 0;
+        return file_read(loader->file, buffer, size) == FSS_OK;
+    }
+#endif
+
+    return 0;
+}
+
+// Takes zeroed memory for the loaded screen, 0 if there is not enough of it left.
+static void * _allocate(vtft_loader_t *loader, uint32_t size)
+{
+    uint8_t *memory;
+
+    size = (size + 3) & ~(uint32_t)3;
+    if (loader->memory_used + size > loader->memory_size)
+        return 0;
+
+    memory = loader->memory + loader->memory_used;
+    loader->memory_used += size;
+    memset(memory, 0x00, size);
+
+    return memory;
+}
+
+// Gets the event with the given index. Returns false if there is no such event.
+static vtft_bool_t _get_event(vtft_loader_t *loader, uint8_t index, vtft_event *event)
+{
+    *event = 0;
+    if (index == VTFT_SCREEN_NO_RESOURCE)
+        return 1;
+    if (index >= loader->resources->event_count)
+        return 0;
+
+    *event = loader->resources->events[index];
+    return 1;
+}
+
+// Reads the header of the opened screen data.
+static vtft_loader_err_t _open(vtft_loader_t *loader)
+{
+    uint8_t header[_HEADER_SIZE];
+    uint16_t version;
+
+    loader->screen = 0;
+    loader->memory_used = 0;
+    if (!_read(loader, 0, header, _HEADER_SIZE))
+        return VTFT_LOADER_ERROR_READ;
+
+    if ((header[0] != 'V') || (header[1] != 'T') || (header[2] != 'S') || (header[3] != 'C'))
+        return VTFT_LOADER_ERROR_FORMAT;
+
+    version = _get_u16(&header[4]);
+    if (version == 0)
+        return VTFT_LOADER_ERROR_FORMAT;
+    if (version > VTFT_SCREEN_FORMAT_VERSION)
+        return VTFT_LOADER_ERROR_VERSION;
+
+    loader->screen_count = _get_u16(&header[6]);
+    loader->style_count = _get_u16(&header[8]);
+    loader->style_offset = _get_u32(&header[12]);
+
+    return VTFT_LOADER_OK;
+}
+
+// Gets the style with the given index, reading it only if it is not the cached one.
+static vtft_loader_err_t _get_style(vtft_loader_t *loader, vtft_loader_style_cache_t *cache, uint16_t index)
+{
+    uint8_t record[_STYLE_SIZE];
+    vtft_loader_style_t *style = &cache->style;
+
+    if (index == cache->index)
+        return VTFT_LOADER_OK;
+
+    if (index >= loader->style_count)
+        return VTFT_LOADER_ERROR_FORMAT;
+    if (!_read(loader, loader->style_offset + (uint32_t)index * _STYLE_SIZE, record, _STYLE_SIZE))
+        return VTFT_LOADER_ERROR_READ;
+
+    style->pen.color = _get_color(&record[0]);
+    style->pen.width = _get_u16(&record[28]);
+    style->gradient.start_color = _get_color(&record[4]);
+    style->gradient.end_color = _get_color(&record[8]);
+    style->gradient.press_start_color = _get_color(&record[12]);
+    style->gradient.press_end_color = _get_color(&record[16]);
+    style->gradient.gradient_style = (vtft_gradient_style)record[30];
+    style->gradient.transparent = record[31];
+    style->font.color = _get_color(&record[20]);
+    style->back_color = _get_color(&record[24]);
+
+    style->font.font_data = 0;
+    if (record[32] != VTFT_SCREEN_NO_RESOURCE)
+    {
+        if (record[32] >= loader->resources->font_count)
+            return VTFT_LOADER_ERROR_FORMAT;
+        style->font.font_data = loader->resources->fonts[record[32]];
+    }
+
+    cache->index = index;
+    return VTFT_LOADER_OK;
+}
+
+// Gets the caption of the component, stored at the given offset.
+// Captions in memory mapped data are used in place, unless they can be edited to be longer,
+// so the caption may be in flash memory and its pointer stays generic.
+static vtft_byte_t * __generic_ptr _get_caption(vtft_loader_t *loader, uint32_t offset, const uint8_t *record)
+{
+    uint16_t length = _get_u16(&record[32]);
+    uint16_t max_length = _get_u16(&record[34]);
+    vtft_byte_t *caption;
+
+    if (max_length < length)
+        max_length = length;
+    if (max_length == 0)
+        return _empty_caption;
+
+    if ((loader->data != 0) && (max_length == length))
+        return (vtft_byte_t * __generic_ptr)(loader->data + offset);
+
+    caption = (vtft_byte_t *)_allocate(loader, max_length + 1);
+    if (caption == 0)
+        return 0;
+    if ((length != 0) && !_read(loader, offset, caption, length))
+        return 0;
+
+    return caption;
+}
+
+// Fills the text of the component.
+static vtft_loader_err_t _get_text(vtft_loader_t *loader, uint32_t offset, const uint8_t *record,
+    const vtft_loader_style_t *style, vtft_text *text)
+{
+    text->caption = _get_caption(loader, offset, record);
+    if (text->caption == 0)
+        return VTFT_LOADER_ERROR_MEMORY;
+
+    text->max_length = _get_u16(&record[34]);
+    text->font = style->font;
+
+    return VTFT_LOADER_OK;
+}
+
+// Gets the size of the given component type in memory, 0 for types which can't be loaded.
+static uint32_t _get_component_size(uint8_t type)
+{
+    switch (type)
+    {
+        case VTFT_COMPONENT_BOX: return sizeof(vtft_box);
+        case VTFT_COMPONENT_ROUNDED_BOX: return sizeof(vtft_rounded_box);
+        case VTFT_COMPONENT_CIRCLE: return sizeof(vtft_circle);
+        case VTFT_COMPONENT_ELLIPSE: return sizeof(vtft_ellipse);
+        case VTFT_COMPONENT_LINE: return sizeof(vtft_line);
+        case VTFT_COMPONENT_LABEL: return sizeof(vtft_label);
+        case VTFT_COMPONENT_BUTTON: return sizeof(vtft_button);
+        case VTFT_COMPONENT_ROUNDED_BUTTON: return sizeof(vtft_rounded_button);
+        case VTFT_COMPONENT_CIRCLE_BUTTON: return sizeof(vtft_circle_button);
+        case VTFT_COMPONENT_IMAGE: return sizeof(vtft_image);
+        case VTFT_COMPONENT_CHECK_BOX: return sizeof(vtft_check_box);
+        case VTFT_COMPONENT_RADIO_BUTTON: return sizeof(vtft_radio_button);
+        case VTFT_COMPONENT_PROGRESS_BAR: return sizeof(vtft_progress_bar);
+        default: return 0;
+    }
+}
+
+// Builds the component described by the given record, whose caption follows at the given offset.
+static vtft_loader_err_t _load_component(vtft_loader_t *loader, vtft_loader_style_cache_t *cache,
+    const uint8_t *record, uint32_t offset, vtft_index_t order, vtft_component **loaded)
+{
+    uint8_t type = record[0];
+    uint8_t flags = record[1];
+    vtft_coord_t left = (vtft_coord_t)_get_u16(&record[4]);
+    vtft_coord_t top = (vtft_coord_t)_get_u16(&record[6]);
+    vtft_ucoord_t width = _get_u16(&record[8]);
+    vtft_ucoord_t height = _get_u16(&record[10]);
+    vtft_ucoord_t corner_radius = _get_u16(&record[12]);
+    vtft_text_alignment text_align = (vtft_text_alignment)record[14];
+    const vtft_loader_style_t *style = &cache->style;
+    vtft_component *component;
+    vtft_active_component *active;
+    vtft_colored_component *colored;
+    vtft_loader_err_t error;
+    uint32_t size;
+    uint8_t i;
+
+    size = _get_component_size(type);
+    if (size == 0)
+        return VTFT_LOADER_ERROR_FORMAT;
+
+    error = _get_style(loader, cache, _get_u16(&record[2]));
+    if (error != VTFT_LOADER_OK)
+        return error;
+
+    component = (vtft_component *)_allocate(loader, size);
+    if (component == 0)
+        return VTFT_LOADER_ERROR_MEMORY;
+
+    component->type = (vtft_comp_type_t)type;
+    component->order = order;
+    component->visible = (flags & VTFT_SCREEN_FLAG_VISIBLE) != 0;
+
+    // All types but lines and progress bars begin as active components, most of them as colored ones.
+    active = (vtft_active_component *)component;
+    colored = (vtft_colored_component *)component;
+    if ((type != VTFT_COMPONENT_LINE) && (type != VTFT_COMPONENT_PROGRESS_BAR))
+    {
+        active->left = left;
+        active->top = top;
+        active->active = (flags & VTFT_SCREEN_FLAG_ACTIVE) != 0;
+        for (i = 0; i < 4; i++)
+        {
+            vtft_event *event = (i == 0) ? &active->event_set.press_event :
+                                (i == 1) ? &active->event_set.down_event :
+                                (i == 2) ? &active->event_set.up_event : &active->event_set.click_event;
+            if (!_get_event(loader, record[16 + i], event))
+                return VTFT_LOADER_ERROR_FORMAT;
+        }
+
+        if ((type != VTFT_COMPONENT_LABEL) && (type != VTFT_COMPONENT_IMAGE))
+        {
+            colored->pen = style->pen;
+            colored->press_gradient = style->gradient;
+        }
+    }
+
+    error = VTFT_LOADER_OK;
+    switch (type)
+    {
+        case VTFT_COMPONENT_BOX:
+        case VTFT_COMPONENT_ELLIPSE:
+            ((vtft_box *)component)->width = width;
+            ((vtft_box *)component)->height = height;
+            break;
+
+        case VTFT_COMPONENT_ROUNDED_BOX:
+        {
+            vtft_rounded_box *box = (vtft_rounded_box *)component;
+
+            box->width = width;
+            box->height = height;
+            box->corner_radius = corner_radius;
+            break;
+        }
+
+        case VTFT_COMPONENT_CIRCLE:
+            ((vtft_circle *)component)->radius = width;
+            break;
+
+        case VTFT_COMPONENT_LINE:
+        {
+            vtft_line *line = (vtft_line *)component;
+
+            line->pen = style->pen;
+            line->first_left = left;
+            line->first_top = top;
+            line->second_left = (vtft_coord_t)width;
+            line->second_top = (vtft_coord_t)height;
+            break;
+        }
+
+        case VTFT_COMPONENT_LABEL:
+        {
+            vtft_label *label = (vtft_label *)component;
+
+            label->width = width;
+            label->height = height;
+            label->vertical_text = (flags & VTFT_SCREEN_FLAG_VERTICAL_TEXT) != 0;
+            error = _get_text(loader, offset, record, style, &label->text);
+            break;
+        }
+
+        case VTFT_COMPONENT_BUTTON:
+        {
+            vtft_button *button = (vtft_button *)component;
+
+            button->width = width;
+            button->height = height;
+            button->text_align = text_align;
+            button->vertical_text = (flags & VTFT_SCREEN_FLAG_VERTICAL_TEXT) != 0;
+            error = _get_text(loader, offset, record, style, &button->text);
+            break;
+        }
+
+        case VTFT_COMPONENT_ROUNDED_BUTTON:
+        {
+            vtft_rounded_button *button = (vtft_rounded_button *)component;
+
+            button->width = width;
+            button->height = height;
+            button->corner_radius = corner_radius;
+            button->text_align = text_align;
+            button->vertical_text = (flags & VTFT_SCREEN_FLAG_VERTICAL_TEXT) != 0;
+            error = _get_text(loader, offset, record, style, &button->text);
+            break;
+        }
+
+        case VTFT_COMPONENT_CIRCLE_BUTTON:
+        {
+            vtft_circle_button *button = (vtft_circle_button *)component;
+
+            button->radius = width;
+            button->text_align = text_align;
+            button->vertical_text = (flags & VTFT_SCREEN_FLAG_VERTICAL_TEXT) != 0;
+            error = _get_text(loader, offset, record, style, &button->text);
+            break;
+        }
+
+        case VTFT_COMPONENT_IMAGE:
+        {
+            vtft_image *image = (vtft_image *)component;
+
+            if (record[15] >= loader->resources->picture_count)
+                return VTFT_LOADER_ERROR_FORMAT;
+
+            image->width = width;
+            image->height = height;
+            image->picture_data = loader->resources->pictures[record[15]];
+            image->ratio = _get_u32(&record[20]);
+            break;
+        }
+
+        case VTFT_COMPONENT_CHECK_BOX:
+        {
+            vtft_check_box *check_box = (vtft_check_box *)component;
+
+            check_box->width = width;
+            check_box->height = height;
+            check_box->text_align = text_align;
+            check_box->checked = (flags & VTFT_SCREEN_FLAG_CHECKED) != 0;
+            check_box->corner_radius = corner_radius;
+            error = _get_text(loader, offset, record, style, &check_box->text);
+            break;
+        }
+
+        case VTFT_COMPONENT_RADIO_BUTTON:
+        {
+            vtft_radio_button *radio_button = (vtft_radio_button *)component;
+
+            radio_button->width = width;
+            radio_button->height = height;
+            radio_button->text_align = text_align;
+            radio_button->checked = (flags & VTFT_SCREEN_FLAG_CHECKED) != 0;
+            radio_button->back_color = style->back_color;
+            error = _get_text(loader, offset, record, style, &radio_button->text);
+            break;
+        }
+
+        case VTFT_COMPONENT_PROGRESS_BAR:
+        {
+            vtft_progress_bar *progress_bar = (vtft_progress_bar *)component;
+
+            progress_bar->left = left;
+            progress_bar->top = top;
+            progress_bar->width = width;
+            progress_bar->height = height;
+            progress_bar->corner_radius = corner_radius;
+            progress_bar->font = style->font;
+            progress_bar->pen = style->pen;
+            progress_bar->gradient.transparent = style->gradient.transparent;
+            progress_bar->gradient.gradient_style = style->gradient.gradient_style;
+            progress_bar->gradient.start_color = style->gradient.start_color;
+            progress_bar->gradient.end_color = style->gradient.end_color;
+            progress_bar->back_color = style->back_color;
+            progress_bar->position = _get_u32(&record[20]);
+            progress_bar->prev_pos = progress_bar->position;
+            progress_bar->min_position = _get_u32(&record[24]);
+            progress_bar->max_position = _get_u32(&record[28]);
+            progress_bar->smooth = (flags & VTFT_SCREEN_FLAG_SMOOTH) != 0;
+            progress_bar->show_percent = (flags & VTFT_SCREEN_FLAG_SHOW_PERCENT) != 0;
+            progress_bar->show_position = (flags & VTFT_SCREEN_FLAG_SHOW_POSITION) != 0;
+
+            // Percentage is written into the caption, "100%" has to fit.
+            progress_bar->caption = (vtft_byte_t *)_allocate(loader, 8);
+            if (progress_bar->caption == 0)
+                return VTFT_LOADER_ERROR_MEMORY;
+            break;
+        }
+    }
+
+    *loaded = component;
+    return error;
+}
+
+// Global Function Definitions
+
+// Initializes the screen loader.
+void vtft_loader_init(vtft_loader_t *loader, const vtft_loader_resources_t *resources, uint8_t *memory, uint32_t memory_size)
+{
+    memset(loader, 0x00, sizeof(vtft_loader_t));
+    loader->resources = resources;
+    loader->memory = memory;
+    loader->memory_size = memory_size;
+}
+
+// Opens screens placed in memory.
+vtft_loader_err_t vtft_loader_open_memory(vtft_loader_t *loader, const uint8_t * __generic_ptr data)
+{
+    loader->data = data;
+#ifdef VTFT_SCREEN_FILES_ENABLED
+    loader->file = 0;
+#endif
+
+    return _open(loader);
+}
+
+#ifdef VTFT_SCREEN_FILES_ENABLED
+// Opens screens stored in a file.
+vtft_loader_err_t vtft_loader_open_file(vtft_loader_t *loader, file_t *file)
+{
+    loader->data = 0;
+    loader->file = file;
+
+    return _open(loader);
+}
+#endif
+
+// Loads the given screen.
+vtft_loader_err_t vtft_loader_load_screen(vtft_loader_t *loader, uint16_t index, vtft_screen **screen)
+{
+    uint8_t record[_COMPONENT_SIZE];
+    vtft_loader_style_cache_t cache;
+    vtft_screen *loaded;
+    vtft_component **components;
+    vtft_loader_err_t error;
+    uint32_t offset;
+    vtft_index_t i;
+
+    // Previous screen is released.
+    loader->screen = 0;
+    loader->memory_used = 0;
+    cache.index = 0xFFFF;
+
+    if (index >= loader->screen_count)
+        return VTFT_LOADER_ERROR_INDEX;
+
+    if (!_read(loader, _HEADER_SIZE + (uint32_t)index * 4, record, 4))
+        return VTFT_LOADER_ERROR_READ;
+    offset = _get_u32(record);
+    if (!_read(loader, offset, record, _SCREEN_SIZE))
+        return VTFT_LOADER_ERROR_READ;
+
+    loaded = (vtft_screen *)_allocate(loader, sizeof(vtft_screen));
+    if (loaded == 0)
+        return VTFT_LOADER_ERROR_MEMORY;
+
+    loaded->width = _get_u16(&record[0]);
+    loaded->height = _get_u16(&record[2]);
+    loaded->color = _get_color(&record[4]);
+    if (!_get_event(loader, record[8], &loaded->press_event) ||
+        !_get_event(loader, record[9], &loaded->down_event) ||
+        !_get_event(loader, record[10], &loaded->up_event))
+        return VTFT_LOADER_ERROR_FORMAT;
+    loaded->component_count = _get_u16(&record[12]);
+
+    components = (vtft_component **)_allocate(loader, loaded->component_count * sizeof(vtft_component *));
+    if ((components == 0) && (loaded->component_count != 0))
+        return VTFT_LOADER_ERROR_MEMORY;
+    loaded->components = components;
+
+    offset += _SCREEN_SIZE;
+    for (i = 0; i < loaded->component_count; i++)
+    {
+        if (!_read(loader, offset, record, _COMPONENT_SIZE))
+            return VTFT_LOADER_ERROR_READ;
+        offset += _COMPONENT_SIZE;
+
+        error = _load_component(loader, &cache, record, offset, i, &components[i]);
+        if (error != VTFT_LOADER_OK)
+            return error;
+
+        // Captions are padded to 4 bytes.
+        offset += ((uint32_t)_get_u16(&record[32]) + 3) & ~(uint32_t)3;
+    }
+
+    loader->screen = loaded;
+    *screen = loaded;
+    return VTFT_LOADER_OK;
+}
+
+// Loads the given screen and shows it.
+vtft_loader_err_t vtft_loader_show_screen(vtft_t *instance, vtft_loader_t *loader, uint16_t index)
+{
+    vtft_screen *screen;
+    vtft_loader_err_t error;
+
+    // Loading releases the shown screen, so nothing may refer to it any more.
+    // Its cache entry would be taken by the next screen, built at the same address.
+    if (loader->screen != 0)
+    {
+        _stop_screen_tweens(instance, loader->screen);
+        vtft_cache_screen(instance, loader->screen, 0);
+    }
+    if (instance->current_screen == loader->screen)
+    {
+        instance->current_screen = 0;
+        instance->current_active_component = 0;
+        instance->pressed_component = 0;
+        instance->scrolling_list_view = 0;
+    }
+
+    error = vtft_loader_load_screen(loader, index, &screen);
+    if (error != VTFT_LOADER_OK)
+        return error;
+
+    vtft_set_current_screen(instance, screen);
+    return VTFT_LOADER_OK;
+}
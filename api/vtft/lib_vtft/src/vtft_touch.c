@@ -40,95 +40,176 @@
 #include "vtft_touch.h"
 #include <string.h>
 #include "vtft.h"
+#include "vtft_drawing.h"
 
 // Currently used VTFT instance. Needed for TP callbacks.
 static vtft_t *_current_instance = 0;
 
 // Local Function Definitions
 
-// Returns the frontmost active component at the given coordinates.
-static vtft_active_component * __generic_ptr _get_active_component(vtft_t * instance, vtft_coord_t x, vtft_coord_t y)
+// Returns true if the given component can be touched at the given coordinates.
+static vtft_bool_t _hit_component(vtft_component * __generic_ptr component, vtft_coord_t x, vtft_coord_t y)
 {
-    int32_t i;
-    vtft_component * __generic_ptr * __generic_ptr components = instance->current_screen->components;
-    vtft_index_t component_count = instance->current_screen->component_count;
+    vtft_component_type type;
+    vtft_positioned_component * __generic_ptr positioned_component;
+    vtft_coord_t left;
+    vtft_coord_t top;
 
-    for (i = component_count - 1; i >= 0; i--)
+    if (component->visible == 0)
+        return 0;
+
+    type = component->type;
+
+    // Skip if the component isn't an active component.
+    if ((type == VTFT_COMPONENT_LINE) || (type == VTFT_COMPONENT_PROGRESS_BAR) || (type == VTFT_COMPONENT_CHART))
+        return 0;
+
+    // Skip if the coordinates are to the left or above the component.
+    positioned_component = (vtft_positioned_component * __generic_ptr)component;
+    left = positioned_component->left;
+    top = positioned_component->top;
+    if ((x < left) || (y < top))
+        return 0;
+
+    // Check all component types.
+
+    if ((type == VTFT_COMPONENT_CIRCLE) ||
+        (type == VTFT_COMPONENT_CIRCLE_BUTTON))
     {
-        vtft_component * __generic_ptr component;
-        vtft_component_type type;
-        vtft_positioned_component * __generic_ptr positioned_component;
-        vtft_coord_t left;
-        vtft_coord_t top;
-
-        component = components[i];
-        if (component->visible == 0)
-            continue;
+        vtft_circle * __generic_ptr circle = (vtft_circle *__generic_ptr) component;
+        vtft_ucoord_t diameter = circle->radius << 1;
+        if ((x < left + diameter) && (y < top + diameter))
+            return 1;
+    }
 
-        type = component->type;
+    if ((type == VTFT_COMPONENT_BOX) ||
+        (type == VTFT_COMPONENT_ROUNDED_BOX) ||
+        (type == VTFT_COMPONENT_BUTTON) ||
+        (type == VTFT_COMPONENT_ROUNDED_BUTTON) ||
+        (type == VTFT_COMPONENT_ELLIPSE))
+    {
+        vtft_box * __generic_ptr box = (vtft_box * __generic_ptr)component;
+        if ((x < left + box->width) && (y < top + box->height))
+            return 1;
+    }
 
-        // Skip if the component isn't an active component.
-        if ((type == VTFT_COMPONENT_LINE) || (type == VTFT_COMPONENT_PROGRESS_BAR))
-            continue;
+    if (type == VTFT_COMPONENT_LABEL)
+    {
+        vtft_label * __generic_ptr label = (vtft_label * __generic_ptr)component;
+        if ((x < left + label->width) && (y < top + label->height))
+            return 1;
+    }
 
-        // Skip if the coordinates are to the left or above the component.
-        positioned_component = (vtft_positioned_component * __generic_ptr)component;
-        left = positioned_component->left;
-        top = positioned_component->top;
-        if ((x < left) || (y < top))
-            continue;
+    if (type == VTFT_COMPONENT_LIST_VIEW)
+    {
+        vtft_list_view * __generic_ptr list_view = (vtft_list_view * __generic_ptr)component;
+        if ((x < left + list_view->width) && (y < top + list_view->height))
+            return 1;
+    }
 
-        // Check all component types.
+    if (type == VTFT_COMPONENT_IMAGE)
+    {
+        vtft_image * __generic_ptr image = (vtft_image * __generic_ptr)component;
+        if ((x < left + image->width) && (y < top + image->height))
+            return 1;
+    }
 
-        if ((type == VTFT_COMPONENT_CIRCLE) ||
-            (type == VTFT_COMPONENT_CIRCLE_BUTTON))
+    if ((type == VTFT_COMPONENT_CHECK_BOX) ||
+        (type == VTFT_COMPONENT_RADIO_BUTTON))
+    {
+        vtft_check_box * __generic_ptr box = (vtft_check_box * __generic_ptr)component;
+        if (box->text_align == VTFT_TEXT_ALIGNMENT_LEFT)
         {
-            vtft_circle * __generic_ptr circle = (vtft_circle *__generic_ptr) component;
-            vtft_ucoord_t diameter = circle->radius << 1;
-            if ((x < left + diameter) && (y < top + diameter))
-                return (vtft_active_component *__generic_ptr)component;
+            if ((x < (left + box->width)) && (x > (left + box->width - box->height)) && (y < (top + box->height)))
+                return 1;
         }
-
-        if ((type == VTFT_COMPONENT_BOX) ||
-            (type == VTFT_COMPONENT_ROUNDED_BOX) ||
-            (type == VTFT_COMPONENT_BUTTON) ||
-            (type == VTFT_COMPONENT_ROUNDED_BUTTON) ||
-            (type == VTFT_COMPONENT_ELLIPSE))
+        else
         {
-            vtft_box * __generic_ptr box = (vtft_box * __generic_ptr)component;
-            if ((x < left + box->width) && (y < top + box->height))
-                return (vtft_active_component * __generic_ptr)component;
+            if ((x < (left + box->height)) && (y < (top + box->height)))
+                return 1;
         }
+    }
 
-        if (type == VTFT_COMPONENT_LABEL)
-        {
-            vtft_label * __generic_ptr label = (vtft_label * __generic_ptr)component;
-            if ((x < left + label->width) && (y < top + label->height))
-                return (vtft_active_component * __generic_ptr)component;
-        }
+    return 0;
+}
+
+#if VTFT_TOUCH_GRID_ENTRIES > 0
+// Gets the range of grid cells covered by the given component.
+// Returns false if the component can never be touched or lies outside of the screen.
+static vtft_bool_t _get_grid_cells(const vtft_touch_grid *grid, const vtft_screen * __generic_ptr screen,
+    const vtft_component * __generic_ptr component,
+    uint8_t *first_column, uint8_t *last_column, uint8_t *first_row, uint8_t *last_row)
+{
+    gl_rectangle_t rect;
+    vtft_coord_t right;
+    vtft_coord_t bottom;
+
+    if ((component->type == VTFT_COMPONENT_LINE) || (component->type == VTFT_COMPONENT_PROGRESS_BAR) ||
+        (component->type == VTFT_COMPONENT_CHART))
+        return 0;
+
+    _get_component_rect(component, &rect);
+    right = rect.top_left.x + rect.width - 1;
+    bottom = rect.top_left.y + rect.height - 1;
+    if ((rect.width == 0) || (rect.height == 0) || (right < 0) || (bottom < 0) ||
+        (rect.top_left.x >= (vtft_coord_t)screen->width) || (rect.top_left.y >= (vtft_coord_t)screen->height))
+        return 0;
+
+    if (rect.top_left.x < 0)
+        rect.top_left.x = 0;
+    if (rect.top_left.y < 0)
+        rect.top_left.y = 0;
+    if (right >= (vtft_coord_t)screen->width)
+        right = screen->width - 1;
+    if (bottom >= (vtft_coord_t)screen->height)
+        bottom = screen->height - 1;
+
+    *first_column = rect.top_left.x / grid->cell_width;
+    *last_column = right / grid->cell_width;
+    *first_row = rect.top_left.y / grid->cell_height;
+    *last_row = bottom / grid->cell_height;
+
+    return 1;
+}
+#endif
+
+// Returns the frontmost active component at the given coordinates.
+static vtft_active_component * __generic_ptr _get_active_component(vtft_t * instance, vtft_coord_t x, vtft_coord_t y)
+{
+    int32_t i;
+    vtft_component * __generic_ptr * __generic_ptr components = instance->current_screen->components;
+    vtft_index_t component_count = instance->current_screen->component_count;
+
+#if VTFT_TOUCH_GRID_ENTRIES > 0
+    vtft_touch_grid *grid = &instance->touch_grid;
+
+    // Only components listed in the touched cell can be hit.
+    if (grid->valid)
+    {
+        uint16_t cell;
+        int32_t first;
 
-        if (type == VTFT_COMPONENT_IMAGE)
+        if ((x < 0) || (y < 0) ||
+            (x >= (vtft_coord_t)instance->current_screen->width) || (y >= (vtft_coord_t)instance->current_screen->height))
+            return 0;
+
+        cell = (y / grid->cell_height) * VTFT_TOUCH_GRID_COLUMNS + x / grid->cell_width;
+        first = grid->cell_start[cell];
+        for (i = grid->cell_start[cell + 1] - 1; i >= first; i--)
         {
-            vtft_image * __generic_ptr image = (vtft_image * __generic_ptr)component;
-            if ((x < left + image->width) && (y < top + image->height))
+            vtft_component * __generic_ptr component = components[grid->entries[i]];
+            if (_hit_component(component, x, y))
                 return (vtft_active_component * __generic_ptr)component;
         }
 
-        if ((type == VTFT_COMPONENT_CHECK_BOX) ||
-            (type == VTFT_COMPONENT_RADIO_BUTTON))
-        {
-            vtft_check_box * __generic_ptr box = (vtft_check_box * __generic_ptr)component;
-            if (box->text_align == VTFT_TEXT_ALIGNMENT_LEFT)
-            {
-                if ((x < (left + box->width)) && (x > (left + box->width - box->height)) && (y < (top + box->height)))
-                    return (vtft_active_component * __generic_ptr)component;
-            }
-            else
-            {
-                if ((x < (left + box->height)) && (y < (top + box->height)))
-                    return (vtft_active_component * __generic_ptr)component;
-            }
-        }
+        return 0;
+    }
+#endif
+
+    for (i = component_count - 1; i >= 0; i--)
+    {
+        if (_hit_component(components[i], x, y))
+            return (vtft_active_component * __generic_ptr)components[i];
     }
 
     return 0;
@@ -148,7 +229,8 @@ static uint8_t _has_press_color(const vtft_component * __generic_ptr component)
     vtft_component_type type = component->type;
     if ((type != VTFT_COMPONENT_LABEL)
         && (type != VTFT_COMPONENT_IMAGE)
-        && (type != VTFT_COMPONENT_PROGRESS_BAR))
+        && (type != VTFT_COMPONENT_PROGRESS_BAR)
+        && (type != VTFT_COMPONENT_LIST_VIEW))
         return 1;
     else
         return 0;
@@ -170,6 +252,9 @@ static void _toggle_checkable_component(vtft_component * __generic_ptr component
 
     abstract_check_box = (vtft_abstract_check_box * __generic_ptr)component;
     abstract_check_box->checked = (abstract_check_box->checked == 0) ? 1 : 0;
+
+    // Recorded screen shows the previous state.
+    vtft_invalidate_screen_cache(_current_instance, _current_instance->current_screen);
 }
 
 // Checks and calls the given event.
@@ -179,6 +264,70 @@ static void _call_event(vtft_event event)
         event();
 }
 
+// Starts tracking the touch on the given list view, stopping its scrolling.
+static void _press_list_view(vtft_t *instance, vtft_list_view *list_view, vtft_coord_t y)
+{
+    if (instance->scrolling_list_view == list_view)
+        instance->scrolling_list_view = 0;
+
+    list_view->speed = 0;
+    list_view->scroll_fraction = 0;
+    list_view->press_y = y;
+    list_view->drag_y = y;
+    list_view->dragging = 0;
+}
+
+// Scrolls the given list view so that it follows the touch.
+static void _drag_list_view(vtft_t *instance, vtft_list_view *list_view, vtft_coord_t y)
+{
+    int32_t delta;
+
+    if (!list_view->dragging)
+    {
+        delta = y - list_view->press_y;
+        if ((delta < VTFT_LIST_VIEW_DRAG_THRESHOLD) && (-delta < VTFT_LIST_VIEW_DRAG_THRESHOLD))
+            return;
+        list_view->dragging = 1;
+    }
+
+    // Moving the touch up scrolls towards the later rows.
+    delta = list_view->drag_y - y;
+    list_view->drag_y = y;
+
+    // Average the last moves, one move is reported per call of vtft_process.
+    list_view->speed = (list_view->speed + (delta << 8)) / 2;
+    _scroll_list_view(instance, list_view, list_view->scroll + delta);
+}
+
+// Stops tracking the touch on the given list view and lets it keep scrolling at its last speed.
+// Returns true if the list view was scrolled by the touch, so it was not clicked.
+static vtft_bool_t _release_list_view(vtft_t *instance, vtft_list_view *list_view)
+{
+    if (!list_view->dragging)
+        return 0;
+
+    list_view->dragging = 0;
+    if ((list_view->speed >= VTFT_LIST_VIEW_MIN_SPEED) || (-list_view->speed >= VTFT_LIST_VIEW_MIN_SPEED))
+        instance->scrolling_list_view = list_view;
+    else
+        list_view->speed = 0;
+
+    return 1;
+}
+
+// Processes the row click event of the given list view.
+static void _click_list_view(vtft_list_view *list_view, vtft_coord_t y)
+{
+    int32_t row;
+
+    if ((list_view->row_click == 0) || (list_view->row_height == 0))
+        return;
+
+    row = (y - list_view->top + list_view->scroll) / list_view->row_height;
+    if ((row >= 0) && (row < list_view->row_count))
+        list_view->row_click(list_view, row);
+}
+
 // Global Function Definitions
 
 // Processes a touch down event.
@@ -198,6 +347,8 @@ void _process_touch_down(tp_coord_t x, tp_coord_t y)
         if (active->active != 0)
         {
             _current_instance->pressed_component = active;
+            if (active->type == VTFT_COMPONENT_LIST_VIEW)
+                _press_list_view(_current_instance, (vtft_list_view *)active, (vtft_coord_t)y);
             // Recolor the pressed component.
             if (_has_press_color((const vtft_component * __generic_ptr)active))
                 vtft_draw_component(_current_instance, (const vtft_component * __generic_ptr)active);
@@ -217,6 +368,7 @@ void _process_touch_up(tp_coord_t x, tp_coord_t y)
 {
     vtft_active_component * __generic_ptr active;
     vtft_active_component * __generic_ptr pressed;
+    vtft_bool_t dragged = 0;
 
     _current_instance->pen_down = 0;
 
@@ -235,6 +387,8 @@ void _process_touch_up(tp_coord_t x, tp_coord_t y)
     if (pressed != 0)
     {
         _current_instance->pressed_component = 0;
+        if (pressed->type == VTFT_COMPONENT_LIST_VIEW)
+            dragged = _release_list_view(_current_instance, (vtft_list_view *)pressed);
         _toggle_checkable_component((vtft_component * __generic_ptr)pressed);
         if (_has_press_color((vtft_component * __generic_ptr)pressed))
         {
@@ -250,8 +404,13 @@ void _process_touch_up(tp_coord_t x, tp_coord_t y)
             _call_event(active->event_set.up_event);
 
             // If the pressed component is the active one, process its click event.
-            if (active == pressed)
+            // Scrolling a list view isn't a click.
+            if ((active == pressed) && !dragged)
+            {
                 _call_event(active->event_set.click_event);
+                if (active->type == VTFT_COMPONENT_LIST_VIEW)
+                    _click_list_view((vtft_list_view *)active, (vtft_coord_t)y);
+            }
 
             return;
         }
@@ -261,6 +420,108 @@ void _process_touch_up(tp_coord_t x, tp_coord_t y)
     _call_event(_current_instance->current_screen->up_event);
 }
 
+// Builds the touch hit-test grid for the current screen.
+void _build_touch_grid(vtft_t *instance)
+{
+#if VTFT_TOUCH_GRID_ENTRIES > 0
+    vtft_touch_grid *grid = &instance->touch_grid;
+    const vtft_screen * __generic_ptr screen = instance->current_screen;
+    vtft_component * __generic_ptr * __generic_ptr components;
+    uint16_t fill[VTFT_TOUCH_GRID_COLUMNS * VTFT_TOUCH_GRID_ROWS];
+    uint16_t total;
+    uint16_t cell;
+    uint8_t first_column, last_column, first_row, last_row;
+    uint8_t row, column;
+    vtft_index_t i;
+
+    grid->valid = 0;
+    grid->required_entries = 0;
+    if ((screen == 0) || (screen->width == 0) || (screen->height == 0))
+        return;
+
+    components = screen->components;
+    grid->cell_width = (screen->width + VTFT_TOUCH_GRID_COLUMNS - 1) / VTFT_TOUCH_GRID_COLUMNS;
+    grid->cell_height = (screen->height + VTFT_TOUCH_GRID_ROWS - 1) / VTFT_TOUCH_GRID_ROWS;
+
+    // Count the components of every cell.
+    memset(fill, 0x00, sizeof(fill));
+    for (i = 0; i < screen->component_count; i++)
+    {
+        if (!_get_grid_cells(grid, screen, components[i], &first_column, &last_column, &first_row, &last_row))
+            continue;
+
+        for (row = first_row; row <= last_row; row++)
+            for (column = first_column; column <= last_column; column++)
+                fill[row * VTFT_TOUCH_GRID_COLUMNS + column]++;
+    }
+
+    total = 0;
+    for (cell = 0; cell < VTFT_TOUCH_GRID_COLUMNS * VTFT_TOUCH_GRID_ROWS; cell++)
+    {
+        grid->cell_start[cell] = total;
+        total += fill[cell];
+        fill[cell] = grid->cell_start[cell];
+    }
+    grid->cell_start[cell] = total;
+    grid->required_entries = total;
+
+    // Too many entries, touch scans all components instead.
+    if (total > VTFT_TOUCH_GRID_ENTRIES)
+        return;
+
+    // Fill the lists, keeping the drawing order.
+    for (i = 0; i < screen->component_count; i++)
+    {
+        if (!_get_grid_cells(grid, screen, components[i], &first_column, &last_column, &first_row, &last_row))
+            continue;
+
+        for (row = first_row; row <= last_row; row++)
+            for (column = first_column; column <= last_column; column++)
+                grid->entries[fill[row * VTFT_TOUCH_GRID_COLUMNS + column]++] = i;
+    }
+
+    grid->valid = 1;
+#else
+    (void *)instance;
+#endif
+}
+
+// Marks the touch hit-test grid as outdated, after components of the current screen are moved.
+// Touch scans all components until the screen is drawn again.
+void _invalidate_touch_grid(vtft_t *instance)
+{
+#if VTFT_TOUCH_GRID_ENTRIES > 0
+    instance->touch_grid.valid = 0;
+#else
+    (void *)instance;
+#endif
+}
+
+// Moves the list view which was released while scrolling, slowing it down until it stops.
+void _process_list_view_scrolling(vtft_t *instance)
+{
+    vtft_list_view *list_view = instance->scrolling_list_view;
+    int32_t step;
+
+    if (list_view == 0)
+        return;
+
+    list_view->scroll_fraction += list_view->speed;
+    step = list_view->scroll_fraction / 256;
+    list_view->scroll_fraction -= step * 256;
+    list_view->speed -= list_view->speed / (1 << VTFT_LIST_VIEW_FRICTION_SHIFT);
+
+    // Stop at the first or the last row, or once it slows down enough.
+    if ((step != 0) && _scroll_list_view(instance, list_view, list_view->scroll + step))
+        list_view->speed = 0;
+    if ((list_view->speed < VTFT_LIST_VIEW_MIN_SPEED) && (-list_view->speed < VTFT_LIST_VIEW_MIN_SPEED))
+    {
+        list_view->speed = 0;
+        list_view->scroll_fraction = 0;
+        instance->scrolling_list_view = 0;
+    }
+}
+
 // Sets the screen changed indicator.
 void _set_screen_changed(vtft_t *instance)
 {
@@ -292,11 +553,9 @@ void _notify_press_events()
 }
 
 
-void _tp_event_handler( tp_event_t event, tp_coord_t x, tp_coord_t y, tp_touch_id_t i)
+// Processes the given touch event.
+static void _dispatch_touch_event(tp_event_t event, tp_coord_t x, tp_coord_t y)
 {
-    if (i != 0)
-        return;
-
     switch (event)
     {
     case TP_EVENT_PRESS_DOWN:
@@ -306,6 +565,10 @@ void _tp_event_handler( tp_event_t event, tp_coord_t x, tp_coord_t y, tp_touch_i
 
     case TP_EVENT_PRESS_MOVE:
         _get_top_active_component(_current_instance, (vtft_coord_t)x, (vtft_coord_t)y);
+        // Pressed list view follows the touch even when it leaves the list view.
+        if ((_current_instance->pressed_component != 0) && (_current_instance->screen_changed == 0) &&
+            (_current_instance->pressed_component->type == VTFT_COMPONENT_LIST_VIEW))
+            _drag_list_view(_current_instance, (vtft_list_view *)_current_instance->pressed_component, (vtft_coord_t)y);
         // _process_touch_press(x, y);
         break;
 
@@ -314,3 +577,89 @@ void _tp_event_handler( tp_event_t event, tp_coord_t x, tp_coord_t y, tp_touch_i
         break;
     }
 }
+
+#if VTFT_EVENT_QUEUE_SIZE > 0
+// Adds the given touch event to the queue, to be processed by _process_touch_events.
+static void _queue_touch_event(vtft_t *instance, tp_event_t event, tp_coord_t x, tp_coord_t y)
+{
+    vtft_touch_event *last = 0;
+
+    if (instance->event_count != 0)
+        last = &instance->events[(instance->event_head + instance->event_count - 1) % VTFT_EVENT_QUEUE_SIZE];
+
+    // Only the latest position of the touch matters, so consecutive moves are merged.
+    if ((last != 0) && (last->event == TP_EVENT_PRESS_MOVE) && (event == TP_EVENT_PRESS_MOVE))
+    {
+        last->x = x;
+        last->y = y;
+        instance->event_stats.coalesced++;
+        return;
+    }
+
+    // Last entry is kept for an up event, so that every queued press is released. Once a down
+    // event is queued only its own up event can take that entry, moves and presses are dropped.
+    if ((instance->event_count == VTFT_EVENT_QUEUE_SIZE) ||
+        ((instance->event_count == VTFT_EVENT_QUEUE_SIZE - 1) && (event != TP_EVENT_PRESS_UP)))
+    {
+        instance->event_stats.dropped++;
+        return;
+    }
+
+    last = &instance->events[(instance->event_head + instance->event_count) % VTFT_EVENT_QUEUE_SIZE];
+    last->event = event;
+    last->x = x;
+    last->y = y;
+    instance->event_count++;
+
+    instance->event_stats.queued++;
+    if (instance->event_count > instance->event_stats.max_pending)
+        instance->event_stats.max_pending = instance->event_count;
+}
+#endif
+
+// Processes the queued touch events, in the order they were reported.
+void _process_touch_events(vtft_t *instance)
+{
+#if VTFT_EVENT_QUEUE_SIZE > 0
+    vtft_touch_event touch_event;
+#if VTFT_EVENT_BUDGET > 0
+    vtft_bool_t limited = (instance->timestamp != 0);
+    uint32_t start = 0;
+
+    if (limited)
+        start = instance->timestamp();
+#endif
+
+    while (instance->event_count != 0)
+    {
+        // Event handlers may queue new events, so the entry is released first.
+        touch_event = instance->events[instance->event_head];
+        instance->event_head = (instance->event_head + 1) % VTFT_EVENT_QUEUE_SIZE;
+        instance->event_count--;
+
+        instance->event_stats.processed++;
+        _dispatch_touch_event(touch_event.event, touch_event.x, touch_event.y);
+
+#if VTFT_EVENT_BUDGET > 0
+        // At least one event is processed, so that the queue doesn't stall.
+        if (limited && ((instance->timestamp() - start) >= VTFT_EVENT_BUDGET))
+            break;
+#endif
+    }
+#else
+    (void *)instance;
+#endif
+}
+
+void _tp_event_handler( tp_event_t event, tp_coord_t x, tp_coord_t y, tp_touch_id_t i)
+{
+    if (i != 0)
+        return;
+
+#if VTFT_EVENT_QUEUE_SIZE > 0
+    _queue_touch_event(_current_instance, event, x, y);
+#else
+    _current_instance->event_stats.processed++;
+    _dispatch_touch_event(event, x, y);
+#endif
+}
@@ -51,6 +51,18 @@ void _process_touch_down(tp_coord_t x, tp_coord_t y);
 // Processes a touch up event.
 void _process_touch_up(tp_coord_t x, tp_coord_t y);
 
+// Builds the touch hit-test grid for the current screen.
+void _build_touch_grid(vtft_t *instance);
+
+// Marks the touch hit-test grid as outdated.
+void _invalidate_touch_grid(vtft_t *instance);
+
+// Moves the list view which was released while scrolling.
+void _process_list_view_scrolling(vtft_t *instance);
+
+// Processes the queued touch events.
+void _process_touch_events(vtft_t *instance);
+
 // Sets the screen changed indicator.
 void _set_screen_changed(vtft_t *instance);
 
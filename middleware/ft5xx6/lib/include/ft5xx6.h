@@ -593,6 +593,8 @@ typedef struct
     tp_touch_item_t  touch;         /**< Touch item. */
     tp_event_t       gesture;       /**< Gesture event. */
 
+    uint8_t          int_mode;      /**< INT pin mode, polling or trigger. */
+
 } ft5xx6_t;
 
 /**
@@ -735,6 +737,32 @@ ft5xx6_init( ft5xx6_t * ctx, ft5xx6_cfg_t * cfg, tp_drv_t * drv );
 void
 ft5xx6_default_cfg( ft5xx6_t * ctx );
 
+/**
+ * @brief FT5xx6 Interrupt Mode Setup Function.
+ * @details This function selects the behaviour of the INT pin of the FT5xx6
+ * touch controller. In polling mode INT pin is held low while the panel is
+ * touched, and the driver reads the touch points only then. In trigger mode
+ * INT pin pulses on every new report, including release, and the driver
+ * reads the touch points whenever it's processed, so it should be processed
+ * only after the pulse, e.g. by #tp_irq_notify or #tp_irq_sample.
+ * @param[in] ctx : FT5xx6 context object. See #ft5xx6_t structure definition
+ * for detailed explanation.
+ * @param[in] mode : @li @c 0 - Polling mode,
+ *                   @li @c 1 - Trigger mode.
+ * @return Nothing.
+ *
+ * @b Example
+ * @code
+ *    // FT5xx6 driver object.
+ *    ft5xx6_t ft5xx6;
+ *
+ *    // Pulse INT pin on every touch report.
+ *    ft5xx6_int_mode_setup( &ft5xx6, FT5XX6_INT_MODE_TRIGGER );
+ * @endcode
+ */
+void
+ft5xx6_int_mode_setup( ft5xx6_t * ctx, uint8_t mode );
+
 /**
  * @brief FT5xx6 Generic Write Function.
  * @details This function allows user to write any 8-bit data to the selected
@@ -46,6 +46,17 @@
 #include "drv_digital_out.h"
 #include "drv_digital_in.h"
 
+/**
+ * @brief FT5xx6 Burst Read Sizes.
+ * @details Touch data is read in a single burst starting from the gesture ID
+ * register, followed by touch status and touch point registers.
+ */
+#define FT5XX6_BURST_HEADER             ( FT5XX6_REG_TOUCH1_XH - FT5XX6_REG_GEST_ID )
+#define FT5XX6_BURST_POINT_DATA         4
+#define FT5XX6_BURST_SIZE_MAX           ( FT5XX6_BURST_HEADER + \
+                                          ( TP_N_TOUCHES_MAX - 1 ) * FT5XX6_OFFSET_TOUCH_READING + \
+                                          FT5XX6_BURST_POINT_DATA )
+
 /**
  * @brief FT5xx6 Events Definition.
  * @details Events code definition depending on the family of touch controller.
@@ -105,25 +116,42 @@ const ft5xx6_controller_t FT5X46_CONTROLLER =
 /**
  * @brief FT5xx6 Pressure Coordinates Read Function.
  * @details This function reads the coordinates of pressed touch point/points.
+ * Gesture ID, touch status and as many points as were touched on the previous
+ * read, plus one, are read in a single burst. Only if more points are touched
+ * now, the rest of them is read by another burst.
  * @param[out] ctx : FT5xx6 context object. See #ft5xx6_t structure definition
  * for detailed explanation.
+ * @param[out] gest_id : Gesture ID read in the same burst.
  * @return @li @c 0 - OK,
  *         @li @c 5 - Number of pressed touches is out of range.
  * See #tp_err_t structure definition for detailed explanation.
  */
 static tp_err_t
-ft5xx6_read_press_coordinates( ft5xx6_t * ctx );
+ft5xx6_read_press_coordinates( ft5xx6_t * ctx, uint8_t * gest_id );
+
+/**
+ * @brief FT5xx6 Touch Point Decode Function.
+ * @details This function decodes coordinates, event and ID of the touch point
+ * from its registers.
+ * @param[out] point : Touch point. See #tp_touch_coord_t structure definition
+ * for detailed explanation.
+ * @param[in] read_data : Touch point registers, starting from TOUCHn_XH.
+ * @return Nothing.
+ */
+static void
+ft5xx6_decode_point( tp_touch_coord_t * point, const uint8_t * read_data );
 
 /**
- * @brief FT5xx6 Gesture Read Function.
- * @details This function reads the gesture ID and allows user to see the slide
+ * @brief FT5xx6 Gesture Decode Function.
+ * @details This function decodes the gesture ID and allows user to see the slide
  * direction.
  * @param[out] ctx : FT5xx6 context object. See #ft5xx6_t structure definition
  * for detailed explanation.
+ * @param[in] gest_id : Gesture ID register value.
  * @return Nothing.
  */
 static void
-ft5xx6_read_gesture( ft5xx6_t * ctx );
+ft5xx6_decode_gesture( ft5xx6_t * ctx, uint8_t gest_id );
 
 void
 ft5xx6_cfg_setup( ft5xx6_cfg_t * cfg, const ft5xx6_controller_t * controller )
@@ -173,6 +201,7 @@ ft5xx6_init( ft5xx6_t * ctx, ft5xx6_cfg_t * cfg, tp_drv_t * drv )
     }
 
     ctx->controller = cfg->controller;
+    ctx->int_mode   = FT5XX6_INT_MODE_POLLING;
 
     drv->tp_press_detect_f      = ft5xx6_press_detect;
     drv->tp_press_coordinates_f = ft5xx6_press_coordinates;
@@ -193,10 +222,18 @@ ft5xx6_default_cfg( ft5xx6_t * ctx )
 {
     ft5xx6_run_mode_setup( ctx, FT5XX6_RUN_MODE_CFG );
     ft5xx6_dev_mode_setup( ctx, FT5XX6_DEV_MODE_NORMAL );
-    ft5xx6_generic_write( ctx, FT5XX6_REG_IVT_TO_HOST_STATUS, FT5XX6_INT_MODE_POLLING );
+    ft5xx6_int_mode_setup( ctx, FT5XX6_INT_MODE_POLLING );
     ft5xx6_run_mode_setup( ctx, FT5XX6_RUN_MODE_WORK );
 }
 
+void
+ft5xx6_int_mode_setup( ft5xx6_t * ctx, uint8_t mode )
+{
+    ft5xx6_generic_write( ctx, FT5XX6_REG_IVT_TO_HOST_STATUS, mode );
+
+    ctx->int_mode = mode;
+}
+
 void
 ft5xx6_generic_write( ft5xx6_t * ctx, uint8_t reg_addr, uint8_t data_in )
 {
@@ -282,55 +319,73 @@ tp_err_t
 ft5xx6_process( ft5xx6_t * ctx )
 {
     tp_err_t status;
+    uint8_t  gest_id;
 
-    status = ft5xx6_read_press_coordinates( ctx );
+    status = ft5xx6_read_press_coordinates( ctx, &gest_id );
 
     if ( ( status == TP_OK ) && ( ctx->press_det == TP_EVENT_PRESS_DET ) )
     {
-        ft5xx6_read_gesture( ctx );
+        ft5xx6_decode_gesture( ctx, gest_id );
     }
 
     return status;
 }
 
 static tp_err_t
-ft5xx6_read_press_coordinates( ft5xx6_t * ctx )
+ft5xx6_read_press_coordinates( ft5xx6_t * ctx, uint8_t * gest_id )
 {
-    if ( !digital_in_read( &ctx->int_pin ) )
+    // In trigger mode INT pin is only pulsed, so the number of touches tells
+    // whether the panel is touched.
+    if ( ( ctx->int_mode == FT5XX6_INT_MODE_TRIGGER ) || !digital_in_read( &ctx->int_pin ) )
     {
-        ctx->touch.n_touches = ft5xx6_generic_read_single( ctx, FT5XX6_REG_TD_STATUS );
+        uint8_t read_data[ FT5XX6_BURST_SIZE_MAX ];
+        uint8_t n_read;
 
-        if ( ctx->touch.n_touches > TP_N_TOUCHES_MAX )
+        // Number of touches rarely changes by more than one between reads.
+        if ( ctx->touch.n_touches < TP_N_TOUCHES_MAX )
         {
-            return TP_ERR_N_TOUCHES;
+            n_read = ctx->touch.n_touches + 1;
         }
         else
         {
-            uint8_t read_data[ 4 ];
-            uint8_t touch_addr = FT5XX6_REG_TOUCH1_XH;
+            n_read = TP_N_TOUCHES_MAX;
+        }
+
+        ft5xx6_generic_read_multiple( ctx, FT5XX6_REG_GEST_ID, read_data,
+                                      FT5XX6_BURST_HEADER +
+                                      ( n_read - 1 ) * FT5XX6_OFFSET_TOUCH_READING +
+                                      FT5XX6_BURST_POINT_DATA );
 
-            for ( uint8_t idx = 0; idx < ctx->touch.n_touches; idx++ )
-            {
-                ft5xx6_generic_read_multiple( ctx, touch_addr, read_data, 4 );
+        *gest_id             = read_data[ FT5XX6_REG_GEST_ID - FT5XX6_REG_GEST_ID ];
+        ctx->touch.n_touches = read_data[ FT5XX6_REG_TD_STATUS - FT5XX6_REG_GEST_ID ];
 
-                ctx->touch.point[ idx ].coord_x = read_data[ 0 ];
-                ctx->touch.point[ idx ].coord_x <<= 8;
-                ctx->touch.point[ idx ].coord_x |= read_data[ 1 ];
-                ctx->touch.point[ idx ].coord_x &= FT5XX6_MASK_PRESS_COORD;
+        if ( ctx->touch.n_touches > TP_N_TOUCHES_MAX )
+        {
+            return TP_ERR_N_TOUCHES;
+        }
 
-                ctx->touch.point[ idx ].coord_y = read_data[ 2 ];
-                ctx->touch.point[ idx ].coord_y <<= 8;
-                ctx->touch.point[ idx ].coord_y |= read_data[ 3 ];
-                ctx->touch.point[ idx ].coord_y &= FT5XX6_MASK_PRESS_COORD;
+        if ( ctx->touch.n_touches > n_read )
+        {
+            ft5xx6_generic_read_multiple( ctx, FT5XX6_REG_TOUCH1_XH + n_read * FT5XX6_OFFSET_TOUCH_READING,
+                                          &read_data[ FT5XX6_BURST_HEADER + n_read * FT5XX6_OFFSET_TOUCH_READING ],
+                                          ( ctx->touch.n_touches - n_read - 1 ) * FT5XX6_OFFSET_TOUCH_READING +
+                                          FT5XX6_BURST_POINT_DATA );
+        }
 
-                ctx->touch.point[ idx ].event = read_data[ 0 ] >> FT5XX6_OFFSET_PRESS_EVENT;
-                ctx->touch.point[ idx ].id    = read_data[ 2 ] >> FT5XX6_OFFSET_PRESS_ID;
+        for ( uint8_t idx = 0; idx < ctx->touch.n_touches; idx++ )
+        {
+            ft5xx6_decode_point( &ctx->touch.point[ idx ],
+                                 &read_data[ FT5XX6_BURST_HEADER + idx * FT5XX6_OFFSET_TOUCH_READING ] );
+        }
 
-                touch_addr += FT5XX6_OFFSET_TOUCH_READING;
-            }
+        if ( ( ctx->int_mode == FT5XX6_INT_MODE_TRIGGER ) && ( ctx->touch.n_touches == 0 ) )
+        {
+            ctx->press_det = TP_EVENT_PRESS_NOT_DET;
 
-            ctx->press_det = TP_EVENT_PRESS_DET;
+            return TP_OK;
         }
+
+        ctx->press_det = TP_EVENT_PRESS_DET;
     }
     else
     {
@@ -341,15 +396,28 @@ ft5xx6_read_press_coordinates( ft5xx6_t * ctx )
 }
 
 static void
-ft5xx6_read_gesture( ft5xx6_t * ctx )
+ft5xx6_decode_point( tp_touch_coord_t * point, const uint8_t * read_data )
 {
-    uint8_t read_data;
-
-    read_data = ft5xx6_generic_read_single( ctx, FT5XX6_REG_GEST_ID );
+    point->coord_x = read_data[ 0 ];
+    point->coord_x <<= 8;
+    point->coord_x |= read_data[ 1 ];
+    point->coord_x &= FT5XX6_MASK_PRESS_COORD;
+
+    point->coord_y = read_data[ 2 ];
+    point->coord_y <<= 8;
+    point->coord_y |= read_data[ 3 ];
+    point->coord_y &= FT5XX6_MASK_PRESS_COORD;
+
+    point->event = read_data[ 0 ] >> FT5XX6_OFFSET_PRESS_EVENT;
+    point->id    = read_data[ 2 ] >> FT5XX6_OFFSET_PRESS_ID;
+}
 
+static void
+ft5xx6_decode_gesture( ft5xx6_t * ctx, uint8_t gest_id )
+{
     for ( uint8_t idx = 0; idx < FT5XX6_GESTURE_ITEMS_MAX; idx++ )
     {
-        if ( read_data == ctx->controller->gest_items[ idx ].key )
+        if ( gest_id == ctx->controller->gest_items[ idx ].key )
         {
             ctx->gesture = ctx->controller->gest_items[ idx ].value;
 
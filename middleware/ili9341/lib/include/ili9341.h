@@ -49,6 +49,7 @@
 #include "ili9341_cmd.h"
 #include "ili9341_defines.h"
 #include "drv_port.h"
+#include "drv_spi_master.h"
 
 /*!
  * \brief Mapping for PWM config structure.
@@ -57,6 +58,14 @@
     ili9341_cfg.pwm_cfg.pin = TFT_BPWM;\
     ili9341_cfg.pwm_cfg.freq_hz = (5000);
 
+/*!
+ * \brief Size in bytes of each of two buffers pixel data is streamed from
+ * with SPI host interface. Must be even.
+ */
+#ifndef ILI9341_SPI_BUFFER_SIZE
+#define ILI9341_SPI_BUFFER_SIZE 128
+#endif
+
 /**
  * @brief ILI9341 Interface Mode.
  * @details interface mode for ILI9341 display controller.
@@ -64,9 +73,25 @@
 typedef enum
 {
     ILI9341_HOST_INTERFACE_8BIT = 0, /*!< 8-bit mode. */
-    ILI9341_HOST_INTERFACE_16BIT     /*!< 16-bit mode. */
+    ILI9341_HOST_INTERFACE_16BIT,    /*!< 16-bit mode. */
+    ILI9341_HOST_INTERFACE_SPI       /*!< 4-wire serial mode, @ref spi_master_write with D/C pin. */
 } ili9341_host_interface_t;
 
+/**
+ * @brief ILI9341 SPI transfer function.
+ * @details Starts sending @p len bytes of pixel data and returns without
+ * waiting, e.g. by starting DMA. Buffer is left untouched, and chip select and
+ * D/C pins are left unchanged, until @ref ili9341_spi_busy_t returns false.
+ */
+typedef void ( *ili9341_spi_transfer_t )( const uint8_t *buffer, size_t len );
+
+/**
+ * @brief ILI9341 SPI busy function.
+ * @details Returns true while transfer started by @ref ili9341_spi_transfer_t
+ * is in progress.
+ */
+typedef bool ( *ili9341_spi_busy_t )( void );
+
  /*!
  * \brief Mapping structure for display orientation.
  */
@@ -100,6 +125,10 @@ typedef struct
 
     ili9341_host_interface_t host_interface; /*!< Device mode. */
 
+    spi_master_config_t spi_cfg;            /*!< SPI configuration, used with SPI host interface. */
+    ili9341_spi_transfer_t spi_transfer_f;  /*!< Asynchronous pixel data transfer, optional. */
+    ili9341_spi_busy_t spi_busy_f;          /*!< Asynchronous transfer status, required with transfer function. */
+
     pwm_config_t pwm_cfg; /*!< PWM configuration structure. */
 
     uint16_t width;  /*!< Display width. */
@@ -144,7 +173,8 @@ void ili9341_init( ili9341_cfg_t *cfg, gl_driver_t *__generic_ptr driver, ili934
 
 /**
  * @brief ILI9341 Default Configuration Function.
- * @details This function initializes PWM default configuration.
+ * @details This function initializes PWM and SPI default configuration, without
+ * asynchronous SPI transfer functions.
  * @param[in] cfg : ILI9341 configuration object.
  * See #ili9341_cfg_t structure definition for detailed explanation.
  * @retval Nothing.
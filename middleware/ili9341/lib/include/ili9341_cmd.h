@@ -277,6 +277,7 @@
  */
 #define ILI9341_CMD_PIXEL_FORMAT_SET                   0x3A
 #define ILI9341_PARAM_1_18_BITS_INTERFACE_PIXEL_FORMAT 0x66
+#define ILI9341_PARAM_1_16_BITS_INTERFACE_PIXEL_FORMAT 0x55
 
 /**
  * @brief This command transfers image data from the host processor to the display module’s frame memory continuing from the
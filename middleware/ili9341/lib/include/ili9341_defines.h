@@ -53,9 +53,15 @@
 #define CS_ACTIVE() digital_out_low( &pin_cs )
 #define CS_DEACTIVE() digital_out_high( &pin_cs )
 
+#if ( GL_COLOR_DEPTH == GL_COLOR_DEPTH_16BPP )
 #define R_BITS(c)  ((( gl_color_t )c & 0xF800 ) >> 8 )
 #define G_BITS(c)  ((( gl_color_t )c & 0x07E0 ) >> 3 )
 #define B_BITS(c)  ((( gl_color_t )c & 0x001F ) << 3 )
+#else
+#define R_BITS(c)  GL_RED_OF( c )
+#define G_BITS(c)  GL_GREEN_OF( c )
+#define B_BITS(c)  GL_BLUE_OF( c )
+#endif
 #define RED_OF(c)    ( R_BITS(c) & 0x00FF )
 #define GREEN_OF(c)  ( G_BITS(c) & 0x00FF )
 #define BLUE_OF(c)   ( B_BITS(c) & 0x00FF )
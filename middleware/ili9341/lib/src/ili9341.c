@@ -45,6 +45,7 @@
 
 #ifdef __GNUC__
 #include <me_built_in.h>
+#include <delays.h>
 #endif
 #ifdef __MIKROC__
 #include "built_in.h"
@@ -82,6 +83,103 @@ static uint8_t port_shift_8bit = 0;
 static uint8_t port_shift_16bit_low = 0;
 static uint8_t port_shift_16bit_high = 0;
 
+/**
+ * @brief SPI host interface state. Pixel data is collected in one of two
+ * buffers, while the other one may still be sent by asynchronous transfer
+ * function. Chip select stays active from begin to end of the frame.
+ */
+static bool host_spi = false;
+static spi_master_t spi_master;
+static pin_name_t spi_cs;
+static bool spi_selected = false;
+static ili9341_spi_transfer_t spi_transfer_f = NULL;
+static ili9341_spi_busy_t spi_busy_f = NULL;
+static uint8_t spi_buffer[2][ILI9341_SPI_BUFFER_SIZE];
+static uint8_t spi_buffer_index = 0;
+static size_t spi_buffer_length = 0;
+
+/**
+ * @brief Address window last set in the controller, valid only if
+ * @b window_valid is set. Any command other than window setting clears it.
+ */
+static uint16_t window_start_column;
+static uint16_t window_end_column;
+static uint16_t window_start_page;
+static uint16_t window_end_page;
+static bool window_valid = false;
+
+/**
+ * @brief Position the controller writes the next pixel to, valid only if
+ * @b cursor_valid is set. It's tracked for windows of a single row or column,
+ * so that the next span continuing the previous one is written with memory
+ * write continue command, without setting the window.
+ */
+static uint16_t cursor_x;
+static uint16_t cursor_y;
+static bool cursor_valid = false;
+
+/**
+ * @brief Sets address window in the controller, skipping the axes which are
+ * already set.
+ * @param[in] start_column Start column.
+ * @param[in] end_column End column.
+ * @param[in] start_page Start page.
+ * @param[in] end_page End page.
+ * @return Nothing.
+ */
+static void _ili9341_set_window( uint16_t start_column, uint16_t end_column,
+                                 uint16_t start_page, uint16_t end_page );
+
+/**
+ * @brief Strobes the data already written to port @b count times.
+ * @param[in] count Number of write strobes.
+ * @return Nothing.
+ */
+static void _ili9341_write_strobes( size_t count );
+
+/**
+ * @brief Sends command with its parameters. With SPI host interface both are
+ * sent in one transaction, chip select is left active.
+ * @param[in] command Command.
+ * @param[in] params Parameters, NULL if @b count is 0.
+ * @param[in] count Number of parameters.
+ * @return Nothing.
+ */
+static void _ili9341_command( uint8_t command, uint8_t *params, uint8_t count );
+
+/**
+ * @brief Waits for asynchronous SPI transfer to complete, if one is running.
+ * @return Nothing.
+ */
+static void _ili9341_spi_wait( void );
+
+/**
+ * @brief Activates chip select, if not already active.
+ * @return Nothing.
+ */
+static void _ili9341_spi_select( void );
+
+/**
+ * @brief Waits for SPI transfer to complete and deactivates chip select.
+ * @return Nothing.
+ */
+static void _ili9341_spi_deselect( void );
+
+/**
+ * @brief Sends pixel data over SPI, asynchronously if transfer function is
+ * set. Buffer must not be changed until the next @ref _ili9341_spi_wait.
+ * @param[in] buffer Pixel data.
+ * @param[in] len Number of bytes.
+ * @return Nothing.
+ */
+static void _ili9341_spi_send( uint8_t *buffer, size_t len );
+
+/**
+ * @brief Sends collected pixel data and switches to the other buffer.
+ * @return Nothing.
+ */
+static void _ili9341_spi_flush( void );
+
 uint16_t ili9341_get_display_width() {
     return display_width;
 }
@@ -96,25 +194,64 @@ void _ili9341_begin_frame( gl_rectangle_t *rect ) {
     uint16_t start_page = rect->top_left.y;
     uint16_t end_page = rect->top_left.y + rect->height - 1;
 
-    ili9341_write_command( ILI9341_CMD_COLUMN_ADDRESS_SET );
-    ili9341_write_param( Hi( start_column ) );
-    ili9341_write_param( Lo( start_column ) );
-    ili9341_write_param( Hi( end_column ) );
-    ili9341_write_param( Lo( end_column ) );
+    if ( 1 == rect->height ) {
+        /* Span continuing the previous one in the same row window. */
+        if ( cursor_valid &&
+             ( window_start_page == start_page ) && ( window_end_page == start_page ) &&
+             ( cursor_x == start_column ) && ( cursor_y == start_page ) &&
+             ( window_end_column >= end_column ) ) {
+            _ili9341_command( ILI9341_CMD_WRITE_MEMORY_CONTINUE, NULL, 0 );
+        } else {
+            /* Row window is open to the right, for spans that follow. */
+            _ili9341_set_window( start_column, display_width - 1, start_page, start_page );
+            _ili9341_command( ILI9341_CMD_MEMORY_WRITE, NULL, 0 );
+        }
+
+        window_valid = true;
+        cursor_valid = ( end_column < window_end_column );
+        cursor_x = end_column + 1;
+        cursor_y = start_page;
+    } else if ( 1 == rect->width ) {
+        /* Span continuing the previous one in the same column window. */
+        if ( cursor_valid &&
+             ( window_start_column == start_column ) && ( window_end_column == start_column ) &&
+             ( cursor_x == start_column ) && ( cursor_y == start_page ) &&
+             ( window_end_page >= end_page ) ) {
+            _ili9341_command( ILI9341_CMD_WRITE_MEMORY_CONTINUE, NULL, 0 );
+        } else {
+            /* Column window is open downwards, for spans that follow. */
+            _ili9341_set_window( start_column, start_column, start_page, display_height - 1 );
+            _ili9341_command( ILI9341_CMD_MEMORY_WRITE, NULL, 0 );
+        }
+
+        window_valid = true;
+        cursor_valid = ( end_page < window_end_page );
+        cursor_x = start_column;
+        cursor_y = end_page + 1;
+    } else {
+        _ili9341_set_window( start_column, end_column, start_page, end_page );
+        _ili9341_command( ILI9341_CMD_MEMORY_WRITE, NULL, 0 );
 
-    ili9341_write_command( ILI9341_CMD_PAGE_ADDRESS_SET );
-    ili9341_write_param( Hi( start_page ) );
-    ili9341_write_param( Lo( start_page ) );
-    ili9341_write_param( Hi( end_page ) );
-    ili9341_write_param( Lo( end_page ) );
+        window_valid = true;
+    }
 
-    ili9341_write_command( ILI9341_CMD_MEMORY_WRITE );
+    if ( host_spi ) {
+        /* Chip select is already active, left so by the command. */
+        DATA_SELECT();
+        return;
+    }
 
     CS_ACTIVE();
     DATA_SELECT();
 }
 
 void _ili9341_end_frame() {
+    if ( host_spi ) {
+        _ili9341_spi_flush();
+        _ili9341_spi_deselect();
+        return;
+    }
+
     CS_DEACTIVE();
 }
 
@@ -155,6 +292,24 @@ void _frame_data_8bit_host_interface( gl_color_t color ) {
     WRITE_STROBE();
 }
 
+void _frame_data_buffer_8bit_host_interface( const gl_color_t * __generic_ptr pixels, size_t count ) {
+    gl_color_t color;
+
+    while ( count-- )
+    {
+        color = *pixels++;
+
+        port_write( &data_channel_0, R_BITS( color ) );
+        WRITE_STROBE();
+
+        port_write( &data_channel_0, G_BITS( color ) );
+        WRITE_STROBE();
+
+        port_write( &data_channel_0, B_BITS( color ) );
+        WRITE_STROBE();
+    }
+}
+
 void _fill_16bit_host_interface_single_channel( gl_rectangle_t *rect, gl_color_t color ) {
     uint32_t length = ( uint32_t )rect->width * ( uint32_t )rect->height;
 
@@ -163,7 +318,7 @@ void _fill_16bit_host_interface_single_channel( gl_rectangle_t *rect, gl_color_t
 
     _ili9341_begin_frame( rect );
 
-    port_write( &data_channel_0, color << port_shift_16bit_low );
+    port_write( &data_channel_0, GL_COLOR_TO_RGB565( color ) << port_shift_16bit_low );
 
     while( length-- )
     {
@@ -174,20 +329,39 @@ void _fill_16bit_host_interface_single_channel( gl_rectangle_t *rect, gl_color_t
 }
 
 void _frame_data_16bit_host_interface_single_channel( gl_color_t color ) {
-    port_write( &data_channel_0, color << port_shift_16bit_low );
+    port_write( &data_channel_0, GL_COLOR_TO_RGB565( color ) << port_shift_16bit_low );
     WRITE_STROBE();
 }
 
+void _frame_data_buffer_16bit_host_interface_single_channel( const gl_color_t * __generic_ptr pixels, size_t count ) {
+    const gl_color_t * __generic_ptr end = pixels + count;
+    const gl_color_t * __generic_ptr run;
+
+    while ( pixels < end )
+    {
+        // Equal neighbouring pixels are written to port once.
+        run = pixels + 1;
+        while ( ( run < end ) && ( *run == *pixels ) )
+            run++;
+
+        port_write( &data_channel_0, GL_COLOR_TO_RGB565( *pixels ) << port_shift_16bit_low );
+        _ili9341_write_strobes( run - pixels );
+
+        pixels = run;
+    }
+}
+
 void _fill_16bit_host_interface( gl_rectangle_t *rect, gl_color_t color ) {
     uint32_t length = ( uint32_t )rect->width * ( uint32_t )rect->height;
+    uint16_t value = GL_COLOR_TO_RGB565( color );
 
     if ( !length )
         return;
 
     _ili9341_begin_frame( rect );
 
-    port_write( &data_channel_0, Lo( color ) << port_shift_16bit_low );
-    port_write( &data_channel_1, Hi( color ) << port_shift_16bit_high );
+    port_write( &data_channel_0, Lo( value ) << port_shift_16bit_low );
+    port_write( &data_channel_1, Hi( value ) << port_shift_16bit_high );
 
     while( length-- )
     {
@@ -198,30 +372,140 @@ void _fill_16bit_host_interface( gl_rectangle_t *rect, gl_color_t color ) {
 }
 
 void _frame_data_16bit_host_interface( gl_color_t color ) {
-    port_write( &data_channel_0, Lo( color ) << port_shift_16bit_low );
-    port_write( &data_channel_1, Hi( color ) << port_shift_16bit_high );
+    uint16_t value = GL_COLOR_TO_RGB565( color );
+
+    port_write( &data_channel_0, Lo( value ) << port_shift_16bit_low );
+    port_write( &data_channel_1, Hi( value ) << port_shift_16bit_high );
     WRITE_STROBE();
 }
 
+void _frame_data_buffer_16bit_host_interface( const gl_color_t * __generic_ptr pixels, size_t count ) {
+    const gl_color_t * __generic_ptr end = pixels + count;
+    const gl_color_t * __generic_ptr run;
+    uint16_t value;
+
+    while ( pixels < end )
+    {
+        // Equal neighbouring pixels are written to port once.
+        run = pixels + 1;
+        while ( ( run < end ) && ( *run == *pixels ) )
+            run++;
+
+        value = GL_COLOR_TO_RGB565( *pixels );
+        port_write( &data_channel_0, Lo( value ) << port_shift_16bit_low );
+        port_write( &data_channel_1, Hi( value ) << port_shift_16bit_high );
+        _ili9341_write_strobes( run - pixels );
+
+        pixels = run;
+    }
+}
+
+void _fill_spi_host_interface( gl_rectangle_t *rect, gl_color_t color ) {
+    uint32_t length = ( uint32_t )rect->width * ( uint32_t )rect->height;
+    uint16_t value = GL_COLOR_TO_RGB565( color );
+    uint8_t *buffer = spi_buffer[spi_buffer_index];
+    size_t pixels;
+    size_t i;
+
+    if ( !length )
+        return;
+
+    _ili9341_begin_frame( rect );
+
+    /* Buffer of equal pixels is prepared once, and sent as many times as needed. */
+    pixels = ( length < ILI9341_SPI_BUFFER_SIZE / 2 ) ? length : ILI9341_SPI_BUFFER_SIZE / 2;
+    for ( i = 0; i < pixels; i++ )
+    {
+        buffer[2 * i] = Hi( value );
+        buffer[2 * i + 1] = Lo( value );
+    }
+
+    while ( length )
+    {
+        pixels = ( length < ILI9341_SPI_BUFFER_SIZE / 2 ) ? length : ILI9341_SPI_BUFFER_SIZE / 2;
+        _ili9341_spi_send( buffer, pixels * 2 );
+        length -= pixels;
+    }
+
+    _ili9341_end_frame();
+}
+
+void _frame_data_spi_host_interface( gl_color_t color ) {
+    uint16_t value = GL_COLOR_TO_RGB565( color );
+    uint8_t *buffer = spi_buffer[spi_buffer_index];
+
+    buffer[spi_buffer_length++] = Hi( value );
+    buffer[spi_buffer_length++] = Lo( value );
+
+    if ( ILI9341_SPI_BUFFER_SIZE == spi_buffer_length )
+        _ili9341_spi_flush();
+}
+
+void _frame_data_buffer_spi_host_interface( const gl_color_t * __generic_ptr pixels, size_t count ) {
+    uint8_t *buffer = spi_buffer[spi_buffer_index];
+    uint16_t value;
+
+    while ( count-- )
+    {
+        value = GL_COLOR_TO_RGB565( *pixels );
+        pixels++;
+        buffer[spi_buffer_length++] = Hi( value );
+        buffer[spi_buffer_length++] = Lo( value );
+
+        if ( ILI9341_SPI_BUFFER_SIZE == spi_buffer_length ) {
+            _ili9341_spi_flush();
+            buffer = spi_buffer[spi_buffer_index];
+        }
+    }
+}
+
 void ili9341_init( ili9341_cfg_t *cfg, gl_driver_t *__generic_ptr driver, ili9341_t *ctx ) {
-    digital_out_init( &pin_cs, cfg->cs );
+    host_spi = ( ILI9341_HOST_INTERFACE_SPI == cfg->host_interface );
+
     digital_out_init( &pin_rs, cfg->rs );
-    digital_out_init( &pin_wr, cfg->wr );
-    digital_out_init( &pin_rd, cfg->rd );
     digital_out_init( &pin_rst, cfg->rst );
 
-    digital_out_high( &pin_cs );
     digital_out_high( &pin_rs );
-    digital_out_high( &pin_wr );
-    digital_out_high( &pin_rd );
     digital_out_low( &pin_rst );
 
-    port_init( &data_channel_0, cfg->data_channel_0, cfg->data_channel_0_mask, GPIO_DIGITAL_OUTPUT );
-    port_write( &data_channel_0, PORT_DEFAULT_VALUE );
+    if ( !host_spi ) {
+        digital_out_init( &pin_cs, cfg->cs );
+        digital_out_init( &pin_wr, cfg->wr );
+        digital_out_init( &pin_rd, cfg->rd );
+
+        digital_out_high( &pin_cs );
+        digital_out_high( &pin_wr );
+        digital_out_high( &pin_rd );
+
+        port_init( &data_channel_0, cfg->data_channel_0, cfg->data_channel_0_mask, GPIO_DIGITAL_OUTPUT );
+        port_write( &data_channel_0, PORT_DEFAULT_VALUE );
+    }
+
+    if ( ILI9341_HOST_INTERFACE_SPI == cfg->host_interface ) {
+        spi_master_open( &spi_master, &cfg->spi_cfg );
+        spi_cs = cfg->cs;
+        spi_selected = false;
+        spi_master_deselect_device( spi_cs );
+
+        /* Without busy function transfer can't be waited for, so it's blocking. */
+        spi_transfer_f = NULL;
+        spi_busy_f = NULL;
+        if ( cfg->spi_transfer_f && cfg->spi_busy_f ) {
+            spi_transfer_f = cfg->spi_transfer_f;
+            spi_busy_f = cfg->spi_busy_f;
+        }
+        spi_buffer_index = 0;
+        spi_buffer_length = 0;
+
+        driver->fill_f = _fill_spi_host_interface;
+        driver->frame_data_f = _frame_data_spi_host_interface;
+        driver->frame_data_buffer_f = _frame_data_buffer_spi_host_interface;
+    }
 
     if ( ILI9341_HOST_INTERFACE_8BIT == cfg->host_interface ) {
         driver->fill_f = _fill_8bit_host_interface;
         driver->frame_data_f = _frame_data_8bit_host_interface;
+        driver->frame_data_buffer_f = _frame_data_buffer_8bit_host_interface;
 
         port_shift_8bit = 0;
         if ( DATA_PORT_NIBBLE_HIGH == cfg->data_channel_0_mask ) {
@@ -233,6 +517,7 @@ void ili9341_init( ili9341_cfg_t *cfg, gl_driver_t *__generic_ptr driver, ili934
         if ( HAL_PORT_NC == cfg->data_channel_1 ) {
             driver->fill_f = _fill_16bit_host_interface_single_channel;
             driver->frame_data_f = _frame_data_16bit_host_interface_single_channel;
+            driver->frame_data_buffer_f = _frame_data_buffer_16bit_host_interface_single_channel;
 
             port_shift_16bit_low = 0;
             if ( DATA_PORT_NIBBLE_HIGH == cfg->data_channel_0_mask ) {
@@ -244,6 +529,7 @@ void ili9341_init( ili9341_cfg_t *cfg, gl_driver_t *__generic_ptr driver, ili934
 
             driver->fill_f = _fill_16bit_host_interface;
             driver->frame_data_f = _frame_data_16bit_host_interface;
+            driver->frame_data_buffer_f = _frame_data_buffer_16bit_host_interface;
 
             port_shift_16bit_low = 0;
             port_shift_16bit_high = 0;
@@ -273,6 +559,7 @@ void ili9341_init( ili9341_cfg_t *cfg, gl_driver_t *__generic_ptr driver, ili934
 
     driver->begin_frame_f = _ili9341_begin_frame;
     driver->end_frame_f = _ili9341_end_frame;
+    driver->copy_rect_f = NULL;
 
     Delay_100ms();
 
@@ -280,9 +567,29 @@ void ili9341_init( ili9341_cfg_t *cfg, gl_driver_t *__generic_ptr driver, ili934
 
     Delay_100ms();
     Delay_100ms();
+
+    /* Reset sets the window to the whole display. */
+    window_valid = false;
+    cursor_valid = false;
+
+    if ( host_spi ) {
+        /* Two bytes per pixel, instead of three after reset. */
+        ili9341_write_command( ILI9341_CMD_PIXEL_FORMAT_SET );
+        ili9341_write_param( ILI9341_PARAM_1_16_BITS_INTERFACE_PIXEL_FORMAT );
+    }
 }
 
 void ili9341_write_command( uint8_t command ) {
+    if ( host_spi ) {
+        _ili9341_command( command, NULL, 0 );
+        _ili9341_spi_deselect();
+        return;
+    }
+
+    /* Window and cursor are known only after commands sent by begin frame. */
+    window_valid = false;
+    cursor_valid = false;
+
     CS_ACTIVE();
     COMMAND_SELECT();
 
@@ -292,6 +599,15 @@ void ili9341_write_command( uint8_t command ) {
 }
 
 void ili9341_write_param( uint8_t param ) {
+    if ( host_spi ) {
+        _ili9341_spi_wait();
+        _ili9341_spi_select();
+        DATA_SELECT();
+        spi_master_write( &spi_master, &param, 1 );
+        _ili9341_spi_deselect();
+        return;
+    }
+
     CS_ACTIVE();
     DATA_SELECT();
 
@@ -302,11 +618,15 @@ void ili9341_write_param( uint8_t param ) {
 
 void ili9341_default_cfg( ili9341_cfg_t *cfg ) {
     pwm_configure_default( &cfg->pwm_cfg );
+
+    spi_master_configure_default( &cfg->spi_cfg );
+    cfg->spi_transfer_f = NULL;
+    cfg->spi_busy_f = NULL;
 }
 
 void ili9341_backlight_control_init( ili9341_cfg_t *cfg, ili9341_t *ctx ) {
     pwm_open( &ctx->pwm, &cfg->pwm_cfg );
-    pwm_set_freq( &ctx->pwm, cfg->pwm_cfg->freq_hz );
+    pwm_set_freq( &ctx->pwm, cfg->pwm_cfg.freq_hz );
     pwm_start( &ctx->pwm );
 }
 
@@ -318,7 +638,7 @@ void ili9341_set_backlight_intensity( float intensity, ili9341_t *ctx ) {
 
 void ili9341_rotate( ili9341_t *ctx, tp_rotate_t *rotate ) {
     uint16_t tmp = 0;
-    ctx->rotate = rotate;
+    ctx->rotate = *rotate;
 
     ili9341_write_command( ILI9341_CMD_MEMORY_ACCESS_CONTROL );
     switch( ctx->rotate ){
@@ -347,4 +667,122 @@ void ili9341_rotate( ili9341_t *ctx, tp_rotate_t *rotate ) {
     }
 }
 
+static void _ili9341_set_window( uint16_t start_column, uint16_t end_column,
+                                 uint16_t start_page, uint16_t end_page ) {
+    bool column_set = window_valid &&
+                      ( window_start_column == start_column ) && ( window_end_column == end_column );
+    bool page_set = window_valid &&
+                    ( window_start_page == start_page ) && ( window_end_page == end_page );
+
+    uint8_t params[4];
+
+    if ( !column_set ) {
+        params[0] = Hi( start_column );
+        params[1] = Lo( start_column );
+        params[2] = Hi( end_column );
+        params[3] = Lo( end_column );
+        _ili9341_command( ILI9341_CMD_COLUMN_ADDRESS_SET, params, 4 );
+
+        window_start_column = start_column;
+        window_end_column = end_column;
+    }
+
+    if ( !page_set ) {
+        params[0] = Hi( start_page );
+        params[1] = Lo( start_page );
+        params[2] = Hi( end_page );
+        params[3] = Lo( end_page );
+        _ili9341_command( ILI9341_CMD_PAGE_ADDRESS_SET, params, 4 );
+
+        window_start_page = start_page;
+        window_end_page = end_page;
+    }
+}
+
+static void _ili9341_write_strobes( size_t count ) {
+    while ( count >= 4 )
+    {
+        WRITE_STROBE();
+        WRITE_STROBE();
+        WRITE_STROBE();
+        WRITE_STROBE();
+        count -= 4;
+    }
+
+    while ( count-- )
+    {
+        WRITE_STROBE();
+    }
+}
+
+static void _ili9341_command( uint8_t command, uint8_t *params, uint8_t count ) {
+    uint8_t i;
+
+    if ( !host_spi ) {
+        ili9341_write_command( command );
+        for ( i = 0; i < count; i++ )
+            ili9341_write_param( params[i] );
+        return;
+    }
+
+    /* Window and cursor are known only after commands sent by begin frame. */
+    window_valid = false;
+    cursor_valid = false;
+
+    /* Pixels of a frame left open by begin frame without end frame go first. */
+    _ili9341_spi_flush();
+    _ili9341_spi_wait();
+    _ili9341_spi_select();
+
+    COMMAND_SELECT();
+    spi_master_write( &spi_master, &command, 1 );
+
+    if ( count ) {
+        DATA_SELECT();
+        spi_master_write( &spi_master, params, count );
+    }
+}
+
+static void _ili9341_spi_wait( void ) {
+    if ( spi_busy_f ) {
+        while ( spi_busy_f() );
+    }
+}
+
+static void _ili9341_spi_select( void ) {
+    if ( !spi_selected ) {
+        spi_master_select_device( spi_cs );
+        spi_selected = true;
+    }
+}
+
+static void _ili9341_spi_deselect( void ) {
+    _ili9341_spi_wait();
+
+    if ( spi_selected ) {
+        spi_master_deselect_device( spi_cs );
+        spi_selected = false;
+    }
+}
+
+static void _ili9341_spi_send( uint8_t *buffer, size_t len ) {
+    if ( spi_transfer_f ) {
+        _ili9341_spi_wait();
+        spi_transfer_f( buffer, len );
+    } else {
+        spi_master_write( &spi_master, buffer, len );
+    }
+}
+
+static void _ili9341_spi_flush( void ) {
+    if ( !spi_buffer_length )
+        return;
+
+    _ili9341_spi_send( spi_buffer[spi_buffer_index], spi_buffer_length );
+
+    /* The other buffer is free, its transfer was waited for before this one. */
+    spi_buffer_index ^= 1;
+    spi_buffer_length = 0;
+}
+
 // ------------------------------------------------------------------------- END
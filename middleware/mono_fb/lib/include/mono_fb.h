@@ -0,0 +1,297 @@
+/****************************************************************************
+**
+** Copyright (C) 2023 MikroElektronika d.o.o.
+** Contact: https://www.mikroe.com/contact
+**
+** This file is part of the mikroSDK package
+**
+** Commercial License Usage
+**
+** Licensees holding valid commercial NECTO compilers AI licenses may use this
+** file in accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The MikroElektronika Company.
+** For licensing terms and conditions see
+** https://www.mikroe.com/legal/software-license-agreement.
+** For further information use the contact form at
+** https://www.mikroe.com/contact.
+**
+**
+** GNU Lesser General Public License Usage
+**
+** Alternatively, this file may be used for
+** non-commercial projects under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** The above copyright notice and this permission notice shall be
+** included in all copies or substantial portions of the Software.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+** OF MERCHANTABILITY, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED
+** TO THE WARRANTIES FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+** IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+** DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT
+** OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+** OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+**
+****************************************************************************/
+/*!
+ * @file  mono_fb.h
+ * @brief Monochrome Page-Organised Framebuffer Display Driver.
+ */
+
+#ifndef _MONO_FB_H_
+#define _MONO_FB_H_
+
+#include "generic_pointer.h"
+#include "gl_types.h"
+#include "drv_name.h"
+#include "drv_digital_out.h"
+#include "drv_spi_master.h"
+#include "drv_i2c_master.h"
+#include <stddef.h>
+
+/**
+ * @brief Number of display rows stored in one page (one byte per column).
+ */
+#define MONO_FB_PAGE_HEIGHT 8
+
+/**
+ * @brief Maximum number of pages supported by the driver.
+ * @details Dirty tracking is kept per page in the context object, so this
+ * value determines its size. Can be overridden at build time.
+ */
+#ifndef MONO_FB_PAGES_MAX
+#define MONO_FB_PAGES_MAX 8
+#endif
+
+/**
+ * @brief Maximum number of data bytes sent in one I2C transaction.
+ */
+#ifndef MONO_FB_I2C_CHUNK_SIZE
+#define MONO_FB_I2C_CHUNK_SIZE 32
+#endif
+
+/**
+ * @brief I2C control bytes which precede command and display data stream.
+ */
+#define MONO_FB_I2C_CONTROL_COMMAND 0x00
+#define MONO_FB_I2C_CONTROL_DATA    0x40
+
+/**
+ * @brief Page addressing commands shared by SSD1306, SH1106, ST7565 and
+ * compatible page-organised controllers.
+ */
+#define MONO_FB_CMD_SET_PAGE            0xB0
+#define MONO_FB_CMD_SET_COLUMN_LOW      0x00
+#define MONO_FB_CMD_SET_COLUMN_HIGH     0x10
+
+/**
+ * @brief Required size of the framebuffer in bytes for given panel dimensions.
+ */
+#define MONO_FB_BUFFER_SIZE( width, height ) \
+    ( ( size_t )( width ) * ( ( ( height ) + MONO_FB_PAGE_HEIGHT - 1 ) / MONO_FB_PAGE_HEIGHT ) )
+
+/**
+ * @brief Monochrome framebuffer return values.
+ */
+typedef enum
+{
+    MONO_FB_OK = 0,       /*!< Success. */
+    MONO_FB_ERROR = (-1)  /*!< Error. */
+} mono_fb_err_t;
+
+/**
+ * @brief Bus used for transferring pages to the display controller.
+ */
+typedef enum
+{
+    MONO_FB_TRANSPORT_SPI = 0,  /*!< 4-wire SPI with D/C pin, @ref spi_master_write. */
+    MONO_FB_TRANSPORT_I2C,      /*!< I2C with control byte prefix, @ref i2c_master_write. */
+    MONO_FB_TRANSPORT_CALLBACK  /*!< User supplied write function, e.g. host test surface. */
+} mono_fb_transport_t;
+
+/**
+ * @brief Write function used with @ref MONO_FB_TRANSPORT_CALLBACK.
+ * @details Receives every command (@p is_data false) and display data
+ * (@p is_data true) stream exactly as it would be sent over the bus.
+ */
+typedef void ( *mono_fb_write_t )( bool is_data, const uint8_t *buffer, size_t len );
+
+/**
+ * @brief Monochrome framebuffer configuration object.
+ */
+typedef struct
+{
+    mono_fb_transport_t transport;  /*!< Bus selection. */
+
+    spi_master_config_t spi_cfg;    /*!< SPI configuration, used with @ref MONO_FB_TRANSPORT_SPI. */
+    pin_name_t cs;                  /*!< SPI Chip Select pin. */
+    pin_name_t dc;                  /*!< SPI Data/Command select pin. */
+
+    i2c_master_config_t i2c_cfg;    /*!< I2C configuration, used with @ref MONO_FB_TRANSPORT_I2C. */
+    uint8_t i2c_address;            /*!< I2C slave address of the controller. */
+
+    mono_fb_write_t write_f;        /*!< Write function, used with @ref MONO_FB_TRANSPORT_CALLBACK. */
+
+    pin_name_t rst;                 /*!< Reset pin, optional. */
+
+    uint8_t *buffer;                /*!< Framebuffer of at least @ref MONO_FB_BUFFER_SIZE bytes. */
+    uint16_t width;                 /*!< Display width. */
+    uint16_t height;                /*!< Display height. */
+    uint8_t column_offset;          /*!< First visible column in controller RAM (2 for SH1106). */
+
+    const uint8_t *init_sequence;   /*!< Controller specific commands sent on init, optional. */
+    size_t init_sequence_len;       /*!< Number of bytes in init sequence. */
+} mono_fb_cfg_t;
+
+/**
+ * @brief Monochrome framebuffer context object.
+ * @details The framebuffer is page-major: byte at index page * width + x
+ * holds rows page * 8 to page * 8 + 7 of column x, LSB on top.
+ */
+typedef struct
+{
+    mono_fb_transport_t transport;  /*!< Bus selection. */
+
+    spi_master_t spi;               /*!< SPI driver object. */
+    pin_name_t cs;                  /*!< SPI Chip Select pin. */
+    digital_out_t dc;               /*!< SPI Data/Command select pin. */
+
+    i2c_master_t i2c;               /*!< I2C driver object. */
+
+    mono_fb_write_t write_f;        /*!< User write function. */
+
+    digital_out_t rst;              /*!< Reset pin. */
+
+    uint8_t *buffer;                /*!< Page-major framebuffer. */
+    uint16_t width;                 /*!< Display width. */
+    uint16_t height;                /*!< Display height. */
+    uint8_t pages;                  /*!< Number of pages in use. */
+    uint8_t column_offset;          /*!< First visible column in controller RAM. */
+
+    uint16_t dirty_start[ MONO_FB_PAGES_MAX ];  /*!< First changed column per page. */
+    uint16_t dirty_end[ MONO_FB_PAGES_MAX ];    /*!< One past the last changed column per page. */
+
+    gl_rectangle_t frame;           /*!< Window opened by begin frame. */
+    gl_coord_t frame_x;             /*!< Column of the next pixel in frame. */
+    gl_coord_t frame_y;             /*!< Row of the next pixel in frame. */
+} mono_fb_t;
+
+/*!
+ * @addtogroup middlewaregroup Middleware
+ * @{
+ */
+
+/*!
+ * @addtogroup mono_fb Monochrome Framebuffer Display Driver
+ * @brief Monochrome Framebuffer Display Driver API reference.
+ * @details Generic 1-bpp driver for page-organised controllers. Graphic Library
+ * draws into RAM framebuffer, and only changed columns of changed pages are
+ * sent to the display by @ref mono_fb_flush.
+ * @{
+ */
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * @brief Monochrome framebuffer configuration object setup.
+ * @details Initializes configuration object to default values: SPI transport,
+ * all pins unconnected, no buffer and no init sequence.
+ * @param[out] cfg : Configuration object. See #mono_fb_cfg_t structure definition for detailed explanation.
+ * @return Nothing.
+ */
+void mono_fb_cfg_setup( mono_fb_cfg_t *cfg );
+
+/**
+ * @brief Monochrome framebuffer initialization.
+ * @details Opens selected bus, resets the controller, sends init sequence and
+ * links Graphic Library driver interface object with framebuffer functions.
+ * Whole framebuffer is cleared and marked as changed.
+ * @param[out] ctx : Context object. See #mono_fb_t structure definition for detailed explanation.
+ * @param[in] cfg : Configuration object. See #mono_fb_cfg_t structure definition for detailed explanation.
+ * @param[out] driver : Graphics Library driver interface object. See #gl_driver_t structure definition and #gl_set_driver function for detailed explanation.
+ * @return @li @c  0 - Success,
+ *         @li @c -1 - Error, invalid configuration or bus could not be opened.
+ * @note Graphic Library driver functions do not take context, so only one
+ * monochrome framebuffer can be active at the time. Last initialized one is used.
+ *
+ * @b Example
+ * @code
+ *    static uint8_t fb_buffer[ MONO_FB_BUFFER_SIZE( 128, 64 ) ];
+ *    static mono_fb_t fb;
+ *    mono_fb_cfg_t fb_cfg;
+ *    gl_driver_t driver;
+ *
+ *    mono_fb_cfg_setup( &fb_cfg );
+ *    fb_cfg.transport = MONO_FB_TRANSPORT_I2C;
+ *    fb_cfg.i2c_cfg.scl = MIKROBUS_1_SCL;
+ *    fb_cfg.i2c_cfg.sda = MIKROBUS_1_SDA;
+ *    fb_cfg.i2c_address = 0x3C;
+ *    fb_cfg.buffer = fb_buffer;
+ *    fb_cfg.width = 128;
+ *    fb_cfg.height = 64;
+ *    mono_fb_init( &fb, &fb_cfg, &driver );
+ *
+ *    gl_set_driver( &driver );
+ *    gl_clear( GL_BLACK );
+ *    gl_draw_text( "Status", 0, 0 );
+ *    mono_fb_flush( &fb );
+ * @endcode
+ */
+err_t mono_fb_init( mono_fb_t *ctx, mono_fb_cfg_t *cfg, gl_driver_t *__generic_ptr driver );
+
+/**
+ * @brief Send command bytes to the display controller.
+ * @param[in] ctx : Context object. See #mono_fb_t structure definition for detailed explanation.
+ * @param[in] commands : Command bytes.
+ * @param[in] len : Number of command bytes.
+ * @return Nothing.
+ */
+void mono_fb_write_commands( mono_fb_t *ctx, const uint8_t *commands, size_t len );
+
+/**
+ * @brief Transfer changed part of the framebuffer to the display.
+ * @details For every page with changes, sets page and column address and sends
+ * only the range of changed columns. Dirty state is cleared afterwards.
+ * @param[in] ctx : Context object. See #mono_fb_t structure definition for detailed explanation.
+ * @return Nothing.
+ */
+void mono_fb_flush( mono_fb_t *ctx );
+
+/**
+ * @brief Mark whole framebuffer as changed.
+ * @details Next @ref mono_fb_flush transfers the complete framebuffer.
+ * @param[in] ctx : Context object. See #mono_fb_t structure definition for detailed explanation.
+ * @return Nothing.
+ */
+void mono_fb_invalidate( mono_fb_t *ctx );
+
+/**
+ * @brief Check whether framebuffer has changes which are not flushed.
+ * @param[in] ctx : Context object. See #mono_fb_t structure definition for detailed explanation.
+ * @return true if any page is dirty, false otherwise.
+ */
+bool mono_fb_is_dirty( mono_fb_t *ctx );
+
+/**
+ * @brief Read pixel state from the framebuffer.
+ * @param[in] ctx : Context object. See #mono_fb_t structure definition for detailed explanation.
+ * @param[in] x : Column.
+ * @param[in] y : Row.
+ * @return true if pixel is on, false if it is off or out of display.
+ */
+bool mono_fb_get_pixel( mono_fb_t *ctx, gl_coord_t x, gl_coord_t y );
+
+#ifdef __cplusplus
+}
+#endif
+
+/*! @} */ // mono_fb
+/*! @} */ // mwgroup
+
+#endif // _MONO_FB_H_
+// ------------------------------------------------------------------------- END
@@ -0,0 +1,413 @@
+/****************************************************************************
+**
+** Copyright (C) 2023 MikroElektronika d.o.o.
+** Contact: https://www.mikroe.com/contact
+**
+** This file is part of the mikroSDK package
+**
+** Commercial License Usage
+**
+** Licensees holding valid commercial NECTO compilers AI licenses may use this
+** file in accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The MikroElektronika Company.
+** For licensing terms and conditions see
+** https://www.mikroe.com/legal/software-license-agreement.
+** For further information use the contact form at
+** https://www.mikroe.com/contact.
+**
+**
+** GNU Lesser General Public License Usage
+**
+** Alternatively, this file may be used for
+** non-commercial projects under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** The above copyright notice and this permission notice shall be
+** included in all copies or substantial portions of the Software.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+** OF MERCHANTABILITY, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED
+** TO THE WARRANTIES FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+** IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+** DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT
+** OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+** OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+**
+****************************************************************************/
+/*!
+ * @file  mono_fb.c
+ * @brief Monochrome page-organised framebuffer source file.
+ */
+
+#include "mono_fb.h"
+#include <string.h>
+#ifdef __GNUC__
+#include <delays.h>
+#endif
+
+/**
+ * @remark Graphic Library driver functions have no context argument, so the
+ * framebuffer drawn into is the one linked by the last @ref mono_fb_init call.
+ */
+static mono_fb_t *active_fb = NULL;
+
+/**
+ * @brief Converts GL color to pixel state. In 1 bpp build color is already
+ * native, otherwise pixel is on for colors at least half bright.
+ */
+#if ( GL_COLOR_DEPTH == GL_COLOR_DEPTH_1BPP )
+#define _PIXEL_ON( color ) ( 0 != ( color ) )
+#else
+#define _PIXEL_ON( color ) ( ( ( ( ( uint16_t )GL_RED_OF( color ) & 0xFF ) + \
+                          ( ( ( uint16_t )GL_GREEN_OF( color ) & 0xFF ) << 1 ) + \
+                          ( ( uint16_t )GL_BLUE_OF( color ) & 0xFF ) ) >> 2 ) >= 0x80 )
+#endif
+
+static void _mono_fb_bus_write( mono_fb_t *ctx, bool is_data, const uint8_t *buffer, size_t len ) {
+    uint8_t chunk[MONO_FB_I2C_CHUNK_SIZE + 1];
+    size_t chunk_len;
+
+    if ( !len )
+        return;
+
+    switch ( ctx->transport )
+    {
+    case MONO_FB_TRANSPORT_SPI:
+        spi_master_select_device( ctx->cs );
+        digital_out_write( &ctx->dc, is_data );
+        spi_master_write( &ctx->spi, ( uint8_t * )buffer, len );
+        spi_master_deselect_device( ctx->cs );
+        break;
+
+    case MONO_FB_TRANSPORT_I2C:
+        // Every transaction starts with control byte, so data is sent in chunks.
+        chunk[0] = is_data ? MONO_FB_I2C_CONTROL_DATA : MONO_FB_I2C_CONTROL_COMMAND;
+        while ( len )
+        {
+            chunk_len = len > MONO_FB_I2C_CHUNK_SIZE ? MONO_FB_I2C_CHUNK_SIZE : len;
+            memcpy( &chunk[1], buffer, chunk_len );
+            i2c_master_write( &ctx->i2c, chunk, chunk_len + 1 );
+            buffer += chunk_len;
+            len -= chunk_len;
+        }
+        break;
+
+    case MONO_FB_TRANSPORT_CALLBACK:
+        if ( ctx->write_f )
+            ctx->write_f( is_data, buffer, len );
+        break;
+    }
+}
+
+static void _mono_fb_mark_dirty( mono_fb_t *ctx, uint8_t page, uint16_t x_start, uint16_t x_end ) {
+    if ( x_start < ctx->dirty_start[page] )
+        ctx->dirty_start[page] = x_start;
+    if ( x_end > ctx->dirty_end[page] )
+        ctx->dirty_end[page] = x_end;
+}
+
+static void _mono_fb_set_pixel( mono_fb_t *ctx, gl_coord_t x, gl_coord_t y, bool on ) {
+    uint8_t page;
+    uint8_t mask;
+    uint8_t *cell;
+
+    if ( x < 0 || y < 0 || x >= ctx->width || y >= ctx->height )
+        return;
+
+    page = y / MONO_FB_PAGE_HEIGHT;
+    mask = 1 << ( y % MONO_FB_PAGE_HEIGHT );
+    cell = &ctx->buffer[( size_t )page * ctx->width + x];
+
+    if ( on )
+    {
+        if ( *cell & mask )
+            return;
+        *cell |= mask;
+    }
+    else
+    {
+        if ( !( *cell & mask ) )
+            return;
+        *cell &= ~mask;
+    }
+
+    _mono_fb_mark_dirty( ctx, page, x, x + 1 );
+}
+
+static void _mono_fb_fill( gl_rectangle_t *rect, gl_color_t color ) {
+    mono_fb_t *ctx = active_fb;
+    gl_int_t x_start = rect->top_left.x;
+    gl_int_t y_start = rect->top_left.y;
+    gl_int_t x_end = rect->top_left.x + ( gl_int_t )rect->width;
+    gl_int_t y_end = rect->top_left.y + ( gl_int_t )rect->height;
+    uint8_t page;
+    uint8_t page_last;
+    uint8_t mask;
+    uint8_t *row;
+    gl_int_t x;
+    bool on = _PIXEL_ON( color );
+
+    if ( !ctx )
+        return;
+
+    if ( x_start < 0 )
+        x_start = 0;
+    if ( y_start < 0 )
+        y_start = 0;
+    if ( x_end > ( gl_int_t )ctx->width )
+        x_end = ctx->width;
+    if ( y_end > ( gl_int_t )ctx->height )
+        y_end = ctx->height;
+    if ( x_start >= x_end || y_start >= y_end )
+        return;
+
+    page = y_start / MONO_FB_PAGE_HEIGHT;
+    page_last = ( y_end - 1 ) / MONO_FB_PAGE_HEIGHT;
+
+    // Whole page bytes are updated at once, with mask for partially covered pages.
+    for ( ; page <= page_last; page++ )
+    {
+        mask = 0xFF;
+        if ( page == y_start / MONO_FB_PAGE_HEIGHT )
+            mask &= ( uint8_t )( 0xFF << ( y_start % MONO_FB_PAGE_HEIGHT ) );
+        if ( page == page_last )
+            mask &= ( uint8_t )( 0xFF >> ( MONO_FB_PAGE_HEIGHT - 1 - ( ( y_end - 1 ) % MONO_FB_PAGE_HEIGHT ) ) );
+
+        row = &ctx->buffer[( size_t )page * ctx->width];
+        if ( on )
+        {
+            for ( x = x_start; x < x_end; x++ )
+                row[x] |= mask;
+        }
+        else
+        {
+            for ( x = x_start; x < x_end; x++ )
+                row[x] &= ~mask;
+        }
+
+        _mono_fb_mark_dirty( ctx, page, x_start, x_end );
+    }
+}
+
+static void _mono_fb_begin_frame( gl_rectangle_t *rect ) {
+    mono_fb_t *ctx = active_fb;
+
+    if ( !ctx )
+        return;
+
+    memcpy( &ctx->frame, rect, sizeof( gl_rectangle_t ) );
+    ctx->frame_x = rect->top_left.x;
+    ctx->frame_y = rect->top_left.y;
+}
+
+static void _mono_fb_frame_data( gl_color_t color ) {
+    mono_fb_t *ctx = active_fb;
+
+    if ( !ctx )
+        return;
+
+    _mono_fb_set_pixel( ctx, ctx->frame_x, ctx->frame_y, _PIXEL_ON( color ) );
+
+    if ( ++ctx->frame_x >= ctx->frame.top_left.x + ( gl_int_t )ctx->frame.width )
+    {
+        ctx->frame_x = ctx->frame.top_left.x;
+        ctx->frame_y++;
+    }
+}
+
+static void _mono_fb_frame_data_buffer( const gl_color_t * __generic_ptr pixels, size_t count ) {
+    while ( count-- )
+        _mono_fb_frame_data( *pixels++ );
+}
+
+static void _mono_fb_end_frame() {
+}
+
+static void _mono_fb_copy_rect( gl_rectangle_t *src, gl_coord_t x, gl_coord_t y ) {
+    mono_fb_t *ctx = active_fb;
+    gl_int_t row;
+    gl_int_t column;
+    gl_int_t src_y;
+    gl_int_t src_x;
+    // Walk away from the destination so overlapping source pixels are read before being overwritten.
+    bool bottom_up = y > src->top_left.y;
+    bool right_to_left = x > src->top_left.x;
+
+    if ( !ctx )
+        return;
+
+    for ( row = 0; row < src->height; row++ )
+    {
+        src_y = bottom_up ? src->height - 1 - row : row;
+
+        for ( column = 0; column < src->width; column++ )
+        {
+            src_x = right_to_left ? src->width - 1 - column : column;
+
+            _mono_fb_set_pixel( ctx, x + src_x, y + src_y,
+                                mono_fb_get_pixel( ctx, src->top_left.x + src_x, src->top_left.y + src_y ) );
+        }
+    }
+}
+
+void mono_fb_cfg_setup( mono_fb_cfg_t *cfg ) {
+    cfg->transport = MONO_FB_TRANSPORT_SPI;
+
+    spi_master_configure_default( &cfg->spi_cfg );
+    cfg->cs = HAL_PIN_NC;
+    cfg->dc = HAL_PIN_NC;
+
+    i2c_master_configure_default( &cfg->i2c_cfg );
+    cfg->i2c_address = 0x3C;
+
+    cfg->write_f = NULL;
+
+    cfg->rst = HAL_PIN_NC;
+
+    cfg->buffer = NULL;
+    cfg->width = 128;
+    cfg->height = 64;
+    cfg->column_offset = 0;
+
+    cfg->init_sequence = NULL;
+    cfg->init_sequence_len = 0;
+}
+
+err_t mono_fb_init( mono_fb_t *ctx, mono_fb_cfg_t *cfg, gl_driver_t *__generic_ptr driver ) {
+    uint8_t pages = ( cfg->height + MONO_FB_PAGE_HEIGHT - 1 ) / MONO_FB_PAGE_HEIGHT;
+
+    if ( !cfg->buffer || !cfg->width || !pages || pages > MONO_FB_PAGES_MAX )
+        return MONO_FB_ERROR;
+
+    ctx->transport = cfg->transport;
+    ctx->write_f = cfg->write_f;
+
+    switch ( cfg->transport )
+    {
+    case MONO_FB_TRANSPORT_SPI:
+        if ( spi_master_open( &ctx->spi, &cfg->spi_cfg ) == SPI_MASTER_ERROR )
+            return MONO_FB_ERROR;
+        if ( digital_out_init( &ctx->dc, cfg->dc ) == DIGITAL_OUT_UNSUPPORTED_PIN )
+            return MONO_FB_ERROR;
+        ctx->cs = cfg->cs;
+        spi_master_deselect_device( ctx->cs );
+        break;
+
+    case MONO_FB_TRANSPORT_I2C:
+        if ( i2c_master_open( &ctx->i2c, &cfg->i2c_cfg ) == I2C_MASTER_ERROR )
+            return MONO_FB_ERROR;
+        i2c_master_set_slave_address( &ctx->i2c, cfg->i2c_address );
+        break;
+
+    case MONO_FB_TRANSPORT_CALLBACK:
+        if ( !cfg->write_f )
+            return MONO_FB_ERROR;
+        break;
+
+    default:
+        return MONO_FB_ERROR;
+    }
+
+    ctx->buffer = cfg->buffer;
+    ctx->width = cfg->width;
+    ctx->height = cfg->height;
+    ctx->pages = pages;
+    ctx->column_offset = cfg->column_offset;
+
+    memset( ctx->buffer, 0, MONO_FB_BUFFER_SIZE( ctx->width, ctx->height ) );
+    mono_fb_invalidate( ctx );
+
+    if ( digital_out_init( &ctx->rst, cfg->rst ) == DIGITAL_OUT_SUCCESS )
+    {
+        digital_out_low( &ctx->rst );
+        Delay_1ms();
+        digital_out_high( &ctx->rst );
+        Delay_1ms();
+    }
+
+    mono_fb_write_commands( ctx, cfg->init_sequence, cfg->init_sequence_len );
+
+    active_fb = ctx;
+
+    driver->display_width = ctx->width;
+    driver->display_height = ctx->height;
+    driver->fill_f = _mono_fb_fill;
+    driver->begin_frame_f = _mono_fb_begin_frame;
+    driver->frame_data_f = _mono_fb_frame_data;
+    driver->frame_data_buffer_f = _mono_fb_frame_data_buffer;
+    driver->end_frame_f = _mono_fb_end_frame;
+    driver->copy_rect_f = _mono_fb_copy_rect;
+
+    return MONO_FB_OK;
+}
+
+void mono_fb_write_commands( mono_fb_t *ctx, const uint8_t *commands, size_t len ) {
+    if ( commands )
+        _mono_fb_bus_write( ctx, false, commands, len );
+}
+
+void mono_fb_flush( mono_fb_t *ctx ) {
+    uint8_t page;
+    uint8_t address[3];
+    uint16_t column;
+
+    for ( page = 0; page < ctx->pages; page++ )
+    {
+        if ( ctx->dirty_start[page] >= ctx->dirty_end[page] )
+            continue;
+
+        column = ctx->dirty_start[page] + ctx->column_offset;
+        address[0] = MONO_FB_CMD_SET_PAGE | page;
+        address[1] = MONO_FB_CMD_SET_COLUMN_LOW | ( column & 0x0F );
+        address[2] = MONO_FB_CMD_SET_COLUMN_HIGH | ( ( column >> 4 ) & 0x0F );
+        _mono_fb_bus_write( ctx, false, address, sizeof( address ) );
+
+        _mono_fb_bus_write( ctx, true,
+                           &ctx->buffer[( size_t )page * ctx->width + ctx->dirty_start[page]],
+                           ctx->dirty_end[page] - ctx->dirty_start[page] );
+
+        ctx->dirty_start[page] = ctx->width;
+        ctx->dirty_end[page] = 0;
+    }
+}
+
+void mono_fb_invalidate( mono_fb_t *ctx ) {
+    uint8_t page;
+
+    for ( page = 0; page < MONO_FB_PAGES_MAX; page++ )
+    {
+        if ( page < ctx->pages )
+        {
+            ctx->dirty_start[page] = 0;
+            ctx->dirty_end[page] = ctx->width;
+        }
+        else
+        {
+            ctx->dirty_start[page] = ctx->width;
+            ctx->dirty_end[page] = 0;
+        }
+    }
+}
+
+bool mono_fb_is_dirty( mono_fb_t *ctx ) {
+    uint8_t page;
+
+    for ( page = 0; page < ctx->pages; page++ )
+    {
+        if ( ctx->dirty_start[page] < ctx->dirty_end[page] )
+            return true;
+    }
+
+    return false;
+}
+
+bool mono_fb_get_pixel( mono_fb_t *ctx, gl_coord_t x, gl_coord_t y ) {
+    if ( x < 0 || y < 0 || x >= ctx->width || y >= ctx->height )
+        return false;
+
+    return 0 != ( ctx->buffer[( size_t )( y / MONO_FB_PAGE_HEIGHT ) * ctx->width + x] & ( 1 << ( y % MONO_FB_PAGE_HEIGHT ) ) );
+}
+
+// ------------------------------------------------------------------------- END
@@ -46,6 +46,7 @@
 
 #ifdef __GNUC__
 #include <me_built_in.h>
+#include <delays.h>
 #endif
 #ifdef __MIKROC__
 #include "built_in.h"
@@ -85,6 +86,54 @@ static uint8_t port_shift_16bit_high = 0;
 #define CS_ACTIVE() digital_out_low(&pin_cs)
 #define CS_DEACTIVE() digital_out_high(&pin_cs)
 
+#if (GL_COLOR_DEPTH == GL_COLOR_DEPTH_16BPP)
+#define R_BITS(c) (((c) & 0xF800) >> 8)
+#define G_BITS(c) (((c) & 0x07E0) >> 3)
+#define B_BITS(c) (((c) & 0x001F) << 3)
+#else
+#define R_BITS(c) GL_RED_OF(c)
+#define G_BITS(c) GL_GREEN_OF(c)
+#define B_BITS(c) GL_BLUE_OF(c)
+#endif
+
+/**
+ * @brief Address window last set in the controller, in display coordinates,
+ * valid only if @b window_valid is set. Any command other than window setting
+ * clears it.
+ */
+static uint16_t window_left;
+static uint16_t window_right;
+static uint16_t window_top;
+static uint16_t window_bottom;
+static bool window_valid = false;
+
+/**
+ * @brief Position the controller writes the next pixel to, in display
+ * coordinates, valid only if @b cursor_valid is set. It's tracked for windows
+ * of a single row or column, so that the next span continuing the previous one
+ * is written with write memory continue command, without setting the window.
+ */
+static uint16_t cursor_x;
+static uint16_t cursor_y;
+static bool cursor_valid = false;
+
+/**
+ * @brief Sets address window in the controller, skipping the axes which are
+ * already set.
+ * @param[in] left Left column of the window in display coordinates.
+ * @param[in] right Right column of the window in display coordinates.
+ * @param[in] top Top row of the window in display coordinates.
+ * @param[in] bottom Bottom row of the window in display coordinates.
+ * @return Nothing.
+ */
+static void _ssd1963_set_window(uint16_t left, uint16_t right, uint16_t top, uint16_t bottom);
+
+/**
+ * @brief Strobes the data already written to port @b count times.
+ * @param[in] count Number of write strobes.
+ * @return Nothing.
+ */
+static void _ssd1963_write_strobes(size_t count);
 
 uint16_t ssd1963_get_display_width()
 {
@@ -103,27 +152,62 @@ uint16_t ssd1963_get_display_height()
  */
 void _ssd1963_begin_frame(gl_rectangle_t *rect)
 {
-    /// Orientation dependent.
-    uint16_t start_column = (display_width - 1) - (rect->top_left.x + rect->width - 1);
-    uint16_t end_column =  (display_width - 1) - rect->top_left.x;
-    uint16_t start_page = (display_height - 1) - (rect->top_left.y + rect->height - 1);
-    uint16_t end_page = (display_height - 1) - rect->top_left.y;
+    uint16_t left = rect->top_left.x;
+    uint16_t right = rect->top_left.x + rect->width - 1;
+    uint16_t top = rect->top_left.y;
+    uint16_t bottom = rect->top_left.y + rect->height - 1;
 
-    // CS_ACTIVE();
+    if (1 == rect->height)
+    {
+        // Span continuing the previous one in the same row window.
+        if (cursor_valid &&
+            (window_top == top) && (window_bottom == top) &&
+            (cursor_x == left) && (cursor_y == top) &&
+            (window_right >= right))
+        {
+            ssd1963_write_command(SSD1963_CMD_WRITE_MEMORY_CONTINUE);
+        }
+        else
+        {
+            // Row window is open to the right, for spans that follow.
+            _ssd1963_set_window(left, display_width - 1, top, top);
+            ssd1963_write_command(SSD1963_CMD_WRITE_MEMORY_START);
+        }
 
-    ssd1963_write_command(SSD1963_CMD_SET_COLUMN_ADDRESS);
-    ssd1963_write_param(Hi(start_column));
-    ssd1963_write_param(Lo(start_column));
-    ssd1963_write_param(Hi(end_column));
-    ssd1963_write_param(Lo(end_column));
+        window_valid = true;
+        cursor_valid = (right < window_right);
+        cursor_x = right + 1;
+        cursor_y = top;
+    }
+    else if (1 == rect->width)
+    {
+        // Span continuing the previous one in the same column window.
+        if (cursor_valid &&
+            (window_left == left) && (window_right == left) &&
+            (cursor_x == left) && (cursor_y == top) &&
+            (window_bottom >= bottom))
+        {
+            ssd1963_write_command(SSD1963_CMD_WRITE_MEMORY_CONTINUE);
+        }
+        else
+        {
+            // Column window is open downwards, for spans that follow.
+            _ssd1963_set_window(left, left, top, display_height - 1);
+            ssd1963_write_command(SSD1963_CMD_WRITE_MEMORY_START);
+        }
 
-    ssd1963_write_command(SSD1963_CMD_SET_PAGE_ADDRESS);
-    ssd1963_write_param(Hi(start_page));
-    ssd1963_write_param(Lo(start_page));
-    ssd1963_write_param(Hi(end_page));
-    ssd1963_write_param(Lo(end_page));
+        window_valid = true;
+        cursor_valid = (bottom < window_bottom);
+        cursor_x = left;
+        cursor_y = bottom + 1;
+    }
+    else
+    {
+        _ssd1963_set_window(left, right, top, bottom);
+        ssd1963_write_command(SSD1963_CMD_WRITE_MEMORY_START);
 
-    ssd1963_write_command(SSD1963_CMD_WRITE_MEMORY_START);
+        window_valid = true;
+    }
 
     CS_ACTIVE();
     DATA_SELECT();
@@ -138,9 +222,9 @@ void _ssd1963_end_frame()
 void _fill_8bit_host_interface(gl_rectangle_t *rect, gl_color_t color)
 {
     uint32_t length = (uint32_t)rect->width * (uint32_t)rect->height;
-    uint32_t value1 = ((color & 0xF800) >> 8) & 0x00FF;
-    uint32_t value2 = ((color & 0x07E0 ) >> 3) & 0x00FF;
-    uint32_t value3 = ((color & 0x001F ) << 3) & 0x00FF;
+    uint32_t value1 = R_BITS(color) & 0x00FF;
+    uint32_t value2 = G_BITS(color) & 0x00FF;
+    uint32_t value3 = B_BITS(color) & 0x00FF;
 
     if (!length)
         return;
@@ -175,7 +259,7 @@ void _fill_16bit_host_interface_single_channel(gl_rectangle_t *rect, gl_color_t
 
     _ssd1963_begin_frame(rect);
 
-    port_write(&data_channel_0, color<<port_shift_16bit_low);
+    port_write(&data_channel_0, GL_COLOR_TO_RGB565(color)<<port_shift_16bit_low);
     while(length--)
     {
         WRITE_STROBE();
@@ -187,14 +271,15 @@ void _fill_16bit_host_interface_single_channel(gl_rectangle_t *rect, gl_color_t
 void _fill_16bit_host_interface(gl_rectangle_t *rect, gl_color_t color)
 {
     uint32_t length = (uint32_t)rect->width * (uint32_t)rect->height;
+    uint16_t value = GL_COLOR_TO_RGB565(color);
 
     if (!length)
         return;
 
     _ssd1963_begin_frame(rect);
 
-    port_write(&data_channel_0, Lo(color)<<port_shift_16bit_low);
-    port_write(&data_channel_1, Hi(color)<<port_shift_16bit_high);
+    port_write(&data_channel_0, Lo(value)<<port_shift_16bit_low);
+    port_write(&data_channel_1, Hi(value)<<port_shift_16bit_high);
     while(length--)
     {
         WRITE_STROBE();
@@ -206,30 +291,92 @@ void _fill_16bit_host_interface(gl_rectangle_t *rect, gl_color_t color)
 // TODO Fix color, see datasheet 3cycles
 void _frame_data_8bit_host_interface(gl_color_t color)
 {
-    port_write(&data_channel_0, ((color & 0xF800) >> 8)<<port_shift_8bit);
+    port_write(&data_channel_0, R_BITS(color)<<port_shift_8bit);
     WRITE_STROBE();
 
-    port_write(&data_channel_0, ((color & 0x07E0 ) >> 3)<<port_shift_8bit);
+    port_write(&data_channel_0, G_BITS(color)<<port_shift_8bit);
     WRITE_STROBE();
 
-    port_write(&data_channel_0, ((color & 0x001F ) << 3)<<port_shift_8bit);
+    port_write(&data_channel_0, B_BITS(color)<<port_shift_8bit);
     WRITE_STROBE();
 }
 
+void _frame_data_buffer_8bit_host_interface(const gl_color_t * __generic_ptr pixels, size_t count)
+{
+    gl_color_t color;
+
+    while(count--)
+    {
+        color = *pixels++;
+
+        port_write(&data_channel_0, R_BITS(color)<<port_shift_8bit);
+        WRITE_STROBE();
+
+        port_write(&data_channel_0, G_BITS(color)<<port_shift_8bit);
+        WRITE_STROBE();
+
+        port_write(&data_channel_0, B_BITS(color)<<port_shift_8bit);
+        WRITE_STROBE();
+    }
+}
+
 // TODO Fix color, see datasheet 3cycles
 void _frame_data_16bit_host_interface_single_channel(gl_color_t color)
 {
-    port_write(&data_channel_0, color<<port_shift_16bit_low);
+    port_write(&data_channel_0, GL_COLOR_TO_RGB565(color)<<port_shift_16bit_low);
     WRITE_STROBE();
 }
 
+void _frame_data_buffer_16bit_host_interface_single_channel(const gl_color_t * __generic_ptr pixels, size_t count)
+{
+    const gl_color_t * __generic_ptr end = pixels + count;
+    const gl_color_t * __generic_ptr run;
+
+    while(pixels < end)
+    {
+        // Equal neighbouring pixels are written to port once.
+        run = pixels + 1;
+        while((run < end) && (*run == *pixels))
+            run++;
+
+        port_write(&data_channel_0, GL_COLOR_TO_RGB565(*pixels)<<port_shift_16bit_low);
+        _ssd1963_write_strobes(run - pixels);
+
+        pixels = run;
+    }
+}
+
 void _frame_data_16bit_host_interface(gl_color_t color)
 {
-    port_write(&data_channel_0, Lo(color)<<port_shift_16bit_low);
-    port_write(&data_channel_1, Hi(color)<<port_shift_16bit_high);
+    uint16_t value = GL_COLOR_TO_RGB565(color);
+
+    port_write(&data_channel_0, Lo(value)<<port_shift_16bit_low);
+    port_write(&data_channel_1, Hi(value)<<port_shift_16bit_high);
     WRITE_STROBE();
 }
 
+void _frame_data_buffer_16bit_host_interface(const gl_color_t * __generic_ptr pixels, size_t count)
+{
+    const gl_color_t * __generic_ptr end = pixels + count;
+    const gl_color_t * __generic_ptr run;
+    uint16_t value;
+
+    while(pixels < end)
+    {
+        // Equal neighbouring pixels are written to port once.
+        run = pixels + 1;
+        while((run < end) && (*run == *pixels))
+            run++;
+
+        value = GL_COLOR_TO_RGB565(*pixels);
+        port_write(&data_channel_0, Lo(value)<<port_shift_16bit_low);
+        port_write(&data_channel_1, Hi(value)<<port_shift_16bit_high);
+        _ssd1963_write_strobes(run - pixels);
+
+        pixels = run;
+    }
+}
+
 void ssd1963_init(ssd1963_cfg_t *cfg, gl_driver_t * __generic_ptr driver)
 {
     digital_out_init(&pin_cs, cfg->cs);
@@ -251,6 +398,7 @@ void ssd1963_init(ssd1963_cfg_t *cfg, gl_driver_t * __generic_ptr driver)
     {
         driver->fill_f = _fill_8bit_host_interface;
         driver->frame_data_f = _frame_data_8bit_host_interface;
+        driver->frame_data_buffer_f = _frame_data_buffer_8bit_host_interface;
 
         port_shift_8bit = 0;
         if (cfg->data_channel_0_mask == DATA_PORT_NIBBLE_HIGH) {
@@ -264,6 +412,7 @@ void ssd1963_init(ssd1963_cfg_t *cfg, gl_driver_t * __generic_ptr driver)
         {
             driver->fill_f = _fill_16bit_host_interface_single_channel;
             driver->frame_data_f = _frame_data_16bit_host_interface_single_channel;
+            driver->frame_data_buffer_f = _frame_data_buffer_16bit_host_interface_single_channel;
 
             port_shift_16bit_low = 0;
             if(cfg->data_channel_0_mask == DATA_PORT_NIBBLE_HIGH) {
@@ -277,6 +426,7 @@ void ssd1963_init(ssd1963_cfg_t *cfg, gl_driver_t * __generic_ptr driver)
 
             driver->fill_f = _fill_16bit_host_interface;
             driver->frame_data_f = _frame_data_16bit_host_interface;
+            driver->frame_data_buffer_f = _frame_data_buffer_16bit_host_interface;
 
             port_shift_16bit_low = 0;
             port_shift_16bit_high = 0;
@@ -291,6 +441,7 @@ void ssd1963_init(ssd1963_cfg_t *cfg, gl_driver_t * __generic_ptr driver)
 
     driver->begin_frame_f = _ssd1963_begin_frame;
     driver->end_frame_f = _ssd1963_end_frame;
+    driver->copy_rect_f = NULL;
 
     display_width = cfg->width;
     driver->display_width = cfg->width;
@@ -301,10 +452,18 @@ void ssd1963_init(ssd1963_cfg_t *cfg, gl_driver_t * __generic_ptr driver)
     digital_out_high(&pin_rst);
     Delay_100ms();
     Delay_100ms();
+
+    // Reset sets the window to the whole display.
+    window_valid = false;
+    cursor_valid = false;
 }
 
 void ssd1963_write_command(uint8_t command)
 {
+    // Window and cursor are known only after commands sent by begin frame.
+    window_valid = false;
+    cursor_valid = false;
+
     CS_ACTIVE();
     COMMAND_SELECT();
 
@@ -323,4 +482,57 @@ void ssd1963_write_param(uint8_t param)
     CS_DEACTIVE();
 }
 
+static void _ssd1963_set_window(uint16_t left, uint16_t right, uint16_t top, uint16_t bottom)
+{
+    bool column_set = window_valid && (window_left == left) && (window_right == right);
+    bool page_set = window_valid && (window_top == top) && (window_bottom == bottom);
+
+    /// Orientation dependent.
+    uint16_t start_column = (display_width - 1) - right;
+    uint16_t end_column = (display_width - 1) - left;
+    uint16_t start_page = (display_height - 1) - bottom;
+    uint16_t end_page = (display_height - 1) - top;
+
+    if (!column_set)
+    {
+        ssd1963_write_command(SSD1963_CMD_SET_COLUMN_ADDRESS);
+        ssd1963_write_param(Hi(start_column));
+        ssd1963_write_param(Lo(start_column));
+        ssd1963_write_param(Hi(end_column));
+        ssd1963_write_param(Lo(end_column));
+
+        window_left = left;
+        window_right = right;
+    }
+
+    if (!page_set)
+    {
+        ssd1963_write_command(SSD1963_CMD_SET_PAGE_ADDRESS);
+        ssd1963_write_param(Hi(start_page));
+        ssd1963_write_param(Lo(start_page));
+        ssd1963_write_param(Hi(end_page));
+        ssd1963_write_param(Lo(end_page));
+
+        window_top = top;
+        window_bottom = bottom;
+    }
+}
+
+static void _ssd1963_write_strobes(size_t count)
+{
+    while(count >= 4)
+    {
+        WRITE_STROBE();
+        WRITE_STROBE();
+        WRITE_STROBE();
+        WRITE_STROBE();
+        count -= 4;
+    }
+
+    while(count--)
+    {
+        WRITE_STROBE();
+    }
+}
+
 // ------------------------------------------------------------------------- END
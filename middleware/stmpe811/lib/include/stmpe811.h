@@ -52,6 +52,7 @@ extern "C"{
 #include "drv_digital_in.h"
 #include "drv_name.h"
 #include "tp.h"
+#include "tp_calibration.h"
 
 /**
  * @addtogroup middlewaregroup Middleware
@@ -132,6 +133,7 @@ extern "C"{
 #define STMPE811_REG_ADDR_TSC_DATA_XYZ   ((uint8_t)0x52) /**< 32 bit read only Data port for touchscreen controller data access. */
 #define STMPE811_REG_ADDR_TSC_FRACTION_Z ((uint8_t)0x56) /**< 8 bit Touchscreen controller FRACTION_Z. Value after reset: 0x00 */
 #define STMPE811_REG_ADDR_TSC_DATA       ((uint8_t)0x57) /**< 8 bit read only register. Data port for touchscreen controller data access. Value after reset: 0x00*/
+#define STMPE811_REG_ADDR_TSC_DATA_NON_INC ((uint8_t)0xD7) /**< TSC_DATA without address auto-increment, reads several FIFO samples in one burst. */
 #define STMPE811_REG_ADDR_TSC_I_DRIVE    ((uint8_t)0x58) /**< 8 bit read/write register. Touchscreen controller drive I. Value after reset: 0x00*/
 #define STMPE811_REG_ADDR_TSC_SHIELD     ((uint8_t)0x59) /**< 8 bit read/write register. Touchscreen controller shield. Value after reset: 0x00 */
 #define STMPE811_REG_ADDR_TEMP_CTRL      ((uint8_t)0x60) /**< 8 bit read/write register. Temperature sensor setup. Value after reset: 0x00 */
@@ -257,6 +259,22 @@ extern "C"{
 #define STMPE811_TSC_CFG_AVE_CTRL_8_SAMPLES     ((uint8_t)( 3 << 6 ))
 /** @} */ // TSC_CFG_register_bits
 
+/**
+ * @defgroup stmpe811_fifo_batch FIFO batch settings
+ * @details Samples are collected in the FIFO, averaged by the controller itself,
+ * and read by the driver in batches with a single I2C burst.
+ * @{
+ */
+#ifndef STMPE811_FIFO_BATCH
+#define STMPE811_FIFO_BATCH                 4   /**< FIFO threshold, interrupt is raised once this many samples are ready. */
+#endif
+#ifndef STMPE811_TSC_CFG_AVE_CTRL
+#define STMPE811_TSC_CFG_AVE_CTRL           STMPE811_TSC_CFG_AVE_CTRL_4_SAMPLES /**< Conversions averaged by the controller per sample. */
+#endif
+#define STMPE811_FIFO_BATCH_MAX             8   /**< Maximal number of samples read in a single burst. */
+#define STMPE811_FIFO_SAMPLE_SIZE           4   /**< Size of packed 12-bit X, 12-bit Y and 8-bit Z sample. */
+/** @} */ // stmpe811_fifo_batch
+
 /**
  * @brief Calibration data structure.
  * @details Used for converting raw coordinate to actual pixel cordinate.
@@ -321,6 +339,9 @@ typedef struct {
 
     /**< Calibration constants used for converting raw ADC touch data to actual pixel coordinates.*/
     stmpe811_calibration_data_t calibration_data;
+
+    /**< Transform converting raw ADC touch data to actual pixel coordinates. */
+    tp_calibration_t calibration;
 } stmpe811_t;
 
 /**
@@ -530,6 +551,34 @@ void stmpe811_get_calibration_data( stmpe811_t * ctx, stmpe811_calibration_data_
  */
 void stmpe811_set_calibration_data( stmpe811_t * ctx, const stmpe811_calibration_data_t * cdata );
 
+/**
+ * @brief Utility funciton used for getting a copy of current calibration transform.
+ * @details Function copies transform that's being used for converting raw ADC values
+ * to actual pixel coordinates, e.g. to save it with @ref tp_calibration_save.
+ * @param[in] ctx Initialized STMPE811 context structure. See @ref stmpe811_t for more
+ * @param[out] cal Pointer to memory where calibration transform will be stored.
+ */
+void stmpe811_get_calibration( stmpe811_t * ctx, tp_calibration_t * cal );
+
+/**
+ * @brief Sets touch window of the controller.
+ * @details Controller discards samples with raw coordinates outside of the window,
+ * e.g. touches of the panel edges outside of the display area.
+ * @param[in] ctx Initialized STMPE811 context structure. See @ref stmpe811_t for more
+ * @param[in] window Raw coordinate limits, same as the calibration data.
+ */
+void stmpe811_set_window( stmpe811_t * ctx, const stmpe811_calibration_data_t * window );
+
+/**
+ * @brief Utility funciton used for setting calibration transform.
+ * @details Unlike @ref stmpe811_set_calibration_data, transform computed with
+ * @ref tp_calibration_compute from three or more points read with @ref stmpe811_read_xyz_raw
+ * compensates rotated and skewed panels as well.
+ * @param[in] ctx Initialized STMPE811 context structure. See @ref stmpe811_t for more
+ * @param[in] cal Pointer to memory from where new calibration transform will be copied and set.
+ */
+void stmpe811_set_calibration( stmpe811_t * ctx, const tp_calibration_t * cal );
+
 /*! @} */ // middlewaregroup
 /*! @} */ // stmpe811
 
@@ -61,8 +61,8 @@ static const uint8_t init_sequence[] = {
     STMPE811_REG_ADDR_ADC_CTRL1,      STMPE811_ADC_CTRL1_SAMPLE_TIME_80 | STMPE811_ADC_CTRL1_REF_SEL_EXTERNAL | STMPE811_ADC_CTRL1_MOD_12B, // 0x49,
     STMPE811_REG_ADDR_ADC_CTRL2,      STMPE811_ADC_CTRL2_ADC_FREQ_3_25_MHz, //0x01
     STMPE811_REG_ADDR_GPIO_AF,        0x00,
-    STMPE811_REG_ADDR_TSC_CFG,        STMPE811_TSC_CFG_SETTLING_500us | STMPE811_TSC_CFG_TOUCH_DET_DELAY_500us | STMPE811_TSC_CFG_AVE_CTRL_4_SAMPLES, // 0x9a,
-    STMPE811_REG_ADDR_FIFO_TH,        1, // 0x01 single point
+    STMPE811_REG_ADDR_TSC_CFG,        STMPE811_TSC_CFG_SETTLING_500us | STMPE811_TSC_CFG_TOUCH_DET_DELAY_500us | STMPE811_TSC_CFG_AVE_CTRL,
+    STMPE811_REG_ADDR_FIFO_TH,        STMPE811_FIFO_BATCH, // interrupt once the batch is ready
     STMPE811_REG_ADDR_FIFO_STA,       STMPE811_FIFO_STA_RESET, // 0x01,
     STMPE811_REG_ADDR_FIFO_STA,       STMPE811_FIFO_STA_START, // 0x00,
     STMPE811_REG_ADDR_TSC_FRACTION_Z, 0x7,
@@ -76,25 +76,27 @@ static const uint8_t init_sequence[] = {
 /* --------------------------------------------- PRIVATE FUNCTIONS - DECLARATIONS -------------------------------------------*/
 
 /**
- * @brief Maps value of @p x in [in_min, in_max] range to [0, out_max] range.
- * @param[in] x Raw conversion result from TSC2003 IC.
- * @param[in] in_min Calibrated minimum value.
- * @param[in] in_max Calibrated maximum value.
- * @param[in] out_max Screen actual resolution value. ( Example 240,320... )
- * @retval Returns actual coordinate value for read AD conversion from IC.
+ * @brief Converts calibration data to calibration transform.
+ * @details Calibration transform maps [min, max] calibration data ranges to [0, width/height].
+ * @param[out] ctx Initialized STMPE811 context structure. See @ref stmpe811_t for more
+ * information about the context structure.
+ * @retval Nothing.
  */
-static uint32_t _map( uint32_t x, uint32_t in_min, uint32_t in_max, uint32_t out_max );
+static void _stmpe811_update_calibration( stmpe811_t * ctx );
 
 /**
  * @brief Reads x & y coordinate values to 'touch point 0' ctx member if z is over press threshold
+ * @details Up to @ref STMPE811_FIFO_BATCH_MAX packed samples are read from the FIFO in a single
+ * burst and averaged. If more samples piled up, the rest of them is dropped.
  * @note STMPE811 should be configured for x,y,z operation mode in order to read values.
  * Function doesn't relly on @li @ref stmpe811_read_xyz for the sake of
  * using less pointers and better performance.
  * @param[out] ctx Initialized STMPE811 context structure. See @ref stmpe811_t for more
  * information about the context structure.
+ * @param[in] fifo_size Number of samples in the FIFO.
  * @retval Returns true if coords have been updated.
  */
-static bool _stmpe811_update_ctx_coords( stmpe811_t * ctx );
+static bool _stmpe811_update_ctx_coords( stmpe811_t * ctx, uint8_t fifo_size );
 
 /**
  * @brief Utility funciton used for calibration.
@@ -161,14 +163,14 @@ tp_err_t stmpe811_process( stmpe811_t * ctx ) {
                  * This works well with TP library and uses old coordinates util new ones are ready.
                  */
                 if( fifo_size ) {
-                    _stmpe811_update_ctx_coords(ctx);
+                    _stmpe811_update_ctx_coords( ctx, fifo_size );
                 }
             } else if( fifo_size ) {
                 /**
                  * @note If pen is not down and new coords are ready, then its a pen down event.
                  * Check for coords & threshold.
                  */
-                if( _stmpe811_update_ctx_coords(ctx) ) {
+                if( _stmpe811_update_ctx_coords( ctx, fifo_size ) ) {
                     ctx->press_det = TP_EVENT_PRESS_DET;
                     ctx->pen_down = true;
                     ctx->touch.point[0].event = TP_EVENT_PRESS_DOWN;
@@ -317,6 +319,8 @@ void stmpe811_calibrate( stmpe811_t* ctx ) {
     _stmpe811_calibrate_point( ctx, false );
     _stmpe811_calibrate_point( ctx, false );
     _stmpe811_calibrate_point( ctx, false );
+
+    _stmpe811_update_calibration( ctx );
 }
 
 void stmpe811_read_xyz_raw( stmpe811_t * ctx, uint16_t* x, uint16_t* y, uint16_t* z ) {
@@ -330,10 +334,6 @@ void stmpe811_read_xyz_raw( stmpe811_t * ctx, uint16_t* x, uint16_t* y, uint16_t
     *y = (uint16_t)values[3] + ((uint16_t)values[2] << 8);
     *z = values[4];
 
-    /* Get actual display pixel coordinates. */
-    *x = _map( *x, ctx->calibration_data.min_x, ctx->calibration_data.max_x, ctx->width );
-    *y = _map( *y, ctx->calibration_data.min_y, ctx->calibration_data.max_y, ctx->height );
-
     /* Clear fifo. */
     stmpe811_generic_write_byte( ctx, STMPE811_REG_ADDR_FIFO_STA, STMPE811_FIFO_STA_RESET);
     stmpe811_generic_write_byte( ctx, STMPE811_REG_ADDR_FIFO_STA, STMPE811_FIFO_STA_START);
@@ -342,8 +342,7 @@ void stmpe811_read_xyz_raw( stmpe811_t * ctx, uint16_t* x, uint16_t* y, uint16_t
 void stmpe811_read_xyz( stmpe811_t * ctx, uint16_t* x, uint16_t* y, uint16_t* z ) {
     stmpe811_read_xyz_raw ( ctx, x, y, z );
     /* Get actual display pixel coordinates. */
-    *x = _map( *x, ctx->calibration_data.min_x, ctx->calibration_data.max_x, ctx->width );
-    *y = _map( *y, ctx->calibration_data.min_y, ctx->calibration_data.max_y, ctx->height );
+    tp_calibration_apply( &ctx->calibration, *x, *y, x, y );
 }
 
 void stmpe811_get_calibration_data( stmpe811_t * ctx, stmpe811_calibration_data_t * cdata ) {
@@ -352,39 +351,81 @@ void stmpe811_get_calibration_data( stmpe811_t * ctx, stmpe811_calibration_data_
 
 void stmpe811_set_calibration_data( stmpe811_t * ctx, const stmpe811_calibration_data_t * cdata ) {
     memcpy( (void *)&ctx->calibration_data, (const void*)cdata, sizeof(stmpe811_calibration_data_t) );
+    _stmpe811_update_calibration( ctx );
+}
+
+void stmpe811_set_window( stmpe811_t * ctx, const stmpe811_calibration_data_t * window ) {
+    uint8_t tmp_data[2];
+
+    tmp_data[0] = window->max_x >> 8;
+    tmp_data[1] = window->max_x;
+    stmpe811_generic_write( ctx, STMPE811_REG_ADDR_WDW_TR_X, tmp_data, 2 );
+
+    tmp_data[0] = window->max_y >> 8;
+    tmp_data[1] = window->max_y;
+    stmpe811_generic_write( ctx, STMPE811_REG_ADDR_WDW_TR_Y, tmp_data, 2 );
+
+    tmp_data[0] = window->min_x >> 8;
+    tmp_data[1] = window->min_x;
+    stmpe811_generic_write( ctx, STMPE811_REG_ADDR_WDW_BL_X, tmp_data, 2 );
+
+    tmp_data[0] = window->min_y >> 8;
+    tmp_data[1] = window->min_y;
+    stmpe811_generic_write( ctx, STMPE811_REG_ADDR_WDW_BL_Y, tmp_data, 2 );
+}
+
+void stmpe811_get_calibration( stmpe811_t * ctx, tp_calibration_t * cal ) {
+    *cal = ctx->calibration;
+}
+
+void stmpe811_set_calibration( stmpe811_t * ctx, const tp_calibration_t * cal ) {
+    ctx->calibration = *cal;
 }
 
 /* --------------------------------------------- PRIVATE FUNCTIONS - IMPLEMENTATIONS ----------------------------------------*/
 
-static uint32_t _map( uint32_t x, uint32_t in_min, uint32_t in_max, uint32_t out_max ) {
-    x -= in_min;
-    return (x * out_max) / (in_max - in_min);
+static void _stmpe811_update_calibration( stmpe811_t * ctx ) {
+    tp_calibration_from_range( &ctx->calibration,
+                               ctx->calibration_data.min_x, ctx->calibration_data.max_x,
+                               ctx->calibration_data.min_y, ctx->calibration_data.max_y,
+                               ctx->width, ctx->height );
 }
 
-static bool _stmpe811_update_ctx_coords( stmpe811_t * ctx ) {
-    uint8_t values[5];
-    int16_t val;
+static bool _stmpe811_update_ctx_coords( stmpe811_t * ctx, uint8_t fifo_size ) {
+    uint8_t values[STMPE811_FIFO_BATCH_MAX * STMPE811_FIFO_SAMPLE_SIZE];
+    uint32_t x = 0, y = 0, z = 0;
+    uint8_t *sample = values;
+    bool backlog = false;
 
-    stmpe811_generic_read( ctx, STMPE811_REG_ADDR_TSC_DATA_X, values, 5 );
+    if( fifo_size > STMPE811_FIFO_BATCH_MAX ) {
+        fifo_size = STMPE811_FIFO_BATCH_MAX;
+        backlog = true;
+    }
 
-    /* Pack values. */
-    uint16_t x = (uint16_t)values[1] + ((uint16_t)values[0] << 8);
-    uint16_t y = (uint16_t)values[3] + ((uint16_t)values[2] << 8);
-    uint8_t z = values[4];
+    /* Whole batch is read from the same data port address. */
+    stmpe811_generic_read( ctx, STMPE811_REG_ADDR_TSC_DATA_NON_INC, values, fifo_size * STMPE811_FIFO_SAMPLE_SIZE );
 
-    /* Get actual display pixel coordinates. */
-    x = _map( x, ctx->calibration_data.min_x, ctx->calibration_data.max_x, ctx->width );
-    y = _map( y, ctx->calibration_data.min_y, ctx->calibration_data.max_y, ctx->height );
+    /* Samples piled up while the driver wasn't processed are dropped, so touch doesn't lag behind. */
+    if( backlog )
+        _stmpe811_clear_fifo( ctx );
 
-    /* Write coords. */
-    if( z > ctx->press_threshold ) {
-        ctx->touch.point[0].coord_x = x;
-        ctx->touch.point[0].coord_y = y;
+    /* Unpack 12-bit x, 12-bit y and 8-bit z of every sample. */
+    for( uint8_t i = 0; i < fifo_size; i++ ) {
+        x += ((uint16_t)sample[0] << 4) | (sample[1] >> 4);
+        y += ((uint16_t)(sample[1] & 0x0F) << 8) | sample[2];
+        z += sample[3];
+        sample += STMPE811_FIFO_SAMPLE_SIZE;
     }
 
-    /* Clear fifo. */
-    stmpe811_generic_write_byte( ctx, STMPE811_REG_ADDR_FIFO_STA, STMPE811_FIFO_STA_RESET );
-    stmpe811_generic_write_byte( ctx, STMPE811_REG_ADDR_FIFO_STA, STMPE811_FIFO_STA_START );
+    x /= fifo_size;
+    y /= fifo_size;
+    z /= fifo_size;
+
+    /* Write actual display pixel coordinates. */
+    if( z > ctx->press_threshold ) {
+        tp_calibration_apply( &ctx->calibration, x, y,
+                              &ctx->touch.point[0].coord_x, &ctx->touch.point[0].coord_y );
+    }
 
     return (z > ctx->press_threshold) ? true : false;
 }
@@ -52,6 +52,7 @@ extern "C"{
 #include "drv_digital_out.h"
 #include "drv_digital_in.h"
 #include "tp.h"
+#include "tp_calibration.h"
 #include "gl.h"
 #include "board.h"
 
@@ -93,6 +94,27 @@ extern "C"{
 #define TP_MIKROE_PRESSURE_THRESHOLD_UPPER 0
 #endif
 
+/**
+ * @brief Number of AD conversions per measured value.
+ * @details Conversions are sorted, the lowest and the highest one are left out
+ * and the rest are averaged.
+ */
+#ifndef TP_MIKROE_OVERSAMPLING
+#define TP_MIKROE_OVERSAMPLING 5
+#endif
+
+/**
+ * @brief Settling times in milliseconds.
+ * @details Time the panel needs after switching the driven plates, before
+ * pressure (Z) or coordinates (X, Y) can be measured.
+ */
+#ifndef TP_MIKROE_SETTLE_TIME_Z
+#define TP_MIKROE_SETTLE_TIME_Z 10
+#endif
+#ifndef TP_MIKROE_SETTLE_TIME_XY
+#define TP_MIKROE_SETTLE_TIME_XY 1
+#endif
+
 /**
  * @brief Mapping for ADC config structure.
  */
@@ -126,6 +148,24 @@ typedef struct {
     uint16_t tp_mikroe_pressure_threshold_upper; /**< Upper threshold level.*/
 } tp_mikroe_pressure_threshold_t;
 
+/**
+ * @brief Tick source function.
+ * @details Returns free running millisecond counter, e.g. system tick or
+ * counter incremented by timer interrupt.
+ */
+typedef uint32_t ( *tp_mikroe_tick_t )( void );
+
+/**
+ * @brief Measurement phase.
+ * @details Plates driven while the panel is being measured without blocking.
+ */
+typedef enum {
+    TP_MIKROE_PHASE_IDLE, /**< Panel is not driven. */
+    TP_MIKROE_PHASE_Z,    /**< Pressure is measured once the panel settles. */
+    TP_MIKROE_PHASE_X,    /**< X plate is driven, Y coordinate is measured once it settles. */
+    TP_MIKROE_PHASE_Y     /**< Y plate is driven, X coordinate is measured once it settles. */
+} tp_mikroe_phase_t;
+
 /**
  * @brief TP_MIKROE Configuration Object.
  * @details Configuration object definition for TP_MIKROE touch controller.
@@ -172,7 +212,7 @@ typedef struct {
     tp_event_t press_det;   /**< Touch pressure event. */
     tp_touch_coord_t touch; /**< Touch item. */
     tp_event_t gesture;     /**< Gesture event. */
-    tp_rotate_t rotate;     /**< Panel rotation. */
+    tp_rotate_t rotate;     /**< Panel rotation, applied when calibration data is set. */
 
     bool pen_down; /**< Utility helper variable used for interpreting events. */
 
@@ -182,8 +222,16 @@ typedef struct {
     /**< Calibration constants used for converting raw ADC touch data to actual pixel coordinates.*/
     tp_mikroe_calibration_data_t calibration_data;
 
+    /**< Transform converting raw ADC touch data to actual pixel coordinates. */
+    tp_calibration_t calibration;
+
     uint16_t width;  /**< Touch panel width in pixels. */
     uint16_t height; /**< Touch panel height in pixels. */
+
+    tp_mikroe_tick_t tick_f;   /**< Tick source, NULL if the panel is measured with delays. */
+    tp_mikroe_phase_t phase;   /**< Current measurement phase. */
+    uint32_t phase_start;      /**< Tick at which the current phase started. */
+    uint16_t y_pos;            /**< Y coordinate ADC value, while X coordinate is measured. */
 } tp_mikroe_t;
 
 /**
@@ -228,6 +276,19 @@ typedef struct {
  */
 tp_err_t tp_mikroe_process( tp_mikroe_t *ctx );
 
+/**
+ * @brief Sets tick source for measuring without delays.
+ * @details With tick source set, @ref tp_mikroe_process doesn't wait for the panel
+ * to settle. Every call makes the next step of the measurement once enough time has
+ * passed since the previous one, and returns immediately otherwise. Measured values
+ * are oversampled and filtered, see @ref TP_MIKROE_OVERSAMPLING.
+ * @param[in] ctx Initialized TP_MIKROE context structure. See @ref tp_mikroe_t for more
+ * information about the context structure.
+ * @param[in] tick Tick source, NULL returns to measuring with delays.
+ * @retval Nothing.
+ */
+void tp_mikroe_set_tick( tp_mikroe_t *ctx, tp_mikroe_tick_t tick );
+
 /**
  * @brief Read gesture information.
  * @details Since TP_MIKROE does not support gestures this function is purely for interfacing
@@ -295,6 +356,29 @@ void tp_mikroe_get_calibration_data ( tp_mikroe_t *ctx, tp_mikroe_calibration_da
  */
 void tp_mikroe_set_calibration_data ( tp_mikroe_t *ctx, const tp_mikroe_calibration_data_t *cdata );
 
+/**
+ * @brief Utility function used for getting a copy of current calibration transform.
+ * @details Function copies transform that's being used for converting raw ADC values
+ * to actual pixel coordinates, e.g. to save it with @ref tp_calibration_save.
+ * @param[in] ctx Initialized TP_MIKROE context structure. See @ref tp_mikroe_t for more
+ * information about the context structure.
+ * @param[out] cal Pointer to memory where calibration transform will be stored.
+ * @retval Nothing.
+ */
+void tp_mikroe_get_calibration ( tp_mikroe_t *ctx, tp_calibration_t *cal );
+
+/**
+ * @brief Utility function used for setting calibration transform.
+ * @details Unlike @ref tp_mikroe_set_calibration_data, transform computed with
+ * @ref tp_calibration_compute from three or more points read with @ref tp_mikroe_check_pressure
+ * compensates rotated and skewed panels as well. Panel rotation is not applied to it.
+ * @param[in] ctx Initialized TP_MIKROE context structure. See @ref tp_mikroe_t for more
+ * information about the context structure.
+ * @param[in] cal Pointer to memory from where new calibration transform will be copied and set.
+ * @retval Nothing.
+ */
+void tp_mikroe_set_calibration ( tp_mikroe_t *ctx, const tp_calibration_t *cal );
+
 /**
  * @brief Utility function used for setting threshold levels.
  * @details Function copies data stored in @p pressure. That information will be  be used for
@@ -74,15 +74,14 @@ const tp_mikroe_calibration_data_t TP_MIKROE_CALIBRATION_DATA_DEFAULT = {
 };
 
 /**
- * @brief Function for calculating coordinates.
- * @details This function calculates the coordinates of pressed touch point/points.
+ * @brief Function for converting calibration data to calibration transform.
+ * @details This function maps [min, max] calibration data ranges to [0, width/height],
+ * swapping and mirroring the axes depending on panel rotation.
  * @param[in] ctx Initialized TP_MIKROE context structure. See @ref tp_mikroe_t for more
  * information about the context structure.
- * @param[in] *x_coord_int - x value.
- * @param[in] *y_coord_int - y value.
  * @retval Nothing.
  */
-static void tp_mikroe_calc_coord( tp_mikroe_t *ctx, int *x_coord_int, int *y_coord_int );
+static void tp_mikroe_update_calibration( tp_mikroe_t *ctx );
 
 /**
  * @brief Configures pins.
@@ -116,6 +115,56 @@ static void tp_mikroe_driver_z_on();
  */
 static void tp_mikroe_adc_init_pins();
 
+/**
+ * @brief Reads oversampled ADC value.
+ * @details Makes @ref TP_MIKROE_OVERSAMPLING conversions, leaves out the lowest and
+ * the highest one and averages the rest.
+ * @param[in] analog_in ADC context structure.
+ * @retval Filtered ADC value.
+ */
+static uint16_t tp_mikroe_read_filtered( analog_in_t *analog_in );
+
+/**
+ * @brief Checks if pressure read on Y plate is strong enough.
+ * @param[in] ctx Initialized TP_MIKROE context structure. See @ref tp_mikroe_t for more
+ * information about the context structure.
+ * @param[in] adc_rd Pressure ADC value.
+ * @retval True if press is detected, False if not.
+ */
+static bool tp_mikroe_is_pressed( tp_mikroe_t *ctx, uint16_t adc_rd );
+
+/**
+ * @brief Updates touch events after measurement.
+ * @details Touch down is reported once pressure and both coordinates are measured,
+ * and is released on the next measurement.
+ * @param[in] ctx Initialized TP_MIKROE context structure. See @ref tp_mikroe_t for more
+ * information about the context structure.
+ * @param[in] pressed Pressure is detected.
+ * @param[in] measured Coordinates are measured, valid only if the pen was up.
+ * @param[in] x_pos X coordinate ADC value.
+ * @param[in] y_pos Y coordinate ADC value.
+ * @retval Nothing.
+ */
+static void tp_mikroe_update_events( tp_mikroe_t *ctx, bool pressed, bool measured,
+                                     uint16_t x_pos, uint16_t y_pos );
+
+/**
+ * @brief Makes the next step of the measurement without blocking.
+ * @param[in] ctx Initialized TP_MIKROE context structure with tick source set.
+ * See @ref tp_mikroe_t for more information about the context structure.
+ * @retval Nothing.
+ */
+static void tp_mikroe_process_phase( tp_mikroe_t *ctx );
+
+/**
+ * @brief Starts the given measurement phase.
+ * @param[in] ctx Initialized TP_MIKROE context structure with tick source set.
+ * See @ref tp_mikroe_t for more information about the context structure.
+ * @param[in] phase Phase to be started.
+ * @retval Nothing.
+ */
+static void tp_mikroe_start_phase( tp_mikroe_t *ctx, tp_mikroe_phase_t phase );
+
 void tp_mikroe_default_cfg_adc ( tp_mikroe_t *ctx ) {
     tp_mikroe_adc_init_pins();
 }
@@ -124,8 +173,6 @@ tp_err_t tp_mikroe_init_tp ( tp_mikroe_t *ctx, tp_mikroe_cfg_t *cfg, tp_drv_t *d
     analog_in_open( &ctx->analog_in_x, &cfg->analog_in_cfg_read_x );
     analog_in_open( &ctx->analog_in_y, &cfg->analog_in_cfg_read_y );
 
-    tp_mikroe_set_calibration_data( ctx, &TP_MIKROE_CALIBRATION_DATA_DEFAULT );
-
     ctx->pressure_threshold_level.tp_mikroe_pressure_threshold_lower =
         cfg->pressure_threshold_level.tp_mikroe_pressure_threshold_lower;
     ctx->pressure_threshold_level.tp_mikroe_pressure_threshold_upper =
@@ -143,10 +190,15 @@ tp_err_t tp_mikroe_init_tp ( tp_mikroe_t *ctx, tp_mikroe_cfg_t *cfg, tp_drv_t *d
     ctx->width = cfg->width;
     ctx->height = cfg->height;
 
+    tp_mikroe_set_calibration_data( ctx, &TP_MIKROE_CALIBRATION_DATA_DEFAULT );
+
     ctx->press_det = TP_EVENT_PRESS_NOT_DET;
 
     ctx->pen_down = false;
 
+    ctx->tick_f = NULL;
+    ctx->phase = TP_MIKROE_PHASE_IDLE;
+
     return TP_OK;
 
     tmp_ptr1( NULL );
@@ -157,32 +209,27 @@ tp_err_t tp_mikroe_init_tp ( tp_mikroe_t *ctx, tp_mikroe_cfg_t *cfg, tp_drv_t *d
 
 tp_err_t tp_mikroe_process ( tp_mikroe_t *ctx ) {
     uint16_t x_pos = 0, y_pos = 0;
+    bool pressed, measured = false;
 
-    ctx->touch.id = TP_TOUCH_ID_0;
-    ctx->touch.event = TP_EVENT_PRESS_NOT_DET;
-    ctx->press_det = TP_EVENT_PRESS_NOT_DET;
+    if ( ctx->tick_f ) {
+        tp_mikroe_process_phase( ctx );
+        return TP_OK;
+    }
 
-    if ( tp_mikroe_pressure_level_detect( ctx ) ) {
-        if ( !ctx->pen_down ) {
-            if ( tp_mikroe_check_pressure( ctx, &x_pos, &y_pos ) ) {
-                tp_mikroe_update_ctx_coords( ctx, x_pos, y_pos );
-                ctx->press_det = TP_EVENT_PRESS_DET;
-                ctx->touch.event = TP_EVENT_PRESS_DOWN;
-                ctx->pen_down = true;
-            } else {
-                ctx->press_det = TP_EVENT_PRESS_DET;
-                ctx->touch.event = TP_EVENT_PRESS_UP;
-                ctx->pen_down = false;
-            }
-        }
-    } else {
-        ctx->pen_down = false;
-        ctx->touch.event = TP_EVENT_PRESS_NOT_DET;
-        ctx->press_det = TP_EVENT_PRESS_NOT_DET;
+    pressed = tp_mikroe_pressure_level_detect( ctx );
+    if ( pressed && !ctx->pen_down ) {
+        measured = tp_mikroe_check_pressure( ctx, &x_pos, &y_pos );
     }
+
+    tp_mikroe_update_events( ctx, pressed, measured, x_pos, y_pos );
     return TP_OK;
 }
 
+void tp_mikroe_set_tick ( tp_mikroe_t *ctx, tp_mikroe_tick_t tick ) {
+    ctx->tick_f = tick;
+    ctx->phase = TP_MIKROE_PHASE_IDLE;
+}
+
 void tp_mikroe_gesture ( tp_mikroe_t *ctx, tp_event_t *event ) {
     /**
      * @brief MikroE Touch panel implementation
@@ -215,6 +262,8 @@ void tp_mikroe_calibrate ( tp_t *tp_instance ) {
     DRAW_ARROW_BOTTOM_LEFT();
     tp_mikroe_calibrate_point( tp_instance->tp_drv_ctx, false );
 
+    tp_mikroe_update_calibration( tp_instance->tp_drv_ctx );
+
     gl_clear( GL_BLACK );
 }
 
@@ -224,6 +273,15 @@ void tp_mikroe_get_calibration_data ( tp_mikroe_t *ctx, tp_mikroe_calibration_da
 
 void tp_mikroe_set_calibration_data ( tp_mikroe_t *ctx, const tp_mikroe_calibration_data_t *cdata ) {
     memcpy( ( void * )&ctx->calibration_data, ( const void * )cdata, sizeof( tp_mikroe_calibration_data_t ) );
+    tp_mikroe_update_calibration( ctx );
+}
+
+void tp_mikroe_get_calibration ( tp_mikroe_t *ctx, tp_calibration_t *cal ) {
+    *cal = ctx->calibration;
+}
+
+void tp_mikroe_set_calibration ( tp_mikroe_t *ctx, const tp_calibration_t *cal ) {
+    ctx->calibration = *cal;
 }
 
 void tp_mikroe_set_pressure_threshold_level ( tp_mikroe_cfg_t *cfg, tp_mikroe_pressure_threshold_t pressure ) {
@@ -231,14 +289,14 @@ void tp_mikroe_set_pressure_threshold_level ( tp_mikroe_cfg_t *cfg, tp_mikroe_pr
 }
 
 bool tp_mikroe_check_pressure ( tp_mikroe_t *ctx, uint16_t *x_pos, uint16_t *y_pos ) {
-    unsigned int result = 0;
+    uint16_t result = 0;
 
     tp_mikroe_driver_x_on();
 
     Delay_1ms();
 
-    analog_in_read ( &ctx->analog_in_y, &result );
-    if ( ctx->pressure_threshold_level->tp_mikroe_pressure_threshold_lower > result ) {
+    result = tp_mikroe_read_filtered( &ctx->analog_in_y );
+    if ( ctx->pressure_threshold_level.tp_mikroe_pressure_threshold_lower > result ) {
         return false;
     }
 
@@ -248,8 +306,8 @@ bool tp_mikroe_check_pressure ( tp_mikroe_t *ctx, uint16_t *x_pos, uint16_t *y_p
 
     Delay_1ms();
 
-    analog_in_read ( &ctx->analog_in_x, &result );
-    if ( ctx->pressure_threshold_level->tp_mikroe_pressure_threshold_lower > result ) {
+    result = tp_mikroe_read_filtered( &ctx->analog_in_x );
+    if ( ctx->pressure_threshold_level.tp_mikroe_pressure_threshold_lower > result ) {
         return false;
     }
 
@@ -261,15 +319,7 @@ bool tp_mikroe_check_pressure ( tp_mikroe_t *ctx, uint16_t *x_pos, uint16_t *y_p
 }
 
 void tp_mikroe_update_ctx_coords ( tp_mikroe_t *ctx, uint16_t x_pos, uint16_t y_pos ) {
-    int x_coord_int = 0, y_coord_int = 0;
-
-    x_coord_int = x_pos - ctx->calibration_data->min_x;
-    y_coord_int = y_pos - ctx->calibration_data->min_y;
-
-    tp_mikroe_calc_coord( ctx, &x_coord_int, &y_coord_int );
-
-    ctx->touch.coord_x = x_coord_int;
-    ctx->touch.coord_y = y_coord_int;
+    tp_calibration_apply( &ctx->calibration, x_pos, y_pos, &ctx->touch.coord_x, &ctx->touch.coord_y );
 }
 
 void tp_mikroe_calibrate_point ( tp_mikroe_t *ctx, bool calibration_points_uninitialized ) {
@@ -312,49 +362,156 @@ void tp_mikroe_cfg_setup ( tp_mikroe_cfg_t *cfg ) {
 }
 
 char tp_mikroe_pressure_level_detect ( tp_mikroe_t *ctx ) {
-    int adc_rd = 0;
-    char result = 0;
-
     tp_mikroe_driver_z_on();
 
     Delay_10ms();
 
-    analog_in_read ( &ctx->analog_in_y, &adc_rd );
+    return tp_mikroe_is_pressed( ctx, tp_mikroe_read_filtered( &ctx->analog_in_y ) );
+}
+
+static uint16_t tp_mikroe_read_filtered ( analog_in_t *analog_in ) {
+    uint16_t samples[ TP_MIKROE_OVERSAMPLING ];
+    uint16_t tmp;
+    uint32_t sum = 0;
+    uint8_t i, j, first = 0, last = TP_MIKROE_OVERSAMPLING;
+
+    // Conversions are few, insertion sort is enough.
+    for ( i = 0; i < TP_MIKROE_OVERSAMPLING; i++ ) {
+        tmp = 0;
+        analog_in_read( analog_in, &tmp );
+        for ( j = i; ( j > 0 ) && ( samples[ j - 1 ] > tmp ); j-- )
+            samples[ j ] = samples[ j - 1 ];
+        samples[ j ] = tmp;
+    }
+
+    // Leave out the extremes, they are most likely noise.
+    if ( TP_MIKROE_OVERSAMPLING > 2 ) {
+        first = 1;
+        last = TP_MIKROE_OVERSAMPLING - 1;
+    }
+
+    for ( i = first; i < last; i++ )
+        sum += samples[ i ];
+
+    return sum / ( last - first );
+}
 
+static bool tp_mikroe_is_pressed ( tp_mikroe_t *ctx, uint16_t adc_rd ) {
     #if defined TP_MIKROE_TRANSISTOR_LOGIC
-    result = ( ctx->pressure_threshold_level->tp_mikroe_pressure_threshold_upper < adc_rd );
+    return ( ctx->pressure_threshold_level.tp_mikroe_pressure_threshold_upper < adc_rd );
     #else
-    result = ( ctx->pressure_threshold_level->tp_mikroe_pressure_threshold_upper > adc_rd );
+    return ( ctx->pressure_threshold_level.tp_mikroe_pressure_threshold_upper > adc_rd );
     #endif
+}
 
-    return result;
+static void tp_mikroe_update_events ( tp_mikroe_t *ctx, bool pressed, bool measured,
+                                      uint16_t x_pos, uint16_t y_pos ) {
+    ctx->touch.id = TP_TOUCH_ID_0;
+    ctx->touch.event = TP_EVENT_PRESS_NOT_DET;
+    ctx->press_det = TP_EVENT_PRESS_NOT_DET;
+
+    if ( pressed ) {
+        if ( !ctx->pen_down ) {
+            if ( measured ) {
+                tp_mikroe_update_ctx_coords( ctx, x_pos, y_pos );
+                ctx->press_det = TP_EVENT_PRESS_DET;
+                ctx->touch.event = TP_EVENT_PRESS_DOWN;
+                ctx->pen_down = true;
+            } else {
+                ctx->press_det = TP_EVENT_PRESS_DET;
+                ctx->touch.event = TP_EVENT_PRESS_UP;
+                ctx->pen_down = false;
+            }
+        }
+    } else {
+        ctx->pen_down = false;
+    }
 }
 
-static void tp_mikroe_calc_coord ( tp_mikroe_t *ctx, int *x_coord_int, int *y_coord_int ) {
-    int tmp = 0;
-    int x_coord_int_local = *x_coord_int;
-    int y_coord_int_local = *y_coord_int;
+static void tp_mikroe_start_phase ( tp_mikroe_t *ctx, tp_mikroe_phase_t phase ) {
+    if ( TP_MIKROE_PHASE_X == phase )
+        tp_mikroe_driver_x_on();
+    else if ( TP_MIKROE_PHASE_Y == phase )
+        tp_mikroe_driver_y_on();
+    else
+        tp_mikroe_driver_z_on();
+
+    ctx->phase = phase;
+    ctx->phase_start = ctx->tick_f();
+}
+
+static void tp_mikroe_process_phase ( tp_mikroe_t *ctx ) {
+    uint32_t elapsed;
+    uint16_t result;
+    bool pressed;
+
+    if ( TP_MIKROE_PHASE_IDLE == ctx->phase ) {
+        tp_mikroe_start_phase( ctx, TP_MIKROE_PHASE_Z );
+    }
+
+    // Until the measurement is done, press detection stays as it was and no new event is reported.
+    ctx->touch.event = TP_EVENT_PRESS_NOT_DET;
+
+    // Settling time is exceeded by up to one tick, so it's never cut short.
+    elapsed = ctx->tick_f() - ctx->phase_start;
+    if ( elapsed <= ( ( TP_MIKROE_PHASE_Z == ctx->phase ) ? TP_MIKROE_SETTLE_TIME_Z : TP_MIKROE_SETTLE_TIME_XY ) ) {
+        return;
+    }
+
+    switch ( ctx->phase ) {
+        case TP_MIKROE_PHASE_Z:
+            pressed = tp_mikroe_is_pressed( ctx, tp_mikroe_read_filtered( &ctx->analog_in_y ) );
+            if ( pressed && !ctx->pen_down ) {
+                tp_mikroe_start_phase( ctx, TP_MIKROE_PHASE_X );
+                return;
+            }
+            // Panel stays driven for pressure, so it's measured again on the next call.
+            tp_mikroe_update_events( ctx, pressed, false, 0, 0 );
+            break;
+
+        case TP_MIKROE_PHASE_X:
+            result = tp_mikroe_read_filtered( &ctx->analog_in_y );
+            if ( ctx->pressure_threshold_level.tp_mikroe_pressure_threshold_lower > result ) {
+                tp_mikroe_update_events( ctx, true, false, 0, 0 );
+                tp_mikroe_start_phase( ctx, TP_MIKROE_PHASE_Z );
+                return;
+            }
+            ctx->y_pos = result;
+            tp_mikroe_start_phase( ctx, TP_MIKROE_PHASE_Y );
+            break;
+
+        default:
+            result = tp_mikroe_read_filtered( &ctx->analog_in_x );
+            tp_mikroe_update_events( ctx,
+                                     true,
+                                     ctx->pressure_threshold_level.tp_mikroe_pressure_threshold_lower <= result,
+                                     result,
+                                     ctx->y_pos );
+            tp_mikroe_start_phase( ctx, TP_MIKROE_PHASE_Z );
+            break;
+    }
+}
+
+static void tp_mikroe_update_calibration ( tp_mikroe_t *ctx ) {
+    tp_mikroe_calibration_data_t *cdata = &ctx->calibration_data;
+
+    if ( ( TP_MIKROE_ROTATE_CASE_0 == ctx->rotate ) || ( TP_MIKROE_ROTATE_CASE_2 == ctx->rotate ) ) {
+        // X coordinate is measured on Y plate and vice versa.
+        tp_calibration_from_range( &ctx->calibration, cdata->min_y, cdata->max_y,
+                                   cdata->min_x, cdata->max_x, ctx->width, ctx->height );
+        tp_calibration_swap_axes( &ctx->calibration );
+    } else {
+        tp_calibration_from_range( &ctx->calibration, cdata->min_x, cdata->max_x,
+                                   cdata->min_y, cdata->max_y, ctx->width, ctx->height );
+    }
 
     if ( TP_MIKROE_ROTATE_CASE_0 == ctx->rotate ) {
-        tmp = y_coord_int_local;
-        y_coord_int_local = ( ( ( long )x_coord_int_local * ctx->height ) / ( ctx->calibration_data->max_x - ctx->calibration_data->min_x ) );
-        x_coord_int_local = ( ( ( long )tmp * ctx->width ) / ( ctx->calibration_data->max_y - ctx->calibration_data->min_y ) );
-        y_coord_int_local = ctx->height - y_coord_int_local;
-        x_coord_int_local = ctx->width - x_coord_int_local;
+        tp_calibration_mirror( &ctx->calibration, ctx->width, ctx->height );
     } else if ( TP_MIKROE_ROTATE_CASE_1 == ctx->rotate ) {
-        x_coord_int_local = ( ( ( long )x_coord_int_local * ctx->width ) / ( ctx->calibration_data->max_x - ctx->calibration_data->min_x ) );
-        y_coord_int_local = ctx->height - ( ( ( long )y_coord_int_local * ctx->height ) / ( ctx->calibration_data->max_y - ctx->calibration_data->min_y ) );
-    } else if ( TP_MIKROE_ROTATE_CASE_2 == ctx->rotate ) {
-        tmp = y_coord_int_local;
-        y_coord_int_local = ( ( ( long )x_coord_int_local * ctx->height ) / ( ctx->calibration_data->max_x - ctx->calibration_data->min_x ) );
-        x_coord_int_local = ( ( ( long )tmp * ctx->width ) / ( ctx->calibration_data->max_y - ctx->calibration_data->min_y ) );
+        tp_calibration_mirror( &ctx->calibration, 0, ctx->height );
     } else if ( TP_MIKROE_ROTATE_CASE_3 == ctx->rotate ) {
-        x_coord_int_local = ctx->width - ( ( ( long )x_coord_int_local * ctx->width ) / ( ctx->calibration_data->max_x - ctx->calibration_data->min_x ) );
-        y_coord_int_local = ( ( ( long )y_coord_int_local * ctx->height ) / ( ctx->calibration_data->max_y - ctx->calibration_data->min_y ) );
+        tp_calibration_mirror( &ctx->calibration, ctx->width, 0 );
     }
-
-    *x_coord_int = x_coord_int_local;
-    *y_coord_int = y_coord_int_local;
 }
 
 #ifdef TP_MIKROE_TRANSISTOR_LOGIC
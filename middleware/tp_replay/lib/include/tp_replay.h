@@ -0,0 +1,448 @@
+/****************************************************************************
+**
+** Copyright (C) 2023 MikroElektronika d.o.o.
+** Contact: https://www.mikroe.com/contact
+**
+** This file is part of the mikroSDK package
+**
+** Commercial License Usage
+**
+** Licensees holding valid commercial NECTO compilers AI licenses may use this
+** file in accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The MikroElektronika Company.
+** For licensing terms and conditions see
+** https://www.mikroe.com/legal/software-license-agreement.
+** For further information use the contact form at
+** https://www.mikroe.com/contact.
+**
+**
+** GNU Lesser General Public License Usage
+**
+** Alternatively, this file may be used for
+** non-commercial projects under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** The above copyright notice and this permission notice shall be
+** included in all copies or substantial portions of the Software.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+** OF MERCHANTABILITY, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED
+** TO THE WARRANTIES FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+** IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+** DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT
+** OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+** OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+**
+****************************************************************************/
+/*!
+ * @file tp_replay.h
+ * @brief Touch Panel Record And Replay Driver.
+ */
+
+/**
+ * @brief Recorded touch stream format:
+ *
+ * Stream is a sequence of records, one per touch controller reading, with
+ * multibyte values in little endian order:
+ *
+ * -------------------------------------------------------------------------
+ * | timestamp (4) | press_det (1) | gesture (1) | n_touches (1) | points |
+ * -------------------------------------------------------------------------
+ *
+ * and each of @b n_touches points:
+ *
+ * ---------------------------------------------------
+ * | coord_x (2) | coord_y (2) | event (1) | id (1) |
+ * ---------------------------------------------------
+ *
+ * The same stream is replayed from memory, e.g. constant array built on host,
+ * or from a file, so streams recorded on one target replay on any other
+ * target or on host.
+ */
+
+#ifndef _TP_REPLAY_H_
+#define _TP_REPLAY_H_
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+#include <stdbool.h>
+#include "tp.h"
+
+#ifdef TP_REPLAY_FILES_ENABLED
+#include "file.h"
+#endif
+
+/**
+ * @addtogroup middlewaregroup Middleware
+ * @brief This section includes the mikroSDK API Reference for Middleware Layer.
+ * @{
+ */
+
+/*!
+ * @addtogroup tp_replay Touch Panel Record And Replay Driver
+ * @brief Touch Panel Record And Replay Driver API Reference.
+ * @{
+ */
+
+/**
+ * @brief Size of recorded touch reading header, in bytes.
+ */
+#define TP_REPLAY_HEADER_SIZE  7
+
+/**
+ * @brief Size of recorded touch point, in bytes.
+ */
+#define TP_REPLAY_POINT_SIZE   6
+
+/**
+ * @brief Maximal size of recorded touch reading, in bytes.
+ */
+#define TP_REPLAY_RECORD_SIZE_MAX  ( TP_REPLAY_HEADER_SIZE + TP_N_TOUCHES_MAX * TP_REPLAY_POINT_SIZE )
+
+/**
+ * @brief Replay timing.
+ */
+typedef enum {
+    TP_REPLAY_MODE_STEP,    /**< Each driver process call reports the next reading, for fastest benchmarks. */
+    TP_REPLAY_MODE_REALTIME /**< Readings are reported at their recorded times, like a real touch controller. */
+} tp_replay_mode_t;
+
+/**
+ * @brief Latency counters.
+ * @details Times are in units of the timestamp function.
+ */
+typedef struct {
+    uint32_t count; /**< Number of measured events. */
+    uint32_t min;   /**< Minimal latency. */
+    uint32_t max;   /**< Maximal latency. */
+    uint32_t total; /**< Sum of latencies, divided by @b count gives the average. */
+} tp_replay_latency_t;
+
+/**
+ * @brief Touch Panel Replay Driver Context Object.
+ * @details Context object of the driver reporting recorded touch readings to
+ * the touch panel library, as if they were read from a touch controller.
+ * @warning Changing values inside this structure is not recomended as it can cause unwanted and incorrect
+ * behaviour when used with @ref tp_replay_process function.
+ */
+typedef struct {
+    const uint8_t * buffer; /**< Recorded stream in memory, NULL if it's in file. */
+    uint32_t size; /**< Size of the recorded stream in memory, in bytes. */
+    uint32_t offset; /**< Offset of the next reading in memory. */
+#ifdef TP_REPLAY_FILES_ENABLED
+    file_t * file; /**< Recorded stream file, NULL if it's in memory. */
+#endif
+
+    tp_replay_mode_t mode; /**< Replay timing. */
+    tp_timestamp_t timestamp_f; /**< Timestamp function handler. */
+
+    tp_sample_t current; /**< Reading reported to the touch panel library. */
+    tp_sample_t next; /**< Next reading, waiting for its time. */
+    bool next_valid; /**< Next reading is read from the stream. */
+    bool done; /**< All readings are reported. */
+    bool released; /**< Reading reported since the last @ref tp_replay_processed. */
+
+    uint32_t start_time; /**< Time the replay started. */
+    uint32_t stream_start; /**< Timestamp of the first recorded reading. */
+    uint32_t due_time; /**< Time the reported reading was due. */
+
+    tp_replay_latency_t processing; /**< Processing time of reported readings. */
+    tp_replay_latency_t dispatch; /**< Time from reading being due until its event was handled. */
+} tp_replay_t;
+
+/**
+ * @brief Touch Panel Recorder Driver Context Object.
+ * @details Context object of the driver passing readings of another touch
+ * controller driver to the touch panel library, and recording them.
+ * @warning Changing values inside this structure is not recomended as it can cause unwanted and incorrect
+ * behaviour when used with @ref tp_replay_recorder_process function.
+ */
+typedef struct {
+    tp_drv_t * source_drv; /**< Recorded touch controller driver interface. */
+    void * source_ctx; /**< Recorded touch controller driver context. */
+
+    uint8_t * buffer; /**< Memory the stream is recorded to, NULL if it's recorded to file. */
+    uint32_t size; /**< Size of the memory, in bytes. */
+    uint32_t offset; /**< Size of the recorded stream, in bytes. */
+#ifdef TP_REPLAY_FILES_ENABLED
+    file_t * file; /**< File the stream is recorded to, NULL if it's recorded to memory. */
+#endif
+
+    tp_timestamp_t timestamp_f; /**< Timestamp function handler. */
+
+    tp_sample_t sample; /**< Last reading of the touch controller. */
+    bool touched; /**< Last recorded reading was touched. */
+
+    uint32_t records; /**< Number of recorded readings. */
+    uint32_t dropped; /**< Readings not recorded, because the memory or file was full. */
+} tp_replay_recorder_t;
+
+/**
+ * @brief Touch Panel Replay Driver Initialization Function.
+ * @details This function initializes replay driver context object to replay
+ * the stream from memory, and links touch panel driver interface object with
+ * replay driver functions.
+ * @param[out] ctx Replay driver context object. See @ref tp_replay_t structure
+ * definition for detailed explanation.
+ * @param[in] buffer Recorded stream.
+ * @param[in] size Size of the recorded stream, in bytes.
+ * @param[in] mode Replay timing. See @ref tp_replay_mode_t for valid values.
+ * @param[in] timestamp Timestamp function, used for timing and latency
+ * measurement. Can be NULL in @ref TP_REPLAY_MODE_STEP mode.
+ * @param[out] drv TP driver interface object. See @ref tp_drv_t structure
+ * definition for detailed explanation.
+ * @retval @li @c TP_OK OK,
+ *         @li @c TP_ERR_INIT_DRV Timestamp function is needed for realtime replay.
+ * See @ref tp_err_t structure definition for detailed explanation.
+ */
+tp_err_t tp_replay_init( tp_replay_t * ctx, const uint8_t * buffer, uint32_t size,
+                         tp_replay_mode_t mode, tp_timestamp_t timestamp, tp_drv_t * drv );
+
+#ifdef TP_REPLAY_FILES_ENABLED
+/**
+ * @brief Touch Panel Replay Driver File Function.
+ * @details This function switches the replay driver to replay the stream from
+ * the file, from its current position. Readings are read from the file one at
+ * a time, so stream length is not limited by memory.
+ * @param[in,out] ctx Initialized replay driver context object. See @ref tp_replay_t
+ * structure definition for detailed explanation.
+ * @param[in] file Opened file. See @ref file_t structure definition for
+ * detailed explanation.
+ * @retval Nothing.
+ */
+void tp_replay_open_file( tp_replay_t * ctx, file_t * file );
+#endif
+
+/**
+ * @brief Touch Panel Replay Start Function.
+ * @details This function starts the replay from the first recorded reading,
+ * at the current time, and clears the latency counters.
+ * @param[in,out] ctx Initialized replay driver context object. See @ref tp_replay_t
+ * structure definition for detailed explanation.
+ * @retval Nothing.
+ * @note Stream in file is replayed from the current position of the file, so
+ * it has to be rewound before replaying it again.
+ */
+void tp_replay_start( tp_replay_t * ctx );
+
+/**
+ * @brief Touch Panel Replay Done Function.
+ * @details This function checks if all recorded readings are reported.
+ * @param[in] ctx Initialized replay driver context object. See @ref tp_replay_t
+ * structure definition for detailed explanation.
+ * @retval @li @c true All readings are reported,
+ *         @li @c false Replay is in progress.
+ */
+bool tp_replay_is_done( tp_replay_t * ctx );
+
+/**
+ * @brief Touch Panel Replay Processed Function.
+ * @details This function measures processing time of the reported reading,
+ * if @ref tp_process, or a function calling it, reported a new reading.
+ * @param[in,out] ctx Initialized replay driver context object. See @ref tp_replay_t
+ * structure definition for detailed explanation.
+ * @param[in] start Time taken just before @ref tp_process call.
+ * @retval Nothing.
+ */
+void tp_replay_processed( tp_replay_t * ctx, uint32_t start );
+
+/**
+ * @brief Touch Panel Replay Dispatched Function.
+ * @details This function measures the time from the reported reading being
+ * due until its event was handled. In @ref TP_REPLAY_MODE_REALTIME mode it
+ * includes the time the reading waited for @ref tp_process, as touch to
+ * response latency of the application.
+ * @param[in,out] ctx Initialized replay driver context object. See @ref tp_replay_t
+ * structure definition for detailed explanation.
+ * @retval Nothing.
+ * @note Call it from the handler where the touch event ends up, e.g. touch
+ * panel press callback or VTFT component event handler.
+ */
+void tp_replay_dispatched( tp_replay_t * ctx );
+
+/**
+ * @brief Touch Panel Replay Latency Function.
+ * @details This function gets latency counters measured since the replay start.
+ * @param[in] ctx Initialized replay driver context object. See @ref tp_replay_t
+ * structure definition for detailed explanation.
+ * @param[out] processing Processing time counters, measured by @ref tp_replay_processed.
+ * Can be NULL.
+ * @param[out] dispatch Dispatch latency counters, measured by @ref tp_replay_dispatched.
+ * Can be NULL.
+ * @retval Nothing.
+ *
+ * @b Example
+ * @code
+ *    // Replay the stream through VTFT, with press handler of the measured
+ *    // component calling tp_replay_dispatched( &replay ).
+ *    tp_replay_init( &replay, stream, sizeof( stream ), TP_REPLAY_MODE_STEP,
+ *                    timestamp, &tp_interface );
+ *    tp_init( &tp, &tp_cfg, &tp_interface, &replay );
+ *    vtft_init( &vtft, &tp );
+ *
+ *    tp_replay_start( &replay );
+ *    while ( !tp_replay_is_done( &replay ) ) {
+ *        uint32_t start = timestamp( );
+ *        vtft_process( &vtft );
+ *        tp_replay_processed( &replay, start );
+ *    }
+ *    tp_replay_get_latency( &replay, &processing, &dispatch );
+ * @endcode
+ */
+void tp_replay_get_latency( tp_replay_t * ctx, tp_replay_latency_t * processing,
+                            tp_replay_latency_t * dispatch );
+
+/**
+ * @brief Touch Panel Replay Process Function.
+ * @details This function reports the next recorded reading, when it's due.
+ * @note This function is necessary for interfacing with touch panel library as its
+ * address is stored in tp_drv_t driver structure during the replay driver initialization.
+ * @param[in] ctx Initialized replay driver context object. See @ref tp_replay_t
+ * structure definition for detailed explanation.
+ * @retval @li @c TP_OK OK,
+ *         @li @c TP_ERR_N_DATA Recorded reading is corrupted, replay is done.
+ * See @ref tp_err_t structure definition for detailed explanation.
+ */
+tp_err_t tp_replay_process( tp_replay_t * ctx );
+
+/**
+ * @brief Touch Panel Replay Press Detection Function.
+ * @details This function returns press detection of the reported reading.
+ * @note This function is necessary for interfacing with touch panel library as its
+ * address is stored in tp_drv_t driver structure during the replay driver initialization.
+ * @param[in] ctx Initialized replay driver context object. See @ref tp_replay_t
+ * structure definition for detailed explanation.
+ * @retval @li @c TP_EVENT_PRESS_NOT_DET - Touch pressure is not detected.
+ *         @li @c TP_EVENT_PRESS_DET - Touch pressure is detected.
+ */
+tp_event_t tp_replay_press_detect( tp_replay_t * ctx );
+
+/**
+ * @brief Touch Panel Replay Press Coordinates Function.
+ * @details This function copies touch points of the reported reading.
+ * @note This function is necessary for interfacing with touch panel library as its
+ * address is stored in tp_drv_t driver structure during the replay driver initialization.
+ * @param[in] ctx Initialized replay driver context object. See @ref tp_replay_t
+ * structure definition for detailed explanation.
+ * @param[out] touch_item Touch item. See @ref tp_touch_item_t structure
+ * definition for detailed explanation.
+ * @retval Nothing.
+ */
+void tp_replay_press_coordinates( tp_replay_t * ctx, tp_touch_item_t * touch_item );
+
+/**
+ * @brief Touch Panel Replay Gesture Function.
+ * @details This function returns gesture of the reported reading.
+ * @note This function is necessary for interfacing with touch panel library as its
+ * address is stored in tp_drv_t driver structure during the replay driver initialization.
+ * @param[in] ctx Initialized replay driver context object. See @ref tp_replay_t
+ * structure definition for detailed explanation.
+ * @param[out] event Gesture event. See @ref tp_event_t definition for detailed
+ * explanation.
+ * @retval Nothing.
+ */
+void tp_replay_gesture( tp_replay_t * ctx, tp_event_t * event );
+
+/**
+ * @brief Touch Panel Recorder Driver Initialization Function.
+ * @details This function initializes recorder driver context object to record
+ * readings of the given touch controller driver to memory, and links touch
+ * panel driver interface object with recorder driver functions. Touch panel
+ * library gets the same readings, as if it used the touch controller driver.
+ * @param[out] ctx Recorder driver context object. See @ref tp_replay_recorder_t
+ * structure definition for detailed explanation.
+ * @param[in] source_drv Initialized touch controller driver interface object.
+ * See @ref tp_drv_t structure definition for detailed explanation.
+ * @param[in] source_ctx Initialized touch controller driver context object.
+ * @param[out] buffer Memory the stream is recorded to.
+ * @param[in] size Size of the memory, in bytes.
+ * @param[in] timestamp Timestamp function, NULL records all readings with
+ * timestamp 0.
+ * @param[out] drv TP driver interface object. See @ref tp_drv_t structure
+ * definition for detailed explanation.
+ * @retval Nothing.
+ * @note Only touched readings, and the first reading after release, are
+ * recorded. Size of the recorded stream is in @b offset member of the context.
+ */
+void tp_replay_recorder_init( tp_replay_recorder_t * ctx, tp_drv_t * source_drv, void * source_ctx,
+                              uint8_t * buffer, uint32_t size, tp_timestamp_t timestamp, tp_drv_t * drv );
+
+#ifdef TP_REPLAY_FILES_ENABLED
+/**
+ * @brief Touch Panel Recorder Driver File Function.
+ * @details This function switches the recorder driver to record the stream to
+ * the file, from its current position.
+ * @param[in,out] ctx Initialized recorder driver context object. See @ref tp_replay_recorder_t
+ * structure definition for detailed explanation.
+ * @param[in] file File opened for writing. See @ref file_t structure definition
+ * for detailed explanation.
+ * @retval Nothing.
+ */
+void tp_replay_recorder_open_file( tp_replay_recorder_t * ctx, file_t * file );
+#endif
+
+/**
+ * @brief Touch Panel Recorder Process Function.
+ * @details This function reads the touch controller through its driver and
+ * records the reading.
+ * @note This function is necessary for interfacing with touch panel library as its
+ * address is stored in tp_drv_t driver structure during the recorder driver initialization.
+ * @param[in] ctx Initialized recorder driver context object. See @ref tp_replay_recorder_t
+ * structure definition for detailed explanation.
+ * @retval Error code of the touch controller driver. See @ref tp_err_t
+ * structure definition for detailed explanation.
+ */
+tp_err_t tp_replay_recorder_process( tp_replay_recorder_t * ctx );
+
+/**
+ * @brief Touch Panel Recorder Press Detection Function.
+ * @details This function returns press detection of the last reading.
+ * @note This function is necessary for interfacing with touch panel library as its
+ * address is stored in tp_drv_t driver structure during the recorder driver initialization.
+ * @param[in] ctx Initialized recorder driver context object. See @ref tp_replay_recorder_t
+ * structure definition for detailed explanation.
+ * @retval @li @c TP_EVENT_PRESS_NOT_DET - Touch pressure is not detected.
+ *         @li @c TP_EVENT_PRESS_DET - Touch pressure is detected.
+ */
+tp_event_t tp_replay_recorder_press_detect( tp_replay_recorder_t * ctx );
+
+/**
+ * @brief Touch Panel Recorder Press Coordinates Function.
+ * @details This function copies touch points of the last reading.
+ * @note This function is necessary for interfacing with touch panel library as its
+ * address is stored in tp_drv_t driver structure during the recorder driver initialization.
+ * @param[in] ctx Initialized recorder driver context object. See @ref tp_replay_recorder_t
+ * structure definition for detailed explanation.
+ * @param[out] touch_item Touch item. See @ref tp_touch_item_t structure
+ * definition for detailed explanation.
+ * @retval Nothing.
+ */
+void tp_replay_recorder_press_coordinates( tp_replay_recorder_t * ctx, tp_touch_item_t * touch_item );
+
+/**
+ * @brief Touch Panel Recorder Gesture Function.
+ * @details This function returns gesture of the last reading.
+ * @note This function is necessary for interfacing with touch panel library as its
+ * address is stored in tp_drv_t driver structure during the recorder driver initialization.
+ * @param[in] ctx Initialized recorder driver context object. See @ref tp_replay_recorder_t
+ * structure definition for detailed explanation.
+ * @param[out] event Gesture event. See @ref tp_event_t definition for detailed
+ * explanation.
+ * @retval Nothing.
+ */
+void tp_replay_recorder_gesture( tp_replay_recorder_t * ctx, tp_event_t * event );
+
+/*! @} */ // tp_replay
+/*! @} */ // middlewaregroup
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // _TP_REPLAY_H_
+
+// ------------------------------------------------------------------------ END
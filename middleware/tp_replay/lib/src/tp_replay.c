@@ -0,0 +1,447 @@
+/****************************************************************************
+**
+** Copyright (C) 2023 MikroElektronika d.o.o.
+** Contact: https://www.mikroe.com/contact
+**
+** This file is part of the mikroSDK package
+**
+** Commercial License Usage
+**
+** Licensees holding valid commercial NECTO compilers AI licenses may use this
+** file in accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The MikroElektronika Company.
+** For licensing terms and conditions see
+** https://www.mikroe.com/legal/software-license-agreement.
+** For further information use the contact form at
+** https://www.mikroe.com/contact.
+**
+**
+** GNU Lesser General Public License Usage
+**
+** Alternatively, this file may be used for
+** non-commercial projects under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** The above copyright notice and this permission notice shall be
+** included in all copies or substantial portions of the Software.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+** OF MERCHANTABILITY, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED
+** TO THE WARRANTIES FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+** IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+** DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT
+** OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+** OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+**
+****************************************************************************/
+/*!
+ * @file tp_replay.c
+ * @brief Touch Panel Record And Replay Driver.
+ */
+
+#include "tp_replay.h"
+
+/* --------------------------------------------- PRIVATE FUNCTIONS - DECLARATIONS -------------------------------------------*/
+
+/**
+ * @brief Reads the next recorded reading from the stream.
+ * @param[in,out] ctx Initialized replay driver context object. See @ref tp_replay_t
+ * structure definition for detailed explanation.
+ * @param[out] buffer Record buffer, at least @ref TP_REPLAY_RECORD_SIZE_MAX bytes.
+ * @param[in] size Number of bytes to read.
+ * @retval @b true if all bytes are read, @b false at the end of the stream.
+ */
+static bool tp_replay_read( tp_replay_t * ctx, uint8_t * buffer, uint32_t size );
+
+/**
+ * @brief Reads the next recorded reading to @b next member of the context.
+ * @param[in,out] ctx Initialized replay driver context object. See @ref tp_replay_t
+ * structure definition for detailed explanation.
+ * @retval @li @c TP_OK OK, @b next_valid tells if there was a reading,
+ *         @li @c TP_ERR_N_DATA Recorded reading is corrupted.
+ */
+static tp_err_t tp_replay_read_next( tp_replay_t * ctx );
+
+/**
+ * @brief Adds the latency to the counters.
+ * @param[in,out] latency Latency counters. See @ref tp_replay_latency_t
+ * structure definition for detailed explanation.
+ * @param[in] time Measured latency.
+ * @retval Nothing.
+ */
+static void tp_replay_add_latency( tp_replay_latency_t * latency, uint32_t time );
+
+/**
+ * @brief Records the last reading of the touch controller.
+ * @param[in,out] ctx Initialized recorder driver context object. See @ref tp_replay_recorder_t
+ * structure definition for detailed explanation.
+ * @retval Nothing.
+ */
+static void tp_replay_recorder_write( tp_replay_recorder_t * ctx );
+
+/* ----------------------------------------- PUBLIC TP INTERFACE FUNCTION IMPLEMENTATION ----------------------------------------------------*/
+
+tp_err_t tp_replay_process( tp_replay_t * ctx ) {
+    tp_err_t status;
+    uint32_t now;
+
+    if ( !ctx->next_valid ) {
+        if ( ctx->done ) {
+            return TP_OK;
+        }
+
+        status = tp_replay_read_next( ctx );
+
+        if ( TP_OK != status ) {
+            ctx->done = true;
+            return status;
+        }
+
+        if ( !ctx->next_valid ) {
+            ctx->done = true;
+            ctx->current.press_det = TP_EVENT_PRESS_NOT_DET;
+            return TP_OK;
+        }
+    }
+
+    now = ( NULL != ctx->timestamp_f ) ? ctx->timestamp_f() : 0;
+
+    if ( TP_REPLAY_MODE_REALTIME == ctx->mode ) {
+        uint32_t due = ctx->start_time + ( ctx->next.timestamp - ctx->stream_start );
+
+        /* Reading is reported at its recorded time, relative to the first one. */
+        if ( ( int32_t )( now - due ) < 0 ) {
+            return TP_OK;
+        }
+
+        ctx->due_time = due;
+    } else {
+        ctx->due_time = now;
+    }
+
+    ctx->current = ctx->next;
+    ctx->next_valid = false;
+    ctx->released = true;
+
+    return TP_OK;
+}
+
+tp_event_t tp_replay_press_detect( tp_replay_t * ctx ) {
+    return ctx->current.press_det;
+}
+
+void tp_replay_press_coordinates( tp_replay_t * ctx, tp_touch_item_t * touch_item ) {
+    *touch_item = ctx->current.touch;
+}
+
+void tp_replay_gesture( tp_replay_t * ctx, tp_event_t * event ) {
+    *event = ctx->current.gesture;
+}
+
+tp_err_t tp_replay_recorder_process( tp_replay_recorder_t * ctx ) {
+    tp_err_t status;
+
+    status = ctx->source_drv->tp_process_f( ctx->source_ctx );
+
+    if ( TP_OK != status ) {
+        return status;
+    }
+
+    ctx->sample.timestamp = ( NULL != ctx->timestamp_f ) ? ctx->timestamp_f() : 0;
+    ctx->sample.press_det = ctx->source_drv->tp_press_detect_f( ctx->source_ctx );
+    ctx->sample.touch.n_touches = 0;
+    ctx->sample.gesture = TP_EVENT_GEST_NONE;
+
+    if ( TP_EVENT_PRESS_DET == ctx->sample.press_det ) {
+        ctx->source_drv->tp_press_coordinates_f( ctx->source_ctx, &ctx->sample.touch );
+        ctx->source_drv->tp_gesture_f( ctx->source_ctx, &ctx->sample.gesture );
+    }
+
+    /* Idle readings are skipped, the first one after release is kept. */
+    if ( ( TP_EVENT_PRESS_DET == ctx->sample.press_det ) || ctx->touched ) {
+        tp_replay_recorder_write( ctx );
+    }
+
+    ctx->touched = ( TP_EVENT_PRESS_DET == ctx->sample.press_det );
+
+    return TP_OK;
+}
+
+tp_event_t tp_replay_recorder_press_detect( tp_replay_recorder_t * ctx ) {
+    return ctx->sample.press_det;
+}
+
+void tp_replay_recorder_press_coordinates( tp_replay_recorder_t * ctx, tp_touch_item_t * touch_item ) {
+    *touch_item = ctx->sample.touch;
+}
+
+void tp_replay_recorder_gesture( tp_replay_recorder_t * ctx, tp_event_t * event ) {
+    *event = ctx->sample.gesture;
+}
+
+// -------------------------------------------------  PUBLIC FUNCTIONS - IMPLEMENTATION  -----------------------------------------------------*/
+
+tp_err_t tp_replay_init( tp_replay_t * ctx, const uint8_t * buffer, uint32_t size,
+                         tp_replay_mode_t mode, tp_timestamp_t timestamp, tp_drv_t * drv ) {
+    if ( ( TP_REPLAY_MODE_REALTIME == mode ) && ( NULL == timestamp ) ) {
+        return TP_ERR_INIT_DRV;
+    }
+
+    ctx->buffer = buffer;
+    ctx->size = size;
+#ifdef TP_REPLAY_FILES_ENABLED
+    ctx->file = NULL;
+#endif
+    ctx->mode = mode;
+    ctx->timestamp_f = timestamp;
+
+    tp_replay_start( ctx );
+
+    drv->tp_press_detect_f      = ( tp_press_det_t )&tp_replay_press_detect;
+    drv->tp_press_coordinates_f = ( tp_press_coord_t )&tp_replay_press_coordinates;
+    drv->tp_gesture_f           = ( tp_gesture_t )&tp_replay_gesture;
+    drv->tp_process_f           = ( tp_process_t )&tp_replay_process;
+
+    return TP_OK;
+}
+
+#ifdef TP_REPLAY_FILES_ENABLED
+void tp_replay_open_file( tp_replay_t * ctx, file_t * file ) {
+    ctx->buffer = NULL;
+    ctx->size = 0;
+    ctx->file = file;
+
+    tp_replay_start( ctx );
+}
+#endif
+
+void tp_replay_start( tp_replay_t * ctx ) {
+    ctx->offset = 0;
+    ctx->next_valid = false;
+    ctx->done = false;
+    ctx->released = false;
+
+    ctx->current.timestamp = 0;
+    ctx->current.press_det = TP_EVENT_PRESS_NOT_DET;
+    ctx->current.touch.n_touches = 0;
+    ctx->current.gesture = TP_EVENT_GEST_NONE;
+
+    ctx->start_time = ( NULL != ctx->timestamp_f ) ? ctx->timestamp_f() : 0;
+    ctx->due_time = ctx->start_time;
+
+    ctx->processing.count = 0;
+    ctx->processing.min = UINT32_MAX;
+    ctx->processing.max = 0;
+    ctx->processing.total = 0;
+    ctx->dispatch = ctx->processing;
+
+    /* Timestamps of the stream are relative to its first reading. */
+    if ( TP_OK != tp_replay_read_next( ctx ) ) {
+        ctx->done = true;
+    }
+
+    ctx->stream_start = ( ctx->next_valid ) ? ctx->next.timestamp : 0;
+}
+
+bool tp_replay_is_done( tp_replay_t * ctx ) {
+    return ctx->done;
+}
+
+void tp_replay_processed( tp_replay_t * ctx, uint32_t start ) {
+    if ( ctx->released && ( NULL != ctx->timestamp_f ) ) {
+        tp_replay_add_latency( &ctx->processing, ctx->timestamp_f() - start );
+    }
+
+    ctx->released = false;
+}
+
+void tp_replay_dispatched( tp_replay_t * ctx ) {
+    if ( NULL != ctx->timestamp_f ) {
+        tp_replay_add_latency( &ctx->dispatch, ctx->timestamp_f() - ctx->due_time );
+    }
+}
+
+void tp_replay_get_latency( tp_replay_t * ctx, tp_replay_latency_t * processing,
+                            tp_replay_latency_t * dispatch ) {
+    if ( NULL != processing ) {
+        *processing = ctx->processing;
+    }
+
+    if ( NULL != dispatch ) {
+        *dispatch = ctx->dispatch;
+    }
+}
+
+void tp_replay_recorder_init( tp_replay_recorder_t * ctx, tp_drv_t * source_drv, void * source_ctx,
+                              uint8_t * buffer, uint32_t size, tp_timestamp_t timestamp, tp_drv_t * drv ) {
+    ctx->source_drv = source_drv;
+    ctx->source_ctx = source_ctx;
+    ctx->buffer = buffer;
+    ctx->size = size;
+    ctx->offset = 0;
+#ifdef TP_REPLAY_FILES_ENABLED
+    ctx->file = NULL;
+#endif
+    ctx->timestamp_f = timestamp;
+
+    ctx->sample.timestamp = 0;
+    ctx->sample.press_det = TP_EVENT_PRESS_NOT_DET;
+    ctx->sample.touch.n_touches = 0;
+    ctx->sample.gesture = TP_EVENT_GEST_NONE;
+    ctx->touched = false;
+
+    ctx->records = 0;
+    ctx->dropped = 0;
+
+    drv->tp_press_detect_f      = ( tp_press_det_t )&tp_replay_recorder_press_detect;
+    drv->tp_press_coordinates_f = ( tp_press_coord_t )&tp_replay_recorder_press_coordinates;
+    drv->tp_gesture_f           = ( tp_gesture_t )&tp_replay_recorder_gesture;
+    drv->tp_process_f           = ( tp_process_t )&tp_replay_recorder_process;
+}
+
+#ifdef TP_REPLAY_FILES_ENABLED
+void tp_replay_recorder_open_file( tp_replay_recorder_t * ctx, file_t * file ) {
+    ctx->buffer = NULL;
+    ctx->size = 0;
+    ctx->offset = 0;
+    ctx->file = file;
+}
+#endif
+
+/* --------------------------------------------- PRIVATE FUNCTIONS - IMPLEMENTATION -------------------------------------------*/
+
+static bool tp_replay_read( tp_replay_t * ctx, uint8_t * buffer, uint32_t size ) {
+    uint32_t cnt;
+
+#ifdef TP_REPLAY_FILES_ENABLED
+    if ( NULL != ctx->file ) {
+        return ( FSS_OK == file_read( ctx->file, buffer, size ) );
+    }
+#endif
+
+    if ( ( ctx->size - ctx->offset ) < size ) {
+        return false;
+    }
+
+    for ( cnt = 0; cnt < size; cnt++ ) {
+        buffer[ cnt ] = ctx->buffer[ ctx->offset++ ];
+    }
+
+    return true;
+}
+
+static tp_err_t tp_replay_read_next( tp_replay_t * ctx ) {
+    uint8_t record[ TP_REPLAY_RECORD_SIZE_MAX ];
+    uint8_t * point;
+    uint8_t cnt;
+
+    ctx->next_valid = false;
+
+    if ( !tp_replay_read( ctx, record, TP_REPLAY_HEADER_SIZE ) ) {
+        return TP_OK;
+    }
+
+    if ( TP_N_TOUCHES_MAX < record[ 6 ] ) {
+        return TP_ERR_N_DATA;
+    }
+
+    if ( !tp_replay_read( ctx, &record[ TP_REPLAY_HEADER_SIZE ], record[ 6 ] * TP_REPLAY_POINT_SIZE ) ) {
+        return TP_ERR_N_DATA;
+    }
+
+    ctx->next.timestamp = ( uint32_t )record[ 0 ] | ( ( uint32_t )record[ 1 ] << 8 ) |
+                          ( ( uint32_t )record[ 2 ] << 16 ) | ( ( uint32_t )record[ 3 ] << 24 );
+    ctx->next.press_det = ( tp_event_t )record[ 4 ];
+    ctx->next.gesture = ( tp_event_t )record[ 5 ];
+    ctx->next.touch.n_touches = record[ 6 ];
+
+    point = &record[ TP_REPLAY_HEADER_SIZE ];
+
+    for ( cnt = 0; cnt < ctx->next.touch.n_touches; cnt++ ) {
+        ctx->next.touch.point[ cnt ].coord_x = ( tp_coord_t )( point[ 0 ] | ( point[ 1 ] << 8 ) );
+        ctx->next.touch.point[ cnt ].coord_y = ( tp_coord_t )( point[ 2 ] | ( point[ 3 ] << 8 ) );
+        ctx->next.touch.point[ cnt ].event = ( tp_event_t )point[ 4 ];
+        ctx->next.touch.point[ cnt ].id = ( tp_touch_id_t )point[ 5 ];
+        point += TP_REPLAY_POINT_SIZE;
+    }
+
+    ctx->next_valid = true;
+
+    return TP_OK;
+}
+
+static void tp_replay_add_latency( tp_replay_latency_t * latency, uint32_t time ) {
+    latency->count++;
+    latency->total += time;
+
+    if ( time < latency->min ) {
+        latency->min = time;
+    }
+
+    if ( time > latency->max ) {
+        latency->max = time;
+    }
+}
+
+static void tp_replay_recorder_write( tp_replay_recorder_t * ctx ) {
+    uint8_t record[ TP_REPLAY_RECORD_SIZE_MAX ];
+    uint8_t * point;
+    uint32_t size;
+    uint8_t n_touches;
+    uint8_t cnt;
+
+    n_touches = ctx->sample.touch.n_touches;
+
+    if ( TP_N_TOUCHES_MAX < n_touches ) {
+        n_touches = TP_N_TOUCHES_MAX;
+    }
+
+    record[ 0 ] = ( uint8_t )ctx->sample.timestamp;
+    record[ 1 ] = ( uint8_t )( ctx->sample.timestamp >> 8 );
+    record[ 2 ] = ( uint8_t )( ctx->sample.timestamp >> 16 );
+    record[ 3 ] = ( uint8_t )( ctx->sample.timestamp >> 24 );
+    record[ 4 ] = ( uint8_t )ctx->sample.press_det;
+    record[ 5 ] = ( uint8_t )ctx->sample.gesture;
+    record[ 6 ] = n_touches;
+
+    point = &record[ TP_REPLAY_HEADER_SIZE ];
+
+    for ( cnt = 0; cnt < n_touches; cnt++ ) {
+        point[ 0 ] = ( uint8_t )ctx->sample.touch.point[ cnt ].coord_x;
+        point[ 1 ] = ( uint8_t )( ctx->sample.touch.point[ cnt ].coord_x >> 8 );
+        point[ 2 ] = ( uint8_t )ctx->sample.touch.point[ cnt ].coord_y;
+        point[ 3 ] = ( uint8_t )( ctx->sample.touch.point[ cnt ].coord_y >> 8 );
+        point[ 4 ] = ( uint8_t )ctx->sample.touch.point[ cnt ].event;
+        point[ 5 ] = ( uint8_t )ctx->sample.touch.point[ cnt ].id;
+        point += TP_REPLAY_POINT_SIZE;
+    }
+
+    size = TP_REPLAY_HEADER_SIZE + ( uint32_t )n_touches * TP_REPLAY_POINT_SIZE;
+
+#ifdef TP_REPLAY_FILES_ENABLED
+    if ( NULL != ctx->file ) {
+        if ( FSS_OK == file_write( ctx->file, record, size ) ) {
+            ctx->offset += size;
+            ctx->records++;
+        } else {
+            ctx->dropped++;
+        }
+        return;
+    }
+#endif
+
+    if ( ( ctx->size - ctx->offset ) < size ) {
+        ctx->dropped++;
+        return;
+    }
+
+    for ( cnt = 0; cnt < size; cnt++ ) {
+        ctx->buffer[ ctx->offset++ ] = record[ cnt ];
+    }
+
+    ctx->records++;
+}
+
+// ------------------------------------------------------------------------ END
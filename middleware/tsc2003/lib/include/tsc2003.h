@@ -67,6 +67,7 @@ extern "C"{
 #include "drv_digital_in.h"
 #include "drv_name.h"
 #include "tp.h"
+#include "tp_calibration.h"
 
 /**
  * @addtogroup middlewaregroup Middleware
@@ -260,6 +261,9 @@ typedef struct {
 
     /**< Calibration constants used for converting raw ADC touch data to actual pixel coordinates.*/
     tsc2003_calibration_data_t calibration_data;
+
+    /**< Transform converting raw ADC touch data to actual pixel coordinates. */
+    tp_calibration_t calibration;
 } tsc2003_t;
 
 /**
@@ -431,6 +435,41 @@ void tsc2003_get_calibration_data( tsc2003_t * ctx, tsc2003_calibration_data_t *
  */
 void tsc2003_set_calibration_data( tsc2003_t * ctx, const tsc2003_calibration_data_t * cdata );
 
+/**
+ * @brief Utility funciton used for getting a copy of current calibration transform.
+ * @details Function copies transform that's being used for converting raw ADC values
+ * to actual pixel coordinates, e.g. to save it with @ref tp_calibration_save.
+ * @param[in] ctx Initialized TSC2003 context structure. See @ref tsc2003_t for more
+ * information about the context structure.
+ * @param[out] cal Pointer to memory where calibration transform will be stored.
+ * @retval Nothing.
+ */
+void tsc2003_get_calibration( tsc2003_t * ctx, tp_calibration_t * cal );
+
+/**
+ * @brief Utility funciton used for setting calibration transform.
+ * @details Unlike @ref tsc2003_set_calibration_data, transform computed with
+ * @ref tp_calibration_compute from three or more touched points compensates rotated
+ * and skewed panels as well.
+ * @param[in] ctx Initialized TSC2003 context structure. See @ref tsc2003_t for more
+ * information about the context structure.
+ * @param[in] cal Pointer to memory from where new calibration transform will be copied and set.
+ * @retval Nothing.
+ */
+void tsc2003_set_calibration( tsc2003_t * ctx, const tp_calibration_t * cal );
+
+/**
+ * @brief Reads raw X and Y AD conversion results.
+ * @details Reads raw values without converting them to pixel coordinates, used to
+ * collect points for @ref tp_calibration_compute.
+ * @param[in] ctx Initialized TSC2003 context structure. See @ref tsc2003_t for more
+ * information about the context structure.
+ * @param[out] x Pointer to where X AD conversion result will be placed.
+ * @param[out] y Pointer to where Y AD conversion result will be placed.
+ * @retval @b True(1) if adequate pressure has been applied to the screen, @b False(0) if not.
+ */
+bool tsc2003_read_xy_raw( tsc2003_t * ctx, uint16_t * x, uint16_t * y );
+
 /**
  * @brief Utility funciton used for setting threshold levels.
  * @details Function copies data stored in @p pressure. That information will be  be used for
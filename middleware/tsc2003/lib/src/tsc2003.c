@@ -61,14 +61,13 @@ const tsc2003_calibration_data_t TSC2003_CALIBRATION_DATA_DEFAULT = {
 /* --------------------------------------------- PRIVATE FUNCTIONS - DECLARATIONS -------------------------------------------*/
 
 /**
- * @brief Maps value of @p x in [in_min, in_max] range to [0, out_max] range.
- * @param[in] x Raw conversion result from TSC2003 IC.
- * @param[in] in_min Calibrated minimum value.
- * @param[in] in_max Calibrated maximum value.
- * @param[in] out_max Screen actual resolution value. ( Example 240,320... )
- * @retval Returns actual coordinate value for read AD conversion from IC.
+ * @brief Converts calibration data to calibration transform.
+ * @details Calibration transform maps [min, max] calibration data ranges to [0, width/height].
+ * @param[out] ctx Initialized TSC2003 context structure. See @ref tsc2003_t for more
+ * information about the context structure.
+ * @retval Nothing.
  */
-static uint32_t _map( uint32_t x, uint32_t in_min, uint32_t in_max, uint32_t out_max );
+static void tsc2003_update_calibration( tsc2003_t * ctx );
 
 /**
  * @brief Reads @p x_pos & @p y_pos coordinate values to 'touch point 0' ctx member if @b z is
@@ -249,6 +248,8 @@ void tsc2003_calibrate( tsc2003_t* ctx ) {
     tsc2003_calibrate_point( ctx, false );
     tsc2003_calibrate_point( ctx, false );
     tsc2003_calibrate_point( ctx, false );
+
+    tsc2003_update_calibration( ctx );
 }
 
 void tsc2003_generic_read( tsc2003_t * ctx, uint8_t reg_addr, uint8_t *data_buff, uint8_t len ) {
@@ -264,6 +265,19 @@ void tsc2003_get_calibration_data( tsc2003_t * ctx, tsc2003_calibration_data_t *
 
 void tsc2003_set_calibration_data( tsc2003_t * ctx, const tsc2003_calibration_data_t * cdata ) {
     memcpy( (void *)&ctx->calibration_data, (const void*)cdata, sizeof(tsc2003_calibration_data_t) );
+    tsc2003_update_calibration( ctx );
+}
+
+void tsc2003_get_calibration( tsc2003_t * ctx, tp_calibration_t * cal ) {
+    *cal = ctx->calibration;
+}
+
+void tsc2003_set_calibration( tsc2003_t * ctx, const tp_calibration_t * cal ) {
+    ctx->calibration = *cal;
+}
+
+bool tsc2003_read_xy_raw( tsc2003_t * ctx, uint16_t * x, uint16_t * y ) {
+    return tsc2003_check_pressure( ctx, x, y );
 }
 
 void tsc2003_set_pressure_threshold_level( tsc2003_cfg_t * cfg, tsc2003_pressure_threshold_t pressure ) {
@@ -313,15 +327,17 @@ static bool tsc2003_check_pressure( tsc2003_t *ctx, uint16_t *x_pos, uint16_t *y
     }
 }
 
-static uint32_t _map( uint32_t x, uint32_t in_min, uint32_t in_max, uint32_t out_max ) {
-    x -= in_min;
-    return (x * out_max) / (in_max - in_min);
+static void tsc2003_update_calibration( tsc2003_t * ctx ) {
+    tp_calibration_from_range( &ctx->calibration,
+                               ctx->calibration_data.min_x, ctx->calibration_data.max_x,
+                               ctx->calibration_data.min_y, ctx->calibration_data.max_y,
+                               ctx->width, ctx->height );
 }
 
 static void tsc2003_update_ctx_coords( tsc2003_t * ctx, uint16_t x_pos, uint16_t y_pos ) {
     /* Get actual display pixel coordinates. */
-    ctx->touch.point[0].coord_x =  _map( x_pos, ctx->calibration_data.min_x, ctx->calibration_data.max_x, ctx->width );
-    ctx->touch.point[0].coord_y =  _map( y_pos, ctx->calibration_data.min_y, ctx->calibration_data.max_y, ctx->height );
+    tp_calibration_apply( &ctx->calibration, x_pos, y_pos,
+                          &ctx->touch.point[0].coord_x, &ctx->touch.point[0].coord_y );
 }
 
 static void tsc2003_calibrate_point( tsc2003_t* ctx, bool calibration_points_uninitialized ) {
@@ -0,0 +1,571 @@
+#include "display_bus.h"
+#include "drv_digital_out.h"
+#include "drv_digital_in.h"
+#include "drv_port.h"
+#include "drv_pwm.h"
+#include "drv_spi_master.h"
+#include "gl_colors.h"
+#include <string.h>
+
+#define DCS_COLUMN_ADDRESS_SET     0x2A
+#define DCS_PAGE_ADDRESS_SET       0x2B
+#define DCS_MEMORY_WRITE           0x2C
+#define DCS_MEMORY_WRITE_CONTINUE  0x3C
+
+uint16_t display_bus_frame[ DISPLAY_BUS_HEIGHT ][ DISPLAY_BUS_WIDTH ];
+uint16_t display_bus_reference[ DISPLAY_BUS_HEIGHT ][ DISPLAY_BUS_WIDTH ];
+display_bus_counters_t display_bus_counters;
+
+/* === SIMULATED CONTROLLER === */
+
+static display_bus_format_t bus_format;
+static bool bus_mirrored;
+static bool bus_busy;
+
+// Levels of the control pins and values of the data ports.
+static uint8_t level_cs;
+static uint8_t level_rs;
+static uint8_t level_wr;
+static uint16_t port_0;
+static uint16_t port_1;
+
+// Last command and its parameters.
+static uint8_t command;
+static uint8_t params[ 4 ];
+static uint8_t n_params;
+
+// Address window registers, in controller coordinates.
+static uint16_t start_column;
+static uint16_t end_column;
+static uint16_t start_page;
+static uint16_t end_page;
+
+// Memory write window and position, in display coordinates.
+static bool writing;
+static bool position_valid;
+static uint16_t window_left;
+static uint16_t window_right;
+static uint16_t window_top;
+static uint16_t window_bottom;
+static uint16_t position_x;
+static uint16_t position_y;
+
+// Bytes of the pixel, waiting for its last byte.
+static uint8_t rgb[ 2 ];
+static uint8_t n_rgb;
+
+/* Window set by the address registers, in display coordinates. */
+static bool _display_bus_window( void )
+{
+    if ( ( start_column > end_column ) || ( end_column >= DISPLAY_BUS_WIDTH ) ||
+         ( start_page > end_page ) || ( end_page >= DISPLAY_BUS_HEIGHT ) )
+        return false;
+
+    if ( bus_mirrored )
+    {
+        window_left = ( DISPLAY_BUS_WIDTH - 1 ) - end_column;
+        window_right = ( DISPLAY_BUS_WIDTH - 1 ) - start_column;
+        window_top = ( DISPLAY_BUS_HEIGHT - 1 ) - end_page;
+        window_bottom = ( DISPLAY_BUS_HEIGHT - 1 ) - start_page;
+    }
+    else
+    {
+        window_left = start_column;
+        window_right = end_column;
+        window_top = start_page;
+        window_bottom = end_page;
+    }
+
+    return true;
+}
+
+static void _display_bus_command( uint8_t value )
+{
+    // Window parameters must be complete before the next command.
+    if ( ( ( DCS_COLUMN_ADDRESS_SET == command ) || ( DCS_PAGE_ADDRESS_SET == command ) ) &&
+         ( n_params != 4 ) )
+        display_bus_counters.errors++;
+
+    display_bus_counters.commands++;
+    command = value;
+    n_params = 0;
+    n_rgb = 0;
+    writing = false;
+
+    switch ( command )
+    {
+        case DCS_MEMORY_WRITE:
+            display_bus_counters.memory_writes++;
+            writing = _display_bus_window( );
+            position_valid = writing;
+            position_x = window_left;
+            position_y = window_top;
+            if ( !writing )
+                display_bus_counters.errors++;
+            break;
+
+        case DCS_MEMORY_WRITE_CONTINUE:
+            // Continues at the position after the last written pixel.
+            display_bus_counters.continues++;
+            writing = position_valid && _display_bus_window( ) &&
+                      ( position_x >= window_left ) && ( position_x <= window_right ) &&
+                      ( position_y >= window_top ) && ( position_y <= window_bottom );
+            if ( !writing )
+                display_bus_counters.errors++;
+            break;
+
+        case DCS_COLUMN_ADDRESS_SET:
+        case DCS_PAGE_ADDRESS_SET:
+            break;
+
+        default:
+            // Other commands may change how memory is written.
+            position_valid = false;
+            break;
+    }
+}
+
+static void _display_bus_pixel( uint16_t pixel )
+{
+    display_bus_frame[ position_y ][ position_x ] = pixel;
+
+    if ( position_x < window_right )
+    {
+        position_x++;
+        return;
+    }
+
+    position_x = window_left;
+    position_y = ( position_y < window_bottom ) ? position_y + 1 : window_top;
+}
+
+static void _display_bus_data( uint16_t value )
+{
+    if ( writing )
+    {
+        display_bus_counters.pixels++;
+
+        if ( DISPLAY_BUS_RGB565_WORD == bus_format )
+        {
+            _display_bus_pixel( value );
+            return;
+        }
+
+        if ( DISPLAY_BUS_RGB565_BYTES == bus_format )
+        {
+            if ( !n_rgb )
+            {
+                rgb[ n_rgb++ ] = ( uint8_t )value;
+                return;
+            }
+
+            n_rgb = 0;
+            _display_bus_pixel( ( ( uint16_t )rgb[ 0 ] << 8 ) | ( uint8_t )value );
+            return;
+        }
+
+        if ( n_rgb < 2 )
+        {
+            rgb[ n_rgb++ ] = ( uint8_t )value;
+            return;
+        }
+
+        n_rgb = 0;
+        _display_bus_pixel( ( ( uint16_t )( rgb[ 0 ] >> 3 ) << 11 ) |
+                            ( ( uint16_t )( rgb[ 1 ] >> 2 ) << 5 ) |
+                            ( ( uint8_t )value >> 3 ) );
+        return;
+    }
+
+    display_bus_counters.params++;
+
+    if ( n_params >= 4 )
+    {
+        // Only window commands are expected to have that many parameters here.
+        display_bus_counters.errors++;
+        return;
+    }
+
+    params[ n_params++ ] = ( uint8_t )value;
+
+    if ( 4 == n_params )
+    {
+        if ( DCS_COLUMN_ADDRESS_SET == command )
+        {
+            start_column = ( ( uint16_t )params[ 0 ] << 8 ) | params[ 1 ];
+            end_column = ( ( uint16_t )params[ 2 ] << 8 ) | params[ 3 ];
+        }
+        else if ( DCS_PAGE_ADDRESS_SET == command )
+        {
+            start_page = ( ( uint16_t )params[ 0 ] << 8 ) | params[ 1 ];
+            end_page = ( ( uint16_t )params[ 2 ] << 8 ) | params[ 3 ];
+        }
+    }
+}
+
+/* Rising edge of write strobe latches the data port. */
+static void _display_bus_strobe( void )
+{
+    uint16_t value = port_0 | ( port_1 << 8 );
+
+    if ( level_cs )
+        return;
+
+    if ( DISPLAY_BUS_RGB666_BYTES == bus_format )
+        value &= 0xFF;
+
+    if ( level_rs )
+        _display_bus_data( value );
+    else
+        _display_bus_command( ( uint8_t )value );
+}
+
+void display_bus_init( display_bus_format_t format, bool mirrored )
+{
+    bus_format = format;
+    bus_mirrored = mirrored;
+    bus_busy = false;
+
+    level_cs = 1;
+    level_rs = 1;
+    level_wr = 1;
+    port_0 = 0;
+    port_1 = 0;
+
+    command = 0;
+    n_params = 0;
+    n_rgb = 0;
+    writing = false;
+    position_valid = false;
+
+    start_column = 0;
+    end_column = DISPLAY_BUS_WIDTH - 1;
+    start_page = 0;
+    end_page = DISPLAY_BUS_HEIGHT - 1;
+
+    memset( display_bus_frame, 0, sizeof( display_bus_frame ) );
+    memset( display_bus_reference, 0, sizeof( display_bus_reference ) );
+    display_bus_reset_counters( );
+}
+
+void display_bus_reset_counters( void )
+{
+    memset( &display_bus_counters, 0, sizeof( display_bus_counters ) );
+}
+
+void display_bus_serial_write( const uint8_t * data, size_t len )
+{
+    while ( len-- )
+    {
+        if ( level_cs )
+            display_bus_counters.errors++;
+        else if ( level_rs )
+            _display_bus_data( *data );
+        else
+            _display_bus_command( *data );
+
+        data++;
+    }
+}
+
+void display_bus_set_busy( bool busy )
+{
+    bus_busy = busy;
+}
+
+uint32_t display_bus_frames( void )
+{
+    return display_bus_counters.memory_writes + display_bus_counters.continues;
+}
+
+int32_t display_bus_saved_cycles( void )
+{
+    return ( int32_t )( display_bus_frames( ) * DISPLAY_BUS_FRAME_SETUP_CYCLES ) -
+           ( int32_t )( display_bus_counters.commands + display_bus_counters.params );
+}
+
+uint32_t display_bus_compare( void )
+{
+    uint32_t differences = 0;
+    uint16_t x;
+    uint16_t y;
+
+    for ( y = 0; y < DISPLAY_BUS_HEIGHT; y++ )
+        for ( x = 0; x < DISPLAY_BUS_WIDTH; x++ )
+            if ( display_bus_frame[ y ][ x ] != display_bus_reference[ y ][ x ] )
+                differences++;
+
+    return differences;
+}
+
+/* === REFERENCE DRIVER === */
+
+static gl_rectangle_t reference_rect;
+static uint32_t reference_position;
+
+static void _reference_put( gl_coord_t x, gl_coord_t y, gl_color_t color )
+{
+    if ( ( x >= 0 ) && ( x < DISPLAY_BUS_WIDTH ) && ( y >= 0 ) && ( y < DISPLAY_BUS_HEIGHT ) )
+        display_bus_reference[ y ][ x ] = GL_COLOR_TO_RGB565( color );
+}
+
+static void _reference_fill( gl_rectangle_t * rect, gl_color_t color )
+{
+    uint16_t x;
+    uint16_t y;
+
+    for ( y = 0; y < rect->height; y++ )
+        for ( x = 0; x < rect->width; x++ )
+            _reference_put( rect->top_left.x + x, rect->top_left.y + y, color );
+}
+
+static void _reference_begin_frame( gl_rectangle_t * rect )
+{
+    reference_rect = *rect;
+    reference_position = 0;
+}
+
+static void _reference_frame_data( gl_color_t color )
+{
+    if ( !reference_rect.width )
+        return;
+
+    _reference_put( reference_rect.top_left.x + reference_position % reference_rect.width,
+                    reference_rect.top_left.y + reference_position / reference_rect.width, color );
+    reference_position++;
+}
+
+static void _reference_frame_data_buffer( const gl_color_t * __generic_ptr pixels, size_t count )
+{
+    while ( count-- )
+        _reference_frame_data( *pixels++ );
+}
+
+static void _reference_end_frame( void )
+{
+}
+
+void display_bus_reference_driver( gl_driver_t * driver )
+{
+    driver->display_width = DISPLAY_BUS_WIDTH;
+    driver->display_height = DISPLAY_BUS_HEIGHT;
+    driver->fill_f = _reference_fill;
+    driver->begin_frame_f = _reference_begin_frame;
+    driver->frame_data_f = _reference_frame_data;
+    driver->frame_data_buffer_f = _reference_frame_data_buffer;
+    driver->end_frame_f = _reference_end_frame;
+    driver->copy_rect_f = NULL;
+}
+
+/* === SIMULATED DRIVERS === */
+
+err_t digital_out_init( digital_out_t *out, pin_name_t name )
+{
+    out->pin = name;
+
+    return 0;
+}
+
+err_t digital_out_write( digital_out_t *out, uint8_t value )
+{
+    if ( bus_busy )
+        display_bus_counters.errors++;
+
+    switch ( out->pin )
+    {
+        case DISPLAY_BUS_PIN_CS:
+            level_cs = value;
+            break;
+
+        case DISPLAY_BUS_PIN_RS:
+            level_rs = value;
+            break;
+
+        case DISPLAY_BUS_PIN_WR:
+            if ( !level_wr && value )
+                _display_bus_strobe( );
+            level_wr = value;
+            break;
+
+        default:
+            break;
+    }
+
+    return 0;
+}
+
+err_t digital_out_high( digital_out_t *out )
+{
+    return digital_out_write( out, 1 );
+}
+
+err_t digital_out_low( digital_out_t *out )
+{
+    return digital_out_write( out, 0 );
+}
+
+err_t digital_out_toggle( digital_out_t *out )
+{
+    uint8_t level = 0;
+
+    if ( DISPLAY_BUS_PIN_CS == out->pin )
+        level = level_cs;
+    else if ( DISPLAY_BUS_PIN_RS == out->pin )
+        level = level_rs;
+    else if ( DISPLAY_BUS_PIN_WR == out->pin )
+        level = level_wr;
+
+    return digital_out_write( out, !level );
+}
+
+err_t digital_in_init( digital_in_t *in, pin_name_t name )
+{
+    in->pin = name;
+
+    return 0;
+}
+
+uint8_t digital_in_read( digital_in_t *in )
+{
+    ( void )in;
+
+    return 0;
+}
+
+err_t port_init( port_t *port, port_name_t name, port_size_t mask, pin_direction_t direction )
+{
+    ( void )direction;
+
+    port->name = name;
+    port->mask = mask;
+
+    return 0;
+}
+
+err_t port_write( port_t *port, port_size_t value )
+{
+    if ( bus_busy )
+        display_bus_counters.errors++;
+
+    if ( DISPLAY_BUS_PORT_0 == port->name )
+        port_0 = value & port->mask;
+    else if ( DISPLAY_BUS_PORT_1 == port->name )
+        port_1 = value & port->mask;
+
+    return 0;
+}
+
+port_size_t port_read_input( port_t *port )
+{
+    return ( DISPLAY_BUS_PORT_1 == port->name ) ? port_1 : port_0;
+}
+
+port_size_t port_read_output( port_t *port )
+{
+    return port_read_input( port );
+}
+
+void pwm_configure_default( pwm_config_t *config )
+{
+    config->pin = HAL_PIN_NC;
+    config->freq_hz = 0;
+}
+
+err_t pwm_open( pwm_t *obj, pwm_config_t *config )
+{
+    obj->config = *config;
+
+    return 0;
+}
+
+err_t pwm_set_freq( pwm_t *obj, uint32_t freq_hz )
+{
+    obj->config.freq_hz = freq_hz;
+
+    return 0;
+}
+
+err_t pwm_start( pwm_t *obj )
+{
+    ( void )obj;
+
+    return 0;
+}
+
+err_t pwm_set_duty( pwm_t *obj, float duty_ratio )
+{
+    ( void )obj;
+    ( void )duty_ratio;
+
+    return 0;
+}
+
+err_t pwm_stop( pwm_t *obj )
+{
+    ( void )obj;
+
+    return 0;
+}
+
+err_t pwm_close( pwm_t *obj )
+{
+    ( void )obj;
+
+    return 0;
+}
+
+void spi_master_configure_default( spi_master_config_t *config )
+{
+    memset( config, 0, sizeof( *config ) );
+    config->default_write_data = 0xFF;
+    config->sck = HAL_PIN_NC;
+    config->miso = HAL_PIN_NC;
+    config->mosi = HAL_PIN_NC;
+    config->speed = 100000;
+    config->mode = SPI_MASTER_MODE_DEFAULT;
+}
+
+err_t spi_master_open( spi_master_t *obj, spi_master_config_t *config )
+{
+    obj->config = *config;
+
+    return SPI_MASTER_SUCCESS;
+}
+
+void spi_master_select_device( pin_name_t chip_select )
+{
+    if ( bus_busy )
+        display_bus_counters.errors++;
+
+    if ( DISPLAY_BUS_PIN_CS == chip_select )
+        level_cs = 0;
+}
+
+void spi_master_deselect_device( pin_name_t chip_select )
+{
+    if ( bus_busy )
+        display_bus_counters.errors++;
+
+    if ( DISPLAY_BUS_PIN_CS == chip_select )
+        level_cs = 1;
+}
+
+err_t spi_master_write( spi_master_t *obj, uint8_t * __generic_ptr write_data_buffer,
+                                           size_t len_write_data )
+{
+    ( void )obj;
+
+    if ( bus_busy )
+        display_bus_counters.errors++;
+
+    display_bus_serial_write( write_data_buffer, len_write_data );
+
+    return SPI_MASTER_SUCCESS;
+}
+
+err_t spi_master_close( spi_master_t *obj )
+{
+    ( void )obj;
+
+    return 0;
+}
@@ -0,0 +1,141 @@
+/*!
+ * @file  display_bus.h
+ * @brief Simulated display controller on parallel and serial host interfaces,
+ * for host tests of display drivers.
+ *
+ * Controller latches the data port on each rising edge of the write strobe,
+ * or takes each byte written with SPI master, while chip select is active. It
+ * decodes the DCS commands display drivers
+ * use: column address set, page address set, memory write and memory write
+ * continue. Pixels are written to a frame buffer, so drawing through a driver
+ * can be compared with the reference drawing, and bus cycles are counted.
+ */
+
+#ifndef _DISPLAY_BUS_H_
+#define _DISPLAY_BUS_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "gl_types.h"
+
+/**
+ * @brief Pins and ports the display is connected to, given to the driver.
+ */
+#define DISPLAY_BUS_PIN_RST  1
+#define DISPLAY_BUS_PIN_CS   2
+#define DISPLAY_BUS_PIN_RS   3
+#define DISPLAY_BUS_PIN_RD   4
+#define DISPLAY_BUS_PIN_WR   5
+#define DISPLAY_BUS_PORT_0   1
+#define DISPLAY_BUS_PORT_1   2
+
+#define DISPLAY_BUS_WIDTH    320
+#define DISPLAY_BUS_HEIGHT   240
+
+/**
+ * @brief Bus cycles of setting the window and starting memory write for
+ * each frame, without caching: command and 4 parameters for each axis, and
+ * memory write command.
+ */
+#define DISPLAY_BUS_FRAME_SETUP_CYCLES  11
+
+/**
+ * @brief Pixel format on the bus.
+ */
+typedef enum
+{
+    DISPLAY_BUS_RGB565_WORD,    /**< 16-bit bus, one cycle per pixel. */
+    DISPLAY_BUS_RGB666_BYTES,   /**< 8-bit bus, red, green and blue cycles per pixel. */
+    DISPLAY_BUS_RGB565_BYTES    /**< Serial bus, high and low byte per pixel. */
+} display_bus_format_t;
+
+/**
+ * @brief Bus cycle counters.
+ */
+typedef struct
+{
+    uint32_t commands;          /**< Command cycles. */
+    uint32_t params;            /**< Command parameter cycles. */
+    uint32_t pixels;            /**< Pixel data cycles. */
+    uint32_t memory_writes;     /**< Memory write commands, each starting a frame. */
+    uint32_t continues;         /**< Memory write continue commands, each continuing a frame. */
+    uint32_t errors;            /**< Cycles the controller couldn't accept, e.g. pixels without memory write,
+                                     and bus changes while it's busy. */
+} display_bus_counters_t;
+
+/**
+ * @brief Frame buffer of the simulated display, in RGB565.
+ */
+extern uint16_t display_bus_frame[ DISPLAY_BUS_HEIGHT ][ DISPLAY_BUS_WIDTH ];
+
+/**
+ * @brief Frame buffer drawn by the reference driver, in RGB565.
+ */
+extern uint16_t display_bus_reference[ DISPLAY_BUS_HEIGHT ][ DISPLAY_BUS_WIDTH ];
+
+/**
+ * @brief Bus cycles counted since the last @ref display_bus_reset_counters.
+ */
+extern display_bus_counters_t display_bus_counters;
+
+/**
+ * @brief Resets the simulated display.
+ * @param[in] format Pixel format on the bus.
+ * @param[in] mirrored Controller addresses are mirrored on both axes, like
+ * SSD1963 panels mounted upside down.
+ * @return Nothing.
+ */
+void display_bus_init( display_bus_format_t format, bool mirrored );
+
+/**
+ * @brief Resets bus cycle counters.
+ * @return Nothing.
+ */
+void display_bus_reset_counters( void );
+
+/**
+ * @brief Writes bytes on serial bus, as SPI master does. Each byte is a
+ * command or data, depending on the data/command pin.
+ * @param[in] data Bytes to write.
+ * @param[in] len Number of bytes.
+ * @return Nothing.
+ */
+void display_bus_serial_write( const uint8_t * data, size_t len );
+
+/**
+ * @brief Marks the bus as driven by an asynchronous transfer, e.g. DMA. While
+ * it's busy, any change of pins, ports or SPI made by the driver is an error.
+ * @param[in] busy Transfer is in progress.
+ * @return Nothing.
+ */
+void display_bus_set_busy( bool busy );
+
+/**
+ * @brief Sets up the reference driver, drawing straight to the reference
+ * frame buffer.
+ * @param[out] driver GL driver.
+ * @return Nothing.
+ */
+void display_bus_reference_driver( gl_driver_t * driver );
+
+/**
+ * @brief Number of frames started with memory write or memory write continue.
+ * @return Number of frames.
+ */
+uint32_t display_bus_frames( void );
+
+/**
+ * @brief Bus cycles saved, compared to setting the whole window for each frame.
+ * @return Saved bus cycles.
+ */
+int32_t display_bus_saved_cycles( void );
+
+/**
+ * @brief Compares the frame buffer with the reference one.
+ * @return Number of different pixels.
+ */
+uint32_t display_bus_compare( void );
+
+#endif // _DISPLAY_BUS_H_
+// ------------------------------------------------------------------------- END
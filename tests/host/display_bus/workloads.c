@@ -0,0 +1,132 @@
+#include "workloads.h"
+#include "gl.h"
+#include "gl_text.h"
+#include "gl_shapes.h"
+#include "gl_colors.h"
+
+/* === TEST FONT === */
+
+/*
+ * Font in GL format, built on first use: header with first character, last
+ * character and height, table of width and 24-bit offset for each character,
+ * then character bitmaps, one byte per row since characters are 6 wide. It
+ * starts with character 0, since text drawing looks up the width of the
+ * terminating null.
+ */
+
+#define FONT_FIRST_CHAR  0
+#define FONT_LAST_CHAR   'Z'
+#define FONT_CHARS       ( FONT_LAST_CHAR - FONT_FIRST_CHAR + 1 )
+#define FONT_WIDTH       6
+#define FONT_HEIGHT      8
+#define FONT_TABLE       8
+#define FONT_BITMAPS     ( FONT_TABLE + 4 * FONT_CHARS )
+
+static uint8_t font[ FONT_BITMAPS + FONT_CHARS * FONT_HEIGHT ];
+
+static const uint8_t * font_setup( void )
+{
+    uint32_t offset;
+    uint8_t ch;
+    uint8_t row;
+
+    font[ 2 ] = FONT_FIRST_CHAR;
+    font[ 4 ] = FONT_LAST_CHAR;
+    font[ 6 ] = FONT_HEIGHT;
+
+    for ( ch = 0; ch < FONT_CHARS; ch++ )
+    {
+        offset = FONT_BITMAPS + ch * FONT_HEIGHT;
+        font[ FONT_TABLE + 4 * ch ] = FONT_WIDTH;
+        font[ FONT_TABLE + 4 * ch + 1 ] = ( uint8_t )offset;
+        font[ FONT_TABLE + 4 * ch + 2 ] = ( uint8_t )( offset >> 8 );
+        font[ FONT_TABLE + 4 * ch + 3 ] = ( uint8_t )( offset >> 16 );
+
+        // Space and control characters are blank, others get a pattern of their own.
+        for ( row = 0; row < FONT_HEIGHT; row++ )
+            font[ offset + row ] = ( ch > ' ' ) ? ( ( ch * 7 ) ^ ( row * 13 ) ^ ( row << 2 ) ) & 0x3F : 0;
+    }
+
+    return font;
+}
+
+/* === WORKLOADS === */
+
+static const char * const text_lines[] =
+{
+    "THE QUICK BROWN FOX JUMPS OVER THE LAZY DOG",
+    "0123456789 ABCDEFGHIJKLMNOPQRSTUVWXYZ",
+    "MIKROE GRAPHIC LIBRARY TEXT",
+    "PACK MY BOX WITH FIVE DOZEN LIQUOR JUGS"
+};
+
+static void draw_text_lines( void )
+{
+    uint8_t idx;
+
+    gl_set_font( font_setup( ) );
+    gl_set_font_orientation( GL_FONT_HORIZONTAL );
+    gl_set_pen( GL_NAVY, 1 );
+
+    for ( idx = 0; idx < 20; idx++ )
+        gl_draw_text( text_lines[ idx % 4 ], 2 + idx % 3, 2 + idx * 11 );
+}
+
+static void draw_text( void )
+{
+    gl_set_font_background( false );
+    draw_text_lines( );
+}
+
+static void draw_text_background( void )
+{
+    gl_set_font_background( true );
+    gl_set_font_background_color( GL_YELLOW );
+    draw_text_lines( );
+    gl_set_font_background( false );
+}
+
+static void draw_lines( void )
+{
+    gl_coord_t idx;
+
+    gl_set_pen( GL_RED, 1 );
+    for ( idx = 0; idx < 320; idx += 16 )
+    {
+        gl_draw_line( idx, 0, 319 - idx, 239 );
+        gl_draw_line( idx, 0, idx, 239 );
+    }
+
+    gl_set_pen( GL_GREEN, 3 );
+    for ( idx = 0; idx < 240; idx += 24 )
+        gl_draw_line( 0, idx, 319, 239 - idx );
+}
+
+static void draw_shapes( void )
+{
+    gl_set_pen( GL_BLACK, 1 );
+    gl_set_brush_style( GL_BRUSH_STYLE_NONE );
+    gl_draw_circle( 80, 120, 60 );
+
+    gl_set_pen( GL_BLUE, 4 );
+    gl_set_brush_style( GL_BRUSH_STYLE_FILL );
+    gl_set_brush_color( GL_OLIVE );
+    gl_draw_circle( 240, 120, 50 );
+    gl_draw_rect( 10, 10, 100, 40 );
+
+    gl_set_brush_style( GL_BRUSH_STYLE_GRADIENT_TOP_DOWN );
+    gl_set_brush_color_from( GL_WHITE );
+    gl_set_brush_color_to( GL_MAROON );
+    gl_draw_rect( 180, 180, 120, 50 );
+
+    gl_set_brush_style( GL_BRUSH_STYLE_NONE );
+}
+
+const workload_t workloads[] =
+{
+    { "text", draw_text, true },
+    { "text_background", draw_text_background, true },
+    { "lines", draw_lines, true },
+    { "shapes", draw_shapes, false },
+    { NULL, NULL, false }
+};
@@ -0,0 +1,29 @@
+/*!
+ * @file  workloads.h
+ * @brief Drawings made through the Graphic Library, for host tests of display
+ * drivers. Each one draws the same way on each run, so it can be drawn through
+ * a driver and through the reference driver and compared.
+ */
+
+#ifndef _WORKLOADS_H_
+#define _WORKLOADS_H_
+
+#include <stdbool.h>
+
+/**
+ * @brief Drawing with its name.
+ */
+typedef struct
+{
+    const char * name;      /**< Name printed by tests. */
+    void ( *draw )( void ); /**< Draws through the current GL driver. */
+    bool glyphs;            /**< Drawn with single pixel fills, which window caching is for. */
+} workload_t;
+
+/**
+ * @brief All drawings, ended with one without name.
+ */
+extern const workload_t workloads[];
+
+#endif // _WORKLOADS_H_
+// ------------------------------------------------------------------------- END
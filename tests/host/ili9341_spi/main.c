@@ -0,0 +1,256 @@
+#include "ili9341.h"
+#include "display_bus.h"
+#include "workloads.h"
+#include "gl.h"
+#include "test_check.h"
+#include <string.h>
+
+/* === ASYNCHRONOUS TRANSFER === */
+
+/*
+ * Transfer hooks simulating DMA: transfer is busy for a few polls, and the
+ * bytes reach the controller when it ends. Buffer must be left untouched, and
+ * the bus left alone, until then.
+ */
+
+#define TRANSFER_POLLS  3
+
+static const uint8_t * transfer_buffer;
+static uint8_t transfer_copy[ ILI9341_SPI_BUFFER_SIZE ];
+static size_t transfer_len;
+static uint8_t transfer_polls;
+static uint32_t transfers;
+static uint32_t transfer_changes;
+
+static void spi_transfer( const uint8_t * buffer, size_t len )
+{
+    TEST_CHECK( 0 == transfer_polls );
+    TEST_CHECK( len && ( len <= sizeof( transfer_copy ) ) );
+
+    transfer_buffer = buffer;
+    transfer_len = len;
+    memcpy( transfer_copy, buffer, len );
+    transfer_polls = TRANSFER_POLLS;
+    transfers++;
+
+    display_bus_set_busy( true );
+}
+
+static bool spi_busy( void )
+{
+    if ( !transfer_polls )
+        return false;
+
+    if ( --transfer_polls )
+        return true;
+
+    if ( memcmp( transfer_buffer, transfer_copy, transfer_len ) )
+        transfer_changes++;
+
+    display_bus_set_busy( false );
+    display_bus_serial_write( transfer_copy, transfer_len );
+
+    return false;
+}
+
+/* === HOST INTERFACES === */
+
+typedef struct
+{
+    const char * name;
+    ili9341_host_interface_t host_interface;
+    bool asynchronous;
+    display_bus_format_t format;
+
+} bus_t;
+
+static const bus_t buses[] =
+{
+    { "16-bit", ILI9341_HOST_INTERFACE_16BIT, false, DISPLAY_BUS_RGB565_WORD },
+    { "spi", ILI9341_HOST_INTERFACE_SPI, false, DISPLAY_BUS_RGB565_BYTES },
+    { "spi async", ILI9341_HOST_INTERFACE_SPI, true, DISPLAY_BUS_RGB565_BYTES }
+};
+
+#define BUS_COUNT  ( sizeof( buses ) / sizeof( buses[ 0 ] ) )
+
+static ili9341_t ctx;
+
+static void display_setup( const bus_t * bus, gl_driver_t * driver )
+{
+    ili9341_cfg_t cfg;
+
+    display_bus_init( bus->format, false );
+
+    ili9341_default_cfg( &cfg );
+    cfg.rst = DISPLAY_BUS_PIN_RST;
+    cfg.cs = DISPLAY_BUS_PIN_CS;
+    cfg.rs = DISPLAY_BUS_PIN_RS;
+    cfg.rd = DISPLAY_BUS_PIN_RD;
+    cfg.wr = DISPLAY_BUS_PIN_WR;
+    cfg.data_channel_0 = DISPLAY_BUS_PORT_0;
+    cfg.data_channel_0_mask = 0xFFFF;
+    cfg.data_channel_1 = HAL_PORT_NC;
+    cfg.orientation = ILI9341_MODE_LANDSCAPE_UP;
+    cfg.host_interface = bus->host_interface;
+    if ( bus->asynchronous )
+    {
+        cfg.spi_transfer_f = spi_transfer;
+        cfg.spi_busy_f = spi_busy;
+    }
+    cfg.width = DISPLAY_BUS_WIDTH;
+    cfg.height = DISPLAY_BUS_HEIGHT;
+    ili9341_init( &cfg, driver, &ctx );
+
+    display_bus_reset_counters( );
+    transfers = 0;
+    transfer_changes = 0;
+}
+
+/* === DRIVER WORKLOADS === */
+
+/*
+ * Drawn straight through driver functions, with the same pseudo random
+ * sequence on each run: frames longer than the SPI buffer, written with both
+ * frame data functions, and fills of any size.
+ */
+
+static gl_driver_t * target;
+static uint32_t seed;
+
+static uint32_t random_next( uint32_t range )
+{
+    seed = seed * 1103515245u + 12345u;
+
+    return ( seed >> 8 ) % range;
+}
+
+static gl_color_t random_color( void )
+{
+    uint8_t red = random_next( 256 );
+    uint8_t green = random_next( 256 );
+    uint8_t blue = random_next( 256 );
+
+    return GL_RGB2COLOR( red, green, blue );
+}
+
+static void random_rect( gl_rectangle_t * rect, uint16_t max_width, uint16_t max_height )
+{
+    rect->width = 1 + random_next( max_width );
+    rect->height = 1 + random_next( max_height );
+    rect->top_left.x = random_next( DISPLAY_BUS_WIDTH - rect->width + 1 );
+    rect->top_left.y = random_next( DISPLAY_BUS_HEIGHT - rect->height + 1 );
+}
+
+static void draw_frames( void )
+{
+    gl_color_t pixels[ 97 ];
+    gl_rectangle_t rect;
+    uint32_t count;
+    uint32_t sent;
+    uint16_t frame;
+    uint8_t idx;
+
+    seed = 1;
+    for ( frame = 0; frame < 300; frame++ )
+    {
+        random_rect( &rect, 40, 20 );
+        count = ( uint32_t )rect.width * rect.height;
+
+        target->begin_frame_f( &rect );
+        for ( sent = 0; sent < count; )
+        {
+            uint32_t chunk = 1 + random_next( 97 );
+
+            if ( chunk > count - sent )
+                chunk = count - sent;
+
+            for ( idx = 0; idx < chunk; idx++ )
+                pixels[ idx ] = random_color( );
+
+            // Odd chunks pixel by pixel, even ones as a buffer.
+            if ( chunk & 1 )
+                for ( idx = 0; idx < chunk; idx++ )
+                    target->frame_data_f( pixels[ idx ] );
+            else
+                target->frame_data_buffer_f( pixels, chunk );
+
+            sent += chunk;
+        }
+        target->end_frame_f( );
+    }
+}
+
+static void draw_fills( void )
+{
+    gl_rectangle_t rect;
+    uint16_t fill;
+
+    seed = 2;
+    for ( fill = 0; fill < 3000; fill++ )
+    {
+        if ( random_next( 4 ) )
+            random_rect( &rect, 8, 8 );
+        else
+            random_rect( &rect, DISPLAY_BUS_WIDTH, DISPLAY_BUS_HEIGHT );
+
+        target->fill_f( &rect, random_color( ) );
+    }
+}
+
+static const workload_t driver_workloads[] =
+{
+    { "frames", draw_frames, false },
+    { "fills", draw_fills, false },
+    { NULL, NULL, false }
+};
+
+/* === TESTS === */
+
+/*
+ * Each drawing goes through the driver to the simulated controller, and
+ * through the reference driver, so all host interfaces give the same picture.
+ */
+static void test_workload( const bus_t * bus, const workload_t * workload )
+{
+    gl_driver_t driver;
+    gl_driver_t reference;
+
+    display_setup( bus, &driver );
+    target = &driver;
+    gl_set_driver( &driver );
+    workload->draw( );
+
+    display_bus_reference_driver( &reference );
+    target = &reference;
+    gl_set_driver( &reference );
+    workload->draw( );
+
+    printf( "%-10s %-16s %8lu pixel cycles, %6lu transfers\n", bus->name, workload->name,
+            ( unsigned long )display_bus_counters.pixels, ( unsigned long )transfers );
+
+    TEST_CHECK( 0 == display_bus_compare( ) );
+    TEST_CHECK( 0 == display_bus_counters.errors );
+    TEST_CHECK( display_bus_counters.pixels > 0 );
+
+    // Every transfer ended before drawing returned, with the buffer untouched.
+    TEST_CHECK( 0 == transfer_polls );
+    TEST_CHECK( 0 == transfer_changes );
+    TEST_CHECK( bus->asynchronous == ( transfers > 0 ) );
+}
+
+int main( void )
+{
+    const workload_t * workload;
+    uint8_t idx;
+
+    for ( idx = 0; idx < BUS_COUNT; idx++ )
+    {
+        for ( workload = workloads; workload->name; workload++ )
+            test_workload( &buses[ idx ], workload );
+
+        for ( workload = driver_workloads; workload->name; workload++ )
+            test_workload( &buses[ idx ], workload );
+    }
+
+    return TEST_RESULT( "ili9341_spi" );
+}
@@ -0,0 +1,34 @@
+/*!
+ * @file  test_check.h
+ * @brief Checks of host tests.
+ */
+
+#ifndef _TEST_CHECK_H_
+#define _TEST_CHECK_H_
+
+#include <stdio.h>
+
+/**
+ * @brief Number of failed checks, returned by main of the test.
+ */
+static int test_failures = 0;
+
+/**
+ * @brief Counts and prints failed condition, test goes on.
+ */
+#define TEST_CHECK(cond) \
+    do { \
+        if (!(cond)) { \
+            printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond); \
+            test_failures++; \
+        } \
+    } while (0)
+
+/**
+ * @brief Prints test result, value to be returned by main.
+ */
+#define TEST_RESULT(name) \
+    (printf("%s: %s\n", (name), test_failures ? "FAILED" : "OK"), test_failures ? 1 : 0)
+
+#endif // _TEST_CHECK_H_
+// ------------------------------------------------------------------------- END
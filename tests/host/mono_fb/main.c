@@ -0,0 +1,381 @@
+#include "mono_fb.h"
+#include "test_check.h"
+#include <string.h>
+
+#define WIDTH          128
+#define HEIGHT         64
+#define PAGES          ( HEIGHT / MONO_FB_PAGE_HEIGHT )
+#define COLUMN_OFFSET  2
+
+/* === I2C === */
+
+/* Only the callback transport is tested, so the bus is never opened. */
+
+void i2c_master_configure_default( i2c_master_config_t *config )
+{
+    memset( config, 0, sizeof( *config ) );
+}
+
+err_t i2c_master_open( i2c_master_t *obj, i2c_master_config_t *config )
+{
+    ( void )obj;
+    ( void )config;
+    return I2C_MASTER_ERROR;
+}
+
+err_t i2c_master_set_slave_address( i2c_master_t *obj, uint8_t address )
+{
+    ( void )obj;
+    ( void )address;
+    return I2C_MASTER_ERROR;
+}
+
+err_t i2c_master_write( i2c_master_t *obj, uint8_t *write_data_buf, size_t len_write_data )
+{
+    ( void )obj;
+    ( void )write_data_buf;
+    ( void )len_write_data;
+    return I2C_MASTER_ERROR;
+}
+
+err_t i2c_master_close( i2c_master_t *obj )
+{
+    ( void )obj;
+    return I2C_MASTER_ERROR;
+}
+
+/* === TRANSPORT === */
+
+/* Streams written by the driver since the last reset, as they would be sent over the bus. */
+
+#define WRITES_MAX     ( 2 * PAGES + 2 )
+
+typedef struct
+{
+    bool is_data;
+    size_t len;
+    uint8_t bytes[ WIDTH ];
+} write_t;
+
+static write_t writes[ WRITES_MAX ];
+static uint8_t write_count;
+static uint8_t write_overflow;
+
+static void record_write( bool is_data, const uint8_t *buffer, size_t len )
+{
+    write_t *write;
+
+    if ( ( WRITES_MAX == write_count ) || ( len > WIDTH ) )
+    {
+        write_overflow++;
+        return;
+    }
+
+    write = &writes[ write_count++ ];
+    write->is_data = is_data;
+    write->len = len;
+    memcpy( write->bytes, buffer, len );
+}
+
+static void reset_writes( void )
+{
+    write_count = 0;
+    write_overflow = 0;
+}
+
+/* Checks that the given write sets the address of the given page and column. */
+static void check_address( uint8_t index, uint8_t page, uint16_t x )
+{
+    const write_t *write = &writes[ index ];
+    uint16_t column = x + COLUMN_OFFSET;
+
+    TEST_CHECK( !write->is_data );
+    TEST_CHECK( 3 == write->len );
+    TEST_CHECK( ( MONO_FB_CMD_SET_PAGE | page ) == write->bytes[ 0 ] );
+    TEST_CHECK( ( MONO_FB_CMD_SET_COLUMN_LOW | ( column & 0x0F ) ) == write->bytes[ 1 ] );
+    TEST_CHECK( ( MONO_FB_CMD_SET_COLUMN_HIGH | ( column >> 4 ) ) == write->bytes[ 2 ] );
+}
+
+/* Checks that the given write sends the given number of framebuffer bytes of the page from the column. */
+static void check_data( uint8_t index, const mono_fb_t *fb, uint8_t page, uint16_t x, size_t len )
+{
+    const write_t *write = &writes[ index ];
+
+    TEST_CHECK( write->is_data );
+    TEST_CHECK( len == write->len );
+    TEST_CHECK( 0 == memcmp( write->bytes, &fb->buffer[ page * WIDTH + x ], len ) );
+}
+
+/* Checks the changed columns of the given page, start not below end if it is clean. */
+static void check_dirty( const mono_fb_t *fb, uint8_t page, uint16_t start, uint16_t end )
+{
+    if ( start < end )
+    {
+        TEST_CHECK( start == fb->dirty_start[ page ] );
+        TEST_CHECK( end == fb->dirty_end[ page ] );
+    }
+    else
+    {
+        TEST_CHECK( fb->dirty_start[ page ] >= fb->dirty_end[ page ] );
+    }
+}
+
+/* === DRIVER === */
+
+static const uint8_t init_sequence[] = { 0xAE, 0xA1, 0xC8, 0xAF };
+
+static uint8_t buffer[ MONO_FB_BUFFER_SIZE( WIDTH, HEIGHT ) ];
+static mono_fb_t fb;
+static gl_driver_t driver;
+
+static void fill( gl_coord_t x, gl_coord_t y, gl_uint_t width, gl_uint_t height, gl_color_t color )
+{
+    gl_rectangle_t rect;
+
+    rect.top_left.x = x;
+    rect.top_left.y = y;
+    rect.width = width;
+    rect.height = height;
+    driver.fill_f( &rect, color );
+}
+
+static void check_init( void )
+{
+    mono_fb_cfg_t cfg;
+    uint8_t page;
+
+    // Callback transport needs a write function.
+    mono_fb_cfg_setup( &cfg );
+    cfg.transport = MONO_FB_TRANSPORT_CALLBACK;
+    cfg.buffer = buffer;
+    TEST_CHECK( MONO_FB_ERROR == mono_fb_init( &fb, &cfg, &driver ) );
+
+    memset( buffer, 0xA5, sizeof( buffer ) );
+    cfg.write_f = record_write;
+    cfg.width = WIDTH;
+    cfg.height = HEIGHT;
+    cfg.column_offset = COLUMN_OFFSET;
+    cfg.init_sequence = init_sequence;
+    cfg.init_sequence_len = sizeof( init_sequence );
+    TEST_CHECK( MONO_FB_OK == mono_fb_init( &fb, &cfg, &driver ) );
+
+    // Init sequence is sent as it is, framebuffer is cleared and whole of it is changed.
+    TEST_CHECK( 1 == write_count );
+    TEST_CHECK( !writes[ 0 ].is_data );
+    TEST_CHECK( sizeof( init_sequence ) == writes[ 0 ].len );
+    TEST_CHECK( 0 == memcmp( writes[ 0 ].bytes, init_sequence, sizeof( init_sequence ) ) );
+    TEST_CHECK( WIDTH == driver.display_width );
+    TEST_CHECK( HEIGHT == driver.display_height );
+    TEST_CHECK( mono_fb_is_dirty( &fb ) );
+
+    reset_writes( );
+    mono_fb_flush( &fb );
+
+    // Every page is sent whole.
+    TEST_CHECK( 2 * PAGES == write_count );
+    for ( page = 0; page < PAGES; page++ )
+    {
+        check_address( 2 * page, page, 0 );
+        check_data( 2 * page + 1, &fb, page, 0, WIDTH );
+        TEST_CHECK( 0 == writes[ 2 * page + 1 ].bytes[ WIDTH - 1 ] );
+    }
+    TEST_CHECK( !mono_fb_is_dirty( &fb ) );
+
+    // Nothing changed, nothing is sent.
+    reset_writes( );
+    mono_fb_flush( &fb );
+    TEST_CHECK( 0 == write_count );
+}
+
+/* === FILL === */
+
+static void check_fill( void )
+{
+    uint16_t x;
+
+    // Rows 3 to 12 cover the bottom of page 0 and the top of page 1.
+    fill( 20, 3, 5, 10, GL_WHITE );
+    for ( x = 20; x < 25; x++ )
+    {
+        TEST_CHECK( 0xF8 == buffer[ x ] );
+        TEST_CHECK( 0x1F == buffer[ WIDTH + x ] );
+    }
+    TEST_CHECK( 0 == buffer[ 19 ] );
+    TEST_CHECK( 0 == buffer[ 25 ] );
+    TEST_CHECK( 0 == buffer[ WIDTH + 19 ] );
+    TEST_CHECK( 0 == buffer[ WIDTH + 25 ] );
+    check_dirty( &fb, 0, 20, 25 );
+    check_dirty( &fb, 1, 20, 25 );
+    check_dirty( &fb, 2, 0, 0 );
+
+    // Whole pages 3 and 4, clipped at the right edge of the display.
+    fill( WIDTH - 4, 24, 10, 16, GL_WHITE );
+    TEST_CHECK( 0xFF == buffer[ 3 * WIDTH + WIDTH - 4 ] );
+    TEST_CHECK( 0xFF == buffer[ 4 * WIDTH + WIDTH - 1 ] );
+    TEST_CHECK( 0 == buffer[ 3 * WIDTH + WIDTH - 5 ] );
+    TEST_CHECK( 0 == buffer[ 5 * WIDTH + WIDTH - 1 ] );
+    check_dirty( &fb, 3, WIDTH - 4, WIDTH );
+    check_dirty( &fb, 4, WIDTH - 4, WIDTH );
+    check_dirty( &fb, 5, 0, 0 );
+
+    // Clearing a single pixel keeps the rest of its page byte, and widens nothing.
+    fill( 22, 4, 1, 1, GL_BLACK );
+    TEST_CHECK( 0xE8 == buffer[ 22 ] );
+    TEST_CHECK( !mono_fb_get_pixel( &fb, 22, 4 ) );
+    TEST_CHECK( mono_fb_get_pixel( &fb, 22, 3 ) );
+    check_dirty( &fb, 0, 20, 25 );
+
+    // Rectangle fully outside changes nothing.
+    fill( -10, -10, 5, 5, GL_WHITE );
+    check_dirty( &fb, 7, 0, 0 );
+
+    reset_writes( );
+    mono_fb_flush( &fb );
+
+    // Only the changed columns of the changed pages are sent, with the column offset.
+    TEST_CHECK( 8 == write_count );
+    check_address( 0, 0, 20 );
+    check_data( 1, &fb, 0, 20, 5 );
+    TEST_CHECK( 0xE8 == writes[ 1 ].bytes[ 2 ] );
+    check_address( 2, 1, 20 );
+    check_data( 3, &fb, 1, 20, 5 );
+    check_address( 4, 3, WIDTH - 4 );
+    check_data( 5, &fb, 3, WIDTH - 4, 4 );
+    check_address( 6, 4, WIDTH - 4 );
+    check_data( 7, &fb, 4, WIDTH - 4, 4 );
+    TEST_CHECK( 0 == write_overflow );
+    TEST_CHECK( !mono_fb_is_dirty( &fb ) );
+}
+
+/* === FRAME === */
+
+static void check_frame( void )
+{
+    gl_rectangle_t rect;
+    uint8_t pixel;
+
+    // 3 x 2 frame across pages 6 and 7, every other pixel on.
+    rect.top_left.x = 60;
+    rect.top_left.y = 55;
+    rect.width = 3;
+    rect.height = 2;
+    driver.begin_frame_f( &rect );
+    for ( pixel = 0; pixel < 6; pixel++ )
+    {
+        driver.frame_data_f( ( pixel & 1 ) ? GL_BLACK : GL_WHITE );
+    }
+    driver.end_frame_f( );
+
+    TEST_CHECK( 0x80 == buffer[ 6 * WIDTH + 60 ] );
+    TEST_CHECK( 0x00 == buffer[ 6 * WIDTH + 61 ] );
+    TEST_CHECK( 0x80 == buffer[ 6 * WIDTH + 62 ] );
+    TEST_CHECK( 0x00 == buffer[ 7 * WIDTH + 60 ] );
+    TEST_CHECK( 0x01 == buffer[ 7 * WIDTH + 61 ] );
+    TEST_CHECK( 0x00 == buffer[ 7 * WIDTH + 62 ] );
+
+    // Unchanged pixels don't widen the dirty range.
+    check_dirty( &fb, 6, 60, 63 );
+    check_dirty( &fb, 7, 61, 62 );
+
+    reset_writes( );
+    mono_fb_flush( &fb );
+    TEST_CHECK( 4 == write_count );
+    check_address( 0, 6, 60 );
+    check_data( 1, &fb, 6, 60, 3 );
+    check_address( 2, 7, 61 );
+    check_data( 3, &fb, 7, 61, 1 );
+}
+
+/* === COPY === */
+
+static bool copy_expected[ HEIGHT ][ WIDTH ];
+
+static void check_copy_rect( int8_t dx, int8_t dy )
+{
+    gl_rectangle_t src;
+    gl_coord_t x;
+    gl_coord_t y;
+
+    // Diagonal pattern around the middle of the display.
+    fill( 0, 0, WIDTH, HEIGHT, GL_BLACK );
+    for ( y = 24; y < 40; y++ )
+    {
+        for ( x = 56; x < 72; x++ )
+        {
+            if ( ( x + 2 * y ) % 5 < 2 )
+                fill( x, y, 1, 1, GL_WHITE );
+        }
+    }
+    mono_fb_flush( &fb );
+
+    src.top_left.x = 58;
+    src.top_left.y = 26;
+    src.width = 10;
+    src.height = 9;
+
+    // Source as it was, before any of it is overwritten.
+    for ( y = 0; y < HEIGHT; y++ )
+    {
+        for ( x = 0; x < WIDTH; x++ )
+        {
+            copy_expected[ y ][ x ] = mono_fb_get_pixel( &fb, x, y );
+        }
+    }
+    for ( y = 0; y < src.height; y++ )
+    {
+        for ( x = 0; x < src.width; x++ )
+        {
+            copy_expected[ src.top_left.y + dy + y ][ src.top_left.x + dx + x ] =
+                mono_fb_get_pixel( &fb, src.top_left.x + x, src.top_left.y + y );
+        }
+    }
+
+    driver.copy_rect_f( &src, src.top_left.x + dx, src.top_left.y + dy );
+
+    for ( y = 0; y < HEIGHT; y++ )
+    {
+        for ( x = 0; x < WIDTH; x++ )
+        {
+            if ( copy_expected[ y ][ x ] != mono_fb_get_pixel( &fb, x, y ) )
+            {
+                printf( "copy by %d, %d differs at %d, %d\n", dx, dy, x, y );
+                TEST_CHECK( copy_expected[ y ][ x ] == mono_fb_get_pixel( &fb, x, y ) );
+                return;
+            }
+        }
+    }
+
+    // Changed columns lie within the destination.
+    for ( y = 0; y < PAGES; y++ )
+    {
+        if ( fb.dirty_start[ y ] >= fb.dirty_end[ y ] )
+            continue;
+
+        TEST_CHECK( fb.dirty_start[ y ] >= src.top_left.x + dx );
+        TEST_CHECK( fb.dirty_end[ y ] <= src.top_left.x + dx + src.width );
+        TEST_CHECK( y * MONO_FB_PAGE_HEIGHT + MONO_FB_PAGE_HEIGHT > src.top_left.y + dy );
+        TEST_CHECK( y * MONO_FB_PAGE_HEIGHT < src.top_left.y + dy + src.height );
+    }
+    TEST_CHECK( mono_fb_is_dirty( &fb ) );
+    mono_fb_flush( &fb );
+}
+
+int main( void )
+{
+    check_init( );
+    check_fill( );
+    check_frame( );
+
+    // Overlapping copies in every direction, and one apart from the source.
+    check_copy_rect( 4, 0 );
+    check_copy_rect( -4, 0 );
+    check_copy_rect( 0, 3 );
+    check_copy_rect( 0, -3 );
+    check_copy_rect( 3, 2 );
+    check_copy_rect( -3, -2 );
+    check_copy_rect( 2, -5 );
+    check_copy_rect( -4, 6 );
+    check_copy_rect( 20, 12 );
+
+    return TEST_RESULT( "mono_fb" );
+}
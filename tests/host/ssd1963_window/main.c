@@ -0,0 +1,142 @@
+#include "ssd1963.h"
+#include "ssd1963_cmd.h"
+#include "display_bus.h"
+#include "workloads.h"
+#include "gl.h"
+#include "test_check.h"
+
+/* === HOST INTERFACES === */
+
+typedef struct
+{
+    const char * name;
+    ssd1963_host_interface_t host_interface;
+    uint32_t data_channel_0_mask;
+    hal_port_name_t data_channel_1;
+    display_bus_format_t format;
+
+} bus_t;
+
+static const bus_t buses[] =
+{
+    { "8-bit", SSD1963_HOST_INTERFACE_8BIT, 0x00FF, HAL_PORT_NC, DISPLAY_BUS_RGB666_BYTES },
+    { "16-bit", SSD1963_HOST_INTERFACE_16BIT, 0xFFFF, HAL_PORT_NC, DISPLAY_BUS_RGB565_WORD },
+    { "16-bit dual", SSD1963_HOST_INTERFACE_16BIT, 0x00FF, DISPLAY_BUS_PORT_1, DISPLAY_BUS_RGB565_WORD }
+};
+
+#define BUS_COUNT  ( sizeof( buses ) / sizeof( buses[ 0 ] ) )
+
+static void display_setup( const bus_t * bus, gl_driver_t * driver )
+{
+    ssd1963_cfg_t cfg;
+
+    // Panel is mounted rotated, driver mirrors addresses on both axes.
+    display_bus_init( bus->format, true );
+
+    cfg.rst = DISPLAY_BUS_PIN_RST;
+    cfg.cs = DISPLAY_BUS_PIN_CS;
+    cfg.d_c = DISPLAY_BUS_PIN_RS;
+    cfg.rd = DISPLAY_BUS_PIN_RD;
+    cfg.wr = DISPLAY_BUS_PIN_WR;
+    cfg.data_channel_0 = DISPLAY_BUS_PORT_0;
+    cfg.data_channel_0_mask = bus->data_channel_0_mask;
+    cfg.data_channel_1 = bus->data_channel_1;
+    cfg.data_channel_1_mask = 0x00FF;
+    cfg.host_interface = bus->host_interface;
+    cfg.width = DISPLAY_BUS_WIDTH;
+    cfg.height = DISPLAY_BUS_HEIGHT;
+    ssd1963_init( &cfg, driver );
+
+    // Only drawing is counted, not initialization.
+    display_bus_reset_counters( );
+}
+
+/* === TESTS === */
+
+/*
+ * Each drawing goes through the driver to the simulated controller, and
+ * through the reference driver, and both must give the same picture.
+ */
+static void test_workload( const bus_t * bus, const workload_t * workload )
+{
+    gl_driver_t driver;
+    gl_driver_t reference;
+    int32_t saved;
+
+    display_setup( bus, &driver );
+    gl_set_driver( &driver );
+    workload->draw( );
+
+    display_bus_reference_driver( &reference );
+    gl_set_driver( &reference );
+    workload->draw( );
+
+    saved = display_bus_saved_cycles( );
+    printf( "%-12s %-16s %6lu frames, %5lu continued, %7lu setup cycles, %7ld saved\n",
+            bus->name, workload->name, ( unsigned long )display_bus_frames( ),
+            ( unsigned long )display_bus_counters.continues,
+            ( unsigned long )( display_bus_counters.commands + display_bus_counters.params ),
+            ( long )saved );
+
+    TEST_CHECK( 0 == display_bus_compare( ) );
+    TEST_CHECK( 0 == display_bus_counters.errors );
+    TEST_CHECK( display_bus_frames( ) > 0 );
+    TEST_CHECK( saved >= 0 );
+
+    // Single pixel fills of glyphs and lines mostly share the window.
+    if ( workload->glyphs )
+        TEST_CHECK( saved > 0 );
+}
+
+/*
+ * Adjacent spans in a row are written with memory write continue, unless a
+ * command sent in between could have moved the controller's position.
+ */
+static void test_continue( const bus_t * bus, bool user_command )
+{
+    gl_rectangle_t rect = { { 10, 20 }, 1, 1 };
+    gl_driver_t driver;
+
+    display_setup( bus, &driver );
+
+    driver.fill_f( &rect, GL_RED );
+    if ( user_command )
+        ssd1963_write_command( SSD1963_CMD_NOP );
+    rect.top_left.x++;
+    rect.width = 5;
+    driver.fill_f( &rect, GL_BLUE );
+
+    TEST_CHECK( 0 == display_bus_counters.errors );
+    TEST_CHECK( GL_COLOR_TO_RGB565( GL_RED ) == display_bus_frame[ 20 ][ 10 ] );
+    TEST_CHECK( GL_COLOR_TO_RGB565( GL_BLUE ) == display_bus_frame[ 20 ][ 11 ] );
+    TEST_CHECK( GL_COLOR_TO_RGB565( GL_BLUE ) == display_bus_frame[ 20 ][ 15 ] );
+    TEST_CHECK( 0 == display_bus_frame[ 20 ][ 16 ] );
+
+    if ( user_command )
+    {
+        TEST_CHECK( 2 == display_bus_counters.memory_writes );
+        TEST_CHECK( 0 == display_bus_counters.continues );
+    }
+    else
+    {
+        TEST_CHECK( 1 == display_bus_counters.memory_writes );
+        TEST_CHECK( 1 == display_bus_counters.continues );
+    }
+}
+
+int main( void )
+{
+    const workload_t * workload;
+    uint8_t idx;
+
+    for ( idx = 0; idx < BUS_COUNT; idx++ )
+    {
+        for ( workload = workloads; workload->name; workload++ )
+            test_workload( &buses[ idx ], workload );
+
+        test_continue( &buses[ idx ], false );
+        test_continue( &buses[ idx ], true );
+    }
+
+    return TEST_RESULT( "ssd1963_window" );
+}
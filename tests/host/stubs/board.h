@@ -0,0 +1,10 @@
+/*!
+ * @file  board.h
+ * @brief Host replacement of board pin mapping, pins are given by the tests.
+ */
+
+#ifndef _BOARD_H_
+#define _BOARD_H_
+
+#endif // _BOARD_H_
+// ------------------------------------------------------------------------- END
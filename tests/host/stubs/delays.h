@@ -0,0 +1,17 @@
+/*!
+ * @file  delays.h
+ * @brief Host replacement of toolchain delay functions, which don't wait.
+ */
+
+#ifndef _DELAYS_H_
+#define _DELAYS_H_
+
+#define Delay_1ms()
+#define Delay_10ms()
+#define Delay_100ms()
+#define Delay_1sec()
+#define Delay_ms( time_ms )  ( ( void )( time_ms ) )
+#define Delay_us( time_us )  ( ( void )( time_us ) )
+
+#endif // _DELAYS_H_
+// ------------------------------------------------------------------------- END
@@ -0,0 +1,43 @@
+/*!
+ * @file  drv_analog_in.h
+ * @brief Host replacement of ADC driver types, used by touch panel driver headers.
+ */
+
+#ifndef _DRV_ANALOG_IN_H_
+#define _DRV_ANALOG_IN_H_
+
+#include "drv_name.h"
+
+typedef enum
+{
+    ANALOG_IN_VREF_EXTERNAL = 0,
+    ANALOG_IN_VREF_INTERNAL
+} analog_in_vref_t;
+
+typedef enum
+{
+    ANALOG_IN_RESOLUTION_NOT_SET = 0,
+    ANALOG_IN_RESOLUTION_6_BIT,
+    ANALOG_IN_RESOLUTION_8_BIT,
+    ANALOG_IN_RESOLUTION_10_BIT,
+    ANALOG_IN_RESOLUTION_12_BIT,
+    ANALOG_IN_RESOLUTION_14_BIT,
+    ANALOG_IN_RESOLUTION_16_BIT
+} analog_in_resolution_t;
+
+typedef struct
+{
+    pin_name_t input_pin;
+    analog_in_resolution_t resolution;
+    analog_in_vref_t vref_input;
+    float vref_value;
+} analog_in_config_t;
+
+typedef struct
+{
+    handle_t handle;
+    analog_in_config_t config;
+} analog_in_t;
+
+#endif // _DRV_ANALOG_IN_H_
+// ------------------------------------------------------------------------- END
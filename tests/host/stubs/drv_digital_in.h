@@ -0,0 +1,20 @@
+/*!
+ * @file  drv_digital_in.h
+ * @brief Host replacement of Digital Input driver, implemented by simulated hardware.
+ */
+
+#ifndef _DRV_DIGITAL_IN_H_
+#define _DRV_DIGITAL_IN_H_
+
+#include "drv_name.h"
+
+typedef struct
+{
+    pin_name_t pin;
+} digital_in_t;
+
+err_t digital_in_init( digital_in_t *in, pin_name_t name );
+uint8_t digital_in_read( digital_in_t *in );
+
+#endif // _DRV_DIGITAL_IN_H_
+// ------------------------------------------------------------------------- END
@@ -0,0 +1,29 @@
+/*!
+ * @file  drv_digital_out.h
+ * @brief Host replacement of Digital Output driver, implemented by simulated hardware.
+ */
+
+#ifndef _DRV_DIGITAL_OUT_H_
+#define _DRV_DIGITAL_OUT_H_
+
+#include "drv_name.h"
+
+typedef enum
+{
+    DIGITAL_OUT_SUCCESS = 0,
+    DIGITAL_OUT_UNSUPPORTED_PIN = (-1)
+} digital_out_err_t;
+
+typedef struct
+{
+    pin_name_t pin;
+} digital_out_t;
+
+err_t digital_out_init( digital_out_t *out, pin_name_t name );
+err_t digital_out_high( digital_out_t *out );
+err_t digital_out_low( digital_out_t *out );
+err_t digital_out_toggle( digital_out_t *out );
+err_t digital_out_write( digital_out_t *out, uint8_t value );
+
+#endif // _DRV_DIGITAL_OUT_H_
+// ------------------------------------------------------------------------- END
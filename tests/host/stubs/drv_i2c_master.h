@@ -0,0 +1,39 @@
+/*!
+ * @file  drv_i2c_master.h
+ * @brief Host replacement of I2C Master driver, implemented by the test which uses it.
+ */
+
+#ifndef _DRV_I2C_MASTER_H_
+#define _DRV_I2C_MASTER_H_
+
+#include "drv_name.h"
+
+typedef enum
+{
+    I2C_MASTER_SUCCESS = 0,
+    I2C_MASTER_ERROR = (-1)
+} i2c_master_err_t;
+
+typedef struct
+{
+    uint8_t    addr;
+    pin_name_t sda;
+    pin_name_t scl;
+    uint32_t   speed;
+    uint16_t   timeout_pass_count;
+} i2c_master_config_t;
+
+typedef struct
+{
+    handle_t handle;
+    i2c_master_config_t config;
+} i2c_master_t;
+
+void i2c_master_configure_default( i2c_master_config_t *config );
+err_t i2c_master_open( i2c_master_t *obj, i2c_master_config_t *config );
+err_t i2c_master_set_slave_address( i2c_master_t *obj, uint8_t address );
+err_t i2c_master_write( i2c_master_t *obj, uint8_t *write_data_buf, size_t len_write_data );
+err_t i2c_master_close( i2c_master_t *obj );
+
+#endif // _DRV_I2C_MASTER_H_
+// ------------------------------------------------------------------------- END
@@ -0,0 +1,27 @@
+/*!
+ * @file  drv_name.h
+ * @brief Host replacement of driver types.
+ */
+
+#ifndef _DRV_NAME_H_
+#define _DRV_NAME_H_
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include "hal_gpio.h"
+
+typedef enum
+{
+    GPIO_DIGITAL_INPUT = 0,
+    GPIO_DIGITAL_OUTPUT = 1
+} gpio_direction_t;
+
+typedef gpio_direction_t pin_direction_t;
+
+typedef hal_pin_name_t pin_name_t;
+typedef hal_port_name_t port_name_t;
+typedef hal_port_size_t port_size_t;
+
+#endif // _DRV_NAME_H_
+// ------------------------------------------------------------------------- END
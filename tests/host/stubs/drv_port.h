@@ -0,0 +1,25 @@
+/*!
+ * @file  drv_port.h
+ * @brief Host replacement of Port driver, implemented by simulated hardware.
+ */
+
+#ifndef _DRV_PORT_H_
+#define _DRV_PORT_H_
+
+#include "drv_name.h"
+
+typedef struct
+{
+    port_name_t name;
+    port_size_t mask;
+} port_t;
+
+err_t port_init( port_t *port, port_name_t name, port_size_t mask,
+                 pin_direction_t direction
+               );
+err_t port_write( port_t *port, port_size_t value );
+port_size_t port_read_input( port_t *port );
+port_size_t port_read_output( port_t *port );
+
+#endif // _DRV_PORT_H_
+// ------------------------------------------------------------------------- END
@@ -0,0 +1,32 @@
+/*!
+ * @file  drv_pwm.h
+ * @brief Host replacement of PWM driver, implemented by simulated hardware.
+ */
+
+#ifndef _DRV_PWM_H_
+#define _DRV_PWM_H_
+
+#include "drv_name.h"
+
+typedef struct
+{
+    pin_name_t pin;
+    uint32_t freq_hz;
+} pwm_config_t;
+
+typedef struct
+{
+    handle_t handle;
+    pwm_config_t config;
+} pwm_t;
+
+void pwm_configure_default( pwm_config_t *config );
+err_t pwm_open( pwm_t *obj, pwm_config_t *config );
+err_t pwm_set_freq( pwm_t *obj, uint32_t freq_hz );
+err_t pwm_start( pwm_t *obj );
+err_t pwm_set_duty( pwm_t *obj, float duty_ratio );
+err_t pwm_stop( pwm_t *obj );
+err_t pwm_close( pwm_t *obj );
+
+#endif // _DRV_PWM_H_
+// ------------------------------------------------------------------------- END
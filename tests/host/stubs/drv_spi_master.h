@@ -0,0 +1,52 @@
+/*!
+ * @file  drv_spi_master.h
+ * @brief Host replacement of SPI Master driver, implemented by simulated hardware.
+ */
+
+#ifndef _DRV_SPI_MASTER_H_
+#define _DRV_SPI_MASTER_H_
+
+#include "drv_name.h"
+#include "generic_pointer.h"
+
+typedef enum
+{
+    SPI_MASTER_SUCCESS = 0,
+    SPI_MASTER_ERROR = (-1)
+} spi_master_err_t;
+
+typedef enum {
+    SPI_MASTER_MODE_0 = 0,
+    SPI_MASTER_MODE_1,
+    SPI_MASTER_MODE_2,
+    SPI_MASTER_MODE_3,
+
+    SPI_MASTER_MODE_DEFAULT = SPI_MASTER_MODE_0
+} spi_master_mode_t;
+
+typedef struct
+{
+    uint8_t    default_write_data;
+    pin_name_t sck;
+    pin_name_t miso;
+    pin_name_t mosi;
+    uint32_t   speed;
+    spi_master_mode_t mode;
+} spi_master_config_t;
+
+typedef struct
+{
+    handle_t handle;
+    spi_master_config_t config;
+} spi_master_t;
+
+void spi_master_configure_default( spi_master_config_t *config );
+err_t spi_master_open( spi_master_t *obj, spi_master_config_t *config );
+void spi_master_select_device( pin_name_t chip_select );
+void spi_master_deselect_device( pin_name_t chip_select );
+err_t spi_master_write( spi_master_t *obj, uint8_t * __generic_ptr write_data_buffer,
+                                           size_t len_write_data );
+err_t spi_master_close( spi_master_t *obj );
+
+#endif // _DRV_SPI_MASTER_H_
+// ------------------------------------------------------------------------- END
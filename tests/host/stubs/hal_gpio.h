@@ -0,0 +1,22 @@
+/*!
+ * @file  hal_gpio.h
+ * @brief Host replacement of HAL types, used by driver headers.
+ */
+
+#ifndef _HAL_GPIO_H_
+#define _HAL_GPIO_H_
+
+#include <stdint.h>
+
+typedef int32_t err_t;
+typedef void * handle_t;
+
+typedef uint32_t hal_pin_name_t;
+typedef uint32_t hal_port_name_t;
+typedef uint16_t hal_port_size_t;
+
+#define HAL_PIN_NC (hal_pin_name_t)(0xFFFFFFFF)
+#define HAL_PORT_NC (hal_port_name_t)(0xFFFFFFFF)
+
+#endif // _HAL_GPIO_H_
+// ------------------------------------------------------------------------- END
@@ -0,0 +1,18 @@
+/*!
+ * @file  me_built_in.h
+ * @brief Host replacement of compiler built in macros, used by library sources.
+ */
+
+#ifndef _ME_BUILT_IN_H_
+#define _ME_BUILT_IN_H_
+
+#define Lo(param)       ((unsigned char *)&(param))[0]
+#define Hi(param)       ((unsigned char *)&(param))[1]
+#define Higher(param)   ((unsigned char *)&(param))[2]
+#define Highest(param)  ((unsigned char *)&(param))[3]
+
+#define LoWord(param)   ((unsigned short *)&(param))[0]
+#define HiWord(param)   ((unsigned short *)&(param))[1]
+
+#endif // _ME_BUILT_IN_H_
+// ------------------------------------------------------------------------- END
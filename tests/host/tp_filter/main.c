@@ -0,0 +1,200 @@
+#include "tp.h"
+#include "tp_filter.h"
+#include "test_check.h"
+#include <string.h>
+
+#define X_MAX  319
+#define Y_MAX  239
+
+/* === POSITION GAIN === */
+
+/*
+ * Gain grows from alpha_min to alpha_max with the movement of a report,
+ * as if it were divided by speed_max on every report.
+ */
+static void check_gain( tp_filter_cfg_t * cfg )
+{
+    tp_filter_point_t point;
+    uint16_t alpha;
+    uint16_t x;
+    uint16_t y;
+    uint16_t d;
+    int32_t lowest;
+    int32_t highest;
+
+    for ( d = 0; d <= cfg->speed_max + 2; d++ )
+    {
+        if ( d >= cfg->speed_max )
+            alpha = cfg->alpha_max;
+        else
+            alpha = cfg->alpha_min + ( cfg->alpha_max - cfg->alpha_min ) * d / cfg->speed_max;
+
+        // Slope is rounded down, gain may be 1 lower than the divided one.
+        lowest = ( 100 << TP_FILTER_POSITION_BITS ) +
+                 ( ( ( d << TP_FILTER_POSITION_BITS ) * ( alpha - 1 ) + 128 ) >> TP_FILTER_GAIN_BITS );
+        highest = ( 100 << TP_FILTER_POSITION_BITS ) +
+                  ( ( ( d << TP_FILTER_POSITION_BITS ) * alpha + 128 ) >> TP_FILTER_GAIN_BITS );
+        if ( ( 0 == d ) || ( d >= cfg->speed_max ) )
+            lowest = highest;
+
+        tp_filter_reset( &point, 100, 100 );
+        x = 100 + d;
+        y = 100;
+        tp_filter_update( cfg, &point, &x, &y, X_MAX, Y_MAX );
+
+        TEST_CHECK( point.x.position >= lowest );
+        TEST_CHECK( point.x.position <= highest );
+        TEST_CHECK( ( 100 << TP_FILTER_POSITION_BITS ) == point.y.position );
+    }
+}
+
+static void check_gains( void )
+{
+    tp_filter_cfg_t cfg;
+    tp_t tp;
+
+    tp_filter_cfg_setup( &cfg );
+    check_gain( &cfg );
+
+    // Changed tunables are taken by the setup of the Touch Panel.
+    memset( &tp, 0, sizeof( tp ) );
+    cfg.alpha_min = 16;
+    cfg.alpha_max = 256;
+    cfg.speed_max = 7;
+    cfg.beta = 0;
+    cfg.prediction = 0;
+    tp_filter_setup( &tp, &cfg );
+    TEST_CHECK( &cfg == tp.filter_cfg );
+    check_gain( &cfg );
+
+    cfg.alpha_min = 1;
+    cfg.speed_max = 1;
+    tp_filter_cfg_update( &cfg );
+    check_gain( &cfg );
+
+    cfg.alpha_min = 100;
+    cfg.alpha_max = 101;
+    cfg.speed_max = 200;
+    tp_filter_cfg_update( &cfg );
+    check_gain( &cfg );
+
+    tp_filter_setup( &tp, NULL );
+    TEST_CHECK( NULL == tp.filter_cfg );
+}
+
+/* === STILL AND MOVING TOUCH === */
+
+/* Jitter of the controller, -2 to 2 pixels, repeatable on every host. */
+static uint32_t noise_state = 1;
+
+static int16_t noise( void )
+{
+    noise_state = noise_state * 1103515245u + 12345u;
+
+    return ( int16_t )( ( noise_state >> 16 ) % 5 ) - 2;
+}
+
+#define STILL_REPORTS   1000
+#define STILL_WARM_UP   10
+#define DRAG_REPORTS    60
+#define DRAG_WARM_UP    20
+#define DRAG_SPEED      4
+#define AVERAGE_LENGTH  4
+
+/*
+ * Touch held still with jitter, average distance from the touch in 1/100
+ * pixel, as reported and as filtered.
+ */
+static void check_still( const tp_filter_cfg_t * cfg )
+{
+    tp_filter_point_t point;
+    uint32_t raw_error = 0;
+    uint32_t filtered_error = 0;
+    uint16_t report;
+    uint16_t x;
+    uint16_t y;
+
+    tp_filter_reset( &point, 160, 120 );
+    for ( report = 0; report < STILL_WARM_UP + STILL_REPORTS; report++ )
+    {
+        x = 160 + noise( );
+        y = 120 + noise( );
+        if ( report >= STILL_WARM_UP )
+            raw_error += ( ( x > 160 ) ? x - 160 : 160 - x ) + ( ( y > 120 ) ? y - 120 : 120 - y );
+
+        tp_filter_update( cfg, &point, &x, &y, X_MAX, Y_MAX );
+        if ( report >= STILL_WARM_UP )
+            filtered_error += ( ( x > 160 ) ? x - 160 : 160 - x ) + ( ( y > 120 ) ? y - 120 : 120 - y );
+    }
+
+    raw_error = raw_error * 100 / ( 2 * STILL_REPORTS );
+    filtered_error = filtered_error * 100 / ( 2 * STILL_REPORTS );
+    printf( "still touch error: reported %lu.%02lu px, filtered %lu.%02lu px\n",
+            ( unsigned long )raw_error / 100, ( unsigned long )raw_error % 100,
+            ( unsigned long )filtered_error / 100, ( unsigned long )filtered_error % 100 );
+
+    // Jitter drops to less than 60 percent.
+    TEST_CHECK( 10 * filtered_error < 6 * raw_error );
+}
+
+/*
+ * Drag at constant speed, average distance ahead of the touch in 1/100
+ * report, filtered and by a moving average, which lags behind.
+ */
+static void check_drag( const tp_filter_cfg_t * cfg )
+{
+    tp_filter_point_t point;
+    uint16_t history[ AVERAGE_LENGTH ];
+    int32_t filtered_lead = 0;
+    int32_t average_lead = 0;
+    uint32_t average;
+    uint16_t report;
+    uint16_t touch;
+    uint16_t x;
+    uint16_t y;
+    uint8_t idx;
+
+    tp_filter_reset( &point, 20, 120 );
+    for ( report = 0; report < DRAG_WARM_UP + DRAG_REPORTS; report++ )
+    {
+        touch = 20 + DRAG_SPEED * report;
+        history[ report % AVERAGE_LENGTH ] = touch;
+
+        x = touch;
+        y = 120;
+        tp_filter_update( cfg, &point, &x, &y, X_MAX, Y_MAX );
+        if ( report < DRAG_WARM_UP )
+            continue;
+
+        average = 0;
+        for ( idx = 0; idx < AVERAGE_LENGTH; idx++ )
+            average += history[ idx ];
+
+        filtered_lead += ( int32_t )x - touch;
+        average_lead += ( int32_t )( average * 100 / AVERAGE_LENGTH ) - touch * 100;
+        TEST_CHECK( 120 == y );
+    }
+
+    filtered_lead = filtered_lead * 100 / ( DRAG_REPORTS * DRAG_SPEED );
+    average_lead = average_lead / ( DRAG_REPORTS * DRAG_SPEED );
+    printf( "drag lead: filtered %ld/100 reports, %u report moving average %ld/100 reports\n",
+            ( long )filtered_lead, AVERAGE_LENGTH, ( long )average_lead );
+
+    // Filter reports the touch ahead of it, moving average lags by one and a half reports.
+    TEST_CHECK( filtered_lead >= 50 );
+    TEST_CHECK( filtered_lead <= 150 );
+    TEST_CHECK( -150 == average_lead );
+}
+
+int main( void )
+{
+    tp_filter_cfg_t cfg;
+
+    check_gains( );
+
+    tp_filter_cfg_setup( &cfg );
+    check_still( &cfg );
+    check_drag( &cfg );
+
+    return TEST_RESULT( "tp_filter" );
+}
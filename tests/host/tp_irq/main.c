@@ -0,0 +1,312 @@
+#include "tp.h"
+#include "test_check.h"
+#include <string.h>
+
+/* === SIMULATED TOUCH CONTROLLER === */
+
+/*
+ * Controller reports one touch point. Each driver process call stands for
+ * one bus transaction, e.g. I2C read of the touch registers.
+ */
+
+typedef struct
+{
+    uint8_t     touched;
+    tp_coord_t  x;
+    tp_coord_t  y;
+    uint32_t    reads;
+
+} sim_controller_t;
+
+static sim_controller_t sim;
+static uint32_t sim_time;
+
+static tp_err_t sim_process( void * ctx )
+{
+    ( ( sim_controller_t * )ctx )->reads++;
+
+    return TP_OK;
+}
+
+static tp_event_t sim_press_detect( void * ctx )
+{
+    return ( ( sim_controller_t * )ctx )->touched ? TP_EVENT_PRESS_DET : TP_EVENT_PRESS_NOT_DET;
+}
+
+static void sim_press_coordinates( void * ctx, tp_touch_item_t * touch_item )
+{
+    sim_controller_t * controller = ( sim_controller_t * )ctx;
+
+    touch_item->n_touches = 1;
+    touch_item->point[ 0 ].coord_x = controller->x;
+    touch_item->point[ 0 ].coord_y = controller->y;
+    touch_item->point[ 0 ].event   = TP_EVENT_PRESS_MOVE;
+    touch_item->point[ 0 ].id      = TP_TOUCH_ID_0;
+}
+
+static void sim_gesture( void * ctx, tp_event_t * event )
+{
+    ( void )ctx;
+
+    *event = TP_EVENT_GEST_NONE;
+}
+
+static uint32_t sim_timestamp( void )
+{
+    return sim_time;
+}
+
+static tp_drv_t sim_drv =
+{
+    ( tp_press_det_t )sim_press_detect,
+    ( tp_press_coord_t )sim_press_coordinates,
+    ( tp_gesture_t )sim_gesture,
+    ( tp_process_t )sim_process
+};
+
+/* === RECORDED CALLBACKS === */
+
+#define TEST_LOG_SIZE 64
+
+typedef struct
+{
+    uint8_t     n_touches;
+    tp_coord_t  x;
+    tp_coord_t  y;
+    uint32_t    timestamp;
+
+} test_reading_t;
+
+static tp_t tp;
+static test_reading_t readings[ TEST_LOG_SIZE ];
+static uint8_t n_readings;
+static uint8_t n_up;
+static tp_coord_t up_x;
+static tp_coord_t up_y;
+
+static void touch_callback( tp_touch_item_t * touch_item )
+{
+    test_reading_t * reading = &readings[ n_readings % TEST_LOG_SIZE ];
+
+    reading->n_touches = touch_item->n_touches;
+    reading->x = touch_item->n_touches ? touch_item->point[ 0 ].coord_x : 0;
+    reading->y = touch_item->n_touches ? touch_item->point[ 0 ].coord_y : 0;
+    reading->timestamp = tp_get_sample_timestamp( &tp );
+    n_readings++;
+}
+
+static void press_callback( tp_event_t event, tp_coord_t x, tp_coord_t y, tp_touch_id_t id )
+{
+    ( void )id;
+
+    if ( TP_EVENT_PRESS_UP == event )
+    {
+        up_x = x;
+        up_y = y;
+        n_up++;
+    }
+}
+
+/* Controller interrupt: reports new data, read in the interrupt. */
+static void sim_isr_report( uint8_t touched, tp_coord_t x, tp_coord_t y )
+{
+    sim_time += 10;
+    sim.touched = touched;
+    sim.x = x;
+    sim.y = y;
+
+    tp_irq_sample( &tp );
+}
+
+static void setup( tp_sample_t * samples, uint8_t n_samples, tp_irq_mode_t mode )
+{
+    tp_cfg_t cfg;
+
+    memset( &sim, 0, sizeof( sim ) );
+    sim_time = 0;
+    n_readings = 0;
+    n_up = 0;
+
+    tp_cfg_setup( &cfg );
+    cfg.width = 320;
+    cfg.height = 240;
+    tp_init( &tp, &cfg, &sim_drv, &sim );
+    tp_touch_callback_setup( &tp, touch_callback );
+    tp_press_callback_setup( &tp, press_callback );
+
+    TEST_CHECK( TP_OK == tp_irq_setup( &tp, samples, n_samples, mode, sim_timestamp ) );
+}
+
+/* === TESTS === */
+
+static void test_ring_size( void )
+{
+    tp_sample_t samples[ 2 ];
+
+    setup( NULL, 0, TP_IRQ_MODE_ISR );
+    TEST_CHECK( TP_ERR_N_DATA == tp_irq_setup( &tp, samples, 1, TP_IRQ_MODE_ISR, NULL ) );
+    TEST_CHECK( TP_ERR_N_DATA == tp_irq_setup( &tp, samples, 2, TP_IRQ_MODE_ISR, NULL ) );
+}
+
+static void test_isr_overflow( void )
+{
+    tp_sample_t samples[ 4 ];
+    uint8_t i;
+
+    setup( samples, 4, TP_IRQ_MODE_ISR );
+
+    // No interrupt, no bus traffic.
+    for ( i = 0; i < 100; i++ )
+        tp_process( &tp );
+
+    TEST_CHECK( 0 == sim.reads );
+    TEST_CHECK( 0 == n_readings );
+
+    // One entry is always left empty and one is kept for the release, so
+    // three of five presses are dropped.
+    for ( i = 0; i < 5; i++ )
+        sim_isr_report( 1, 100 + i, 50 + i );
+
+    TEST_CHECK( 5 == sim.reads );
+    TEST_CHECK( 3 == tp.samples_dropped );
+    TEST_CHECK( 0 == n_readings );
+
+    // Release still fits, further samples are dropped without reading the
+    // controller.
+    sim_isr_report( 0, 0, 0 );
+    sim_isr_report( 1, 200, 100 );
+
+    TEST_CHECK( 6 == sim.reads );
+    TEST_CHECK( 4 == tp.samples_dropped );
+
+    // Oldest presses and the release are drained in order, with their
+    // timestamps.
+    tp_process( &tp );
+
+    TEST_CHECK( 3 == n_readings );
+    for ( i = 0; i < 2; i++ )
+    {
+        TEST_CHECK( 1 == readings[ i ].n_touches );
+        TEST_CHECK( 100 + i == readings[ i ].x );
+        TEST_CHECK( 50 + i == readings[ i ].y );
+        TEST_CHECK( 10u * ( i + 1 ) == readings[ i ].timestamp );
+    }
+    TEST_CHECK( 0 == readings[ 2 ].n_touches );
+    TEST_CHECK( 60 == readings[ 2 ].timestamp );
+    TEST_CHECK( 1 == n_up );
+    TEST_CHECK( tp.sample_head == tp.sample_tail );
+
+    // Release is reported where the point was last handled.
+    TEST_CHECK( 101 == up_x );
+    TEST_CHECK( 51 == up_y );
+
+    // Ring is empty, processing doesn't read the controller.
+    tp_process( &tp );
+    TEST_CHECK( 6 == sim.reads );
+    TEST_CHECK( 3 == n_readings );
+}
+
+static void test_isr_wrap( void )
+{
+    tp_sample_t samples[ 5 ];
+    uint8_t reported = 0;
+    uint8_t i;
+    uint8_t j;
+
+    setup( samples, 5, TP_IRQ_MODE_ISR );
+
+    // Ring wraps many times while it's drained between interrupts.
+    for ( i = 0; i < 20; i++ )
+    {
+        for ( j = 0; j <= i % 3; j++ )
+        {
+            sim_isr_report( 1, 10 + reported, 20 + reported );
+            reported++;
+        }
+
+        tp_process( &tp );
+    }
+
+    TEST_CHECK( 0 == tp.samples_dropped );
+    TEST_CHECK( reported == n_readings );
+    TEST_CHECK( reported <= TEST_LOG_SIZE );
+
+    for ( i = 0; i < n_readings; i++ )
+    {
+        TEST_CHECK( 10 + i == readings[ i ].x );
+        TEST_CHECK( 20 + i == readings[ i ].y );
+        TEST_CHECK( 10u * ( i + 1 ) == readings[ i ].timestamp );
+    }
+}
+
+static void test_deferred( void )
+{
+    tp_sample_t samples[ 4 ];
+    uint8_t i;
+
+    setup( samples, 4, TP_IRQ_MODE_DEFERRED );
+
+    // Controller is read once after setup, in case it is already touched.
+    tp_process( &tp );
+    TEST_CHECK( 1 == sim.reads );
+    TEST_CHECK( 0 == n_readings );
+
+    for ( i = 0; i < 100; i++ )
+        tp_process( &tp );
+
+    TEST_CHECK( 1 == sim.reads );
+
+    // Interrupt only notifies, the controller is read by tp_process.
+    sim.touched = 1;
+    sim.x = 30;
+    sim.y = 40;
+    sim_time = 500;
+    tp_irq_notify( &tp );
+
+    TEST_CHECK( 1 == sim.reads );
+
+    tp_process( &tp );
+
+    TEST_CHECK( 2 == sim.reads );
+    TEST_CHECK( 1 == n_readings );
+    TEST_CHECK( 30 == readings[ 0 ].x );
+    TEST_CHECK( 500 == readings[ 0 ].timestamp );
+
+    // While touched, the controller is read on every call, without interrupt.
+    for ( i = 0; i < 3; i++ )
+    {
+        sim_time += 5;
+        sim.x++;
+        tp_process( &tp );
+    }
+
+    TEST_CHECK( 5 == sim.reads );
+    TEST_CHECK( 4 == n_readings );
+    TEST_CHECK( 33 == readings[ 3 ].x );
+    TEST_CHECK( 515 == readings[ 3 ].timestamp );
+
+    // Release is read, then reading stops until the next interrupt.
+    sim.touched = 0;
+    tp_process( &tp );
+
+    TEST_CHECK( 6 == sim.reads );
+    TEST_CHECK( 5 == n_readings );
+    TEST_CHECK( 0 == readings[ 4 ].n_touches );
+    TEST_CHECK( 1 == n_up );
+
+    for ( i = 0; i < 100; i++ )
+        tp_process( &tp );
+
+    TEST_CHECK( 6 == sim.reads );
+    TEST_CHECK( 0 == tp.samples_dropped );
+}
+
+int main( void )
+{
+    test_ring_size( );
+    test_isr_overflow( );
+    test_isr_wrap( );
+    test_deferred( );
+
+    return TEST_RESULT( "tp_irq" );
+}
@@ -0,0 +1,405 @@
+#include "tp.h"
+#include "tp_tracker.h"
+#include "tp_replay.h"
+#include "test_check.h"
+#include <string.h>
+
+/* === SCRIPTED FINGERS === */
+
+/*
+ * Touch controller driver reporting one scripted reading per process call.
+ * Its readings are recorded by the recorder driver, and the recorded stream
+ * is replayed through the Touch Panel library to the tracker.
+ */
+
+#define SCRIPT_POINTS_MAX  3
+
+typedef struct
+{
+    uint32_t    time;
+    uint8_t     n_touches;
+    tp_coord_t  x[ SCRIPT_POINTS_MAX ];
+    tp_coord_t  y[ SCRIPT_POINTS_MAX ];
+
+} script_reading_t;
+
+typedef struct
+{
+    const script_reading_t * readings;
+    uint8_t                  n_readings;
+    uint8_t                  next;
+    const script_reading_t * current;
+
+} script_t;
+
+static script_t script;
+
+static tp_err_t script_process( void * ctx )
+{
+    script_t * s = ( script_t * )ctx;
+
+    s->current = &s->readings[ s->next++ ];
+
+    return TP_OK;
+}
+
+static tp_event_t script_press_detect( void * ctx )
+{
+    return ( ( script_t * )ctx )->current->n_touches ? TP_EVENT_PRESS_DET : TP_EVENT_PRESS_NOT_DET;
+}
+
+static void script_press_coordinates( void * ctx, tp_touch_item_t * touch_item )
+{
+    const script_reading_t * reading = ( ( script_t * )ctx )->current;
+    uint8_t idx;
+
+    touch_item->n_touches = reading->n_touches;
+
+    for ( idx = 0; idx < reading->n_touches; idx++ )
+    {
+        touch_item->point[ idx ].coord_x = reading->x[ idx ];
+        touch_item->point[ idx ].coord_y = reading->y[ idx ];
+        touch_item->point[ idx ].event   = TP_EVENT_PRESS_MOVE;
+        // Controller IDs follow the report order, so they can't be trusted.
+        touch_item->point[ idx ].id      = ( tp_touch_id_t )idx;
+    }
+}
+
+static void script_gesture( void * ctx, tp_event_t * event )
+{
+    ( void )ctx;
+
+    *event = TP_EVENT_GEST_NONE;
+}
+
+static uint32_t script_timestamp( void )
+{
+    return script.current ? script.current->time : 0;
+}
+
+static tp_drv_t script_drv =
+{
+    ( tp_press_det_t )script_press_detect,
+    ( tp_press_coord_t )script_press_coordinates,
+    ( tp_gesture_t )script_gesture,
+    ( tp_process_t )script_process
+};
+
+/* === RECORD AND REPLAY === */
+
+#define TEST_STREAM_SIZE    2048
+#define TEST_READINGS_MAX   32
+
+static uint8_t stream[ TEST_STREAM_SIZE ];
+static uint32_t stream_size;
+
+static tp_replay_t replay;
+static tp_tracker_t tracker;
+
+// Gesture and tracked points after each replayed reading.
+static tp_tracker_gesture_t gestures[ TEST_READINGS_MAX ];
+static tp_tracker_point_t points[ TEST_READINGS_MAX ][ TP_TRACKER_POINTS_MAX ];
+static uint8_t n_updates;
+
+static void tracker_callback( tp_touch_item_t * touch_item )
+{
+    gestures[ n_updates ] = tp_tracker_update( &tracker, touch_item->point, touch_item->n_touches,
+                                               replay.current.timestamp );
+    memcpy( points[ n_updates ], tracker.point, sizeof( tracker.point ) );
+    n_updates++;
+}
+
+static void tp_setup( tp_t * tp, tp_drv_t * drv, void * drv_ctx )
+{
+    tp_cfg_t cfg;
+
+    tp_cfg_setup( &cfg );
+    cfg.width = 320;
+    cfg.height = 240;
+    tp_init( tp, &cfg, drv, drv_ctx );
+}
+
+/* Records the script from the scripted driver, as from a live controller. */
+static void record( const script_reading_t * readings, uint8_t n_readings )
+{
+    tp_replay_recorder_t recorder;
+    tp_drv_t drv;
+    tp_t tp;
+
+    script.readings = readings;
+    script.n_readings = n_readings;
+    script.next = 0;
+    script.current = NULL;
+
+    tp_replay_recorder_init( &recorder, &script_drv, &script, stream, sizeof( stream ),
+                             script_timestamp, &drv );
+    tp_setup( &tp, &drv, &recorder );
+
+    while ( script.next < script.n_readings )
+        tp_process( &tp );
+
+    TEST_CHECK( 0 == recorder.dropped );
+    TEST_CHECK( n_readings == recorder.records );
+
+    stream_size = recorder.offset;
+}
+
+/* Replays the recorded stream and feeds tracked points to the tracker. */
+static void play( void )
+{
+    tp_tracker_cfg_t cfg;
+    tp_drv_t drv;
+    tp_t tp;
+
+    tp_tracker_cfg_setup( &cfg );
+    tp_tracker_init( &tracker, &cfg );
+    n_updates = 0;
+
+    TEST_CHECK( TP_OK == tp_replay_init( &replay, stream, stream_size, TP_REPLAY_MODE_STEP, NULL, &drv ) );
+    tp_setup( &tp, &drv, &replay );
+    tp_touch_callback_setup( &tp, tracker_callback );
+
+    while ( !tp_replay_is_done( &replay ) )
+        tp_process( &tp );
+}
+
+static void record_and_play( const script_reading_t * readings, uint8_t n_readings )
+{
+    record( readings, n_readings );
+    play( );
+
+    TEST_CHECK( n_readings == n_updates );
+}
+
+/* Checks all recognized gestures, in order. */
+static void check_gestures( const tp_tracker_gesture_t * expected, uint8_t n_expected )
+{
+    uint8_t found = 0;
+    uint8_t idx;
+
+    for ( idx = 0; idx < n_updates; idx++ )
+    {
+        if ( TP_TRACKER_GEST_NONE == gestures[ idx ] )
+            continue;
+
+        TEST_CHECK( found < n_expected );
+        if ( found < n_expected )
+            TEST_CHECK( expected[ found ] == gestures[ idx ] );
+        found++;
+    }
+
+    TEST_CHECK( n_expected == found );
+}
+
+/* Checks that the tracked point is touched at the coordinates. */
+static void check_point( uint8_t update, uint8_t id, tp_coord_t x, tp_coord_t y )
+{
+    tp_tracker_point_t * point = &points[ update ][ id ];
+
+    TEST_CHECK( ( point->event != TP_EVENT_PRESS_NOT_DET ) && ( point->event != TP_EVENT_PRESS_UP ) );
+    TEST_CHECK( x == point->coord_x );
+    TEST_CHECK( y == point->coord_y );
+}
+
+/* === TESTS === */
+
+static void test_tap( void )
+{
+    static const script_reading_t readings[] =
+    {
+        {   0, 1, { 100 }, { 100 } },
+        {  20, 1, { 101 }, { 100 } },
+        { 100, 0, { 0 }, { 0 } },
+        // Second tap close to the first one.
+        { 250, 1, { 103 }, { 101 } },
+        { 300, 1, { 103 }, { 102 } },
+        { 330, 0, { 0 }, { 0 } },
+        // Third tap, too late to pair with the second one.
+        { 900, 1, { 103 }, { 101 } },
+        { 950, 0, { 0 }, { 0 } }
+    };
+    static const tp_tracker_gesture_t expected[] =
+    {
+        TP_TRACKER_GEST_TAP, TP_TRACKER_GEST_DOUBLE_TAP, TP_TRACKER_GEST_TAP
+    };
+
+    record_and_play( readings, sizeof( readings ) / sizeof( readings[ 0 ] ) );
+    check_gestures( expected, sizeof( expected ) / sizeof( expected[ 0 ] ) );
+}
+
+static void test_long_press( void )
+{
+    static const script_reading_t readings[] =
+    {
+        { 1000, 1, { 200 }, { 150 } },
+        { 1200, 1, { 202 }, { 151 } },
+        { 1400, 1, { 201 }, { 149 } },
+        { 1600, 1, { 199 }, { 150 } },
+        { 1800, 1, { 200 }, { 152 } },
+        { 2000, 1, { 201 }, { 150 } },
+        { 2100, 0, { 0 }, { 0 } }
+    };
+    static const tp_tracker_gesture_t expected[] = { TP_TRACKER_GEST_LONG_PRESS };
+
+    record_and_play( readings, sizeof( readings ) / sizeof( readings[ 0 ] ) );
+    check_gestures( expected, sizeof( expected ) / sizeof( expected[ 0 ] ) );
+
+    // Reported once it's held long enough, and release isn't a tap.
+    TEST_CHECK( TP_TRACKER_GEST_LONG_PRESS == gestures[ 4 ] );
+}
+
+static void test_swipe( void )
+{
+    static const script_reading_t readings[] =
+    {
+        {  0, 1, {  50 }, { 200 } },
+        { 20, 1, {  80 }, { 202 } },
+        { 40, 1, { 110 }, { 203 } },
+        { 60, 1, { 140 }, { 203 } },
+        { 80, 1, { 170 }, { 204 } },
+        { 90, 0, { 0 }, { 0 } },
+        { 500, 1, { 160 }, { 220 } },
+        { 520, 1, { 158 }, { 180 } },
+        { 540, 1, { 157 }, { 140 } },
+        { 560, 1, { 157 }, { 100 } },
+        { 570, 0, { 0 }, { 0 } },
+        // Too slow for a swipe.
+        { 1000, 1, { 160 }, { 100 } },
+        { 1300, 1, { 160 }, { 140 } },
+        { 1600, 1, { 160 }, { 180 } },
+        { 1700, 0, { 0 }, { 0 } }
+    };
+    static const tp_tracker_gesture_t expected[] =
+    {
+        TP_TRACKER_GEST_RIGHT, TP_TRACKER_GEST_UP
+    };
+
+    record_and_play( readings, sizeof( readings ) / sizeof( readings[ 0 ] ) );
+    check_gestures( expected, sizeof( expected ) / sizeof( expected[ 0 ] ) );
+}
+
+static void test_pinch( void )
+{
+    static const script_reading_t readings[] =
+    {
+        {   0, 2, { 120, 160 }, { 120, 120 } },
+        {  20, 2, { 170, 110 }, { 120, 120 } },
+        {  40, 2, { 100, 180 }, { 120, 120 } },
+        {  60, 2, { 190,  90 }, { 120, 120 } },
+        {  80, 2, { 100, 180 }, { 120, 120 } },
+        { 100, 2, { 170, 110 }, { 120, 120 } },
+        // Small change is not a zoom.
+        { 120, 2, { 115, 165 }, { 120, 120 } },
+        { 140, 0, { 0 }, { 0 } }
+    };
+    static const tp_tracker_gesture_t expected[] =
+    {
+        TP_TRACKER_GEST_ZOOM_IN, TP_TRACKER_GEST_ZOOM_IN, TP_TRACKER_GEST_ZOOM_IN,
+        TP_TRACKER_GEST_ZOOM_OUT, TP_TRACKER_GEST_ZOOM_OUT
+    };
+
+    record_and_play( readings, sizeof( readings ) / sizeof( readings[ 0 ] ) );
+    check_gestures( expected, sizeof( expected ) / sizeof( expected[ 0 ] ) );
+
+    // Fingers reported in alternating order keep their IDs.
+    check_point( 5, 0, 110, 120 );
+    check_point( 5, 1, 170, 120 );
+}
+
+static void test_rotate( void )
+{
+    // Two fingers 50 pixels from the center, turned by 20 degrees each
+    // reading, reported in alternating order.
+    static const script_reading_t readings[] =
+    {
+        {  0, 2, { 110, 210 }, { 120, 120 } },
+        { 20, 2, { 207, 113 }, { 137, 103 } },
+        { 40, 2, { 122, 198 }, {  88, 152 } },
+        { 60, 2, { 185, 135 }, { 163,  77 } },
+        { 80, 2, { 122, 198 }, {  88, 152 } },
+        { 90, 0, { 0 }, { 0 } }
+    };
+    static const tp_tracker_gesture_t expected[] =
+    {
+        TP_TRACKER_GEST_ROTATE_CW, TP_TRACKER_GEST_ROTATE_CW, TP_TRACKER_GEST_ROTATE_CW,
+        TP_TRACKER_GEST_ROTATE_CCW
+    };
+
+    record_and_play( readings, sizeof( readings ) / sizeof( readings[ 0 ] ) );
+    check_gestures( expected, sizeof( expected ) / sizeof( expected[ 0 ] ) );
+}
+
+static void test_ids( void )
+{
+    // Finger A moves right, finger B moves up, in alternating report order.
+    // Finger C is added, then A is lifted and finger D takes its free ID.
+    static const script_reading_t readings[] =
+    {
+        {  0, 2, {  50, 250 }, {  50, 200 } },
+        { 10, 2, { 250,  60 }, { 190,  50 } },
+        { 20, 2, {  70, 250 }, {  50, 180 } },
+        { 30, 2, { 250,  80 }, { 170,  50 } },
+        { 40, 3, { 150,  90, 250 }, { 120, 50, 160 } },
+        { 50, 3, { 250, 150, 100 }, { 150, 121, 50 } },
+        { 60, 2, { 150, 250 }, { 122, 140 } },
+        { 70, 2, { 250, 150 }, { 130, 123 } },
+        { 80, 3, {  30, 250, 150 }, { 30, 120, 124 } },
+        { 90, 0, { 0 }, { 0 } }
+    };
+
+    record_and_play( readings, sizeof( readings ) / sizeof( readings[ 0 ] ) );
+
+    TEST_CHECK( TP_EVENT_PRESS_DOWN == points[ 0 ][ 0 ].event );
+    TEST_CHECK( TP_EVENT_PRESS_DOWN == points[ 0 ][ 1 ].event );
+    check_point( 0, 0, 50, 50 );
+    check_point( 0, 1, 250, 200 );
+    check_point( 1, 0, 60, 50 );
+    check_point( 1, 1, 250, 190 );
+    check_point( 3, 0, 80, 50 );
+    check_point( 3, 1, 250, 170 );
+
+    // New finger gets the lowest free ID.
+    TEST_CHECK( TP_EVENT_PRESS_DOWN == points[ 4 ][ 2 ].event );
+    check_point( 4, 0, 90, 50 );
+    check_point( 4, 1, 250, 160 );
+    check_point( 4, 2, 150, 120 );
+    check_point( 5, 0, 100, 50 );
+    check_point( 5, 1, 250, 150 );
+    check_point( 5, 2, 150, 121 );
+
+    // Lifted finger is released, the others keep their IDs.
+    TEST_CHECK( TP_EVENT_PRESS_UP == points[ 6 ][ 0 ].event );
+    check_point( 6, 1, 250, 140 );
+    check_point( 6, 2, 150, 122 );
+    TEST_CHECK( TP_EVENT_PRESS_NOT_DET == points[ 7 ][ 0 ].event );
+    check_point( 7, 1, 250, 130 );
+    check_point( 7, 2, 150, 123 );
+
+    TEST_CHECK( TP_EVENT_PRESS_DOWN == points[ 8 ][ 0 ].event );
+    check_point( 8, 0, 30, 30 );
+    check_point( 8, 1, 250, 120 );
+    check_point( 8, 2, 150, 124 );
+
+    // Velocity, in pixels per 1000 time units, converges to the movement.
+    TEST_CHECK( points[ 5 ][ 0 ].velocity_x > 900 );
+    TEST_CHECK( points[ 5 ][ 0 ].velocity_x <= 1000 );
+    TEST_CHECK( 0 == points[ 5 ][ 0 ].velocity_y );
+    TEST_CHECK( points[ 8 ][ 1 ].velocity_y < -900 );
+    TEST_CHECK( 0 == points[ 8 ][ 1 ].velocity_x );
+
+    // All released, last velocity is kept.
+    TEST_CHECK( TP_EVENT_PRESS_UP == points[ 9 ][ 1 ].event );
+    TEST_CHECK( points[ 9 ][ 1 ].velocity_y < -900 );
+}
+
+int main( void )
+{
+    test_tap( );
+    test_long_press( );
+    test_swipe( );
+    test_pinch( );
+    test_rotate( );
+    test_ids( );
+
+    return TEST_RESULT( "tp_tracker" );
+}
@@ -0,0 +1,311 @@
+#include "vtft_host.h"
+#include "test_check.h"
+#include <string.h>
+
+/* === SCREEN === */
+
+#define BOX_WIDTH      40
+#define BOX_HEIGHT     30
+
+static vtft_t vtft;
+static vtft_box boxes[ 2 ];
+static vtft_component * components[ 2 ];
+static vtft_screen screen;
+
+static void screen_setup( void )
+{
+    uint8_t idx;
+
+    for ( idx = 0; idx < 2; idx++ )
+    {
+        vtft_box * box = &boxes[ idx ];
+
+        memset( box, 0, sizeof( *box ) );
+        box->type = VTFT_COMPONENT_BOX;
+        box->order = idx;
+        box->visible = 1;
+        box->left = 10;
+        box->top = 20 + idx * 100;
+        box->width = BOX_WIDTH;
+        box->height = BOX_HEIGHT;
+        box->pen.width = 1;
+        box->pen.color = GL_BLACK;
+        box->press_gradient.start_color = GL_WHITE;
+        components[ idx ] = ( vtft_component * )box;
+    }
+
+    screen.width = 320;
+    screen.height = 240;
+    screen.color = GL_WHITE;
+    screen.components = components;
+    screen.component_count = 2;
+}
+
+/* Advances the clock by one animation frame and processes it. */
+static void next_frame( void )
+{
+    vtft_host_time += VTFT_ANIMATION_FRAME_PERIOD;
+    vtft_process( &vtft );
+}
+
+/* === TWEENS === */
+
+static uint32_t done_count;
+
+static void tween_done( vtft_tween * tween )
+{
+    ( void )tween;
+    done_count++;
+}
+
+static void tween_setup( vtft_tween * tween, vtft_component * component, vtft_tween_property property,
+                         int32_t from, int32_t to, uint32_t duration, vtft_easing easing )
+{
+    memset( tween, 0, sizeof( *tween ) );
+    tween->component = component;
+    tween->property = property;
+    tween->from = from;
+    tween->to = to;
+    tween->duration = duration;
+    tween->easing = easing;
+    tween->done = tween_done;
+}
+
+/* === LINEAR MOVE === */
+
+#define MOVE_FRAMES    10
+#define MOVE_DISTANCE  200
+
+static void check_move( void )
+{
+    vtft_box * box = &boxes[ 0 ];
+    vtft_tween tween;
+    vtft_coord_t previous = box->left;
+    int32_t ideal;
+    uint8_t frame;
+
+    tween_setup( &tween, components[ 0 ], VTFT_TWEEN_LEFT, 10, 10 + MOVE_DISTANCE,
+                 MOVE_FRAMES * VTFT_ANIMATION_FRAME_PERIOD, VTFT_EASING_LINEAR );
+    done_count = 0;
+    vtft_start_tween( &vtft, &tween );
+    TEST_CHECK( tween.running );
+
+    for ( frame = 1; frame <= MOVE_FRAMES; frame++ )
+    {
+        vtft_host_reset_counters( );
+        next_frame( );
+
+        // Box follows the line, rounded down.
+        ideal = 10 + MOVE_DISTANCE * frame / MOVE_FRAMES;
+        TEST_CHECK( box->left <= ideal );
+        TEST_CHECK( box->left >= ideal - 1 );
+
+        // Background and box are redrawn where the box was and where it is now, nowhere else.
+        TEST_CHECK( gl_counters.pixels >= 3u * BOX_WIDTH * BOX_HEIGHT );
+        TEST_CHECK( gl_counters.pixels <= 4u * ( BOX_WIDTH + MOVE_DISTANCE / MOVE_FRAMES ) * BOX_HEIGHT );
+        TEST_CHECK( box->left > previous );
+        previous = box->left;
+    }
+
+    // Last frame applies the final value exactly and ends the tween.
+    TEST_CHECK( 10 + MOVE_DISTANCE == box->left );
+    TEST_CHECK( !tween.running );
+    TEST_CHECK( 1 == done_count );
+    TEST_CHECK( 0 == vtft.tweens );
+
+    // Nothing is drawn once it's done.
+    vtft_host_reset_counters( );
+    next_frame( );
+    TEST_CHECK( 0 == gl_counters.pixels );
+}
+
+/* === EASING === */
+
+/*
+ * Custom tweens from 0 to 1000 record the applied values, sampled at every
+ * sixteenth of the duration.
+ */
+
+#define EASE_SCALE     1000
+#define EASE_STEPS     16
+#define EASE_DURATION  ( EASE_STEPS * VTFT_ANIMATION_FRAME_PERIOD )
+
+static int32_t eased[ 4 ];
+
+static void ease_step( vtft_tween * tween, int32_t value )
+{
+    eased[ tween->easing ] = value;
+}
+
+/* Cubic curve of the given easing at the given step, scaled. */
+static int32_t ease_ideal( vtft_easing easing, uint8_t step )
+{
+    int32_t rest = EASE_STEPS - step;
+
+    switch ( easing )
+    {
+        case VTFT_EASING_IN:
+            return EASE_SCALE * step * step * step / ( EASE_STEPS * EASE_STEPS * EASE_STEPS );
+
+        case VTFT_EASING_OUT:
+            return EASE_SCALE - EASE_SCALE * rest * rest * rest / ( EASE_STEPS * EASE_STEPS * EASE_STEPS );
+
+        case VTFT_EASING_IN_OUT:
+            if ( 2 * step < EASE_STEPS )
+                return 4 * EASE_SCALE * step * step * step / ( EASE_STEPS * EASE_STEPS * EASE_STEPS );
+            else
+                return EASE_SCALE - 4 * EASE_SCALE * rest * rest * rest / ( EASE_STEPS * EASE_STEPS * EASE_STEPS );
+
+        default:
+            return EASE_SCALE * step / EASE_STEPS;
+    }
+}
+
+static void check_easing( void )
+{
+    vtft_tween tweens[ 4 ];
+    int32_t previous[ 4 ];
+    int32_t ideal;
+    uint8_t easing;
+    uint8_t step;
+
+    for ( easing = VTFT_EASING_LINEAR; easing <= VTFT_EASING_IN_OUT; easing++ )
+    {
+        tween_setup( &tweens[ easing ], 0, VTFT_TWEEN_CUSTOM, 0, EASE_SCALE, EASE_DURATION,
+                     ( vtft_easing )easing );
+        tweens[ easing ].step = ease_step;
+        previous[ easing ] = 0;
+    }
+    done_count = 0;
+    vtft_start_timeline( &vtft, tweens, 4 );
+
+    for ( step = 1; step <= EASE_STEPS; step++ )
+    {
+        next_frame( );
+
+        for ( easing = VTFT_EASING_LINEAR; easing <= VTFT_EASING_IN_OUT; easing++ )
+        {
+            // Table of the curve is within a percent of the cubic, and never goes back.
+            ideal = ease_ideal( ( vtft_easing )easing, step );
+            TEST_CHECK( eased[ easing ] >= ideal - EASE_SCALE / 100 );
+            TEST_CHECK( eased[ easing ] <= ideal + EASE_SCALE / 100 );
+            TEST_CHECK( eased[ easing ] >= previous[ easing ] );
+            previous[ easing ] = eased[ easing ];
+        }
+    }
+
+    // Slow start, slow end, and both.
+    for ( easing = VTFT_EASING_LINEAR; easing <= VTFT_EASING_IN_OUT; easing++ )
+    {
+        TEST_CHECK( EASE_SCALE == eased[ easing ] );
+        TEST_CHECK( !tweens[ easing ].running );
+    }
+    TEST_CHECK( 4 == done_count );
+}
+
+/* === TIMELINE === */
+
+static void check_timeline( void )
+{
+    vtft_box * box = &boxes[ 1 ];
+    vtft_tween tweens[ 2 ];
+    vtft_animation_stats stats;
+    uint8_t frame;
+
+    // Box moves right, then down after a delay of 3 frames.
+    tween_setup( &tweens[ 0 ], components[ 1 ], VTFT_TWEEN_LEFT, 10, 50,
+                 2 * VTFT_ANIMATION_FRAME_PERIOD, VTFT_EASING_LINEAR );
+    tween_setup( &tweens[ 1 ], components[ 1 ], VTFT_TWEEN_TOP, 120, 180,
+                 2 * VTFT_ANIMATION_FRAME_PERIOD, VTFT_EASING_OUT );
+    tweens[ 1 ].delay = 3 * VTFT_ANIMATION_FRAME_PERIOD;
+    done_count = 0;
+    vtft_reset_animation_stats( &vtft );
+    vtft_start_timeline( &vtft, tweens, 2 );
+
+    for ( frame = 1; frame <= 3; frame++ )
+    {
+        next_frame( );
+
+        // Processing again within the frame period doesn't step.
+        vtft_host_time += VTFT_ANIMATION_FRAME_PERIOD / 2;
+        vtft_process( &vtft );
+        vtft_host_time -= VTFT_ANIMATION_FRAME_PERIOD / 2;
+
+        TEST_CHECK( 120 == box->top );
+    }
+    TEST_CHECK( 50 == box->left );
+    TEST_CHECK( 1 == done_count );
+
+    next_frame( );
+    TEST_CHECK( box->top > 120 );
+    TEST_CHECK( box->top < 180 );
+    next_frame( );
+    TEST_CHECK( 180 == box->top );
+    TEST_CHECK( 2 == done_count );
+
+    vtft_get_animation_stats( &vtft, &stats );
+    TEST_CHECK( 5 == stats.frames );
+    TEST_CHECK( 0 == stats.deferred_frames );
+}
+
+/* === STOP === */
+
+static void check_stop( void )
+{
+    vtft_box * box = &boxes[ 0 ];
+    vtft_tween tween;
+    vtft_coord_t left;
+
+    tween_setup( &tween, components[ 0 ], VTFT_TWEEN_COLOR, GL_WHITE, GL_BLACK,
+                 4 * VTFT_ANIMATION_FRAME_PERIOD, VTFT_EASING_LINEAR );
+    tween.color = &box->press_gradient.start_color;
+    done_count = 0;
+    vtft_start_tween( &vtft, &tween );
+    next_frame( );
+
+    // Color is between the two, both channels going down together.
+    TEST_CHECK( GL_WHITE != box->press_gradient.start_color );
+    TEST_CHECK( GL_BLACK != box->press_gradient.start_color );
+
+    // Stopping without finishing keeps the color.
+    vtft_stop_tween( &vtft, &tween, 0 );
+    TEST_CHECK( GL_WHITE != box->press_gradient.start_color );
+    TEST_CHECK( GL_BLACK != box->press_gradient.start_color );
+    TEST_CHECK( !tween.running );
+
+    // Finishing applies the final value at once.
+    vtft_start_tween( &vtft, &tween );
+    vtft_stop_tween( &vtft, &tween, 1 );
+    TEST_CHECK( GL_BLACK == box->press_gradient.start_color );
+    TEST_CHECK( 0 == done_count );
+    TEST_CHECK( 0 == vtft.tweens );
+
+    // Stopped tween isn't stepped any more.
+    tween_setup( &tween, components[ 0 ], VTFT_TWEEN_LEFT, box->left, box->left + 50,
+                 4 * VTFT_ANIMATION_FRAME_PERIOD, VTFT_EASING_LINEAR );
+    left = box->left;
+    vtft_start_tween( &vtft, &tween );
+    vtft_stop_tween( &vtft, &tween, 0 );
+    next_frame( );
+    next_frame( );
+    TEST_CHECK( left == box->left );
+}
+
+int main( void )
+{
+    gl_driver_t driver;
+
+    vtft_host_count_driver( &driver );
+    gl_set_driver( &driver );
+    vtft_host_init( &vtft );
+    screen_setup( );
+    vtft_set_current_screen( &vtft, &screen );
+    vtft_process( &vtft );
+
+    check_move( );
+    check_easing( );
+    check_timeline( );
+    check_stop( );
+
+    return TEST_RESULT( "vtft_animation" );
+}
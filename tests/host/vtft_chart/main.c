@@ -0,0 +1,293 @@
+#include "vtft_host.h"
+#include "test_check.h"
+#include <string.h>
+
+/* === SCREEN === */
+
+/*
+ * Chart of two samples per column, on a screen of another color so that
+ * anything drawn outside of the chart shows.
+ */
+
+#define CHART_LEFT     20
+#define CHART_TOP      40
+#define CHART_WIDTH    100
+#define CHART_HEIGHT   51
+#define CHART_MIN      0
+#define CHART_MAX      100
+#define COLUMN_SAMPLES 2
+#define CAPACITY       ( CHART_WIDTH * COLUMN_SAMPLES + 1 )
+
+#define DISPLAY_WIDTH  320
+#define DISPLAY_HEIGHT 240
+
+static vtft_t vtft;
+static gl_driver_t driver;
+
+static int16_t samples[ CAPACITY ];
+static vtft_chart chart;
+static vtft_component * components[ 1 ];
+static vtft_screen screen;
+
+static void screen_setup( void )
+{
+    memset( &chart, 0, sizeof( chart ) );
+    chart.type = VTFT_COMPONENT_CHART;
+    chart.visible = 1;
+    chart.left = CHART_LEFT;
+    chart.top = CHART_TOP;
+    chart.width = CHART_WIDTH;
+    chart.height = CHART_HEIGHT;
+    chart.back_color = GL_WHITE;
+    chart.trace_color = GL_RED;
+    chart.min_value = CHART_MIN;
+    chart.max_value = CHART_MAX;
+    chart.samples_per_column = COLUMN_SAMPLES;
+    chart.samples = samples;
+    chart.capacity = CAPACITY;
+    components[ 0 ] = ( vtft_component * )&chart;
+
+    screen.width = DISPLAY_WIDTH;
+    screen.height = DISPLAY_HEIGHT;
+    screen.color = GL_BLACK;
+    screen.components = components;
+    screen.component_count = 1;
+}
+
+// Sawtooth which also goes past both limits of the chart.
+static int16_t sample_at( uint32_t idx )
+{
+    return ( int16_t )( ( idx * 7 ) % 140 ) - 20;
+}
+
+// Display row of the given value, as drawn by the chart.
+static gl_coord_t row_of( int16_t value )
+{
+    if ( value <= CHART_MIN )
+        return CHART_TOP + CHART_HEIGHT - 1;
+    if ( value >= CHART_MAX )
+        return CHART_TOP;
+
+    return CHART_TOP + CHART_HEIGHT - 1 - ( value - CHART_MIN ) * ( CHART_HEIGHT - 1 ) / ( CHART_MAX - CHART_MIN );
+}
+
+/* === DRIVER === */
+
+/*
+ * Counting driver which also keeps the drawn pixels, and moves them as
+ * displays with a frame buffer do.
+ */
+
+static gl_color_t display[ DISPLAY_HEIGHT ][ DISPLAY_WIDTH ];
+static gl_color_t redrawn[ CHART_HEIGHT ][ CHART_WIDTH ];
+static gl_fill_t count_fill;
+static uint32_t copies;
+
+static void record_fill( gl_rectangle_t * rect, gl_color_t color )
+{
+    gl_coord_t x;
+    gl_coord_t y;
+
+    for ( y = rect->top_left.y; y < rect->top_left.y + rect->height; y++ )
+    {
+        for ( x = rect->top_left.x; x < rect->top_left.x + rect->width; x++ )
+        {
+            if ( ( x >= 0 ) && ( x < DISPLAY_WIDTH ) && ( y >= 0 ) && ( y < DISPLAY_HEIGHT ) )
+                display[ y ][ x ] = color;
+        }
+    }
+
+    count_fill( rect, color );
+}
+
+static void record_copy( gl_rectangle_t * src, gl_coord_t x, gl_coord_t y )
+{
+    gl_coord_t row;
+
+    copies++;
+
+    // Copied row by row, moved area may overlap the source.
+    for ( row = 0; row < src->height; row++ )
+    {
+        memmove( &display[ y + row ][ x ], &display[ src->top_left.y + row ][ src->top_left.x ],
+                 src->width * sizeof( gl_color_t ) );
+    }
+}
+
+static void reset_drawn( void )
+{
+    copies = 0;
+    vtft_host_reset_counters( );
+}
+
+// Checks that the chart on the display is the same as when it's redrawn whole.
+static bool same_as_redrawn( void )
+{
+    gl_coord_t row;
+
+    for ( row = 0; row < CHART_HEIGHT; row++ )
+    {
+        memcpy( redrawn[ row ], &display[ CHART_TOP + row ][ CHART_LEFT ], sizeof( redrawn[ row ] ) );
+    }
+
+    vtft_draw_component( &vtft, ( vtft_component * )&chart );
+
+    for ( row = 0; row < CHART_HEIGHT; row++ )
+    {
+        if ( memcmp( redrawn[ row ], &display[ CHART_TOP + row ][ CHART_LEFT ], sizeof( redrawn[ row ] ) ) )
+            return false;
+    }
+
+    return true;
+}
+
+// Checks that nothing was drawn outside of the chart.
+static bool screen_kept( void )
+{
+    gl_coord_t x;
+    gl_coord_t y;
+
+    for ( y = 0; y < DISPLAY_HEIGHT; y++ )
+    {
+        for ( x = 0; x < DISPLAY_WIDTH; x++ )
+        {
+            if ( ( x >= CHART_LEFT ) && ( x < CHART_LEFT + CHART_WIDTH ) &&
+                 ( y >= CHART_TOP ) && ( y < CHART_TOP + CHART_HEIGHT ) )
+                continue;
+            if ( display[ y ][ x ] != GL_BLACK )
+                return false;
+        }
+    }
+
+    return true;
+}
+
+// Adds the given number of whole columns, continuing the sawtooth.
+static void add_columns( uint32_t count )
+{
+    uint32_t idx;
+
+    for ( idx = 0; idx < count * COLUMN_SAMPLES; idx++ )
+    {
+        vtft_add_chart_sample( &vtft, &chart, sample_at( chart.sample_count ) );
+    }
+}
+
+/* === TESTS === */
+
+static void check_sweep( void )
+{
+    uint32_t last;
+
+    vtft_set_current_screen( &vtft, &screen );
+    TEST_CHECK( GL_WHITE == display[ CHART_TOP ][ CHART_LEFT ] );
+
+    // Half of a column draws nothing, the other half draws only that column.
+    reset_drawn( );
+    vtft_add_chart_sample( &vtft, &chart, 10 );
+    TEST_CHECK( 0 == gl_counters.fills );
+    vtft_add_chart_sample( &vtft, &chart, 30 );
+    TEST_CHECK( 2 == gl_counters.fills );
+    TEST_CHECK( ( uint32_t )( CHART_HEIGHT + row_of( 10 ) - row_of( 30 ) + 1 ) == gl_counters.pixels );
+    TEST_CHECK( GL_RED == display[ row_of( 10 ) ][ CHART_LEFT ] );
+    TEST_CHECK( GL_RED == display[ row_of( 30 ) ][ CHART_LEFT ] );
+    TEST_CHECK( GL_WHITE == display[ row_of( 30 ) - 1 ][ CHART_LEFT ] );
+
+    // Next column is joined with the last sample of the previous one.
+    vtft_add_chart_sample( &vtft, &chart, 80 );
+    vtft_add_chart_sample( &vtft, &chart, 90 );
+    TEST_CHECK( GL_RED == display[ row_of( 50 ) ][ CHART_LEFT + 1 ] );
+    TEST_CHECK( GL_WHITE == display[ row_of( 20 ) ][ CHART_LEFT + 1 ] );
+
+    // Past the right edge new columns replace the oldest ones, one by one.
+    reset_drawn( );
+    add_columns( CHART_WIDTH + CHART_WIDTH / 2 );
+    TEST_CHECK( 0 == copies );
+    TEST_CHECK( 2 * ( CHART_WIDTH + CHART_WIDTH / 2 ) == gl_counters.fills );
+    TEST_CHECK( gl_counters.pixels < ( CHART_WIDTH + CHART_WIDTH / 2 ) * 2 * CHART_HEIGHT );
+
+    last = chart.sample_count / COLUMN_SAMPLES - 1;
+    TEST_CHECK( GL_RED == display[ row_of( sample_at( chart.sample_count - 1 ) ) ][ CHART_LEFT + last % CHART_WIDTH ] );
+    TEST_CHECK( same_as_redrawn( ) );
+    TEST_CHECK( screen_kept( ) );
+}
+
+static void check_scroll( void )
+{
+    gl_coord_t row;
+
+    chart.scroll = 1;
+    vtft_clear_chart( &vtft, &chart );
+    TEST_CHECK( 0 == chart.sample_count );
+    for ( row = CHART_TOP; row < CHART_TOP + CHART_HEIGHT; row++ )
+    {
+        TEST_CHECK( GL_WHITE == display[ row ][ CHART_LEFT + CHART_WIDTH / 2 ] );
+    }
+
+    // Trace is moved by a column and the new one is drawn at the right edge.
+    reset_drawn( );
+    add_columns( CHART_WIDTH + CHART_WIDTH / 2 );
+    TEST_CHECK( chart.scroll );
+    TEST_CHECK( CHART_WIDTH + CHART_WIDTH / 2 == copies );
+    TEST_CHECK( 2 * ( CHART_WIDTH + CHART_WIDTH / 2 ) == gl_counters.fills );
+    TEST_CHECK( gl_counters.pixels < ( CHART_WIDTH + CHART_WIDTH / 2 ) * 2 * CHART_HEIGHT );
+
+    TEST_CHECK( GL_RED == display[ row_of( sample_at( chart.sample_count - 1 ) ) ][ CHART_LEFT + CHART_WIDTH - 1 ] );
+    TEST_CHECK( same_as_redrawn( ) );
+    TEST_CHECK( screen_kept( ) );
+}
+
+static void check_scroll_without_copy( void )
+{
+    // Driver which can't move areas turns the chart into a sweeping one, redrawn once.
+    driver.copy_rect_f = NULL;
+    gl_set_driver( &driver );
+
+    reset_drawn( );
+    add_columns( 1 );
+    TEST_CHECK( !chart.scroll );
+    TEST_CHECK( gl_counters.pixels >= CHART_WIDTH * CHART_HEIGHT );
+    TEST_CHECK( same_as_redrawn( ) );
+
+    reset_drawn( );
+    add_columns( 3 );
+    TEST_CHECK( 6 == gl_counters.fills );
+    TEST_CHECK( gl_counters.pixels < 3 * 2 * CHART_HEIGHT );
+    TEST_CHECK( same_as_redrawn( ) );
+    TEST_CHECK( screen_kept( ) );
+
+    driver.copy_rect_f = record_copy;
+    gl_set_driver( &driver );
+}
+
+static void check_hidden( void )
+{
+    // Hidden chart keeps its samples without drawing them.
+    chart.visible = 0;
+    reset_drawn( );
+    add_columns( 10 );
+    TEST_CHECK( 0 == gl_counters.fills );
+
+    chart.visible = 1;
+    vtft_draw_component( &vtft, ( vtft_component * )&chart );
+    TEST_CHECK( GL_RED == display[ row_of( sample_at( chart.sample_count - 1 ) ) ][ CHART_LEFT + ( chart.sample_count / COLUMN_SAMPLES - 1 ) % CHART_WIDTH ] );
+    TEST_CHECK( same_as_redrawn( ) );
+}
+
+int main( void )
+{
+    vtft_host_count_driver( &driver );
+    count_fill = driver.fill_f;
+    driver.fill_f = record_fill;
+    driver.copy_rect_f = record_copy;
+    gl_set_driver( &driver );
+    vtft_host_init( &vtft );
+    screen_setup( );
+
+    check_sweep( );
+    check_scroll( );
+    check_scroll_without_copy( );
+    check_hidden( );
+
+    return TEST_RESULT( "vtft_chart" );
+}
@@ -0,0 +1,118 @@
+#include "vtft_host.h"
+#include "test_check.h"
+#include <string.h>
+
+/* Touch event handler of the library, as called by tp_process. */
+extern void _tp_event_handler( tp_event_t event, tp_coord_t x, tp_coord_t y, tp_touch_id_t i );
+
+/* === SCREEN === */
+
+static vtft_t vtft;
+static vtft_box box;
+static vtft_component * components[ 1 ];
+static vtft_screen screen;
+
+static uint32_t downs;
+static uint32_t ups;
+static bool pressed;
+static uint32_t unreleased;
+
+static void box_down( void )
+{
+    // Down while still pressed means the previous release was lost.
+    if ( pressed )
+        unreleased++;
+
+    pressed = true;
+    downs++;
+}
+
+static void box_up( void )
+{
+    pressed = false;
+    ups++;
+}
+
+static void screen_setup( void )
+{
+    memset( &box, 0, sizeof( box ) );
+    box.type = VTFT_COMPONENT_BOX;
+    box.visible = 1;
+    box.active = 1;
+    box.width = 320;
+    box.height = 240;
+    box.event_set.down_event = box_down;
+    box.event_set.up_event = box_up;
+    components[ 0 ] = ( vtft_component * )&box;
+
+    screen.width = 320;
+    screen.height = 240;
+    screen.color = GL_WHITE;
+    screen.components = components;
+    screen.component_count = 1;
+}
+
+/* === BURSTS === */
+
+#define BURSTS         50
+#define BURST_TAPS     5
+
+/*
+ * Reports the given number of taps at once, the first one with the given
+ * number of moves, so the queue fills up at a down event as well as at an up.
+ */
+static void report_burst( uint8_t taps, uint8_t moves )
+{
+    uint8_t tap;
+    uint8_t move;
+
+    for ( tap = 0; tap < taps; tap++ )
+    {
+        _tp_event_handler( TP_EVENT_PRESS_DOWN, 100, 100, TP_TOUCH_ID_0 );
+        for ( move = 0; move < ( tap ? 0 : moves ); move++ )
+        {
+            _tp_event_handler( TP_EVENT_PRESS_MOVE, 100 + move, 100, TP_TOUCH_ID_0 );
+        }
+        _tp_event_handler( TP_EVENT_PRESS_UP, 100, 100, TP_TOUCH_ID_0 );
+    }
+}
+
+int main( void )
+{
+    vtft_event_stats stats;
+    gl_driver_t driver;
+    uint16_t burst;
+
+    vtft_host_count_driver( &driver );
+    gl_set_driver( &driver );
+    vtft_host_init( &vtft );
+    screen_setup( );
+    vtft_set_current_screen( &vtft, &screen );
+
+    // Library takes the events once it's processed.
+    vtft_process( &vtft );
+
+    for ( burst = 0; burst < BURSTS; burst++ )
+    {
+        report_burst( BURST_TAPS + burst % VTFT_EVENT_QUEUE_SIZE, burst % 3 );
+        vtft_process( &vtft );
+
+        TEST_CHECK( !pressed );
+        TEST_CHECK( 0 == vtft.pen_down );
+        TEST_CHECK( 0 == vtft.pressed_component );
+    }
+
+    vtft_get_event_stats( &vtft, &stats );
+    printf( "%lu downs, %lu ups, %lu queued, %lu coalesced, %lu dropped\n", ( unsigned long )downs,
+            ( unsigned long )ups, ( unsigned long )stats.queued, ( unsigned long )stats.coalesced,
+            ( unsigned long )stats.dropped );
+
+    // Queue overflows, but every handled press is released.
+    TEST_CHECK( stats.dropped > 0 );
+    TEST_CHECK( downs > BURSTS );
+    TEST_CHECK( 0 == unreleased );
+    TEST_CHECK( ups >= downs );
+    TEST_CHECK( stats.queued == stats.processed );
+
+    return TEST_RESULT( "vtft_events" );
+}
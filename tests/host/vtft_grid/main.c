@@ -0,0 +1,208 @@
+#include "vtft_host.h"
+#include "test_check.h"
+#include <string.h>
+
+/* Touch event handler of the library, as called by tp_process. */
+extern void _tp_event_handler( tp_event_t event, tp_coord_t x, tp_coord_t y, tp_touch_id_t i );
+
+/* === SCREENS === */
+
+#define BOX_COLUMNS    12
+#define BOX_ROWS       10
+#define BOX_COUNT      ( BOX_COLUMNS * BOX_ROWS )
+#define BOX_PITCH_X    26
+#define BOX_PITCH_Y    24
+#define BOX_WIDTH      24
+#define BOX_HEIGHT     22
+#define STACK_COUNT    150
+
+static vtft_t vtft;
+static vtft_box boxes[ STACK_COUNT ];
+static vtft_component * components[ STACK_COUNT ];
+static vtft_screen grid_screen;
+static vtft_screen stack_screen;
+static vtft_screen * screen;
+
+static const vtft_active_component * touched;
+
+static void box_down( void )
+{
+    touched = vtft.current_active_component;
+}
+
+static void box_setup( vtft_box * box, uint16_t order, vtft_coord_t left, vtft_coord_t top,
+                       vtft_ucoord_t width, vtft_ucoord_t height )
+{
+    memset( box, 0, sizeof( *box ) );
+    box->type = VTFT_COMPONENT_BOX;
+    box->order = order;
+    box->visible = 1;
+    box->active = 1;
+    box->left = left;
+    box->top = top;
+    box->width = width;
+    box->height = height;
+    box->event_set.down_event = box_down;
+    box->pen.width = 1;
+    box->pen.color = GL_BLACK;
+    box->press_gradient.start_color = GL_WHITE;
+    box->press_gradient.press_start_color = GL_SILVER;
+    components[ order ] = ( vtft_component * )box;
+}
+
+/*
+ * Background box covering the whole display, with small boxes over it,
+ * as on a screen of many buttons and labels.
+ */
+static void grid_screen_setup( void )
+{
+    uint16_t idx;
+
+    box_setup( &boxes[ 0 ], 0, 0, 0, 320, 240 );
+    for ( idx = 0; idx < BOX_COUNT; idx++ )
+    {
+        box_setup( &boxes[ idx + 1 ], idx + 1, ( idx % BOX_COLUMNS ) * BOX_PITCH_X,
+                   ( idx / BOX_COLUMNS ) * BOX_PITCH_Y, BOX_WIDTH, BOX_HEIGHT );
+    }
+
+    grid_screen.width = 320;
+    grid_screen.height = 240;
+    grid_screen.color = GL_WHITE;
+    grid_screen.components = components;
+    grid_screen.component_count = BOX_COUNT + 1;
+    screen = &grid_screen;
+}
+
+/* Boxes stacked over the whole display, each one listed in every cell. */
+static void stack_screen_setup( void )
+{
+    uint16_t idx;
+
+    for ( idx = 0; idx < STACK_COUNT; idx++ )
+    {
+        box_setup( &boxes[ idx ], idx, 0, 0, 320, 240 );
+    }
+
+    stack_screen.width = 320;
+    stack_screen.height = 240;
+    stack_screen.color = GL_WHITE;
+    stack_screen.components = components;
+    stack_screen.component_count = STACK_COUNT;
+    screen = &stack_screen;
+}
+
+/* === TOUCH === */
+
+/* Frontmost box at the given point, found by scanning all components. */
+static const vtft_active_component * scan_box( tp_coord_t x, tp_coord_t y )
+{
+    int16_t idx;
+
+    for ( idx = screen->component_count - 1; idx >= 0; idx-- )
+    {
+        const vtft_box * box = ( const vtft_box * )components[ idx ];
+
+        if ( ( x >= box->left ) && ( x < box->left + box->width ) &&
+             ( y >= box->top ) && ( y < box->top + box->height ) )
+            return ( const vtft_active_component * )box;
+    }
+
+    return 0;
+}
+
+/* Taps the given point and checks that the box found by scanning is pressed. */
+static void check_tap( tp_coord_t x, tp_coord_t y )
+{
+    touched = 0;
+    _tp_event_handler( TP_EVENT_PRESS_DOWN, x, y, TP_TOUCH_ID_0 );
+    _tp_event_handler( TP_EVENT_PRESS_UP, x, y, TP_TOUCH_ID_0 );
+    vtft_process( &vtft );
+
+    TEST_CHECK( 0 != touched );
+    TEST_CHECK( scan_box( x, y ) == touched );
+}
+
+static void check_grid_screen( void )
+{
+    uint16_t idx;
+
+    grid_screen_setup( );
+    vtft_set_current_screen( &vtft, screen );
+    vtft_process( &vtft );
+
+    printf( "%u components, %u grid entries of %u\n", screen->component_count,
+            vtft_get_touch_grid_entries( &vtft ), VTFT_TOUCH_GRID_ENTRIES );
+
+    // Whole screen fits the grid.
+    TEST_CHECK( vtft.touch_grid.valid );
+    TEST_CHECK( vtft_get_touch_grid_entries( &vtft ) > screen->component_count );
+    TEST_CHECK( vtft_get_touch_grid_entries( &vtft ) <= VTFT_TOUCH_GRID_ENTRIES );
+
+    // Corners and middle of every box, and the gap after it.
+    for ( idx = 1; idx <= BOX_COUNT; idx++ )
+    {
+        const vtft_box * box = &boxes[ idx ];
+
+        check_tap( box->left, box->top );
+        check_tap( box->left + BOX_WIDTH / 2, box->top + BOX_HEIGHT / 2 );
+        check_tap( box->left + BOX_WIDTH - 1, box->top + BOX_HEIGHT - 1 );
+        check_tap( box->left + BOX_WIDTH, box->top + BOX_HEIGHT );
+    }
+
+    // Right of the last column only the background is hit.
+    check_tap( 319, 0 );
+    check_tap( 319, 239 );
+}
+
+/* === REDRAWING === */
+
+#define REDRAWN_BOX    100
+
+static void check_component_redraw( void )
+{
+    const vtft_box * box = &boxes[ REDRAWN_BOX ];
+
+    // Component far down the list is redrawn on its own, not with the whole screen.
+    vtft_host_reset_counters( );
+    vtft_invalidate_component( &vtft, ( const vtft_component * )box );
+    vtft_update( &vtft );
+
+    printf( "component %u redrawn with %lu pixels\n", REDRAWN_BOX, ( unsigned long )gl_counters.pixels );
+    TEST_CHECK( gl_counters.pixels >= BOX_WIDTH * BOX_HEIGHT );
+    TEST_CHECK( gl_counters.pixels < 4u * BOX_WIDTH * BOX_HEIGHT );
+}
+
+static void check_stack_screen( void )
+{
+    stack_screen_setup( );
+    vtft_set_current_screen( &vtft, screen );
+    vtft_process( &vtft );
+
+    printf( "%u components, %u grid entries of %u\n", screen->component_count,
+            vtft_get_touch_grid_entries( &vtft ), VTFT_TOUCH_GRID_ENTRIES );
+
+    // Overflow is reported, touch scans all components instead.
+    TEST_CHECK( !vtft.touch_grid.valid );
+    TEST_CHECK( STACK_COUNT * VTFT_TOUCH_GRID_COLUMNS * VTFT_TOUCH_GRID_ROWS ==
+                vtft_get_touch_grid_entries( &vtft ) );
+
+    check_tap( 0, 0 );
+    check_tap( 160, 120 );
+    check_tap( 319, 239 );
+    TEST_CHECK( ( const vtft_active_component * )&boxes[ STACK_COUNT - 1 ] == touched );
+}
+
+int main( void )
+{
+    gl_driver_t driver;
+
+    vtft_host_count_driver( &driver );
+    gl_set_driver( &driver );
+    vtft_host_init( &vtft );
+
+    check_grid_screen( );
+    check_component_redraw( );
+    check_stack_screen( );
+
+    return TEST_RESULT( "vtft_grid" );
+}
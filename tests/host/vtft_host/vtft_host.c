@@ -0,0 +1,127 @@
+#include "vtft_host.h"
+#include "tp_replay.h"
+#include <string.h>
+
+/* === COUNTING GL DRIVER === */
+
+gl_counters_t gl_counters;
+
+static void count_fill( gl_rectangle_t * rect, gl_color_t color )
+{
+    ( void )color;
+
+    gl_counters.fills++;
+    gl_counters.pixels += ( uint32_t )rect->width * rect->height;
+}
+
+static void count_begin_frame( gl_rectangle_t * rect )
+{
+    ( void )rect;
+
+    gl_counters.frames++;
+}
+
+static void count_frame_data( gl_color_t color )
+{
+    ( void )color;
+
+    gl_counters.pixels++;
+}
+
+static void count_frame_data_buffer( const gl_color_t * __generic_ptr pixels, size_t count )
+{
+    ( void )pixels;
+
+    gl_counters.pixels += count;
+}
+
+static void count_end_frame( void )
+{
+}
+
+void vtft_host_count_driver( gl_driver_t * driver )
+{
+    memset( driver, 0, sizeof( *driver ) );
+    driver->display_width = 320;
+    driver->display_height = 240;
+    driver->fill_f = count_fill;
+    driver->begin_frame_f = count_begin_frame;
+    driver->frame_data_f = count_frame_data;
+    driver->frame_data_buffer_f = count_frame_data_buffer;
+    driver->end_frame_f = count_end_frame;
+}
+
+void vtft_host_reset_counters( void )
+{
+    memset( &gl_counters, 0, sizeof( gl_counters ) );
+}
+
+/* === TEST FONT === */
+
+/*
+ * Header with first character, last character and height, table of width
+ * and 24-bit offset for each character, then character bitmaps, one byte per
+ * row. It starts with character 0, since text drawing looks up the width of
+ * the terminating null.
+ */
+
+#define FONT_LAST_CHAR   'Z'
+#define FONT_CHARS       ( FONT_LAST_CHAR + 1 )
+#define FONT_TABLE       8
+#define FONT_BITMAPS     ( FONT_TABLE + 4 * FONT_CHARS )
+
+static vtft_byte_t font[ FONT_BITMAPS + FONT_CHARS * VTFT_HOST_FONT_HEIGHT ];
+
+const vtft_byte_t * vtft_host_font( void )
+{
+    uint32_t offset;
+    uint8_t ch;
+    uint8_t row;
+
+    font[ 4 ] = FONT_LAST_CHAR;
+    font[ 6 ] = VTFT_HOST_FONT_HEIGHT;
+
+    for ( ch = 0; ch < FONT_CHARS; ch++ )
+    {
+        offset = FONT_BITMAPS + ch * VTFT_HOST_FONT_HEIGHT;
+        font[ FONT_TABLE + 4 * ch ] = VTFT_HOST_FONT_WIDTH;
+        font[ FONT_TABLE + 4 * ch + 1 ] = ( vtft_byte_t )offset;
+        font[ FONT_TABLE + 4 * ch + 2 ] = ( vtft_byte_t )( offset >> 8 );
+        font[ FONT_TABLE + 4 * ch + 3 ] = ( vtft_byte_t )( offset >> 16 );
+
+        // Space and control characters are blank, others are filled.
+        for ( row = 0; row < VTFT_HOST_FONT_HEIGHT; row++ )
+            font[ offset + row ] = ( ch > ' ' ) ? 0x3F : 0;
+    }
+
+    return font;
+}
+
+/* === IDLE TOUCH PANEL === */
+
+uint32_t vtft_host_time;
+
+static tp_replay_t replay;
+static tp_drv_t drv;
+static tp_t tp;
+
+static uint32_t host_clock( void )
+{
+    return vtft_host_time;
+}
+
+void vtft_host_init( vtft_t * vtft )
+{
+    tp_cfg_t cfg;
+
+    // Replay of an empty stream never reports a touch.
+    tp_replay_init( &replay, NULL, 0, TP_REPLAY_MODE_STEP, NULL, &drv );
+    tp_cfg_setup( &cfg );
+    cfg.width = 320;
+    cfg.height = 240;
+    tp_init( &tp, &cfg, &drv, &replay );
+
+    vtft_host_time = 0;
+    vtft_init( vtft, &tp );
+    vtft_set_timestamp( vtft, host_clock );
+}
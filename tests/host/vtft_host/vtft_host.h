@@ -0,0 +1,71 @@
+/*!
+ * @file  vtft_host.h
+ * @brief Display and touch panel for host tests of Visual TFT library: GL
+ * driver which only counts what is drawn, font to draw captions with, and a
+ * touch panel which is never touched.
+ */
+
+#ifndef _VTFT_HOST_H_
+#define _VTFT_HOST_H_
+
+#include "vtft.h"
+#include "gl.h"
+
+/**
+ * @brief Size of the test font, equal for all characters.
+ */
+#define VTFT_HOST_FONT_WIDTH   6
+#define VTFT_HOST_FONT_HEIGHT  8
+
+/**
+ * @brief Amount drawn by the counting driver.
+ */
+typedef struct
+{
+    uint32_t fills;     /**< Filled rectangles. */
+    uint32_t frames;    /**< Frames of pixels, e.g. glyphs and images. */
+    uint32_t pixels;    /**< Pixels filled or sent in frames. */
+
+} gl_counters_t;
+
+/**
+ * @brief Amount drawn since the last @ref vtft_host_reset_counters.
+ */
+extern gl_counters_t gl_counters;
+
+/**
+ * @brief Sets up the driver which only counts what is drawn, so tests
+ * measure the library and not the display.
+ * @param[out] driver GL driver, 320 x 240.
+ * @return Nothing.
+ */
+void vtft_host_count_driver( gl_driver_t * driver );
+
+/**
+ * @brief Resets the counters of the counting driver.
+ * @return Nothing.
+ */
+void vtft_host_reset_counters( void );
+
+/**
+ * @brief Font in GL format with characters from 0 to 'Z', each one
+ * @ref VTFT_HOST_FONT_WIDTH wide and @ref VTFT_HOST_FONT_HEIGHT high.
+ * @return Font data.
+ */
+const vtft_byte_t * vtft_host_font( void );
+
+/**
+ * @brief Initializes the VTFT instance with a touch panel which is never
+ * touched, and a clock advanced by the test.
+ * @param[out] vtft VTFT instance.
+ * @return Nothing.
+ */
+void vtft_host_init( vtft_t * vtft );
+
+/**
+ * @brief Time of the clock given to the VTFT instance, in milliseconds.
+ */
+extern uint32_t vtft_host_time;
+
+#endif // _VTFT_HOST_H_
+// ------------------------------------------------------------------------- END
@@ -0,0 +1,225 @@
+#define _POSIX_C_SOURCE 199309L
+
+#include "vtft_host.h"
+#include "tp_replay.h"
+#include "test_check.h"
+#include <string.h>
+#include <time.h>
+
+/* === SCREEN === */
+
+/*
+ * Grid of boxes, each recolored while it's pressed, with down and click
+ * events where the touch ends up.
+ */
+
+#define BOX_COLUMNS  4
+#define BOX_ROWS     3
+#define BOX_COUNT    ( BOX_COLUMNS * BOX_ROWS )
+#define BOX_WIDTH    80
+#define BOX_HEIGHT   80
+
+static vtft_t vtft;
+static tp_replay_t replay;
+
+static vtft_box boxes[ BOX_COUNT ];
+static vtft_component * components[ BOX_COUNT ];
+static vtft_screen screen;
+
+static uint32_t downs;
+static uint32_t clicks;
+
+static void box_down( void )
+{
+    tp_replay_dispatched( &replay );
+    downs++;
+}
+
+static void box_click( void )
+{
+    tp_replay_dispatched( &replay );
+    clicks++;
+}
+
+static void screen_setup( void )
+{
+    uint8_t idx;
+
+    for ( idx = 0; idx < BOX_COUNT; idx++ )
+    {
+        vtft_box * box = &boxes[ idx ];
+
+        memset( box, 0, sizeof( *box ) );
+        box->type = VTFT_COMPONENT_BOX;
+        box->order = idx;
+        box->visible = 1;
+        box->active = 1;
+        box->left = ( idx % BOX_COLUMNS ) * BOX_WIDTH;
+        box->top = ( idx / BOX_COLUMNS ) * BOX_HEIGHT;
+        box->width = BOX_WIDTH;
+        box->height = BOX_HEIGHT;
+        box->event_set.down_event = box_down;
+        box->event_set.click_event = box_click;
+        box->pen.width = 1;
+        box->pen.color = GL_BLACK;
+        box->press_gradient.gradient_style = VTFT_GRADIENT_TOP_BOTTOM;
+        box->press_gradient.start_color = GL_WHITE;
+        box->press_gradient.end_color = GL_SILVER;
+        box->press_gradient.press_start_color = GL_SILVER;
+        box->press_gradient.press_end_color = GL_WHITE;
+        components[ idx ] = ( vtft_component * )box;
+    }
+
+    screen.width = 320;
+    screen.height = 240;
+    screen.color = GL_WHITE;
+    screen.components = components;
+    screen.component_count = BOX_COUNT;
+}
+
+/* === TAP STREAM === */
+
+/*
+ * Taps in the middle of each box in turn, each one pressed for three
+ * readings 10 ms apart, as a touch controller would report them.
+ */
+
+#define TAP_ROUNDS     20
+#define TAP_COUNT      ( TAP_ROUNDS * BOX_COUNT )
+#define TAP_READINGS   4
+
+static uint8_t stream[ TAP_COUNT * TAP_READINGS * ( TP_REPLAY_HEADER_SIZE + TP_REPLAY_POINT_SIZE ) ];
+static uint32_t stream_size;
+
+static void stream_put( uint32_t value, uint8_t size )
+{
+    while ( size-- )
+    {
+        stream[ stream_size++ ] = ( uint8_t )value;
+        value >>= 8;
+    }
+}
+
+static void stream_add( uint32_t timestamp, tp_coord_t x, tp_coord_t y, tp_event_t event )
+{
+    uint8_t touched = ( TP_EVENT_PRESS_NOT_DET != event );
+
+    stream_put( timestamp, 4 );
+    stream_put( touched ? TP_EVENT_PRESS_DET : TP_EVENT_PRESS_NOT_DET, 1 );
+    stream_put( TP_EVENT_GEST_NONE, 1 );
+    stream_put( touched ? 1 : 0, 1 );
+
+    if ( touched )
+    {
+        stream_put( x, 2 );
+        stream_put( y, 2 );
+        stream_put( event, 1 );
+        stream_put( TP_TOUCH_ID_0, 1 );
+    }
+}
+
+static void stream_setup( void )
+{
+    uint32_t timestamp = 0;
+    uint16_t tap;
+    uint8_t reading;
+
+    stream_size = 0;
+
+    for ( tap = 0; tap < TAP_COUNT; tap++ )
+    {
+        const vtft_box * box = &boxes[ tap % BOX_COUNT ];
+        tp_coord_t x = box->left + BOX_WIDTH / 2;
+        tp_coord_t y = box->top + BOX_HEIGHT / 2;
+
+        for ( reading = 0; reading < TAP_READINGS - 1; reading++ )
+        {
+            stream_add( timestamp, x + reading, y,
+                        reading ? TP_EVENT_PRESS_MOVE : TP_EVENT_PRESS_DOWN );
+            timestamp += 10;
+        }
+
+        stream_add( timestamp, 0, 0, TP_EVENT_PRESS_NOT_DET );
+        timestamp += 100;
+    }
+}
+
+/* === BENCHMARK === */
+
+/* Host clock, in microseconds. */
+static uint32_t host_timestamp( void )
+{
+    struct timespec now;
+
+    clock_gettime( CLOCK_MONOTONIC, &now );
+
+    return ( uint32_t )( now.tv_sec * 1000000u + now.tv_nsec / 1000 );
+}
+
+static void print_latency( const char * name, const tp_replay_latency_t * latency )
+{
+    printf( "%-12s %6lu events, min %4lu us, avg %4lu us, max %5lu us\n", name,
+            ( unsigned long )latency->count, ( unsigned long )latency->min,
+            ( unsigned long )( latency->count ? latency->total / latency->count : 0 ),
+            ( unsigned long )latency->max );
+}
+
+int main( void )
+{
+    tp_replay_latency_t processing;
+    tp_replay_latency_t dispatch;
+    gl_counters_t drawn;
+    gl_driver_t driver;
+    tp_drv_t drv;
+    tp_cfg_t cfg;
+    tp_t tp;
+
+    // Driver only counts what is drawn, so the benchmark measures the library and not the display bus.
+    vtft_host_count_driver( &driver );
+    gl_set_driver( &driver );
+    screen_setup( );
+    stream_setup( );
+
+    TEST_CHECK( TP_OK == tp_replay_init( &replay, stream, stream_size, TP_REPLAY_MODE_STEP,
+                                         host_timestamp, &drv ) );
+    tp_cfg_setup( &cfg );
+    cfg.width = 320;
+    cfg.height = 240;
+    tp_init( &tp, &cfg, &drv, &replay );
+    vtft_init( &vtft, &tp );
+    vtft_set_current_screen( &vtft, &screen );
+
+    // Initial drawing isn't part of the touch latency.
+    TEST_CHECK( gl_counters.pixels >= 320u * 240u );
+    vtft_host_reset_counters( );
+
+    tp_replay_start( &replay );
+    while ( !tp_replay_is_done( &replay ) )
+    {
+        uint32_t start = host_timestamp( );
+        vtft_process( &vtft );
+        tp_replay_processed( &replay, start );
+    }
+
+    tp_replay_get_latency( &replay, &processing, &dispatch );
+    drawn = gl_counters;
+
+    printf( "%u taps, %u readings\n", TAP_COUNT, TAP_COUNT * TAP_READINGS );
+    print_latency( "processing", &processing );
+    print_latency( "dispatch", &dispatch );
+    printf( "drawn        %6lu fills, %lu frames, %lu pixels\n", ( unsigned long )drawn.fills,
+            ( unsigned long )drawn.frames, ( unsigned long )drawn.pixels );
+
+    // Every reading is processed and every tap ends up in its handlers.
+    TEST_CHECK( TAP_COUNT * TAP_READINGS == processing.count );
+    TEST_CHECK( TAP_COUNT == downs );
+    TEST_CHECK( TAP_COUNT == clicks );
+    TEST_CHECK( 2 * TAP_COUNT == dispatch.count );
+    TEST_CHECK( 0 == vtft.pen_down );
+
+    // Pressed box is redrawn on down and on up, nothing else.
+    TEST_CHECK( drawn.pixels >= 2u * TAP_COUNT * BOX_WIDTH * BOX_HEIGHT );
+    TEST_CHECK( drawn.pixels < 3u * TAP_COUNT * BOX_WIDTH * BOX_HEIGHT );
+
+    return TEST_RESULT( "vtft_latency" );
+}
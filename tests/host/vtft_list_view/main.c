@@ -0,0 +1,328 @@
+#include "vtft_host.h"
+#include "test_check.h"
+#include <string.h>
+
+extern void _tp_event_handler( tp_event_t event, tp_coord_t x, tp_coord_t y, tp_touch_id_t i );
+
+/* === SCREEN === */
+
+/*
+ * List view of rows which are only recorded when drawn, placed away from the
+ * edges of the display so that moved areas keep their offsets.
+ */
+
+#define LIST_LEFT    40
+#define LIST_TOP     40
+#define LIST_WIDTH   200
+#define LIST_HEIGHT  160
+#define ROW_HEIGHT   20
+#define ROW_COUNT    50
+#define MAX_SCROLL   ( ROW_COUNT * ROW_HEIGHT - LIST_HEIGHT )
+
+static vtft_t vtft;
+static gl_driver_t driver;
+
+static vtft_list_view list_view;
+static vtft_component * components[ 1 ];
+static vtft_screen screen;
+
+// Rows drawn since the last reset, and rows drawn away from their place.
+static uint8_t drawn[ ROW_COUNT ];
+static uint32_t misplaced;
+
+// Row clicked last, -1 if none.
+static int32_t clicked;
+
+static void draw_row( vtft_list_view * lv, uint16_t row, const gl_rectangle_t * area )
+{
+    if ( ( area->top_left.x != LIST_LEFT ) || ( area->width != LIST_WIDTH ) ||
+         ( area->height != ROW_HEIGHT ) ||
+         ( area->top_left.y != LIST_TOP + row * ROW_HEIGHT - lv->scroll ) )
+    {
+        misplaced++;
+    }
+    drawn[ row ]++;
+}
+
+static void row_click( vtft_list_view * lv, uint16_t row )
+{
+    ( void )lv;
+    clicked = row;
+}
+
+static void screen_setup( void )
+{
+    memset( &list_view, 0, sizeof( list_view ) );
+    list_view.type = VTFT_COMPONENT_LIST_VIEW;
+    list_view.visible = 1;
+    list_view.active = 1;
+    list_view.left = LIST_LEFT;
+    list_view.top = LIST_TOP;
+    list_view.width = LIST_WIDTH;
+    list_view.height = LIST_HEIGHT;
+    list_view.back_color = GL_WHITE;
+    list_view.row_count = ROW_COUNT;
+    list_view.row_height = ROW_HEIGHT;
+    list_view.draw_row = draw_row;
+    list_view.row_click = row_click;
+    components[ 0 ] = ( vtft_component * )&list_view;
+
+    screen.width = 320;
+    screen.height = 240;
+    screen.color = GL_BLACK;
+    screen.components = components;
+    screen.component_count = 1;
+}
+
+/* === DRIVER === */
+
+/*
+ * Counting driver which also records the areas it moves, as displays with
+ * a frame buffer do.
+ */
+
+static uint32_t copies;
+static gl_rectangle_t copied;
+static gl_coord_t copied_x;
+static gl_coord_t copied_y;
+
+static void record_copy( gl_rectangle_t * src, gl_coord_t x, gl_coord_t y )
+{
+    copies++;
+    copied = *src;
+    copied_x = x;
+    copied_y = y;
+}
+
+static void reset_drawn( void )
+{
+    memset( drawn, 0, sizeof( drawn ) );
+    misplaced = 0;
+    copies = 0;
+    vtft_host_reset_counters( );
+}
+
+// Checks that exactly the given rows were drawn, each one once.
+static bool drawn_only( int32_t first, int32_t last )
+{
+    int32_t row;
+
+    for ( row = 0; row < ROW_COUNT; row++ )
+    {
+        if ( drawn[ row ] != ( ( ( row >= first ) && ( row <= last ) ) ? 1 : 0 ) )
+            return false;
+    }
+
+    return 0 == misplaced;
+}
+
+static void touch( tp_event_t event, tp_coord_t y )
+{
+    _tp_event_handler( event, LIST_LEFT + 100, y, TP_TOUCH_ID_0 );
+    vtft_process( &vtft );
+}
+
+// Processes until the released list view stops, returns the number of calls.
+static uint32_t coast( void )
+{
+    uint32_t steps = 0;
+    int32_t scroll;
+
+    while ( ( vtft.scrolling_list_view != NULL ) && ( steps < 1000 ) )
+    {
+        scroll = list_view.scroll;
+        vtft_process( &vtft );
+        steps++;
+
+        // Keeps the direction of the drag.
+        TEST_CHECK( list_view.scroll >= scroll );
+    }
+
+    return steps;
+}
+
+/* === TESTS === */
+
+static void check_shown( void )
+{
+    reset_drawn( );
+    vtft_set_current_screen( &vtft, &screen );
+    vtft_process( &vtft );
+
+    TEST_CHECK( drawn_only( 0, LIST_HEIGHT / ROW_HEIGHT - 1 ) );
+    TEST_CHECK( 0 == copies );
+}
+
+static void check_scroll_moves( void )
+{
+    // Rows still visible are moved up, only two new ones are drawn below them.
+    reset_drawn( );
+    vtft_set_list_view_scroll( &vtft, &list_view, 30 );
+    TEST_CHECK( 30 == list_view.scroll );
+    TEST_CHECK( 1 == copies );
+    TEST_CHECK( ( LIST_LEFT == copied.top_left.x ) && ( LIST_TOP + 30 == copied.top_left.y ) );
+    TEST_CHECK( ( LIST_WIDTH == copied.width ) && ( LIST_HEIGHT - 30 == copied.height ) );
+    TEST_CHECK( ( LIST_LEFT == copied_x ) && ( LIST_TOP == copied_y ) );
+    TEST_CHECK( drawn_only( 8, 9 ) );
+    TEST_CHECK( LIST_WIDTH * 30 == gl_counters.pixels );
+
+    // Back towards the first row, moved down.
+    reset_drawn( );
+    vtft_set_list_view_scroll( &vtft, &list_view, 10 );
+    TEST_CHECK( 1 == copies );
+    TEST_CHECK( ( LIST_TOP == copied.top_left.y ) && ( LIST_HEIGHT - 20 == copied.height ) );
+    TEST_CHECK( LIST_TOP + 20 == copied_y );
+    TEST_CHECK( drawn_only( 0, 1 ) );
+    TEST_CHECK( LIST_WIDTH * 20 == gl_counters.pixels );
+
+    // Same scroll draws nothing.
+    reset_drawn( );
+    vtft_set_list_view_scroll( &vtft, &list_view, 10 );
+    TEST_CHECK( 0 == copies );
+    TEST_CHECK( drawn_only( 0, -1 ) );
+    TEST_CHECK( 0 == gl_counters.pixels );
+}
+
+static void check_scroll_limits( void )
+{
+    // Jump longer than the list view redraws it whole, stopped at the last row.
+    reset_drawn( );
+    vtft_set_list_view_scroll( &vtft, &list_view, 100000 );
+    TEST_CHECK( MAX_SCROLL == list_view.scroll );
+    TEST_CHECK( MAX_SCROLL == list_view.drawn_scroll );
+    TEST_CHECK( 0 == copies );
+    TEST_CHECK( drawn_only( ROW_COUNT - LIST_HEIGHT / ROW_HEIGHT, ROW_COUNT - 1 ) );
+    TEST_CHECK( LIST_WIDTH * LIST_HEIGHT == gl_counters.pixels );
+
+    reset_drawn( );
+    vtft_set_list_view_scroll( &vtft, &list_view, -100 );
+    TEST_CHECK( 0 == list_view.scroll );
+    TEST_CHECK( drawn_only( 0, LIST_HEIGHT / ROW_HEIGHT - 1 ) );
+}
+
+static void check_scroll_without_copy( void )
+{
+    // Driver which can't move areas gets the whole list view drawn.
+    driver.copy_rect_f = NULL;
+    gl_set_driver( &driver );
+
+    reset_drawn( );
+    vtft_set_list_view_scroll( &vtft, &list_view, 30 );
+    TEST_CHECK( 30 == list_view.drawn_scroll );
+    TEST_CHECK( 0 == copies );
+    TEST_CHECK( drawn_only( 1, 9 ) );
+    TEST_CHECK( LIST_WIDTH * LIST_HEIGHT == gl_counters.pixels );
+
+    driver.copy_rect_f = record_copy;
+    gl_set_driver( &driver );
+    vtft_set_list_view_scroll( &vtft, &list_view, 0 );
+}
+
+static void check_drag( void )
+{
+    tp_coord_t y;
+    uint32_t steps;
+
+    clicked = -1;
+    reset_drawn( );
+
+    // Touch moved less than the threshold doesn't scroll.
+    touch( TP_EVENT_PRESS_DOWN, LIST_TOP + 140 );
+    touch( TP_EVENT_PRESS_MOVE, LIST_TOP + 140 - ( VTFT_LIST_VIEW_DRAG_THRESHOLD - 1 ) );
+    TEST_CHECK( 0 == list_view.scroll );
+    TEST_CHECK( !list_view.dragging );
+    TEST_CHECK( 0 == copies );
+
+    // Past it the list view follows the touch, from where it was pressed.
+    for ( y = LIST_TOP + 130; y >= LIST_TOP + 60; y -= 10 )
+    {
+        touch( TP_EVENT_PRESS_MOVE, y );
+        TEST_CHECK( LIST_TOP + 140 - y == list_view.scroll );
+    }
+    TEST_CHECK( list_view.dragging );
+    TEST_CHECK( 8 == copies );
+    TEST_CHECK( LIST_WIDTH * 80 == gl_counters.pixels );
+    TEST_CHECK( 0 == misplaced );
+
+    // Released, it keeps scrolling by moving the drawn rows until friction stops it.
+    vtft_host_reset_counters( );
+    touch( TP_EVENT_PRESS_UP, LIST_TOP + 60 );
+    TEST_CHECK( -1 == clicked );
+    steps = coast( );
+    TEST_CHECK( ( steps > 10 ) && ( steps < 1000 ) );
+    TEST_CHECK( ( list_view.scroll > 80 + 120 ) && ( list_view.scroll < 80 + 180 ) );
+    TEST_CHECK( 0 == list_view.speed );
+    TEST_CHECK( LIST_WIDTH * ( list_view.scroll - 80 ) == ( int32_t )gl_counters.pixels );
+    TEST_CHECK( 0 == misplaced );
+}
+
+static void check_flick_to_end( void )
+{
+    tp_coord_t y;
+    uint32_t steps;
+
+    vtft_set_list_view_scroll( &vtft, &list_view, MAX_SCROLL - 100 );
+
+    touch( TP_EVENT_PRESS_DOWN, LIST_TOP + 140 );
+    for ( y = LIST_TOP + 120; y >= LIST_TOP + 60; y -= 20 )
+    {
+        touch( TP_EVENT_PRESS_MOVE, y );
+    }
+    TEST_CHECK( MAX_SCROLL - 20 == list_view.scroll );
+
+    // Stops at the last row instead of slowing down against it.
+    touch( TP_EVENT_PRESS_UP, LIST_TOP + 60 );
+    steps = coast( );
+    TEST_CHECK( steps < 4 );
+    TEST_CHECK( MAX_SCROLL == list_view.scroll );
+    TEST_CHECK( NULL == vtft.scrolling_list_view );
+    TEST_CHECK( 0 == list_view.speed );
+}
+
+static void check_click( void )
+{
+    // Tap clicks the row under it, counted from the first row.
+    clicked = -1;
+    reset_drawn( );
+    touch( TP_EVENT_PRESS_DOWN, LIST_TOP + 5 );
+    touch( TP_EVENT_PRESS_UP, LIST_TOP + 5 );
+    TEST_CHECK( ( MAX_SCROLL + 5 ) / ROW_HEIGHT == clicked );
+
+    // Move shorter than the threshold is still a click.
+    clicked = -1;
+    touch( TP_EVENT_PRESS_DOWN, LIST_TOP + 25 );
+    touch( TP_EVENT_PRESS_MOVE, LIST_TOP + 28 );
+    touch( TP_EVENT_PRESS_UP, LIST_TOP + 28 );
+    TEST_CHECK( ( MAX_SCROLL + 28 ) / ROW_HEIGHT == clicked );
+    TEST_CHECK( MAX_SCROLL == list_view.scroll );
+    TEST_CHECK( drawn_only( 0, -1 ) );
+
+    // Press stops the list view which keeps scrolling.
+    vtft_set_list_view_scroll( &vtft, &list_view, 0 );
+    touch( TP_EVENT_PRESS_DOWN, LIST_TOP + 140 );
+    touch( TP_EVENT_PRESS_MOVE, LIST_TOP + 100 );
+    touch( TP_EVENT_PRESS_UP, LIST_TOP + 100 );
+    TEST_CHECK( &list_view == vtft.scrolling_list_view );
+    touch( TP_EVENT_PRESS_DOWN, LIST_TOP + 100 );
+    TEST_CHECK( NULL == vtft.scrolling_list_view );
+    touch( TP_EVENT_PRESS_UP, LIST_TOP + 100 );
+}
+
+int main( void )
+{
+    vtft_host_count_driver( &driver );
+    driver.copy_rect_f = record_copy;
+    gl_set_driver( &driver );
+    vtft_host_init( &vtft );
+    screen_setup( );
+
+    check_shown( );
+    check_scroll_moves( );
+    check_scroll_limits( );
+    check_scroll_without_copy( );
+    check_drag( );
+    check_flick_to_end( );
+    check_click( );
+
+    return TEST_RESULT( "vtft_list_view" );
+}
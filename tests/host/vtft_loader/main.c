@@ -0,0 +1,215 @@
+#include "vtft.h"
+#include "vtft_loader.h"
+#include "gl.h"
+#include "gl_record.h"
+#include "tp_replay.h"
+#include "display_bus.h"
+#include "test_check.h"
+#include <string.h>
+
+/* === SCREEN DATA === */
+
+/*
+ * Two screens in the binary screen format, a white one with a red box and a
+ * white one with a blue box, without captions, fonts, pictures or events.
+ */
+
+#define SCREEN_COUNT   2
+#define STYLE_COUNT    2
+#define STYLE_OFFSET   ( 16 + SCREEN_COUNT * 4 )
+#define SCREEN_OFFSET  ( STYLE_OFFSET + STYLE_COUNT * 36 )
+#define SCREEN_SIZE    ( 16 + 36 )
+
+#define RED_BOX_LEFT   40
+#define BLUE_BOX_LEFT  160
+#define BOX_TOP        80
+#define BOX_WIDTH      80
+#define BOX_HEIGHT     60
+
+static uint8_t data[ SCREEN_OFFSET + SCREEN_COUNT * SCREEN_SIZE ];
+static uint32_t data_size;
+
+static void data_put( uint32_t value, uint8_t size )
+{
+    while ( size-- )
+    {
+        data[ data_size++ ] = ( uint8_t )value;
+        value >>= 8;
+    }
+}
+
+static void data_add_style( uint32_t color )
+{
+    data_put( 0x000000, 4 );    // pen
+    data_put( color, 4 );       // gradient start
+    data_put( color, 4 );       // gradient end
+    data_put( color, 4 );       // press start
+    data_put( color, 4 );       // press end
+    data_put( 0x000000, 4 );    // font
+    data_put( 0xFFFFFF, 4 );    // back
+    data_put( 1, 2 );           // pen width
+    data_put( VTFT_GRADIENT_NONE, 1 );
+    data_put( 0, 1 );           // not transparent
+    data_put( VTFT_SCREEN_NO_RESOURCE, 1 );
+    data_put( 0, 3 );
+}
+
+static void data_add_screen( uint16_t style, int16_t left )
+{
+    data_put( 320, 2 );
+    data_put( 240, 2 );
+    data_put( 0xFFFFFF, 4 );
+    data_put( VTFT_SCREEN_NO_RESOURCE, 1 );
+    data_put( VTFT_SCREEN_NO_RESOURCE, 1 );
+    data_put( VTFT_SCREEN_NO_RESOURCE, 1 );
+    data_put( 0, 1 );
+    data_put( 1, 2 );           // components
+    data_put( 0, 2 );
+
+    data_put( VTFT_COMPONENT_BOX, 1 );
+    data_put( VTFT_SCREEN_FLAG_VISIBLE | VTFT_SCREEN_FLAG_ACTIVE, 1 );
+    data_put( style, 2 );
+    data_put( ( uint16_t )left, 2 );
+    data_put( BOX_TOP, 2 );
+    data_put( BOX_WIDTH, 2 );
+    data_put( BOX_HEIGHT, 2 );
+    data_put( 0, 4 );           // corner radius, alignment, picture
+    data_put( 0xFFFFFFFF, 4 );  // no events
+    data_put( 0, 12 );
+    data_put( 0, 2 );           // no caption
+    data_put( 0, 2 );
+}
+
+static void data_setup( void )
+{
+    data_size = 0;
+
+    data_put( 'V', 1 );
+    data_put( 'T', 1 );
+    data_put( 'S', 1 );
+    data_put( 'C', 1 );
+    data_put( VTFT_SCREEN_FORMAT_VERSION, 2 );
+    data_put( SCREEN_COUNT, 2 );
+    data_put( STYLE_COUNT, 2 );
+    data_put( 0, 2 );
+    data_put( STYLE_OFFSET, 4 );
+    data_put( SCREEN_OFFSET, 4 );
+    data_put( SCREEN_OFFSET + SCREEN_SIZE, 4 );
+
+    data_add_style( 0xFF0000 );
+    data_add_style( 0x0000FF );
+
+    data_add_screen( 0, RED_BOX_LEFT );
+    data_add_screen( 1, BLUE_BOX_LEFT );
+}
+
+/* === TEST === */
+
+static vtft_t vtft;
+static vtft_loader_t loader;
+static uint32_t loader_memory[ 64 ];
+static uint8_t record_memory[ 1024 ];
+static const vtft_loader_resources_t resources;
+
+static uint32_t clock_ms;
+
+static uint32_t clock_get( void )
+{
+    return clock_ms;
+}
+
+/* Color of the reference frame buffer in the middle of the box at the given left. */
+static uint16_t box_color( int16_t left )
+{
+    return display_bus_reference[ BOX_TOP + BOX_HEIGHT / 2 ][ left + BOX_WIDTH / 2 ];
+}
+
+static void check_tween_of_released_screen( void )
+{
+    vtft_box * red_box;
+    vtft_box * blue_box;
+    vtft_tween tween;
+
+    TEST_CHECK( VTFT_LOADER_OK == vtft_loader_show_screen( &vtft, &loader, 0 ) );
+    red_box = ( vtft_box * )loader.screen->components[ 0 ];
+    TEST_CHECK( GL_RED == box_color( RED_BOX_LEFT ) );
+
+    // Box of the first screen is moving when the second one is shown.
+    memset( &tween, 0, sizeof( tween ) );
+    tween.component = ( vtft_component * )red_box;
+    tween.property = VTFT_TWEEN_LEFT;
+    tween.from = RED_BOX_LEFT;
+    tween.to = 0;
+    tween.duration = 200;
+    vtft_start_tween( &vtft, &tween );
+    clock_ms += 100;
+    vtft_process( &vtft );
+    TEST_CHECK( red_box->left < RED_BOX_LEFT );
+
+    TEST_CHECK( VTFT_LOADER_OK == vtft_loader_show_screen( &vtft, &loader, 1 ) );
+    blue_box = ( vtft_box * )loader.screen->components[ 0 ];
+    TEST_CHECK( !tween.running );
+    TEST_CHECK( 0 == vtft.tweens );
+
+    clock_ms += 200;
+    vtft_process( &vtft );
+    TEST_CHECK( BLUE_BOX_LEFT == blue_box->left );
+    TEST_CHECK( GL_BLUE == box_color( BLUE_BOX_LEFT ) );
+    TEST_CHECK( GL_WHITE == box_color( RED_BOX_LEFT ) );
+}
+
+static void check_cache_of_released_screen( void )
+{
+    gl_record_t record;
+    uint8_t idx;
+
+    // First screen is recorded when it's shown and drawn from its record afterwards.
+    gl_record_init_memory( &record, record_memory, sizeof( record_memory ) );
+    TEST_CHECK( VTFT_LOADER_OK == vtft_loader_show_screen( &vtft, &loader, 0 ) );
+    TEST_CHECK( vtft_cache_screen( &vtft, loader.screen, &record ) );
+    vtft_refresh_current_screen( &vtft );
+    vtft_refresh_current_screen( &vtft );
+    TEST_CHECK( GL_RED == box_color( RED_BOX_LEFT ) );
+
+    // Second screen is built at the same address, it's drawn from its components.
+    TEST_CHECK( VTFT_LOADER_OK == vtft_loader_show_screen( &vtft, &loader, 1 ) );
+    TEST_CHECK( GL_BLUE == box_color( BLUE_BOX_LEFT ) );
+    TEST_CHECK( GL_WHITE == box_color( RED_BOX_LEFT ) );
+
+    for ( idx = 0; idx < VTFT_SCREEN_CACHE_SIZE; idx++ )
+    {
+        TEST_CHECK( 0 == vtft.screen_cache[ idx ].screen );
+    }
+}
+
+int main( void )
+{
+    gl_driver_t driver;
+    tp_replay_t replay;
+    tp_drv_t drv;
+    tp_cfg_t cfg;
+    tp_t tp;
+
+    display_bus_init( DISPLAY_BUS_RGB565_WORD, false );
+    display_bus_reference_driver( &driver );
+    gl_set_driver( &driver );
+
+    // Nothing is touched.
+    TEST_CHECK( TP_OK == tp_replay_init( &replay, NULL, 0, TP_REPLAY_MODE_STEP, NULL, &drv ) );
+    tp_cfg_setup( &cfg );
+    cfg.width = 320;
+    cfg.height = 240;
+    tp_init( &tp, &cfg, &drv, &replay );
+    vtft_init( &vtft, &tp );
+    vtft_set_timestamp( &vtft, clock_get );
+
+    data_setup( );
+    vtft_loader_init( &loader, &resources, ( uint8_t * )loader_memory, sizeof( loader_memory ) );
+    TEST_CHECK( sizeof( data ) == data_size );
+    TEST_CHECK( VTFT_LOADER_OK == vtft_loader_open_memory( &loader, data ) );
+
+    check_tween_of_released_screen( );
+    check_cache_of_released_screen( );
+
+    return TEST_RESULT( "vtft_loader" );
+}
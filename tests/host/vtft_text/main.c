@@ -0,0 +1,219 @@
+#include "vtft_host.h"
+#include "vtft_types.h"
+#include "test_check.h"
+#include <string.h>
+
+#define CHAR_WIDTH   VTFT_HOST_FONT_WIDTH
+#define CHAR_HEIGHT  VTFT_HOST_FONT_HEIGHT
+
+/* === SCREENS === */
+
+/*
+ * First screen has a button, a label, a check box and a progress bar. Second
+ * one has the button and another button whose order shares its entry.
+ */
+
+static vtft_t vtft;
+
+static vtft_byte_t button_caption[ 16 ] = "AB";
+static vtft_byte_t label_caption[ 16 ] = "ABC";
+static vtft_byte_t check_box_caption[ 16 ] = "ON";
+static vtft_byte_t other_caption[ 16 ] = "ABCDEF";
+static vtft_byte_t progress_caption[ 8 ];
+
+static vtft_button button;
+static vtft_label label;
+static vtft_check_box check_box;
+static vtft_progress_bar progress_bar;
+static vtft_button other;
+
+static vtft_component * first_components[ 4 ];
+static vtft_component * second_components[ 2 ];
+static vtft_screen first;
+static vtft_screen second;
+
+static void button_setup( vtft_button * b, vtft_index_t order, vtft_byte_t * caption, vtft_coord_t top )
+{
+    memset( b, 0, sizeof( *b ) );
+    b->type = VTFT_COMPONENT_BUTTON;
+    b->order = order;
+    b->visible = 1;
+    b->left = 10;
+    b->top = top;
+    b->width = 100;
+    b->height = 40;
+    b->pen.width = 1;
+    b->press_gradient.start_color = GL_WHITE;
+    b->press_gradient.end_color = GL_WHITE;
+    b->text.caption = caption;
+    b->text.font.font_data = vtft_host_font( );
+    b->text_align = VTFT_TEXT_ALIGNMENT_CENTER;
+}
+
+static void screens_setup( void )
+{
+    button_setup( &button, 0, button_caption, 10 );
+    button_setup( &other, VTFT_TEXT_METRICS_ENTRIES, other_caption, 60 );
+
+    memset( &label, 0, sizeof( label ) );
+    label.type = VTFT_COMPONENT_LABEL;
+    label.order = 1;
+    label.visible = 1;
+    label.left = 10;
+    label.top = 60;
+    label.width = 3 * CHAR_WIDTH;
+    label.height = CHAR_HEIGHT;
+    label.text.caption = label_caption;
+    label.text.font.font_data = vtft_host_font( );
+
+    memset( &check_box, 0, sizeof( check_box ) );
+    check_box.type = VTFT_COMPONENT_CHECK_BOX;
+    check_box.order = 2;
+    check_box.visible = 1;
+    check_box.left = 10;
+    check_box.top = 80;
+    check_box.width = 100;
+    check_box.height = 20;
+    check_box.pen.width = 1;
+    check_box.text.caption = check_box_caption;
+    check_box.text.font.font_data = vtft_host_font( );
+    check_box.text_align = VTFT_TEXT_ALIGNMENT_RIGHT;
+
+    memset( &progress_bar, 0, sizeof( progress_bar ) );
+    progress_bar.type = VTFT_COMPONENT_PROGRESS_BAR;
+    progress_bar.order = 3;
+    progress_bar.visible = 1;
+    progress_bar.left = 10;
+    progress_bar.top = 120;
+    progress_bar.width = 200;
+    progress_bar.height = 20;
+    progress_bar.caption = progress_caption;
+    progress_bar.font.font_data = vtft_host_font( );
+    progress_bar.max_position = 100;
+    progress_bar.show_position = 1;
+    progress_bar.show_percent = 1;
+
+    first_components[ 0 ] = ( vtft_component * )&button;
+    first_components[ 1 ] = ( vtft_component * )&label;
+    first_components[ 2 ] = ( vtft_component * )&check_box;
+    first_components[ 3 ] = ( vtft_component * )&progress_bar;
+    first.width = 320;
+    first.height = 240;
+    first.color = GL_WHITE;
+    first.components = first_components;
+    first.component_count = 4;
+
+    second_components[ 0 ] = ( vtft_component * )&button;
+    second_components[ 1 ] = ( vtft_component * )&other;
+    second = first;
+    second.components = second_components;
+    second.component_count = 2;
+}
+
+/* === CHECKS === */
+
+static const vtft_text_metrics * metrics_of( const void * component )
+{
+    const vtft_text_metrics * metrics = &vtft.text_metrics[ ( ( const vtft_component * )component )->order %
+                                                            VTFT_TEXT_METRICS_ENTRIES ];
+
+    return ( metrics->component == component ) ? metrics : NULL;
+}
+
+static void check_measured( void )
+{
+    const vtft_text_metrics * metrics;
+
+    // Button caption is centered.
+    metrics = metrics_of( &button );
+    TEST_CHECK( NULL != metrics );
+    TEST_CHECK( metrics && ( 2 * CHAR_WIDTH == metrics->size.width ) );
+    TEST_CHECK( metrics && ( CHAR_HEIGHT == metrics->size.height ) );
+    TEST_CHECK( metrics && ( ( 100 - 2 * CHAR_WIDTH ) / 2 == metrics->offset_x ) );
+    TEST_CHECK( metrics && ( ( 40 - CHAR_HEIGHT ) / 2 == metrics->offset_y ) );
+
+    // Label is drawn at its origin, without measuring.
+    TEST_CHECK( NULL == metrics_of( &label ) );
+
+    // Check box caption is placed next to the box, centered vertically.
+    metrics = metrics_of( &check_box );
+    TEST_CHECK( metrics && ( 2 * CHAR_WIDTH == metrics->size.width ) );
+    TEST_CHECK( metrics && ( ( 20 - CHAR_HEIGHT ) / 2 == metrics->offset_y ) );
+
+    // Progress bar caption is the percentage.
+    TEST_CHECK( 0 == strcmp( ( const char * )progress_caption, "0%" ) );
+    metrics = metrics_of( &progress_bar );
+    TEST_CHECK( metrics && ( 2 * CHAR_WIDTH == metrics->size.width ) );
+    TEST_CHECK( metrics && ( ( 200 - 2 * CHAR_WIDTH ) / 2 == metrics->offset_x ) );
+}
+
+static void check_set_caption( void )
+{
+    const vtft_text_metrics * metrics;
+
+    // Caption changed in place is set again with the same pointer.
+    strcpy( ( char * )button_caption, "ABCD" );
+    TEST_CHECK( vtft_set_caption( &vtft, ( vtft_component * )&button, button_caption ) );
+    TEST_CHECK( NULL == metrics_of( &button ) );
+    vtft_update( &vtft );
+    metrics = metrics_of( &button );
+    TEST_CHECK( metrics && ( 4 * CHAR_WIDTH == metrics->size.width ) );
+    TEST_CHECK( metrics && ( ( 100 - 4 * CHAR_WIDTH ) / 2 == metrics->offset_x ) );
+
+    // Label follows the size of its caption.
+    TEST_CHECK( vtft_set_caption( &vtft, ( vtft_component * )&label, ( vtft_byte_t * )"ABCDE" ) );
+    TEST_CHECK( 5 * CHAR_WIDTH == label.width );
+    TEST_CHECK( CHAR_HEIGHT == label.height );
+    vtft_update( &vtft );
+
+    // Progress bar caption is written by the library.
+    TEST_CHECK( !vtft_set_caption( &vtft, ( vtft_component * )&progress_bar, progress_caption ) );
+    vtft_set_progress_bar_position( &vtft, &progress_bar, 100 );
+    metrics = metrics_of( &progress_bar );
+    TEST_CHECK( metrics && ( 4 * CHAR_WIDTH == metrics->size.width ) );
+
+    // Font is set for components with captions only.
+    TEST_CHECK( vtft_set_font( &vtft, ( vtft_component * )&check_box, vtft_host_font( ), GL_RED ) );
+    TEST_CHECK( NULL == metrics_of( &check_box ) );
+    TEST_CHECK( GL_RED == check_box.text.font.color );
+    TEST_CHECK( vtft_set_font( &vtft, ( vtft_component * )&progress_bar, vtft_host_font( ), GL_RED ) );
+    TEST_CHECK( NULL == metrics_of( &progress_bar ) );
+    vtft_update( &vtft );
+    TEST_CHECK( NULL != metrics_of( &check_box ) );
+}
+
+static void check_shared_entry( void )
+{
+    const vtft_text_metrics * metrics;
+
+    vtft_set_current_screen( &vtft, &second );
+
+    // Later component of the two takes the entry.
+    TEST_CHECK( NULL == metrics_of( &label ) );
+    TEST_CHECK( NULL == metrics_of( &button ) );
+    metrics = metrics_of( &other );
+    TEST_CHECK( metrics && ( 6 * CHAR_WIDTH == metrics->size.width ) );
+
+    // Drawing the other one measures it again.
+    vtft_draw_component( &vtft, ( vtft_component * )&button );
+    metrics = metrics_of( &button );
+    TEST_CHECK( metrics && ( 4 * CHAR_WIDTH == metrics->size.width ) );
+    TEST_CHECK( NULL == metrics_of( &other ) );
+}
+
+int main( void )
+{
+    gl_driver_t driver;
+
+    vtft_host_count_driver( &driver );
+    gl_set_driver( &driver );
+    vtft_host_init( &vtft );
+    screens_setup( );
+
+    vtft_set_current_screen( &vtft, &first );
+    check_measured( );
+    check_set_caption( );
+    check_shared_entry( );
+
+    return TEST_RESULT( "vtft_text" );
+}